@@ -34,6 +34,10 @@ set(DEFAULT_FILE_WAIT "\"500ms\"" CACHE STRING "Default Logcollector file readin
 
 set(DEFAULT_RELOAD_INTERVAL "\"60000ms\"" CACHE STRING "Default Logcollector reload interval (1m)")
 
+set(DEFAULT_MAX_OPEN_FILES 1024 CACHE STRING "Default Logcollector maximum open files per file pattern (1024)")
+
+set(DEFAULT_CHECKPOINT_INTERVAL "\"5000ms\"" CACHE STRING "Default Logcollector file checkpoint interval (5s)")
+
 set(DEFAULT_INVENTORY_ENABLED true CACHE BOOL "Default inventory enabled")
 
 set(DEFAULT_INTERVAL "\"3600000ms\"" CACHE STRING "Default inventory interval (1h)")
@@ -54,8 +58,20 @@ set(DEFAULT_PORTS_ALL false CACHE BOOL "Default inventory ports all")
 
 set(DEFAULT_PROCESSES false CACHE BOOL "Default inventory processes")
 
+set(DEFAULT_PROCESSES_EVENTS false CACHE BOOL "Default inventory processes events")
+
+set(DEFAULT_PROCESSES_FIELDS "\"pid,name,ppid,cmd,argvs,euser,ruser,suser,egroup,rgroup,sgroup,start_time,tgid,tty\"" CACHE STRING "Default inventory processes fields")
+
 set(DEFAULT_HOTFIXES true CACHE BOOL "Default inventory hotfixes")
 
+set(DEFAULT_CPU_LIMIT 0 CACHE STRING "Default inventory scan CPU limit (percentage of one CPU, 0 means no limit)")
+
+set(DEFAULT_NICE 0 CACHE STRING "Default inventory scan nice level")
+
+set(DEFAULT_IO_PRIORITY "\"normal\"" CACHE STRING "Default inventory scan I/O priority")
+
+set(DEFAULT_SCAN_JITTER "\"0s\"" CACHE STRING "Default inventory scan start jitter")
+
 set(QUEUE_STATUS_REFRESH_TIMER 100 CACHE STRING "Default Agent's queue refresh timer (100ms)")
 
 set(QUEUE_DEFAULT_SIZE "\"10000B\"" CACHE STRING "Default Agent's queue size (10000)")
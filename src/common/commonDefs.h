@@ -31,6 +31,7 @@ typedef enum
 {
     UNDEFINED = 0,  /*< Undefined database. */
     SQLITE3   = 1,  /*< SQLite3 database.   */
+    MEMORY    = 2,  /*< In-memory tables, only for VOLATILE databases. */
 } DbEngineType;
 
 /**
@@ -35,6 +35,11 @@ class SysInfo: public ISysInfo
         void packages(std::function<void(nlohmann::json&)>) override;
         void processes(std::function<void(nlohmann::json&)>) override;
         nlohmann::json hotfixes() override;
+        nlohmann::json packagesFingerprint() override;
+        bool packagesComplete() override;
+        bool processEvents(std::function<void(nlohmann::json&, bool)>, std::function<bool()>) override;
+        void setProcessesFields(const std::set<std::string>& fields) override;
+        void setScanThreadHooks(const ScanThreadHooks& hooks) override;
     private:
         virtual nlohmann::json getHardware() const;
         virtual nlohmann::json getPackages() const;
@@ -43,8 +48,14 @@ class SysInfo: public ISysInfo
         virtual nlohmann::json getNetworks() const;
         virtual nlohmann::json getPorts() const;
         virtual nlohmann::json getHotfixes() const;
+        virtual nlohmann::json getPackagesFingerprint() const;
+        virtual bool getPackagesComplete() const;
+        virtual bool getProcessEvents(std::function<void(nlohmann::json&, bool)>, std::function<bool()>) const;
         virtual void getPackages(std::function<void(nlohmann::json&)>) const;
         virtual void getProcessesInfo(std::function<void(nlohmann::json&)>) const;
+
+        std::set<std::string> m_processesFields;
+        ScanThreadHooks m_scanThreadHooks;
 };
 
 #endif //_SYS_INFO_HPP
@@ -13,6 +13,17 @@
 #define _SYS_INFO_INTERFACE
 
 #include <nlohmann/json.hpp>
+#include <functional>
+#include <set>
+
+// Functions run by the worker threads that a scan starts: when a worker starts, after each item and when it ends.
+// The item function is called without any lock of the scan held, so it may sleep.
+struct ScanThreadHooks
+{
+    std::function<void()> enter;
+    std::function<void()> item;
+    std::function<void()> leave;
+};
 
 class ISysInfo
 {
@@ -30,6 +41,25 @@ class ISysInfo
         virtual nlohmann::json hotfixes() = 0;
         virtual void packages(std::function<void(nlohmann::json&)>) = 0;
         virtual void processes(std::function<void(nlohmann::json&)>) = 0;
+        // Cheap fingerprint of the package sources. A null value means that it is not available.
+        virtual nlohmann::json packagesFingerprint()
+        {
+            return nlohmann::json();
+        }
+        // Whether the last packages(callback) call reported every package. False if a scan limit cut it short.
+        virtual bool packagesComplete()
+        {
+            return true;
+        }
+        // Restricts the process data to the given fields, so that the rest is not read. Empty means all fields.
+        virtual void setProcessesFields(const std::set<std::string>&) {}
+        // Sets the hooks run by the worker threads of the packages(callback) scans.
+        virtual void setScanThreadHooks(const ScanThreadHooks&) {}
+        // Reports started (false) and exited (true) processes until stop returns true. False if not supported.
+        virtual bool processEvents(std::function<void(nlohmann::json&, bool)>, std::function<bool()>)
+        {
+            return false;
+        }
 
 };
 
@@ -14,22 +14,32 @@
 
 #include <nlohmann/json.hpp>
 #include "sharedDefs.h"
+#include "sysInfoInterface.hpp"
 #include <functional>
 #include <map>
+#include <mutex>
 
 #if defined(HAS_STDFILESYSTEM) && HAS_STDFILESYSTEM==true
 #include "packages/packagesNPM.hpp"
 #include "packages/packagesPYPI.hpp"
 #else
+class PackageScanContext
+{
+    public:
+        void startScan(const ScanThreadHooks& /*hooks*/);
+        bool complete() const;
+};
 class PYPI
 {
     public:
         void getPackages(const std::set<std::string>& /*paths*/, std::function<void(nlohmann::json&)> /*callback*/);
+        void getPackages(const std::set<std::string>& /*paths*/, std::function<void(nlohmann::json&)> /*callback*/, PackageScanContext& /*context*/);
 };
 class NPM
 {
     public:
         void getPackages(const std::set<std::string>& /*paths*/, std::function<void(nlohmann::json&)> /*callback*/);
+        void getPackages(const std::set<std::string>& /*paths*/, std::function<void(nlohmann::json&)> /*callback*/, PackageScanContext& /*context*/);
 };
 #endif
 
@@ -37,8 +47,14 @@ template <bool>
 class ModernFactoryPackagesCreator final
 {
     public:
-        static void getPackages(const std::map<std::string, std::set<std::string>>& /*paths*/, std::function<void(nlohmann::json&)> /*callback*/)
+        static void getPackages(const std::map<std::string, std::set<std::string>>& /*paths*/, std::function<void(nlohmann::json&)> /*callback*/,
+                                const ScanThreadHooks& /*hooks*/ = {})
+        {
+        }
+
+        static bool complete()
         {
+            return true;
         }
 };
 
@@ -48,10 +64,34 @@ template <>
 class ModernFactoryPackagesCreator<true> final
 {
     public:
-        static void getPackages(const std::map<std::string, std::set<std::string>>& paths, std::function<void(nlohmann::json&)> callback)
+        static void getPackages(const std::map<std::string, std::set<std::string>>& paths, std::function<void(nlohmann::json&)> callback,
+                                const ScanThreadHooks& hooks = {})
+        {
+            const std::lock_guard<std::mutex> lock {scanMutex()};
+            context().startScan(hooks);
+            PYPI().getPackages(paths.at("PYPI"), callback, context());
+            NPM().getPackages(paths.at("NPM"), callback, context());
+        }
+
+        // Whether the last scan reported every package, without reaching the limit of visited files.
+        static bool complete()
+        {
+            const std::lock_guard<std::mutex> lock {scanMutex()};
+            return context().complete();
+        }
+
+    private:
+        static std::mutex& scanMutex()
+        {
+            static std::mutex mutex;
+            return mutex;
+        }
+
+        // The manifest cache outlives the scan, so unchanged packages are not parsed again.
+        static PackageScanContext& context()
         {
-            PYPI().getPackages(paths.at("PYPI"), callback);
-            NPM().getPackages(paths.at("NPM"), callback);
+            static PackageScanContext scanContext;
+            return scanContext;
         }
 };
 
@@ -15,36 +15,31 @@
 
 void getDpkgInfo(const std::string& fileName, std::function<void(nlohmann::json&)> callback)
 {
-    std::fstream file{fileName, std::ios_base::in};
+    std::ifstream file{fileName, std::ios_base::in | std::ios_base::binary | std::ios_base::ate};
 
     if (file.is_open())
     {
-        while (file.good())
+        // The whole file is read at once and parsed in place.
+        const auto size {file.tellg()};
+
+        if (size <= 0)
         {
-            std::string line;
-            std::vector<std::string> data;
+            return;
+        }
 
-            do
-            {
-                std::getline(file, line);
+        std::string content(static_cast<size_t>(size), '\0');
+        file.seekg(0);
+        file.read(content.data(), size);
+        content.resize(static_cast<size_t>(file.gcount()));
 
-                if (line.front() == ' ') //additional info
-                {
-                    data.back() = data.back() + line + "\n";
-                }
-                else
-                {
-                    data.push_back(line + "\n");
-                }
-            }
-            while (!line.empty()); //end of package item info
-
-            auto packageInfo = PackageLinuxHelper::parseDpkg(data);
+        PackageLinuxHelper::parseDpkgStatus(content, [&callback](const PackageLinuxHelper::DpkgStanza & stanza)
+        {
+            auto packageInfo = PackageLinuxHelper::parseDpkg(stanza);
 
             if (!packageInfo.empty())
             {
                 callback(packageInfo);
             }
-        }
+        });
     }
 }
@@ -28,29 +28,79 @@
 #pragma warning(disable: 4505)
 #endif
 
+#include <charconv>
+#include <functional>
 #include <sstream>
+#include <string_view>
 
 // Parse helpers for standard Linux packaging systems (rpm, dpkg, ...)
 namespace PackageLinuxHelper
 {
 
-    static nlohmann::json parseDpkg(const std::vector<std::string>& entries)
+    /**
+     * @brief Fields of a dpkg status stanza that are exported, as views on the parsed text.
+     *
+     * @details Multiline values span their continuation lines, separated by new lines.
+     */
+    struct DpkgStanza
     {
-        std::map<std::string, std::string> info;
-        nlohmann::json ret;
+        std::string_view package;
+        std::string_view status;
+        std::string_view priority;
+        std::string_view section;
+        std::string_view installedSize;
+        std::string_view multiArch;
+        std::string_view architecture;
+        std::string_view source;
+        std::string_view version;
+        std::string_view maintainer;
+        std::string_view description;
+    };
+
+    static const std::pair<std::string_view, std::string_view DpkgStanza::*> DPKG_FIELDS[]
+    {
+        { "Package",        &DpkgStanza::package        },
+        { "Status",         &DpkgStanza::status         },
+        { "Priority",       &DpkgStanza::priority       },
+        { "Section",        &DpkgStanza::section        },
+        { "Installed-Size", &DpkgStanza::installedSize  },
+        { "Multi-Arch",     &DpkgStanza::multiArch      },
+        { "Architecture",   &DpkgStanza::architecture   },
+        { "Source",         &DpkgStanza::source         },
+        { "Version",        &DpkgStanza::version        },
+        { "Maintainer",     &DpkgStanza::maintainer     },
+        { "Description",    &DpkgStanza::description    }
+    };
+
+    static std::string_view trimDpkgValue(std::string_view value, std::string_view chars = " ")
+    {
+        const auto first {value.find_first_not_of(chars)};
 
-        for (const auto& entry : entries)
+        if (first == std::string_view::npos)
         {
-            const auto pos{entry.find(":")};
+            return value.substr(value.size());
+        }
 
-            if (pos != std::string::npos)
+        return value.substr(first, value.find_last_not_of(chars) - first + 1);
+    }
+
+    static std::string_view* dpkgField(DpkgStanza& stanza, std::string_view key)
+    {
+        for (const auto& [name, field] : DPKG_FIELDS)
+        {
+            if (name == key)
             {
-                const auto key{Utils::trim(entry.substr(0, pos))};
-                const auto value{Utils::trim(entry.substr(pos + 1), " \n")};
-                info[key] = value;
+                return &(stanza.*field);
             }
         }
 
+        return nullptr;
+    }
+
+    static nlohmann::json parseDpkg(const DpkgStanza& stanza)
+    {
+        nlohmann::json ret;
+
         /*
            According to dpkg documentation, the status of the package consists in three fields separated by spaces:
            'SELECTION_STATE FLAG PACKAGE_STATE'.
@@ -65,99 +115,132 @@ namespace PackageLinuxHelper
 
            We'll collect packages in any selection state, with 'ok' FLAG and 'installed' PACKAGE_STATE.
          */
-        if (!info.empty() && info.at("Status").find("ok installed") != std::string::npos)
+        if (stanza.package.empty() || stanza.status.find("ok installed") == std::string_view::npos)
         {
-            ret["name"] = info.at("Package");
-
-            nlohmann::json priority = UNKNOWN_VALUE;
-            nlohmann::json groups = UNKNOWN_VALUE;
-            // The multiarch field won't have a default value
-            nlohmann::json multiarch = UNKNOWN_VALUE;
-            nlohmann::json architecture = EMPTY_VALUE;
-            nlohmann::json source = UNKNOWN_VALUE;
-            nlohmann::json version = EMPTY_VALUE;
-            nlohmann::json vendor = UNKNOWN_VALUE;
-            nlohmann::json description = UNKNOWN_VALUE;
-            int64_t size { 0 };
-
-            auto it{info.find("Priority")};
-
-            if (it != info.end())
-            {
-                priority = it->second;
-            }
-
-            it = info.find("Section");
+            return ret;
+        }
 
-            if (it != info.end())
-            {
-                groups = it->second;
-            }
+        // Fields that are not present take a default value, even if they are empty.
+        const auto valueOr = [](std::string_view value, const nlohmann::json & defaultValue) -> nlohmann::json
+        {
+            return value.data() ? nlohmann::json(std::string(value)) : defaultValue;
+        };
+
+        int64_t size { 0 };
+        std::from_chars(stanza.installedSize.data(), stanza.installedSize.data() + stanza.installedSize.size(), size);
+
+        ret["name"]         = std::string(stanza.package);
+        ret["priority"]     = valueOr(stanza.priority, UNKNOWN_VALUE);
+        ret["groups"]       = valueOr(stanza.section, UNKNOWN_VALUE);
+        ret["size"]         = size * 1024;
+        ret["multiarch"]    = valueOr(stanza.multiArch, UNKNOWN_VALUE);
+        ret["architecture"] = valueOr(stanza.architecture, EMPTY_VALUE);
+        ret["source"]       = valueOr(stanza.source, UNKNOWN_VALUE);
+        ret["version"]      = valueOr(stanza.version, EMPTY_VALUE);
+        ret["format"]       = "deb";
+        ret["location"]     = EMPTY_VALUE;
+        ret["vendor"]       = valueOr(stanza.maintainer, UNKNOWN_VALUE);
+        ret["install_time"] = UNKNOWN_VALUE;
+        ret["description"]  = valueOr(stanza.description.substr(0, stanza.description.find('\n')), UNKNOWN_VALUE);
 
-            it = info.find("Installed-Size");
+        return ret;
+    }
 
-            if (it != info.end())
-            {
-                size = stoll(it->second) * 1024;
-            }
+    static nlohmann::json parseDpkg(const std::vector<std::string>& entries)
+    {
+        DpkgStanza stanza;
 
-            it = info.find("Multi-Arch");
+        for (const auto& entry : entries)
+        {
+            const auto pos{entry.find(":")};
 
-            if (it != info.end())
+            if (pos != std::string::npos)
             {
-                multiarch = it->second;
+                const std::string_view view {entry};
+                const auto field {dpkgField(stanza, trimDpkgValue(view.substr(0, pos)))};
+
+                if (field)
+                {
+                    *field = trimDpkgValue(view.substr(pos + 1), " \n");
+                }
             }
+        }
 
-            it = info.find("Architecture");
+        return parseDpkg(stanza);
+    }
 
-            if (it != info.end())
-            {
-                architecture = it->second;
-            }
+    /**
+     * @brief Parses the contents of a dpkg status file, one stanza at a time.
+     *
+     * @param content  Contents of the status file.
+     * @param callback Callback to be called for every stanza, whose views are only valid during the call.
+     *
+     * @details Only the exported fields are kept, and no value is copied.
+     */
+    static void parseDpkgStatus(std::string_view content, const std::function<void(const DpkgStanza&)>& callback)
+    {
+        DpkgStanza stanza;
+        std::string_view* current { nullptr };
+        auto hasFields { false };
+        size_t pos { 0 };
 
-            it = info.find("Source");
+        while (pos < content.size())
+        {
+            auto end { content.find('\n', pos) };
 
-            if (it != info.end())
+            if (end == std::string_view::npos)
             {
-                source = it->second;
+                end = content.size();
             }
 
-            it = info.find("Version");
+            const auto line { content.substr(pos, end - pos) };
+            pos = end + 1;
 
-            if (it != info.end())
+            if (line.empty())
             {
-                version = it->second;
-            }
-
-            it = info.find("Maintainer");
+                // End of package item info.
+                if (hasFields)
+                {
+                    callback(stanza);
+                }
 
-            if (it != info.end())
+                stanza = DpkgStanza();
+                current = nullptr;
+                hasFields = false;
+            }
+            else if (line.front() == ' ' || line.front() == '\t')
             {
-                vendor = it->second;
+                // Additional info of the previous field.
+                const auto value { trimDpkgValue(line, " \t") };
+
+                if (current && !value.empty())
+                {
+                    const auto valueEnd { value.data() + value.size() };
+                    *current = current->empty() ? value : std::string_view(current->data(), static_cast<size_t>(valueEnd - current->data()));
+                }
             }
+            else
+            {
+                const auto colon { line.find(':') };
+                current = nullptr;
 
-            it = info.find("Description");
+                if (colon != std::string_view::npos)
+                {
+                    hasFields = true;
+                    current = dpkgField(stanza, trimDpkgValue(line.substr(0, colon)));
 
-            if (it != info.end())
-            {
-                description = Utils::substrOnFirstOccurrence(it->second, "\n");
+                    if (current)
+                    {
+                        *current = trimDpkgValue(line.substr(colon + 1));
+                    }
+                }
             }
-
-            ret["priority"]     = priority;
-            ret["groups"]       = groups;
-            ret["size"]         = size;
-            ret["multiarch"]    = multiarch;
-            ret["architecture"] = architecture;
-            ret["source"]       = source;
-            ret["version"]      = version;
-            ret["format"]       = "deb";
-            ret["location"]     = EMPTY_VALUE;
-            ret["vendor"]       = vendor;
-            ret["install_time"] = UNKNOWN_VALUE;
-            ret["description"]  = description;
         }
 
-        return ret;
+        if (hasFields)
+        {
+            callback(stanza);
+        }
     }
 
     static nlohmann::json parseSnap(const nlohmann::json& info)
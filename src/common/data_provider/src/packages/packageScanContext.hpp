@@ -0,0 +1,268 @@
+/*
+ * Wazuh data provider.
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 19, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _PACKAGE_SCAN_CONTEXT_HPP
+#define _PACKAGE_SCAN_CONTEXT_HPP
+
+#include <nlohmann/json.hpp>
+#include "sysInfoInterface.hpp"
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+constexpr size_t PACKAGES_MAX_VISITED_FILES {200000};
+constexpr unsigned int PACKAGES_MAX_WORKERS {4};
+
+/**
+ * @brief Shared state of the language package scans (PyPI and NPM).
+ *
+ * @details Manifests are parsed on a bounded pool of workers and cached by path, modification time and
+ * size, so unchanged packages are not parsed again in later scans. The number of files visited in a
+ * single scan is capped, and a scan that reaches the cap is not complete. The workers run the thread
+ * hooks of the scan, so the caller can set their priority and account their CPU time.
+ */
+class PackageScanContext final
+{
+        struct Manifest
+        {
+            std::filesystem::file_time_type lastWriteTime;
+            std::uintmax_t size;
+            nlohmann::json package;
+            bool seen;
+        };
+
+        size_t m_maxVisitedFiles;
+        unsigned int m_maxWorkers;
+        std::atomic<size_t> m_visitedFiles;
+        std::mutex m_cacheMutex;
+        std::unordered_map<std::string, Manifest> m_cache;
+        std::mutex m_callbackMutex;
+        std::vector<nlohmann::json> m_pendingPackages;
+        bool m_reporting;
+        ScanThreadHooks m_threadHooks;
+
+    public:
+        explicit PackageScanContext(size_t maxVisitedFiles = PACKAGES_MAX_VISITED_FILES,
+                                    unsigned int maxWorkers = PACKAGES_MAX_WORKERS)
+            : m_maxVisitedFiles {maxVisitedFiles}
+            , m_maxWorkers {std::max(maxWorkers, 1U)}
+            , m_visitedFiles {0}
+            , m_reporting {false}
+        { }
+
+        /**
+         * @brief Starts a new scan: resets the visited files and drops the manifests not seen since the
+         * previous scan.
+         *
+         * @param hooks Hooks run by the workers of the scan.
+         */
+        void startScan(const ScanThreadHooks& hooks = {})
+        {
+            m_visitedFiles = 0;
+            m_threadHooks = hooks;
+
+            const std::lock_guard<std::mutex> lock {m_cacheMutex};
+
+            for (auto it = m_cache.begin(); it != m_cache.end();)
+            {
+                if (it->second.seen)
+                {
+                    it->second.seen = false;
+                    ++it;
+                }
+                else
+                {
+                    it = m_cache.erase(it);
+                }
+            }
+        }
+
+        /**
+         * @brief Counts a visited file.
+         *
+         * @return False once the maximum number of files of the scan is exceeded.
+         */
+        bool visit()
+        {
+            const auto visited {++m_visitedFiles};
+
+            if (visited == m_maxVisitedFiles + 1)
+            {
+                std::cerr << "Package scan limit reached, after " << m_maxVisitedFiles << " files." << std::endl;
+            }
+
+            return visited <= m_maxVisitedFiles;
+        }
+
+        /**
+         * @brief Whether the scan visited every file, so every package was reported.
+         */
+        bool complete() const
+        {
+            return m_visitedFiles <= m_maxVisitedFiles;
+        }
+
+        /**
+         * @brief Runs a task for every item on the worker pool, and waits for all of them.
+         *
+         * @details The calling thread is one of the workers. The threads started for the pool run the enter
+         * and leave hooks, and every worker runs the item hook after each task.
+         *
+         * @param items Items to process.
+         * @param task  Task to run, which must not throw.
+         */
+        template<typename TItem>
+        void forEach(const std::vector<TItem>& items, const std::function<void(const TItem&)>& task)
+        {
+            std::atomic<size_t> next {0};
+
+            const auto worker {[&]()
+            {
+                for (auto i {next++}; i < items.size(); i = next++)
+                {
+                    task(items[i]);
+
+                    if (m_threadHooks.item)
+                    {
+                        m_threadHooks.item();
+                    }
+                }
+            }};
+
+            const auto poolWorker {[&]()
+            {
+                if (m_threadHooks.enter)
+                {
+                    m_threadHooks.enter();
+                }
+
+                worker();
+
+                if (m_threadHooks.leave)
+                {
+                    m_threadHooks.leave();
+                }
+            }};
+
+            const auto workerCount {std::min<size_t>({m_maxWorkers, std::max(std::thread::hardware_concurrency(), 1U), items.size()})};
+            std::vector<std::thread> workers;
+
+            for (size_t i = 1; i < workerCount; ++i)
+            {
+                workers.emplace_back(poolWorker);
+            }
+
+            worker();
+
+            for (auto& thread : workers)
+            {
+                thread.join();
+            }
+        }
+
+        /**
+         * @brief Gets the package described by a manifest, parsing it only if it changed since it was cached.
+         *
+         * @param path   Manifest path.
+         * @param parser Function that parses the manifest, returning null if it is not a valid package.
+         *
+         * @return Package information, or null.
+         */
+        nlohmann::json manifest(const std::filesystem::path& path, const std::function<nlohmann::json()>& parser)
+        {
+            std::error_code ec;
+            const auto lastWriteTime {std::filesystem::last_write_time(path, ec)};
+            const auto size {ec ? 0 : std::filesystem::file_size(path, ec)};
+
+            if (ec)
+            {
+                // Manifests that cannot be checked are never cached.
+                return parser();
+            }
+
+            const auto key {path.string()};
+
+            {
+                const std::lock_guard<std::mutex> lock {m_cacheMutex};
+                const auto it {m_cache.find(key)};
+
+                if (it != m_cache.end() && it->second.lastWriteTime == lastWriteTime && it->second.size == size)
+                {
+                    it->second.seen = true;
+                    return it->second.package;
+                }
+            }
+
+            auto package = parser();
+
+            const std::lock_guard<std::mutex> lock {m_cacheMutex};
+            m_cache[key] = Manifest {lastWriteTime, size, package, true};
+
+            return package;
+        }
+
+        /**
+         * @brief Reports a package. Packages are reported one at a time, from any worker.
+         *
+         * @details The packages are queued, and the worker that finds no report in progress reports the
+         * queue. The callback is not called under the queue mutex, so the other workers keep parsing
+         * while it runs, even if it waits.
+         */
+        void report(nlohmann::json& package, const std::function<void(nlohmann::json&)>& callback)
+        {
+            std::unique_lock<std::mutex> lock {m_callbackMutex};
+            m_pendingPackages.push_back(std::move(package));
+
+            if (m_reporting)
+            {
+                return;
+            }
+
+            m_reporting = true;
+
+            try
+            {
+                while (!m_pendingPackages.empty())
+                {
+                    std::vector<nlohmann::json> packages;
+                    packages.swap(m_pendingPackages);
+                    lock.unlock();
+
+                    for (auto& pendingPackage : packages)
+                    {
+                        callback(pendingPackage);
+                    }
+
+                    lock.lock();
+                }
+            }
+            catch (...)
+            {
+                if (!lock.owns_lock())
+                {
+                    lock.lock();
+                }
+
+                m_reporting = false;
+                throw;
+            }
+
+            m_reporting = false;
+        }
+};
+
+#endif // _PACKAGE_SCAN_CONTEXT_HPP
@@ -15,6 +15,7 @@
 #include "filesystem_wrapper.hpp"
 #include <nlohmann/json.hpp>
 #include "jsonIO.hpp"
+#include "packageScanContext.hpp"
 #include "sharedDefs.h"
 #include <filesystem>
 #include <fstream>
@@ -26,7 +27,7 @@ class NPM final
     : public TFileSystem
     , public TJsonReader
 {
-        void parsePackage(const std::filesystem::path& folderPath, std::function<void(nlohmann::json&)>& callback)
+        nlohmann::json parsePackage(const std::filesystem::path& path)
         {
             // Map to match fields
             static const std::map<std::string, std::string> NPM_FIELDS
@@ -36,7 +37,6 @@ class NPM final
                 {"description", "description"},
                 {"homepage", "source"},
             };
-            const auto path = folderPath / "package.json";
 
             try
             {
@@ -69,7 +69,7 @@ class NPM final
 
                     if (packageInfo.contains("name") && packageInfo.contains("version"))
                     {
-                        callback(packageInfo);
+                        return packageInfo;
                     }
                 }
             }
@@ -77,11 +77,16 @@ class NPM final
             {
                 std::cerr << "Error reading NPM package: " << path.string() << ", " << e.what() << std::endl;
             }
+
+            return nlohmann::json();
         }
 
         void exploreExpandedPaths(const std::deque<std::string>& expandedPaths,
-                                  std::function<void(nlohmann::json&)> callback)
+                                  const std::function<void(nlohmann::json&)>& callback,
+                                  PackageScanContext& context)
         {
+            std::vector<std::filesystem::path> packageFolders;
+
             for (const auto& expandedPath : expandedPaths)
             {
                 try
@@ -93,10 +98,12 @@ class NPM final
                     {
                         for (const auto& packageFolder : TFileSystem::list_directory(nodeModulesFolder))
                         {
-                            if (TFileSystem::is_directory(packageFolder))
+                            if (!context.visit())
                             {
-                                parsePackage(packageFolder, callback);
+                                break;
                             }
+
+                            packageFolders.push_back(packageFolder);
                         }
                     }
                 }
@@ -106,6 +113,32 @@ class NPM final
                     (void)e;
                 }
             }
+
+            // Package folders are checked and parsed concurrently.
+            context.forEach<std::filesystem::path>(packageFolders, [&](const std::filesystem::path & packageFolder)
+            {
+                try
+                {
+                    if (TFileSystem::is_directory(packageFolder))
+                    {
+                        const auto path = packageFolder / "package.json";
+                        auto packageInfo = context.manifest(path, [this, &path]()
+                        {
+                            return parsePackage(path);
+                        });
+
+                        if (!packageInfo.is_null())
+                        {
+                            context.report(packageInfo, callback);
+                        }
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    // Ignore exception, continue with next folder
+                    (void)e;
+                }
+            });
         }
 
     public:
@@ -114,18 +147,23 @@ class NPM final
 
         void getPackages(const std::set<std::string>& osRootFolders, std::function<void(nlohmann::json&)> callback)
         {
+            PackageScanContext context;
+            getPackages(osRootFolders, callback, context);
+        }
+
+        void getPackages(const std::set<std::string>& osRootFolders,
+                         std::function<void(nlohmann::json&)> callback,
+                         PackageScanContext& context)
+        {
+            std::deque<std::string> expandedPaths;
 
             // Iterate over node_modules folders
             for (const auto& osRootFolder : osRootFolders)
             {
                 try
                 {
-                    std::deque<std::string> expandedPaths;
-
                     // Expand paths
                     TFileSystem::expand_absolute_path(osRootFolder, expandedPaths);
-                    // Explore expanded paths
-                    exploreExpandedPaths(expandedPaths, callback);
                 }
                 catch (const std::exception& e)
                 {
@@ -133,6 +171,9 @@ class NPM final
                     (void)e;
                 }
             }
+
+            // Explore expanded paths
+            exploreExpandedPaths(expandedPaths, callback, context);
         }
 };
 
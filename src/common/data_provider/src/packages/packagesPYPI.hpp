@@ -15,6 +15,7 @@
 #include "file_io.hpp"
 #include "filesystem_wrapper.hpp"
 #include <nlohmann/json.hpp>
+#include "packageScanContext.hpp"
 #include "sharedDefs.h"
 #include "stringHelper.h"
 #include <iostream>
@@ -25,7 +26,7 @@ const static std::map<std::string, std::string> FILE_MAPPING_PYPI {{"egg-info",
 template<typename TFileSystem = filesystem_wrapper::FileSystemWrapper, typename TFileIO = file_io::FileIO>
 class PYPI final : public TFileSystem, public TFileIO
 {
-        void parseMetadata(const std::filesystem::path& path, std::function<void(nlohmann::json&)>& callback)
+        nlohmann::json parseMetadata(const std::filesystem::path& path)
         {
             // Map to match fields
             static const std::map<std::string, std::string> PYPI_FIELDS {{"Name: ", "name"},
@@ -75,11 +76,30 @@ class PYPI final : public TFileSystem, public TFileIO
             // Check if we have a name and version
             if (packageInfo.contains("name") && packageInfo.contains("version"))
             {
-                callback(packageInfo);
+                return packageInfo;
+            }
+
+            return nlohmann::json();
+        }
+
+        void reportMetadata(const std::filesystem::path& path,
+                            const std::function<void(nlohmann::json&)>& callback,
+                            PackageScanContext& context)
+        {
+            auto packageInfo = context.manifest(path, [this, &path]()
+            {
+                return parseMetadata(path);
+            });
+
+            if (!packageInfo.is_null())
+            {
+                context.report(packageInfo, callback);
             }
         }
 
-        void findCorrectPath(const std::filesystem::path& path, std::function<void(nlohmann::json&)> callback)
+        void findCorrectPath(const std::filesystem::path& path,
+                             const std::function<void(nlohmann::json&)>& callback,
+                             PackageScanContext& context)
         {
             try
             {
@@ -91,11 +111,11 @@ class PYPI final : public TFileSystem, public TFileIO
                     {
                         if (TFileSystem::is_regular_file(path))
                         {
-                            parseMetadata(path, callback);
+                            reportMetadata(path, callback, context);
                         }
                         else if (TFileSystem::is_directory(path))
                         {
-                            parseMetadata(path / value, callback);
+                            reportMetadata(path / value, callback, context);
                         }
                         else
                         {
@@ -109,9 +129,13 @@ class PYPI final : public TFileSystem, public TFileIO
                 std::cerr << "Error parsing PYPI package: " << path.string() << ", " << e.what() << std::endl;
             }
         }
+
         void exploreExpandedPaths(const std::deque<std::string>& expandedPaths,
-                                  std::function<void(nlohmann::json&)> callback)
+                                  const std::function<void(nlohmann::json&)>& callback,
+                                  PackageScanContext& context)
         {
+            std::vector<std::filesystem::path> paths;
+
             for (const auto& expandedPath : expandedPaths)
             {
                 try
@@ -121,7 +145,12 @@ class PYPI final : public TFileSystem, public TFileIO
                     {
                         for (const std::filesystem::path& path : TFileSystem::list_directory(expandedPath))
                         {
-                            findCorrectPath(path, callback);
+                            if (!context.visit())
+                            {
+                                break;
+                            }
+
+                            paths.push_back(path);
                         }
                     }
                 }
@@ -130,28 +159,42 @@ class PYPI final : public TFileSystem, public TFileIO
                     // Do nothing, continue with the next path
                 }
             }
+
+            // Metadata files are located and parsed concurrently.
+            context.forEach<std::filesystem::path>(paths, [&](const std::filesystem::path & path)
+            {
+                findCorrectPath(path, callback, context);
+            });
         }
 
     public:
         void getPackages(const std::set<std::string>& osRootFolders, std::function<void(nlohmann::json&)> callback)
         {
+            PackageScanContext context;
+            getPackages(osRootFolders, callback, context);
+        }
+
+        void getPackages(const std::set<std::string>& osRootFolders,
+                         std::function<void(nlohmann::json&)> callback,
+                         PackageScanContext& context)
+        {
+            std::deque<std::string> expandedPaths;
 
             for (const auto& osFolder : osRootFolders)
             {
-                std::deque<std::string> expandedPaths;
-
                 try
                 {
                     // Expand paths
                     TFileSystem::expand_absolute_path(osFolder, expandedPaths);
-                    // Explore expanded paths
-                    exploreExpandedPaths(expandedPaths, callback);
                 }
                 catch (const std::exception&)
                 {
                     // Do nothing, continue with the next path
                 }
             }
+
+            // Explore expanded paths
+            exploreExpandedPaths(expandedPaths, callback, context);
         }
 };
 
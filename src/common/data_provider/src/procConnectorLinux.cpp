@@ -0,0 +1,194 @@
+/*
+ * Wazuh SysInfo
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 19, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "procConnectorLinux.h"
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <linux/cn_proc.h>
+#include <linux/connector.h>
+#include <linux/netlink.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <system_error>
+#include <unistd.h>
+
+// Event identifiers of the connector ABI. Kernel headers declare them in different scopes across versions.
+constexpr uint32_t PROC_CONNECTOR_FORK {0x00000001};
+constexpr uint32_t PROC_CONNECTOR_EXEC {0x00000002};
+constexpr uint32_t PROC_CONNECTOR_EXIT {0x80000000};
+
+constexpr int PROC_CONNECTOR_RCVBUF_SIZE {1024 * 1024};
+constexpr size_t PROC_CONNECTOR_BUFFER_SIZE {8192};
+
+ProcConnector::ProcConnector()
+    : m_socket {socket(PF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_CONNECTOR)}
+{
+    if (m_socket < 0)
+    {
+        throw std::system_error {errno, std::system_category(), "Error creating the netlink connector socket"};
+    }
+
+    // A larger buffer absorbs bursts of events while the consumer is busy.
+    setsockopt(m_socket, SOL_SOCKET, SO_RCVBUF, &PROC_CONNECTOR_RCVBUF_SIZE, sizeof(PROC_CONNECTOR_RCVBUF_SIZE));
+
+    sockaddr_nl address {};
+    address.nl_family = AF_NETLINK;
+    address.nl_groups = CN_IDX_PROC;
+
+    try
+    {
+        if (bind(m_socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0)
+        {
+            throw std::system_error {errno, std::system_category(), "Error binding the netlink connector socket"};
+        }
+
+        subscribe(true);
+    }
+    catch (...)
+    {
+        close(m_socket);
+        throw;
+    }
+}
+
+ProcConnector::~ProcConnector()
+{
+    try
+    {
+        subscribe(false);
+    }
+    catch (...)
+    {
+        // The socket is closed anyway, which also drops the subscription.
+    }
+
+    close(m_socket);
+}
+
+void ProcConnector::subscribe(bool listen)
+{
+    constexpr auto PAYLOAD_SIZE {sizeof(cn_msg) + sizeof(proc_cn_mcast_op)};
+    alignas(nlmsghdr) std::array<char, NLMSG_SPACE(PAYLOAD_SIZE)> buffer {};
+
+    nlmsghdr header {};
+    header.nlmsg_len = NLMSG_LENGTH(PAYLOAD_SIZE);
+    header.nlmsg_type = NLMSG_DONE;
+    header.nlmsg_pid = static_cast<__u32>(getpid());
+
+    cn_msg message {};
+    message.id.idx = CN_IDX_PROC;
+    message.id.val = CN_VAL_PROC;
+    message.len = sizeof(proc_cn_mcast_op);
+
+    const proc_cn_mcast_op operation {listen ? PROC_CN_MCAST_LISTEN : PROC_CN_MCAST_IGNORE};
+
+    std::memcpy(buffer.data(), &header, sizeof(header));
+    std::memcpy(buffer.data() + NLMSG_HDRLEN, &message, sizeof(message));
+    std::memcpy(buffer.data() + NLMSG_HDRLEN + sizeof(message), &operation, sizeof(operation));
+
+    if (send(m_socket, buffer.data(), header.nlmsg_len, 0) < 0)
+    {
+        throw std::system_error {errno, std::system_category(), "Error subscribing to the process events"};
+    }
+}
+
+void ProcConnector::poll(std::chrono::milliseconds timeout,
+                         const ProcEventCallback& callback,
+                         const std::function<bool()>& stop)
+{
+    pollfd descriptor {m_socket, POLLIN, 0};
+
+    if (::poll(&descriptor, 1, static_cast<int>(timeout.count())) <= 0)
+    {
+        return;
+    }
+
+    alignas(nlmsghdr) std::array<char, PROC_CONNECTOR_BUFFER_SIZE> buffer {};
+
+    // A steady stream of events must not keep the caller from stopping.
+    while (!stop())
+    {
+        const auto received {recv(m_socket, buffer.data(), buffer.size(), MSG_DONTWAIT)};
+
+        if (received > 0)
+        {
+            parse(buffer.data(), static_cast<size_t>(received), callback);
+        }
+        else if (received == 0 || errno != ENOBUFS)
+        {
+            // No more pending events. An overflow (ENOBUFS) only means that some events were lost.
+            break;
+        }
+    }
+}
+
+void ProcConnector::parse(const char* buffer, size_t size, const ProcEventCallback& callback)
+{
+    size_t offset {0};
+
+    while (offset + NLMSG_HDRLEN <= size)
+    {
+        nlmsghdr header {};
+        std::memcpy(&header, buffer + offset, sizeof(header));
+
+        if (header.nlmsg_len < NLMSG_HDRLEN || offset + header.nlmsg_len > size)
+        {
+            break;
+        }
+
+        const auto payload {buffer + offset + NLMSG_HDRLEN};
+        const auto payloadSize {header.nlmsg_len - NLMSG_HDRLEN};
+
+        if (header.nlmsg_type == NLMSG_DONE && payloadSize >= sizeof(cn_msg) + sizeof(proc_event))
+        {
+            cn_msg message {};
+            std::memcpy(&message, payload, sizeof(message));
+
+            if (message.id.idx == CN_IDX_PROC && message.id.val == CN_VAL_PROC)
+            {
+                proc_event event {};
+                std::memcpy(&event, payload + sizeof(message), sizeof(event));
+
+                // A process that forks without running a new program is only seen through its fork.
+                switch (static_cast<uint32_t>(event.what))
+                {
+                    case PROC_CONNECTOR_FORK:
+
+                        if (event.event_data.fork.child_pid == event.event_data.fork.child_tgid)
+                        {
+                            callback(event.event_data.fork.child_tgid, ProcEventType::STARTED);
+                        }
+
+                        break;
+
+                    case PROC_CONNECTOR_EXEC:
+                        callback(event.event_data.exec.process_tgid, ProcEventType::STARTED);
+                        break;
+
+                    case PROC_CONNECTOR_EXIT:
+
+                        if (event.event_data.exit.process_pid == event.event_data.exit.process_tgid)
+                        {
+                            callback(event.event_data.exit.process_tgid, ProcEventType::EXITED);
+                        }
+
+                        break;
+
+                    default:
+                        break;
+                }
+            }
+        }
+
+        offset += NLMSG_ALIGN(header.nlmsg_len);
+    }
+}
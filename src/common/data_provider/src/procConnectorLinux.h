@@ -0,0 +1,76 @@
+/*
+ * Wazuh SysInfo
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 19, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _PROC_CONNECTOR_LINUX_H
+#define _PROC_CONNECTOR_LINUX_H
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <sys/types.h>
+
+enum class ProcEventType
+{
+    STARTED,
+    EXITED
+};
+
+using ProcEventCallback = std::function<void(pid_t, ProcEventType)>;
+
+/**
+ * @brief Subscription to the process events of the kernel netlink process connector.
+ *
+ * @details Only processes are reported: thread creation and exit events are ignored.
+ * A process is reported as started when it is forked, and again when it runs a new program.
+ */
+class ProcConnector final
+{
+    public:
+        /**
+         * @brief Opens a netlink connector socket and subscribes to the process events.
+         *
+         * @throws std::system_error if the subscription fails, for instance, without CAP_NET_ADMIN.
+         */
+        ProcConnector();
+        ~ProcConnector();
+
+        ProcConnector(const ProcConnector&) = delete;
+        ProcConnector& operator=(const ProcConnector&) = delete;
+
+        /**
+         * @brief Waits for process events and reports all the pending ones.
+         *
+         * @param timeout  Maximum time to wait for the first event.
+         * @param callback Callback to be called for every single event.
+         * @param stop     Checked between messages, the pending events are left unread once it returns true.
+         *
+         * @details Events dropped by the kernel when the socket buffer overflows are not reported.
+         */
+        void poll(std::chrono::milliseconds timeout,
+                  const ProcEventCallback& callback,
+                  const std::function<bool()>& stop);
+
+        /**
+         * @brief Parses the netlink messages received from the process connector.
+         *
+         * @param buffer   Received data.
+         * @param size     Size of the received data.
+         * @param callback Callback to be called for every single event.
+         */
+        static void parse(const char* buffer, size_t size, const ProcEventCallback& callback);
+
+    private:
+        void subscribe(bool listen);
+
+        int m_socket;
+};
+
+#endif // _PROC_CONNECTOR_LINUX_H
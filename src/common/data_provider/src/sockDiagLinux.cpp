@@ -0,0 +1,173 @@
+/*
+ * Wazuh SysInfo
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 19, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "sockDiagLinux.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <linux/inet_diag.h>
+#include <linux/netlink.h>
+#include <linux/sock_diag.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <system_error>
+#include <unistd.h>
+#include "stringHelper.h"
+#include "networkHelper.h"
+#include "ports/portLinuxWrapper.h"
+
+// Large enough for a full batch of messages of a dump, which the kernel sizes to the page size.
+constexpr size_t SOCK_DIAG_BUFFER_SIZE {64 * 1024};
+constexpr uint32_t SOCK_DIAG_ALL_STATES {0xFFFFFFFF};
+
+static void buildPortData(const inet_diag_msg& message, PortType type, nlohmann::json& port)
+{
+    const auto family {IPVERSION_TYPE.at(type) == IPV4 ? AF_INET : AF_INET6};
+    const auto isTcp {PROTOCOL_TYPE.at(type) == TCP};
+
+    port["protocol"] = PORTS_TYPE.at(type);
+    port["local_ip"] = Utils::NetworkHelper::IAddressToBinary(family, message.id.idiag_src);
+    port["local_port"] = static_cast<int32_t>(ntohs(message.id.idiag_sport));
+    port["remote_ip"] = Utils::NetworkHelper::IAddressToBinary(family, message.id.idiag_dst);
+    port["remote_port"] = static_cast<int32_t>(ntohs(message.id.idiag_dport));
+    // Listening sockets report their backlog limit as write queue, which /proc/net does not.
+    port["tx_queue"] = isTcp && message.idiag_state == TCP_LISTEN ? 0 : static_cast<int32_t>(message.idiag_wqueue);
+    port["rx_queue"] = static_cast<int32_t>(message.idiag_rqueue);
+    port["inode"] = static_cast<int64_t>(message.idiag_inode);
+    port["state"] = UNKNOWN_VALUE;
+
+    if (isTcp)
+    {
+        const auto itState {STATE_TYPE.find(message.idiag_state)};
+
+        if (STATE_TYPE.end() != itState)
+        {
+            port["state"] = itState->second;
+        }
+    }
+
+    port["pid"] = UNKNOWN_VALUE;
+    port["process"] = UNKNOWN_VALUE;
+}
+
+SockDiag::SockDiag()
+    : m_socket {socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_SOCK_DIAG)}
+    , m_buffer(SOCK_DIAG_BUFFER_SIZE)
+{
+    if (m_socket < 0)
+    {
+        throw std::system_error {errno, std::system_category(), "Error creating the sock_diag socket"};
+    }
+}
+
+SockDiag::~SockDiag()
+{
+    close(m_socket);
+}
+
+void SockDiag::dump(PortType type, const SockDiagCallback& callback)
+{
+    struct
+    {
+        nlmsghdr header;
+        inet_diag_req_v2 request;
+    } message {};
+
+    message.header.nlmsg_len = sizeof(message);
+    message.header.nlmsg_type = SOCK_DIAG_BY_FAMILY;
+    message.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    message.request.sdiag_family = IPVERSION_TYPE.at(type) == IPV4 ? AF_INET : AF_INET6;
+    message.request.sdiag_protocol = PROTOCOL_TYPE.at(type) == TCP ? IPPROTO_TCP : IPPROTO_UDP;
+    message.request.idiag_states = SOCK_DIAG_ALL_STATES;
+
+    sockaddr_nl kernel {};
+    kernel.nl_family = AF_NETLINK;
+
+    if (sendto(m_socket, &message, sizeof(message), 0, reinterpret_cast<sockaddr*>(&kernel), sizeof(kernel)) < 0)
+    {
+        throw std::system_error {errno, std::system_category(), "Error requesting the sockets"};
+    }
+
+    auto done {false};
+
+    while (!done)
+    {
+        const auto received {recv(m_socket, m_buffer.data(), m_buffer.size(), 0)};
+
+        if (received < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            throw std::system_error {errno, std::system_category(), "Error receiving the sockets"};
+        }
+
+        if (received == 0)
+        {
+            break;
+        }
+
+        done = parse(m_buffer.data(), static_cast<size_t>(received), type, callback);
+    }
+}
+
+bool SockDiag::parse(const char* buffer, size_t size, PortType type, const SockDiagCallback& callback)
+{
+    size_t offset {0};
+
+    while (offset + NLMSG_HDRLEN <= size)
+    {
+        nlmsghdr header {};
+        std::memcpy(&header, buffer + offset, sizeof(header));
+
+        if (header.nlmsg_len < NLMSG_HDRLEN || offset + header.nlmsg_len > size)
+        {
+            break;
+        }
+
+        const auto payload {buffer + offset + NLMSG_HDRLEN};
+        const auto payloadSize {header.nlmsg_len - NLMSG_HDRLEN};
+
+        if (header.nlmsg_type == NLMSG_DONE)
+        {
+            return true;
+        }
+
+        if (header.nlmsg_type == NLMSG_ERROR)
+        {
+            nlmsgerr error {};
+            std::memcpy(&error, payload, std::min(sizeof(error), static_cast<size_t>(payloadSize)));
+
+            if (error.error != 0)
+            {
+                throw std::system_error {-error.error, std::system_category(), "Error dumping the sockets"};
+            }
+
+            return true;
+        }
+
+        if (header.nlmsg_type == SOCK_DIAG_BY_FAMILY && payloadSize >= sizeof(inet_diag_msg))
+        {
+            inet_diag_msg message {};
+            std::memcpy(&message, payload, sizeof(message));
+
+            nlohmann::json port;
+            buildPortData(message, type, port);
+            callback(port);
+        }
+
+        offset += NLMSG_ALIGN(header.nlmsg_len);
+    }
+
+    return false;
+}
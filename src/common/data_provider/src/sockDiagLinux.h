@@ -0,0 +1,73 @@
+/*
+ * Wazuh SysInfo
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 19, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _SOCK_DIAG_LINUX_H
+#define _SOCK_DIAG_LINUX_H
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "sharedDefs.h"
+
+using SockDiagCallback = std::function<void(nlohmann::json&)>;
+
+/**
+ * @brief Socket enumeration through the kernel NETLINK_SOCK_DIAG interface.
+ *
+ * @details Sockets are reported with the same fields as the /proc/net parser, so both sources can be
+ * used interchangeably. The pid and process fields are left unknown.
+ */
+class SockDiag final
+{
+    public:
+        /**
+         * @brief Opens a sock_diag netlink socket.
+         *
+         * @throws std::system_error if the socket cannot be created.
+         */
+        SockDiag();
+        ~SockDiag();
+
+        SockDiag(const SockDiag&) = delete;
+        SockDiag& operator=(const SockDiag&) = delete;
+
+        /**
+         * @brief Reports all the sockets of the given type, in any state.
+         *
+         * @param type     Protocol and IP version of the sockets.
+         * @param callback Callback to be called for every single socket.
+         *
+         * @throws std::system_error if the kernel rejects the request, for instance, when the udp_diag
+         * module is not available.
+         */
+        void dump(PortType type, const SockDiagCallback& callback);
+
+        /**
+         * @brief Parses the netlink messages of a sock_diag dump.
+         *
+         * @param buffer   Received data.
+         * @param size     Size of the received data.
+         * @param type     Protocol and IP version of the requested sockets.
+         * @param callback Callback to be called for every single socket.
+         *
+         * @return True if the end of the dump was reached, false if more data is expected.
+         *
+         * @throws std::system_error if the data contains an error message.
+         */
+        static bool parse(const char* buffer, size_t size, PortType type, const SockDiagCallback& callback);
+
+    private:
+        int m_socket;
+        std::vector<char> m_buffer;
+};
+
+#endif // _SOCK_DIAG_LINUX_H
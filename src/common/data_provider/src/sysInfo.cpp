@@ -57,6 +57,31 @@ nlohmann::json SysInfo::hotfixes()
     return getHotfixes();
 }
 
+nlohmann::json SysInfo::packagesFingerprint()
+{
+    return getPackagesFingerprint();
+}
+
+bool SysInfo::packagesComplete()
+{
+    return getPackagesComplete();
+}
+
+void SysInfo::setProcessesFields(const std::set<std::string>& fields)
+{
+    m_processesFields = fields;
+}
+
+void SysInfo::setScanThreadHooks(const ScanThreadHooks& hooks)
+{
+    m_scanThreadHooks = hooks;
+}
+
+bool SysInfo::processEvents(std::function<void(nlohmann::json&, bool)> callback, std::function<bool()> stop)
+{
+    return getProcessEvents(callback, stop);
+}
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -8,9 +8,17 @@
  * License (version 2) as published by the FSF - Free Software
  * Foundation.
  */
+#include <array>
+#include <charconv>
+#include <dirent.h>
 #include <fstream>
 #include <iostream>
+#include <optional>
 #include <regex>
+#include <string_view>
+#include <system_error>
+#include <unordered_set>
+#include <sys/stat.h>
 #include <sys/utsname.h>
 #include "packages/modernPackageDataRetriever.hpp"
 #include "sharedDefs.h"
@@ -29,6 +37,8 @@
 #include "packages/berkeleyRpmDbHelper.h"
 #include "packages/packageLinuxDataRetriever.h"
 #include "linuxInfoHelper.h"
+#include "procConnectorLinux.h"
+#include "sockDiagLinux.h"
 
 using ProcessInfo = std::unordered_map<int64_t, std::pair<int32_t, std::string>>;
 
@@ -44,9 +54,100 @@ struct ProcTableDeleter
     }
 };
 
+struct DirDeleter
+{
+    void operator()(DIR* dir)
+    {
+        closedir(dir);
+    }
+};
+
+static void addSourceFingerprint(const std::string& path, nlohmann::json& fingerprint)
+{
+    struct stat info {};
+
+    // Missing sources are left out, so their appearance also changes the fingerprint.
+    if (0 == stat(path.c_str(), &info))
+    {
+        fingerprint[path] = std::to_string(info.st_mtim.tv_sec) + "." + std::to_string(info.st_mtim.tv_nsec) + ":" +
+                            std::to_string(info.st_size) + ":" + std::to_string(info.st_ino);
+    }
+}
+
+static void addDirectoryFingerprint(const std::string& path, nlohmann::json& fingerprint)
+{
+    std::error_code ec;
+
+    for (const auto& entry : std::filesystem::directory_iterator(path, ec))
+    {
+        addSourceFingerprint(entry.path().string(), fingerprint);
+    }
+}
+
 using SysInfoProcessesTable = std::unique_ptr<PROCTAB, ProcTableDeleter>;
 using SysInfoProcess        = std::unique_ptr<proc_t, ProcTableDeleter>;
 
+constexpr auto PROCESS_INFO_FLAGS
+{
+    PROC_FILLMEM | PROC_FILLSTAT | PROC_FILLSTATUS | PROC_FILLARG | PROC_FILLGRP | PROC_FILLUSR | PROC_FILLCOM
+};
+
+// Files of /proc/<pid> that each process field is read from. The pid is always available.
+static const std::map<std::string, int> PROCESS_FIELD_FLAGS
+{
+    {"name", PROC_FILLSTAT},
+    {"state", PROC_FILLSTAT},
+    {"ppid", PROC_FILLSTAT},
+    {"utime", PROC_FILLSTAT},
+    {"stime", PROC_FILLSTAT},
+    {"cmd", PROC_FILLCOM | PROC_FILLARG},
+    {"argvs", PROC_FILLCOM | PROC_FILLARG},
+    {"euser", PROC_FILLSTATUS | PROC_FILLUSR},
+    {"ruser", PROC_FILLSTATUS | PROC_FILLUSR},
+    {"suser", PROC_FILLSTATUS | PROC_FILLUSR},
+    {"egroup", PROC_FILLSTATUS | PROC_FILLGRP},
+    {"rgroup", PROC_FILLSTATUS | PROC_FILLGRP},
+    {"sgroup", PROC_FILLSTATUS | PROC_FILLGRP},
+    {"fgroup", PROC_FILLSTATUS | PROC_FILLGRP},
+    {"priority", PROC_FILLSTAT},
+    {"nice", PROC_FILLSTAT},
+    {"size", PROC_FILLMEM},
+    {"vm_size", PROC_FILLSTATUS},
+    {"resident", PROC_FILLSTATUS},
+    {"share", PROC_FILLMEM},
+    {"start_time", PROC_FILLSTAT},
+    {"pgrp", PROC_FILLSTAT},
+    {"session", PROC_FILLSTAT},
+    {"tgid", PROC_FILLSTATUS},
+    {"tty", PROC_FILLSTAT},
+    {"processor", PROC_FILLSTAT},
+    {"nlwp", PROC_FILLSTAT}
+};
+
+static int getProcessFlags(const std::set<std::string>& fields)
+{
+    if (fields.empty())
+    {
+        return PROCESS_INFO_FLAGS;
+    }
+
+    int flags {0};
+
+    for (const auto& field : fields)
+    {
+        const auto it {PROCESS_FIELD_FLAGS.find(field)};
+
+        if (it != PROCESS_FIELD_FLAGS.end())
+        {
+            flags |= it->second;
+        }
+    }
+
+    return flags;
+}
+
+constexpr std::chrono::milliseconds PROC_EVENTS_POLL_TIMEOUT {1000};
+
 static void parseLineAndFillMap(const std::string& line, const std::string& separator, std::map<std::string, std::string>& systemInfo)
 {
     const auto pos{line.find(separator)};
@@ -79,61 +180,181 @@ static bool getSystemInfo(const std::string& fileName, const std::string& separa
     return ret;
 }
 
-static nlohmann::json getProcessInfo(const SysInfoProcess& process)
+static nlohmann::json getProcessInfo(const SysInfoProcess& process, const std::set<std::string>& fields)
 {
+    const auto wants
+    {
+        [&fields](const char* field)
+        {
+            return fields.empty() || fields.find(field) != fields.end();
+        }
+    };
+
     nlohmann::json jsProcessInfo{};
     // Current process information
-    jsProcessInfo["pid"]        = std::to_string(process->tid);
-    jsProcessInfo["name"]       = process->cmd;
-    jsProcessInfo["state"]      = &process->state;
-    jsProcessInfo["ppid"]       = process->ppid;
-    jsProcessInfo["utime"]      = process->utime;
-    jsProcessInfo["stime"]      = process->stime;
-    std::string commandLine;
-    std::string commandLineArgs;
+    jsProcessInfo["pid"] = std::to_string(process->tid);
+
+    if (wants("name"))
+    {
+        jsProcessInfo["name"] = process->cmd;
+    }
+
+    if (wants("state"))
+    {
+        jsProcessInfo["state"] = &process->state;
+    }
 
-    if (process->cmdline && process->cmdline[0])
+    if (wants("ppid"))
     {
-        commandLine = process->cmdline[0];
+        jsProcessInfo["ppid"] = process->ppid;
+    }
+
+    if (wants("utime"))
+    {
+        jsProcessInfo["utime"] = process->utime;
+    }
+
+    if (wants("stime"))
+    {
+        jsProcessInfo["stime"] = process->stime;
+    }
+
+    if (wants("cmd") || wants("argvs"))
+    {
+        std::string commandLine;
+        std::string commandLineArgs;
 
-        for (int idx = 1; process->cmdline[idx]; ++idx)
+        if (process->cmdline && process->cmdline[0])
         {
-            const auto cmdlineArgSize { sizeof(process->cmdline[idx]) };
+            commandLine = process->cmdline[0];
 
-            if (strnlen(process->cmdline[idx], cmdlineArgSize) != 0)
+            for (int idx = 1; process->cmdline[idx]; ++idx)
             {
-                commandLineArgs += process->cmdline[idx];
+                const auto cmdlineArgSize { sizeof(process->cmdline[idx]) };
 
-                if (process->cmdline[idx + 1])
+                if (strnlen(process->cmdline[idx], cmdlineArgSize) != 0)
                 {
-                    commandLineArgs += " ";
+                    commandLineArgs += process->cmdline[idx];
+
+                    if (process->cmdline[idx + 1])
+                    {
+                        commandLineArgs += " ";
+                    }
                 }
             }
         }
+
+        if (wants("cmd"))
+        {
+            jsProcessInfo["cmd"] = commandLine;
+        }
+
+        if (wants("argvs"))
+        {
+            jsProcessInfo["argvs"] = commandLineArgs;
+        }
+    }
+
+    if (wants("euser"))
+    {
+        jsProcessInfo["euser"] = process->euser;
+    }
+
+    if (wants("ruser"))
+    {
+        jsProcessInfo["ruser"] = process->ruser;
+    }
+
+    if (wants("suser"))
+    {
+        jsProcessInfo["suser"] = process->suser;
+    }
+
+    if (wants("egroup"))
+    {
+        jsProcessInfo["egroup"] = process->egroup;
+    }
+
+    if (wants("rgroup"))
+    {
+        jsProcessInfo["rgroup"] = process->rgroup;
+    }
+
+    if (wants("sgroup"))
+    {
+        jsProcessInfo["sgroup"] = process->sgroup;
+    }
+
+    if (wants("fgroup"))
+    {
+        jsProcessInfo["fgroup"] = process->fgroup;
+    }
+
+    if (wants("priority"))
+    {
+        jsProcessInfo["priority"] = process->priority;
+    }
+
+    if (wants("nice"))
+    {
+        jsProcessInfo["nice"] = process->nice;
+    }
+
+    if (wants("size"))
+    {
+        jsProcessInfo["size"] = process->size;
+    }
+
+    if (wants("vm_size"))
+    {
+        jsProcessInfo["vm_size"] = process->vm_size;
+    }
+
+    if (wants("resident"))
+    {
+        jsProcessInfo["resident"] = process->vm_rss;
+    }
+
+    if (wants("share"))
+    {
+        jsProcessInfo["share"] = process->share;
+    }
+
+    if (wants("start_time"))
+    {
+        jsProcessInfo["start_time"] = Utils::timeTick2unixTime(process->start_time);
+    }
+
+    if (wants("pgrp"))
+    {
+        jsProcessInfo["pgrp"] = process->pgrp;
+    }
+
+    if (wants("session"))
+    {
+        jsProcessInfo["session"] = process->session;
+    }
+
+    if (wants("tgid"))
+    {
+        jsProcessInfo["tgid"] = process->tgid;
+    }
+
+    if (wants("tty"))
+    {
+        jsProcessInfo["tty"] = process->tty;
+    }
+
+    if (wants("processor"))
+    {
+        jsProcessInfo["processor"] = process->processor;
+    }
+
+    if (wants("nlwp"))
+    {
+        jsProcessInfo["nlwp"] = process->nlwp;
     }
 
-    jsProcessInfo["cmd"]        = commandLine;
-    jsProcessInfo["argvs"]      = commandLineArgs;
-    jsProcessInfo["euser"]      = process->euser;
-    jsProcessInfo["ruser"]      = process->ruser;
-    jsProcessInfo["suser"]      = process->suser;
-    jsProcessInfo["egroup"]     = process->egroup;
-    jsProcessInfo["rgroup"]     = process->rgroup;
-    jsProcessInfo["sgroup"]     = process->sgroup;
-    jsProcessInfo["fgroup"]     = process->fgroup;
-    jsProcessInfo["priority"]   = process->priority;
-    jsProcessInfo["nice"]       = process->nice;
-    jsProcessInfo["size"]       = process->size;
-    jsProcessInfo["vm_size"]    = process->vm_size;
-    jsProcessInfo["resident"]   = process->vm_rss;
-    jsProcessInfo["share"]      = process->share;
-    jsProcessInfo["start_time"] = Utils::timeTick2unixTime(process->start_time);
-    jsProcessInfo["pgrp"]       = process->pgrp;
-    jsProcessInfo["session"]    = process->session;
-    jsProcessInfo["tgid"]       = process->tgid;
-    jsProcessInfo["tty"]        = process->tty;
-    jsProcessInfo["processor"]  = process->processor;
-    jsProcessInfo["nlwp"]       = process->nlwp;
     return jsProcessInfo;
 }
 
@@ -410,11 +631,10 @@ nlohmann::json SysInfo::getNetworks() const
 }
 
 
-ProcessInfo portProcessInfo(const std::string& procPath, const std::deque<int64_t>& inodes)
+ProcessInfo portProcessInfo(const std::string& procPath, const std::unordered_set<int64_t>& inodes)
 {
     ProcessInfo ret;
-
-    const auto fsWrapper = std::make_unique<filesystem_wrapper::FileSystemWrapper>();
+    constexpr std::string_view SOCKET_LINK_PREFIX {"socket:["};
 
     auto getProcessName = [](const std::string & filePath) -> std::string
     {
@@ -434,77 +654,83 @@ ProcessInfo portProcessInfo(const std::string& procPath, const std::deque<int64_
         return processInfo;
     };
 
-    auto findInode = [](const std::string & filePath) -> int64_t
+    const std::unique_ptr<DIR, DirDeleter> procDir {opendir(procPath.c_str())};
+
+    if (!procDir)
     {
-        constexpr size_t MAX_LENGTH {256};
-        char buffer[MAX_LENGTH] = "";
+        return ret;
+    }
+
+    // Buffers reused for every process and every descriptor.
+    std::string pidPath;
+    std::string fdPath;
+    std::array<char, 64> link {};
+
+    // Iterate proc directory once, until every inode is resolved.
+    while (ret.size() < inodes.size())
+    {
+        const auto procEntry {readdir(procDir.get())};
 
-        if (-1 == readlink(filePath.c_str(), buffer, MAX_LENGTH - 1))
+        if (!procEntry)
         {
-            throw std::system_error(errno, std::system_category(), "readlink");
+            break;
         }
 
-        // ret format is "socket:[<num>]".
-        const std::string bufferStr {buffer};
-        const auto openBracketPos {bufferStr.find("[")};
-        const auto closeBracketPos {bufferStr.find("]")};
-        const auto match {bufferStr.substr(openBracketPos + 1, closeBracketPos - openBracketPos - 1)};
+        // Only directories that represent a PID are inspected.
+        const std::string_view procFileName {procEntry->d_name};
+        int32_t pid {0};
 
-        return std::stoll(match);
-    };
+        if (std::from_chars(procFileName.data(), procFileName.data() + procFileName.size(), pid).ptr !=
+                procFileName.data() + procFileName.size())
+        {
+            continue;
+        }
 
-    if (fsWrapper->exists(procPath) && fsWrapper->is_directory(procPath))
-    {
-        std::vector<std::filesystem::path> procFiles = fsWrapper->list_directory(procPath);
+        pidPath.assign(procPath).append("/").append(procFileName);
+        fdPath.assign(pidPath).append("/fd");
 
-        // Iterate proc directory.
-        for (const auto& procFile : procFiles)
+        // Only fd directory is inspected. It is not readable for processes that just exited or belong to other users.
+        const std::unique_ptr<DIR, DirDeleter> fdDir {opendir(fdPath.c_str())};
+
+        if (!fdDir)
         {
-            const auto procFileName = procFile.filename().string();
-            // Only directories that represent a PID are inspected.
-            const std::string procFilePath {procPath + "/" + procFileName};
+            continue;
+        }
 
-            if (Utils::isNumber(procFileName) && fsWrapper->exists(procFilePath) && fsWrapper->is_directory(procFilePath))
+        std::optional<std::string> processName;
+
+        while (const auto fdEntry {readdir(fdDir.get())})
+        {
+            if ('.' == fdEntry->d_name[0])
             {
-                // Only fd directory is inspected.
-                const std::string pidFilePath {procFilePath + "/fd"};
+                continue;
+            }
 
-                if (fsWrapper->exists(procFilePath) && fsWrapper->is_directory(procFilePath))
-                {
-                    std::vector<std::filesystem::path> fdFiles = fsWrapper->list_directory(pidFilePath);
+            // Only symlinks that represent a socket are used, their format is "socket:[<num>]".
+            const auto length {readlinkat(dirfd(fdDir.get()), fdEntry->d_name, link.data(), link.size())};
 
-                    // Iterate fd directory.
-                    for (const auto& fdFile : fdFiles)
-                    {
-                        const auto fdFileName = fdFile.filename().string();
-                        // Only sysmlinks that represent a socket are read.
-                        const std::string fdFilePath {pidFilePath + "/" + fdFileName};
+            if (length <= 0)
+            {
+                continue;
+            }
 
-                        if (!Utils::startsWith(fdFileName, ".") && fsWrapper->exists(fdFilePath) && fsWrapper->is_socket(fdFilePath))
-                        {
-                            try
-                            {
-                                int64_t inode {findInode(fdFilePath)};
-
-                                if (std::any_of(inodes.cbegin(), inodes.cend(), [&](const auto it)
-                            {
-                                return it == inode;
-                            }))
-                                {
-                                    std::string statPath {procFilePath + "/" + "stat"};
-                                    std::string processName = getProcessName(statPath);
-                                    int32_t pid { std::stoi(procFileName) };
-
-                                    ret.emplace(std::make_pair(inode, std::make_pair(pid, processName)));
-                                }
-                            }
-                            catch (const std::exception& e)
-                            {
-                                std::cerr << "Error: " << e.what() << std::endl;
-                            }
-                        }
-                    }
+            const std::string_view target {link.data(), static_cast<size_t>(length)};
+            int64_t inode {0};
+
+            if (target.substr(0, SOCKET_LINK_PREFIX.size()) != SOCKET_LINK_PREFIX ||
+                    std::from_chars(target.data() + SOCKET_LINK_PREFIX.size(), target.data() + target.size(), inode).ec != std::errc())
+            {
+                continue;
+            }
+
+            if (inodes.find(inode) != inodes.end())
+            {
+                if (!processName)
+                {
+                    processName = getProcessName(pidPath + "/stat");
                 }
+
+                ret.emplace(inode, std::make_pair(pid, *processName));
             }
         }
     }
@@ -512,64 +738,108 @@ ProcessInfo portProcessInfo(const std::string& procPath, const std::deque<int64_
     return ret;
 }
 
+static void getProcNetPorts(const PortType type, const std::string& fileName, const std::function<void(nlohmann::json&)>& callback)
+{
+    const auto fileIoWrapper = std::make_unique<file_io::FileIO>();
+    const auto fileContent { fileIoWrapper->getFileContent(WM_SYS_NET_DIR + fileName) };
+    auto rows { Utils::split(fileContent, '\n') };
+    auto fileBody { false };
+
+    for (auto& row : rows)
+    {
+        nlohmann::json port {};
+
+        try
+        {
+            if (fileBody)
+            {
+                row = Utils::trim(row);
+                Utils::replaceAll(row, "\t", " ");
+                Utils::replaceAll(row, "  ", " ");
+                std::make_unique<PortImpl>(std::make_shared<LinuxPortWrapper>(type, row))->buildPortData(port);
+                callback(port);
+            }
+
+            fileBody = true;
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Error while parsing port: " << e.what() << std::endl;
+        }
+    }
+}
+
 nlohmann::json SysInfo::getPorts() const
 {
     nlohmann::json ports;
-    std::deque<int64_t> inodes;
+    std::unordered_set<int64_t> inodes;
+    std::unique_ptr<SockDiag> sockDiag;
+
+    try
+    {
+        sockDiag = std::make_unique<SockDiag>();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error while opening sock_diag, /proc/net is used instead: " << e.what() << std::endl;
+    }
 
     for (const auto& portType : PORTS_TYPE)
     {
-        const auto fileIoWrapper = std::make_unique<file_io::FileIO>();
-        const auto fileContent { fileIoWrapper->getFileContent(WM_SYS_NET_DIR + portType.second) };
-        auto rows { Utils::split(fileContent, '\n') };
-        auto fileBody { false };
+        std::vector<nlohmann::json> typePorts;
 
-        for (auto& row : rows)
+        const auto addPort = [&typePorts](nlohmann::json & port)
         {
-            nlohmann::json port {};
+            typePorts.push_back(std::move(port));
+        };
+
+        auto collected { false };
 
+        if (sockDiag)
+        {
             try
             {
-                if (fileBody)
-                {
-                    row = Utils::trim(row);
-                    Utils::replaceAll(row, "\t", " ");
-                    Utils::replaceAll(row, "  ", " ");
-                    std::make_unique<PortImpl>(std::make_shared<LinuxPortWrapper>(portType.first, row))->buildPortData(port);
-                    inodes.push_back(port.at("inode"));
-                    ports.push_back(std::move(port));
-                }
-
-                fileBody = true;
+                sockDiag->dump(portType.first, addPort);
+                collected = true;
             }
             catch (const std::exception& e)
             {
-                std::cerr << "Error while parsing port: " << e.what() << std::endl;
+                std::cerr << "Error while querying " << portType.second << " sockets, /proc/net is used instead: " << e.what() << std::endl;
+                typePorts.clear();
             }
         }
-    }
 
+        if (!collected)
+        {
+            getProcNetPorts(portType.first, portType.second, addPort);
+        }
+
+        for (auto& port : typePorts)
+        {
+            const auto inode { port.at("inode").get<int64_t>() };
+
+            // Sockets without inode, such as those in TIME_WAIT, have no owner.
+            if (0 != inode)
+            {
+                inodes.insert(inode);
+            }
+
+            ports.push_back(std::move(port));
+        }
+    }
 
     if (!inodes.empty())
     {
-        ProcessInfo ret = portProcessInfo(WM_SYS_PROC_DIR, inodes);
+        const ProcessInfo ret = portProcessInfo(WM_SYS_PROC_DIR, inodes);
 
         for (auto& port : ports)
         {
-            try
-            {
-                auto portInode = port.at("inode");
+            const auto it { ret.find(port.at("inode").get<int64_t>()) };
 
-                if (ret.find(portInode) != ret.end())
-                {
-                    std::pair<int32_t, std::string> processInfoPair = ret.at(portInode);
-                    port["pid"] = processInfoPair.first;
-                    port["process"] = processInfoPair.second;
-                }
-            }
-            catch (const std::exception& e)
+            if (ret.end() != it)
             {
-                std::cerr << "Error while parsing pid and process from ports: " << e.what() << std::endl;
+                port["pid"] = it->second.first;
+                port["process"] = it->second.second;
             }
         }
     }
@@ -582,7 +852,7 @@ void SysInfo::getProcessesInfo(std::function<void(nlohmann::json&)> callback) co
 
     const SysInfoProcessesTable spProcTable
     {
-        openproc(PROC_FILLMEM | PROC_FILLSTAT | PROC_FILLSTATUS | PROC_FILLARG | PROC_FILLGRP | PROC_FILLUSR | PROC_FILLCOM | PROC_FILLENV)
+        openproc(getProcessFlags(m_processesFields))
     };
 
     SysInfoProcess spProcInfo { readproc(spProcTable.get(), nullptr) };
@@ -590,12 +860,63 @@ void SysInfo::getProcessesInfo(std::function<void(nlohmann::json&)> callback) co
     while (nullptr != spProcInfo)
     {
         // Get process information object and push it to the caller
-        auto processInfo = getProcessInfo(spProcInfo);
+        auto processInfo = getProcessInfo(spProcInfo, m_processesFields);
         callback(processInfo);
         spProcInfo.reset(readproc(spProcTable.get(), nullptr));
     }
 }
 
+bool SysInfo::getProcessEvents(std::function<void(nlohmann::json&, bool)> callback,
+                               std::function<bool()> stop) const
+{
+    std::unique_ptr<ProcConnector> spConnector;
+
+    try
+    {
+        spConnector = std::make_unique<ProcConnector>();
+    }
+    catch (const std::system_error&)
+    {
+        return false;
+    }
+
+    const auto onEvent
+    {
+        [this, &callback](pid_t pid, ProcEventType type)
+        {
+            if (ProcEventType::EXITED == type)
+            {
+                nlohmann::json processInfo;
+                processInfo["pid"] = std::to_string(pid);
+                callback(processInfo, true);
+                return;
+            }
+
+            pid_t pids[] {pid, 0};
+            const SysInfoProcessesTable spProcTable { openproc(getProcessFlags(m_processesFields) | PROC_PID, pids) };
+
+            if (spProcTable)
+            {
+                // Short-lived processes may be gone already, their exit event follows.
+                const SysInfoProcess spProcInfo { readproc(spProcTable.get(), nullptr) };
+
+                if (spProcInfo)
+                {
+                    auto processInfo = getProcessInfo(spProcInfo, m_processesFields);
+                    callback(processInfo, false);
+                }
+            }
+        }
+    };
+
+    while (!stop())
+    {
+        spConnector->poll(PROC_EVENTS_POLL_TIMEOUT, onEvent, stop);
+    }
+
+    return true;
+}
+
 void SysInfo::getPackages(std::function<void(nlohmann::json&)> callback) const
 {
     FactoryPackagesCreator<LINUX_TYPE>::getPackages(callback);
@@ -604,7 +925,72 @@ void SysInfo::getPackages(std::function<void(nlohmann::json&)> callback) const
         {"PYPI", UNIX_PYPI_DEFAULT_BASE_DIRS},
         {"NPM", UNIX_NPM_DEFAULT_BASE_DIRS}
     };
-    ModernFactoryPackagesCreator<HAS_STDFILESYSTEM>::getPackages(searchPaths, callback);
+    ModernFactoryPackagesCreator<HAS_STDFILESYSTEM>::getPackages(searchPaths, callback, m_scanThreadHooks);
+}
+
+bool SysInfo::getPackagesComplete() const
+{
+    return ModernFactoryPackagesCreator<HAS_STDFILESYSTEM>::complete();
+}
+
+nlohmann::json SysInfo::getPackagesFingerprint() const
+{
+    nlohmann::json fingerprint = nlohmann::json::object();
+    const filesystem_wrapper::FileSystemWrapper fsWrapper;
+
+    addSourceFingerprint(DPKG_STATUS_PATH, fingerprint);
+    addDirectoryFingerprint(RPM_PATH, fingerprint);
+    addSourceFingerprint(std::string(SNAP_PATH) + "/state.json", fingerprint);
+
+    // Installing or removing a Python package renames its metadata folder, which updates the folder times.
+    for (const auto& baseDir : UNIX_PYPI_DEFAULT_BASE_DIRS)
+    {
+        try
+        {
+            std::deque<std::string> expandedPaths;
+            fsWrapper.expand_absolute_path(baseDir, expandedPaths);
+
+            for (const auto& expandedPath : expandedPaths)
+            {
+                addSourceFingerprint(expandedPath, fingerprint);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            // Ignore exception, continue with next folder
+            (void)e;
+        }
+    }
+
+    // NPM packages are updated in place, so every package.json is checked.
+    for (const auto& baseDir : UNIX_NPM_DEFAULT_BASE_DIRS)
+    {
+        try
+        {
+            std::deque<std::string> expandedPaths;
+            fsWrapper.expand_absolute_path(baseDir, expandedPaths);
+
+            for (const auto& expandedPath : expandedPaths)
+            {
+                const auto nodeModulesPath {expandedPath + "/node_modules"};
+                std::error_code ec;
+
+                addSourceFingerprint(nodeModulesPath, fingerprint);
+
+                for (const auto& entry : std::filesystem::directory_iterator(nodeModulesPath, ec))
+                {
+                    addSourceFingerprint((entry.path() / "package.json").string(), fingerprint);
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            // Ignore exception, continue with next folder
+            (void)e;
+        }
+    }
+
+    return fingerprint;
 }
 
 nlohmann::json SysInfo::getHotfixes() const
@@ -467,7 +467,7 @@ void SysInfo::getPackages(std::function<void(nlohmann::json&)> callback) const
         {"PYPI", pypyMacOSPaths},
         {"NPM", UNIX_NPM_DEFAULT_BASE_DIRS}
     };
-    ModernFactoryPackagesCreator<HAS_STDFILESYSTEM>::getPackages(searchPaths, callback);
+    ModernFactoryPackagesCreator<HAS_STDFILESYSTEM>::getPackages(searchPaths, callback, m_scanThreadHooks);
 }
 
 nlohmann::json SysInfo::getHotfixes() const
@@ -475,3 +475,21 @@ nlohmann::json SysInfo::getHotfixes() const
     // Currently not supported for this OS.
     return nlohmann::json();
 }
+
+bool SysInfo::getPackagesComplete() const
+{
+    return ModernFactoryPackagesCreator<HAS_STDFILESYSTEM>::complete();
+}
+
+nlohmann::json SysInfo::getPackagesFingerprint() const
+{
+    // Currently not supported for this OS.
+    return nlohmann::json();
+}
+
+bool SysInfo::getProcessEvents(std::function<void(nlohmann::json&, bool)> /*callback*/,
+                               std::function<bool()> /*stop*/) const
+{
+    // Currently not supported for this OS.
+    return false;
+}
@@ -108,3 +108,21 @@ nlohmann::json SysInfo::getHotfixes() const
     // Currently not supported for this OS.
     return nlohmann::json();
 }
+
+bool SysInfo::getPackagesComplete() const
+{
+    return true;
+}
+
+nlohmann::json SysInfo::getPackagesFingerprint() const
+{
+    // Currently not supported for this OS.
+    return nlohmann::json();
+}
+
+bool SysInfo::getProcessEvents(std::function<void(nlohmann::json&, bool)> /*callback*/,
+                               std::function<bool()> /*stop*/) const
+{
+    // Currently not supported for this OS.
+    return false;
+}
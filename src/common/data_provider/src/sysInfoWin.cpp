@@ -910,7 +910,7 @@ void SysInfo::getPackages(std::function<void(nlohmann::json&)> callback) const
         {"NPM", getNodeDirectories()}
     };
 
-    ModernFactoryPackagesCreator<HAS_STDFILESYSTEM>::getPackages(searchPaths, callback);
+    ModernFactoryPackagesCreator<HAS_STDFILESYSTEM>::getPackages(searchPaths, callback, m_scanThreadHooks);
 }
 nlohmann::json SysInfo::getHotfixes() const
 {
@@ -931,3 +931,21 @@ nlohmann::json SysInfo::getHotfixes() const
 
     return ret;
 }
+
+bool SysInfo::getPackagesComplete() const
+{
+    return ModernFactoryPackagesCreator<HAS_STDFILESYSTEM>::complete();
+}
+
+nlohmann::json SysInfo::getPackagesFingerprint() const
+{
+    // Currently not supported for this OS.
+    return nlohmann::json();
+}
+
+bool SysInfo::getProcessEvents(std::function<void(nlohmann::json&, bool)> /*callback*/,
+                               std::function<bool()> /*stop*/) const
+{
+    // Currently not supported for this OS.
+    return false;
+}
@@ -62,6 +62,22 @@ nlohmann::json SysInfo::getHotfixes() const
     return {};
 }
 
+nlohmann::json SysInfo::getPackagesFingerprint() const
+{
+    return {};
+}
+
+bool SysInfo::getPackagesComplete() const
+{
+    return true;
+}
+
+bool SysInfo::getProcessEvents(std::function<void(nlohmann::json&, bool)> /*callback*/,
+                               std::function<bool()> /*stop*/) const
+{
+    return false;
+}
+
 void SysInfo::getPackages(std::function<void(nlohmann::json&)>callback) const
 {
     callback(PACKAGES_EXPECTED);
@@ -102,6 +118,9 @@ class SysInfoWrapper: public SysInfo
         MOCK_METHOD(nlohmann::json, getNetworks, (), (const override));
         MOCK_METHOD(nlohmann::json, getPorts, (), (const override));
         MOCK_METHOD(nlohmann::json, getHotfixes, (), (const override));
+        MOCK_METHOD(nlohmann::json, getPackagesFingerprint, (), (const override));
+        MOCK_METHOD(bool, getPackagesComplete, (), (const override));
+        MOCK_METHOD(bool, getProcessEvents, (std::function<void(nlohmann::json&, bool)>, std::function<bool()>), (const override));
         MOCK_METHOD(void, getPackages, (std::function<void(nlohmann::json&)>), (const override));
         MOCK_METHOD(void, getProcessesInfo, (std::function<void(nlohmann::json&)>), (const override));
 
@@ -223,6 +242,28 @@ TEST_F(SysInfoTest, hotfixes)
     EXPECT_FALSE(result.empty());
 }
 
+TEST_F(SysInfoTest, packagesFingerprint)
+{
+    SysInfoWrapper info;
+    EXPECT_CALL(info, getPackagesFingerprint()).WillOnce(Return(R"({"/var/lib/dpkg/status":"1:2"})"_json));
+    const auto result {info.packagesFingerprint()};
+    EXPECT_FALSE(result.empty());
+}
+
+TEST_F(SysInfoTest, packagesComplete)
+{
+    SysInfoWrapper info;
+    EXPECT_CALL(info, getPackagesComplete()).WillOnce(Return(false));
+    EXPECT_FALSE(info.packagesComplete());
+}
+
+TEST_F(SysInfoTest, processEvents)
+{
+    SysInfoWrapper info;
+    EXPECT_CALL(info, getProcessEvents(_, _)).WillOnce(Return(true));
+    EXPECT_TRUE(info.processEvents([](nlohmann::json&, bool) {}, []() { return true; }));
+}
+
 TEST_F(SysInfoTest, hardware_c_interface)
 {
     cJSON* object = NULL;
@@ -10,6 +10,8 @@
  */
 
 #include "sysInfoPackagesNPM_test.hpp"
+#include <chrono>
+#include <condition_variable>
 
 using testing::_;
 using testing::Return;
@@ -206,3 +208,166 @@ TEST_F(NPMTest, getPackages_ValidPackageJson2Test)
     EXPECT_TRUE(callbackCalledFirst);
     EXPECT_TRUE(callbackCalledSecond);
 }
+
+TEST_F(NPMTest, getPackages_VisitedFilesLimitTest)
+{
+    std::vector<std::filesystem::path> fakePackages = {"/fake/node_modules/package1", "/fake/node_modules/package2"};
+
+    EXPECT_CALL(*npm, exists(_)).WillRepeatedly(Return(true));
+    EXPECT_CALL(*npm, is_directory(_)).WillRepeatedly(Return(true));
+    EXPECT_CALL(*npm, list_directory(_)).WillOnce(Return(fakePackages));
+
+    EXPECT_CALL(*npm, readJson(std::filesystem::path("/fake/node_modules/package1/package.json")))
+    .WillOnce(Return(nlohmann::json::parse(R"({"name": "TestPackage1", "version": "1.0.0"})")));
+    EXPECT_CALL(*npm, readJson(std::filesystem::path("/fake/node_modules/package2/package.json"))).Times(0);
+
+    EXPECT_CALL(*npm, expand_absolute_path(_, _))
+        .WillRepeatedly([](const std::string& base, std::deque<std::string>& out) {
+            out.push_back(base);
+        });
+
+    PackageScanContext context {1};
+    int callbackCalled = 0;
+
+    npm->getPackages({"/fake"},
+                     [&](nlohmann::json & j)
+    {
+        EXPECT_EQ(j.at("name"), "TestPackage1");
+        ++callbackCalled;
+    },
+    context);
+
+    EXPECT_EQ(callbackCalled, 1);
+    EXPECT_FALSE(context.complete());
+
+    // A new scan is complete until it reaches the limit.
+    context.startScan();
+    EXPECT_TRUE(context.complete());
+}
+
+TEST_F(NPMTest, getPackages_CachedManifestTest)
+{
+    const auto folder {std::filesystem::temp_directory_path() / "npm_cache_test"};
+    const auto packageFolder {folder / "node_modules" / "package1"};
+    std::filesystem::create_directories(packageFolder);
+    std::ofstream file {packageFolder / "package.json"};
+    file << R"({"name": "TestPackage1", "version": "1.0.0"})";
+    file.close();
+
+    EXPECT_CALL(*npm, exists(_)).WillRepeatedly(Return(true));
+    EXPECT_CALL(*npm, is_directory(_)).WillRepeatedly(Return(true));
+    EXPECT_CALL(*npm, list_directory(_)).WillRepeatedly(Return(std::vector<std::filesystem::path> {packageFolder}));
+
+    // Parsed only by the first scan.
+    EXPECT_CALL(*npm, readJson(packageFolder / "package.json"))
+    .WillOnce(Return(nlohmann::json::parse(R"({"name": "TestPackage1", "version": "1.0.0"})")));
+
+    EXPECT_CALL(*npm, expand_absolute_path(_, _))
+        .WillRepeatedly([](const std::string& base, std::deque<std::string>& out) {
+            out.push_back(base);
+        });
+
+    PackageScanContext context;
+    int callbackCalled = 0;
+
+    for (auto i = 0; i < 2; ++i)
+    {
+        context.startScan();
+        npm->getPackages({folder.string()},
+                         [&](nlohmann::json & j)
+        {
+            EXPECT_EQ(j.at("name"), "TestPackage1");
+            ++callbackCalled;
+        },
+        context);
+    }
+
+    EXPECT_EQ(callbackCalled, 2);
+
+    std::filesystem::remove_all(folder);
+}
+
+TEST(PackageScanContextTest, reportDoesNotBlockWorkers)
+{
+    PackageScanContext context;
+    std::mutex mutex;
+    std::condition_variable condition;
+    auto firstStarted {false};
+    auto secondReturned {false};
+    auto returnedBeforeCallbackEnded {false};
+    std::vector<std::string> reported;
+
+    // The first report waits in the callback, as a throttled scan does, until the second one returns.
+    const std::function<void(nlohmann::json&)> callback {[&](nlohmann::json & package)
+    {
+        std::unique_lock<std::mutex> lock {mutex};
+        reported.push_back(package.at("name"));
+
+        if ("first" == package.at("name"))
+        {
+            firstStarted = true;
+            condition.notify_all();
+            returnedBeforeCallbackEnded = condition.wait_for(lock, std::chrono::seconds(5), [&]()
+            {
+                return secondReturned;
+            });
+        }
+    }};
+
+    std::thread first {[&]()
+    {
+        auto package = R"({"name": "first"})"_json;
+        context.report(package, callback);
+    }};
+
+    {
+        std::unique_lock<std::mutex> lock {mutex};
+        condition.wait(lock, [&]()
+        {
+            return firstStarted;
+        });
+    }
+
+    auto package = R"({"name": "second"})"_json;
+    context.report(package, callback);
+
+    {
+        std::lock_guard<std::mutex> lock {mutex};
+        secondReturned = true;
+    }
+
+    condition.notify_all();
+    first.join();
+
+    EXPECT_TRUE(returnedBeforeCallbackEnded);
+    EXPECT_EQ(reported, (std::vector<std::string> {"first", "second"}));
+}
+
+TEST(PackageScanContextTest, forEachRunsThreadHooks)
+{
+    PackageScanContext context {PACKAGES_MAX_VISITED_FILES, 2};
+    std::atomic<int> entered {0};
+    std::atomic<int> items {0};
+    std::atomic<int> left {0};
+
+    context.startScan({[&]()
+    {
+        ++entered;
+    },
+    [&]()
+    {
+        ++items;
+    },
+    [&]()
+    {
+        ++left;
+    }});
+
+    const std::vector<int> values {1, 2, 3, 4};
+    context.forEach<int>(values, [](const int&) {});
+
+    // The calling thread is a worker too, only the threads started for the pool enter and leave.
+    EXPECT_EQ(items, 4);
+    EXPECT_EQ(entered, left);
+    EXPECT_LE(entered, 1);
+}
@@ -324,6 +324,52 @@ TEST_F(SysInfoPackagesLinuxHelperTest, parseDpkgInformation)
     EXPECT_EQ("zlib", jsPackageInfo["source"]);
 }
 
+TEST_F(SysInfoPackagesLinuxHelperTest, parseDpkgStatusStanzas)
+{
+    constexpr auto STATUS_CONTENT
+    {
+        "Package: zlib1g-dev\n"
+        "Status: install ok installed\n"
+        "Installed-Size: 4014865\n"
+        "Conffiles:\n"
+        " /etc/zlib.conf 0123456789abcdef\n"
+        "Version: 1:1.2.11.dfsg-2ubuntu1.2\n"
+        "Description: compression library - development\n"
+        " zlib is a library implementing the deflate compression method found\n"
+        " in gzip and PKZIP.\n"
+        "\n"
+        "Package: removed\n"
+        "Status: deinstall ok config-files\n"
+        "Version: 1.0\n"
+        "\n"
+        "Package: libfoo\n"
+        "Status: hold ok installed\n"
+        "Description:\n"
+        " foo library"
+    };
+    std::vector<nlohmann::json> packages;
+
+    PackageLinuxHelper::parseDpkgStatus(STATUS_CONTENT, [&packages](const PackageLinuxHelper::DpkgStanza & stanza)
+    {
+        auto packageInfo = PackageLinuxHelper::parseDpkg(stanza);
+
+        if (!packageInfo.empty())
+        {
+            packages.push_back(std::move(packageInfo));
+        }
+    });
+
+    ASSERT_EQ(2u, packages.size());
+    EXPECT_EQ("zlib1g-dev", packages[0]["name"]);
+    EXPECT_EQ(4111221760, packages[0]["size"]);
+    EXPECT_EQ("1:1.2.11.dfsg-2ubuntu1.2", packages[0]["version"]);
+    EXPECT_EQ("compression library - development", packages[0]["description"]);
+    EXPECT_EQ(UNKNOWN_VALUE, packages[0]["priority"]);
+    EXPECT_EQ("libfoo", packages[1]["name"]);
+    EXPECT_EQ("foo library", packages[1]["description"]);
+    EXPECT_EQ(EMPTY_VALUE, packages[1]["version"]);
+}
+
 TEST_F(SysInfoPackagesLinuxHelperTest, parseSnapCorrectMapping)
 {
     const auto& jsPackageInfo { PackageLinuxHelper::parseSnap( R"(
@@ -0,0 +1,121 @@
+/*
+ * Wazuh SysInfo
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 19, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+#include <cstring>
+#include <linux/cn_proc.h>
+#include <linux/connector.h>
+#include <linux/netlink.h>
+#include <utility>
+#include <vector>
+#include "sysInfoProcConnectorLinux_test.h"
+#include "procConnectorLinux.h"
+
+void SysInfoProcConnectorLinuxTest::SetUp() {};
+
+void SysInfoProcConnectorLinuxTest::TearDown()
+{
+};
+
+using Events = std::vector<std::pair<pid_t, ProcEventType>>;
+
+static void appendMessage(std::vector<char>& buffer, const proc_event& event, __u32 idx = CN_IDX_PROC)
+{
+    nlmsghdr header {};
+    header.nlmsg_len = NLMSG_LENGTH(sizeof(cn_msg) + sizeof(proc_event));
+    header.nlmsg_type = NLMSG_DONE;
+
+    cn_msg message {};
+    message.id.idx = idx;
+    message.id.val = CN_VAL_PROC;
+    message.len = sizeof(proc_event);
+
+    const auto offset {buffer.size()};
+    buffer.resize(offset + NLMSG_SPACE(sizeof(cn_msg) + sizeof(proc_event)));
+    std::memcpy(buffer.data() + offset, &header, sizeof(header));
+    std::memcpy(buffer.data() + offset + NLMSG_HDRLEN, &message, sizeof(message));
+    std::memcpy(buffer.data() + offset + NLMSG_HDRLEN + sizeof(message), &event, sizeof(event));
+}
+
+static proc_event forkEvent(pid_t pid, pid_t tgid)
+{
+    proc_event event {};
+    event.what = decltype(event.what)(0x00000001);
+    event.event_data.fork.child_pid = pid;
+    event.event_data.fork.child_tgid = tgid;
+    return event;
+}
+
+static proc_event execEvent(pid_t tgid)
+{
+    proc_event event {};
+    event.what = decltype(event.what)(0x00000002);
+    event.event_data.exec.process_pid = tgid;
+    event.event_data.exec.process_tgid = tgid;
+    return event;
+}
+
+static proc_event exitEvent(pid_t pid, pid_t tgid)
+{
+    proc_event event {};
+    event.what = decltype(event.what)(0x80000000);
+    event.event_data.exit.process_pid = pid;
+    event.event_data.exit.process_tgid = tgid;
+    return event;
+}
+
+static Events parse(const std::vector<char>& buffer)
+{
+    Events events;
+    ProcConnector::parse(buffer.data(), buffer.size(), [&events](pid_t pid, ProcEventType type)
+    {
+        events.emplace_back(pid, type);
+    });
+    return events;
+}
+
+TEST_F(SysInfoProcConnectorLinuxTest, processEvents)
+{
+    std::vector<char> buffer;
+    appendMessage(buffer, forkEvent(100, 100));
+    appendMessage(buffer, execEvent(100));
+    appendMessage(buffer, exitEvent(100, 100));
+
+    // The exec is reported again, as it changes the program of the process.
+    const Events expected {{100, ProcEventType::STARTED}, {100, ProcEventType::STARTED}, {100, ProcEventType::EXITED}};
+    EXPECT_EQ(expected, parse(buffer));
+}
+
+TEST_F(SysInfoProcConnectorLinuxTest, threadEventsIgnored)
+{
+    std::vector<char> buffer;
+    appendMessage(buffer, forkEvent(101, 100));
+    appendMessage(buffer, exitEvent(101, 100));
+
+    EXPECT_TRUE(parse(buffer).empty());
+}
+
+TEST_F(SysInfoProcConnectorLinuxTest, otherConnectorIgnored)
+{
+    std::vector<char> buffer;
+    appendMessage(buffer, execEvent(100), CN_IDX_PROC + 1);
+
+    EXPECT_TRUE(parse(buffer).empty());
+}
+
+TEST_F(SysInfoProcConnectorLinuxTest, truncatedMessage)
+{
+    std::vector<char> buffer;
+    appendMessage(buffer, execEvent(100));
+    appendMessage(buffer, execEvent(200));
+    buffer.resize(buffer.size() - 1);
+
+    const Events expected {{100, ProcEventType::STARTED}};
+    EXPECT_EQ(expected, parse(buffer));
+}
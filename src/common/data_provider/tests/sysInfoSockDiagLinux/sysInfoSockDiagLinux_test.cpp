@@ -0,0 +1,167 @@
+/*
+ * Wazuh SysInfo
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 19, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+#include <arpa/inet.h>
+#include <cstring>
+#include <linux/inet_diag.h>
+#include <linux/netlink.h>
+#include <linux/sock_diag.h>
+#include <netinet/tcp.h>
+#include <system_error>
+#include <vector>
+#include "sysInfoSockDiagLinux_test.h"
+#include "sockDiagLinux.h"
+
+void SysInfoSockDiagLinuxTest::SetUp() {};
+
+void SysInfoSockDiagLinuxTest::TearDown()
+{
+};
+
+static void appendMessage(std::vector<char>& buffer, uint16_t type, const void* payload, size_t payloadSize)
+{
+    nlmsghdr header {};
+    header.nlmsg_len = static_cast<__u32>(NLMSG_LENGTH(payloadSize));
+    header.nlmsg_type = type;
+
+    const auto offset {buffer.size()};
+    buffer.resize(offset + NLMSG_SPACE(payloadSize));
+    std::memcpy(buffer.data() + offset, &header, sizeof(header));
+    std::memcpy(buffer.data() + offset + NLMSG_HDRLEN, payload, payloadSize);
+}
+
+static void appendSocket(std::vector<char>& buffer, const inet_diag_msg& message)
+{
+    appendMessage(buffer, SOCK_DIAG_BY_FAMILY, &message, sizeof(message));
+}
+
+static inet_diag_msg ipv4Socket(const char* localIp, uint16_t localPort, const char* remoteIp, uint16_t remotePort, uint8_t state, uint32_t inode)
+{
+    inet_diag_msg message {};
+    message.idiag_family = AF_INET;
+    message.idiag_state = state;
+    message.idiag_inode = inode;
+    message.idiag_rqueue = 1;
+    message.idiag_wqueue = 2;
+    message.id.idiag_sport = htons(localPort);
+    message.id.idiag_dport = htons(remotePort);
+    inet_pton(AF_INET, localIp, message.id.idiag_src);
+    inet_pton(AF_INET, remoteIp, message.id.idiag_dst);
+    return message;
+}
+
+static std::vector<nlohmann::json> parse(const std::vector<char>& buffer, PortType type, bool& done)
+{
+    std::vector<nlohmann::json> ports;
+    done = SockDiag::parse(buffer.data(), buffer.size(), type, [&ports](nlohmann::json & port)
+    {
+        ports.push_back(port);
+    });
+    return ports;
+}
+
+TEST_F(SysInfoSockDiagLinuxTest, tcpSockets)
+{
+    std::vector<char> buffer;
+    appendSocket(buffer, ipv4Socket("127.0.0.1", 631, "0.0.0.0", 0, TCP_LISTEN, 50324));
+    appendSocket(buffer, ipv4Socket("192.168.0.104", 39106, "44.238.116.130", 443, TCP_ESTABLISHED, 122575));
+
+    auto done {true};
+    const auto ports = parse(buffer, TCP_IPV4, done);
+
+    EXPECT_FALSE(done);
+    ASSERT_EQ(2u, ports.size());
+
+    const auto expectedListening = nlohmann::json::parse(R"(
+    {
+        "inode":50324,
+        "local_ip":"127.0.0.1",
+        "local_port":631,
+        "pid":null,
+        "process":null,
+        "protocol":"tcp",
+        "remote_ip":"0.0.0.0",
+        "remote_port":0,
+        "rx_queue":1,
+        "state":"listening",
+        "tx_queue":0
+    })");
+    EXPECT_EQ(expectedListening, ports[0]);
+
+    EXPECT_EQ("established", ports[1].at("state"));
+    EXPECT_EQ("44.238.116.130", ports[1].at("remote_ip"));
+    EXPECT_EQ(443, ports[1].at("remote_port"));
+    EXPECT_EQ(2, ports[1].at("tx_queue"));
+}
+
+TEST_F(SysInfoSockDiagLinuxTest, udpIpv6Sockets)
+{
+    inet_diag_msg message {};
+    message.idiag_family = AF_INET6;
+    message.idiag_state = TCP_CLOSE;
+    message.idiag_inode = 43482;
+    message.id.idiag_sport = htons(51087);
+    inet_pton(AF_INET6, "::1", message.id.idiag_src);
+
+    std::vector<char> buffer;
+    appendSocket(buffer, message);
+
+    auto done {true};
+    const auto ports = parse(buffer, UDP_IPV6, done);
+
+    ASSERT_EQ(1u, ports.size());
+    EXPECT_EQ("udp6", ports[0].at("protocol"));
+    EXPECT_EQ("::1", ports[0].at("local_ip"));
+    EXPECT_EQ(51087, ports[0].at("local_port"));
+    EXPECT_EQ("::", ports[0].at("remote_ip"));
+    EXPECT_TRUE(ports[0].at("state").is_null());
+}
+
+TEST_F(SysInfoSockDiagLinuxTest, endOfDump)
+{
+    std::vector<char> buffer;
+    appendSocket(buffer, ipv4Socket("127.0.0.1", 631, "0.0.0.0", 0, TCP_LISTEN, 50324));
+    const int status {0};
+    appendMessage(buffer, NLMSG_DONE, &status, sizeof(status));
+    appendSocket(buffer, ipv4Socket("127.0.0.1", 632, "0.0.0.0", 0, TCP_LISTEN, 50325));
+
+    auto done {false};
+    const auto ports = parse(buffer, TCP_IPV4, done);
+
+    EXPECT_TRUE(done);
+    EXPECT_EQ(1u, ports.size());
+}
+
+TEST_F(SysInfoSockDiagLinuxTest, errorMessage)
+{
+    nlmsgerr error {};
+    error.error = -ENOENT;
+
+    std::vector<char> buffer;
+    appendMessage(buffer, NLMSG_ERROR, &error, sizeof(error));
+
+    auto done {false};
+    EXPECT_THROW(parse(buffer, UDP_IPV4, done), std::system_error);
+}
+
+TEST_F(SysInfoSockDiagLinuxTest, truncatedMessage)
+{
+    std::vector<char> buffer;
+    appendSocket(buffer, ipv4Socket("127.0.0.1", 631, "0.0.0.0", 0, TCP_LISTEN, 50324));
+    appendSocket(buffer, ipv4Socket("127.0.0.1", 632, "0.0.0.0", 0, TCP_LISTEN, 50325));
+    buffer.resize(buffer.size() - 1);
+
+    auto done {true};
+    const auto ports = parse(buffer, TCP_IPV4, done);
+
+    EXPECT_FALSE(done);
+    ASSERT_EQ(1u, ports.size());
+    EXPECT_EQ(631, ports[0].at("local_port"));
+}
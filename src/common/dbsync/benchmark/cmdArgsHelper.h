@@ -0,0 +1,159 @@
+/*
+ * Wazuh DBSYNC
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 19, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _CMD_LINE_ARGS_HELPER_H_
+#define _CMD_LINE_ARGS_HELPER_H_
+
+#include <string>
+#include <stdexcept>
+#include <iostream>
+
+#ifndef DBSYNC_TESTTOOL_INPUT
+#define DBSYNC_TESTTOOL_INPUT "../testtool/input"
+#endif
+
+class CmdLineArgs
+{
+    public:
+        CmdLineArgs(const int argc, const char* argv[])
+            : m_fixture{ paramValueOf(argc, argv, "-f", "inventory") }
+            , m_rows{ std::stoul(paramValueOf(argc, argv, "-n", "0")) }
+            , m_churn{ std::stoul(paramValueOf(argc, argv, "-p", "10")) }
+            , m_engine{ paramValueOf(argc, argv, "-e", "sqlite") }
+            , m_mode{ paramValueOf(argc, argv, "-m", "sync") }
+            , m_batchSize{ std::stoul(paramValueOf(argc, argv, "-b", "1")) }
+            , m_threads{ static_cast<unsigned int>(std::stoul(paramValueOf(argc, argv, "-t", "1"))) }
+            , m_inputFolder{ paramValueOf(argc, argv, "-i", DBSYNC_TESTTOOL_INPUT) }
+            , m_dbPath{ paramValueOf(argc, argv, "-d", "dbsync_benchmark.db") }
+        {
+            if (m_fixture != "inventory" && m_fixture != "fim")
+            {
+                throw std::runtime_error{ "Unknown fixture: " + m_fixture };
+            }
+
+            if (m_engine != "sqlite" && m_engine != "memory")
+            {
+                throw std::runtime_error{ "Unknown engine: " + m_engine };
+            }
+
+            if (m_mode != "sync" && m_mode != "snapshot")
+            {
+                throw std::runtime_error{ "Unknown mode: " + m_mode };
+            }
+
+            if (m_churn > 100 || 0 == m_batchSize)
+            {
+                throw std::runtime_error{ "The churn must be a percentage and the batch size can't be 0." };
+            }
+        }
+
+        const std::string& fixture() const
+        {
+            return m_fixture;
+        }
+
+        size_t rows() const
+        {
+            return m_rows;
+        }
+
+        size_t churn() const
+        {
+            return m_churn;
+        }
+
+        const std::string& engine() const
+        {
+            return m_engine;
+        }
+
+        const std::string& mode() const
+        {
+            return m_mode;
+        }
+
+        size_t batchSize() const
+        {
+            return m_batchSize;
+        }
+
+        unsigned int threads() const
+        {
+            return m_threads;
+        }
+
+        const std::string& inputFolder() const
+        {
+            return m_inputFolder;
+        }
+
+        const std::string& dbPath() const
+        {
+            return m_dbPath;
+        }
+
+        static void showHelp()
+        {
+            std::cout << "\nUsage: dbsync_benchmark <option(s)>\n"
+                      << "Options:\n"
+                      << "\t-h \t\t\tShow this help message\n"
+                      << "\t-f FIXTURE\t\tRecorded snapshot to replay: inventory (default) or fim.\n"
+                      << "\t-n ROWS\t\t\tRows per table. The recorded rows are repeated with new keys. Default: the recorded rows.\n"
+                      << "\t-p CHURN\t\tPercentage of the rows changed in the churn phase. Default: 10.\n"
+                      << "\t-e ENGINE\t\tDatabase engine: sqlite (default) or memory.\n"
+                      << "\t-m MODE\t\t\tTransaction mode: sync (default) or snapshot.\n"
+                      << "\t-b BATCH_SIZE\t\tRows per synced input. Default: 1.\n"
+                      << "\t-t THREADS\t\tWorker threads of the transactions. If 0 hardware concurrency value will be used. Default: 1.\n"
+                      << "\t-i INPUT_FOLDER\t\tFolder of the dbsync_test_tool inputs, holding the inventory fixture.\n"
+                      << "\t-d DB_PATH\t\tDatabase created for the run, and removed after it. Default: dbsync_benchmark.db.\n"
+                      << "\nExample:"
+                      << "\n\t./dbsync_benchmark -f fim -n 100000 -p 5 -b 100\n"
+                      << std::endl;
+        }
+
+    private:
+
+        static std::string paramValueOf(const int argc,
+                                        const char* argv[],
+                                        const std::string& switchValue,
+                                        const std::string& defaultValue)
+        {
+            for (int i = 1; i < argc; ++i)
+            {
+                const std::string currentValue{ argv[i] };
+
+                if (currentValue == "-h")
+                {
+                    throw std::runtime_error{ "" };
+                }
+
+                if (currentValue == switchValue && i + 1 < argc)
+                {
+                    // Switch found
+                    return argv[i + 1];
+                }
+            }
+
+            return defaultValue;
+        }
+
+        const std::string m_fixture;
+        const size_t m_rows;
+        const size_t m_churn;
+        const std::string m_engine;
+        const std::string m_mode;
+        const size_t m_batchSize;
+        const unsigned int m_threads;
+        const std::string m_inputFolder;
+        const std::string m_dbPath;
+};
+
+#endif // _CMD_LINE_ARGS_HELPER_H_
@@ -0,0 +1,260 @@
+/*
+ * Wazuh DBSYNC
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 19, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _FIXTURE_H_
+#define _FIXTURE_H_
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <sqlite3.h>
+#include <nlohmann/json.hpp>
+#include "fimDbDump.h"
+
+struct FixtureTable final
+{
+    std::string name;
+    std::vector<std::string> primaryKeys;
+    // Column changed in the rows modified by the churn phase.
+    std::string churnColumn;
+    // Rows added to the key of a repeated row, so it does not match the recorded one.
+    int64_t keySpan;
+    nlohmann::json rows;
+};
+
+struct Fixture final
+{
+    std::string sqlStatement;
+    std::vector<FixtureTable> tables;
+};
+
+class FixtureFactory final
+{
+    public:
+        static Fixture create(const std::string& fixture,
+                              const std::string& inputFolder)
+        {
+            return "fim" == fixture ? fimFixture() : inventoryFixture(inputFolder);
+        }
+
+        // Rows of a replayed snapshot. The churned rows are either modified, or replaced by a row with a new key.
+        static nlohmann::json rows(const FixtureTable& table,
+                                   const size_t rowCount,
+                                   const size_t churn)
+        {
+            auto result = nlohmann::json::array();
+            const auto recordedRows { table.rows.size() };
+            const auto cycles { (rowCount + recordedRows - 1) / recordedRows };
+
+            for (size_t i = 0; i < rowCount; ++i)
+            {
+                const auto churned { i % 100 < churn };
+                const auto replaced { churned && 0 != i % 2 };
+                auto row = table.rows[i % recordedRows];
+                setKey(table, row, i / recordedRows + (replaced ? cycles : 0));
+
+                if (churned && !replaced)
+                {
+                    auto& value { row[table.churnColumn] };
+
+                    if (value.is_string())
+                    {
+                        value = value.get<std::string>() + "~";
+                    }
+                    else if (value.is_number_float())
+                    {
+                        value = value.get<double>() + 1;
+                    }
+                    else if (value.is_number())
+                    {
+                        value = value.get<int64_t>() + 1;
+                    }
+                    else
+                    {
+                        value = 0;
+                    }
+                }
+
+                result.push_back(std::move(row));
+            }
+
+            return result;
+        }
+
+    private:
+        using DbPtr = std::unique_ptr<sqlite3, decltype(&sqlite3_close)>;
+        using StmtPtr = std::unique_ptr<sqlite3_stmt, decltype(&sqlite3_finalize)>;
+
+        static DbPtr openDb(const std::string& sql)
+        {
+            sqlite3* db { nullptr };
+            sqlite3_open(":memory:", &db);
+            DbPtr spDb { db, sqlite3_close };
+
+            if (SQLITE_OK != sqlite3_exec(db, sql.c_str(), nullptr, nullptr, nullptr))
+            {
+                throw std::runtime_error{ std::string{ "Invalid fixture schema: " } + sqlite3_errmsg(db) };
+            }
+
+            return spDb;
+        }
+
+        static StmtPtr prepare(const DbPtr& spDb,
+                               const std::string& sql)
+        {
+            sqlite3_stmt* stmt { nullptr };
+            sqlite3_prepare_v2(spDb.get(), sql.c_str(), -1, &stmt, nullptr);
+            return StmtPtr { stmt, sqlite3_finalize };
+        }
+
+        static FixtureTable fixtureTable(const DbPtr& spDb,
+                                         const std::string& name,
+                                         const nlohmann::json& rows)
+        {
+            FixtureTable table { name, {}, {}, 1, rows };
+            const auto stmt { prepare(spDb, "PRAGMA table_info(" + name + ");") };
+
+            while (SQLITE_ROW == sqlite3_step(stmt.get()))
+            {
+                const std::string column { reinterpret_cast<const char*>(sqlite3_column_text(stmt.get(), 1)) };
+
+                if (0 != sqlite3_column_int(stmt.get(), 5))
+                {
+                    table.primaryKeys.push_back(column);
+                }
+                else if (!rows.empty() && rows.front().contains(column))
+                {
+                    table.churnColumn = column;
+                }
+            }
+
+            if (table.primaryKeys.empty() || table.churnColumn.empty() || rows.empty())
+            {
+                throw std::runtime_error{ "The fixture table " + name + " has no primary key or no rows." };
+            }
+
+            for (const auto& row : rows)
+            {
+                const auto& key { row.at(table.primaryKeys.front()) };
+
+                if (key.is_number_integer() && key.get<int64_t>() >= table.keySpan)
+                {
+                    table.keySpan = key.get<int64_t>() + 1;
+                }
+            }
+
+            return table;
+        }
+
+        static void setKey(const FixtureTable& table,
+                           nlohmann::json& row,
+                           const size_t cycle)
+        {
+            if (0 != cycle)
+            {
+                auto& key { row[table.primaryKeys.front()] };
+
+                if (key.is_string())
+                {
+                    key = key.get<std::string>() + "#" + std::to_string(cycle);
+                }
+                else
+                {
+                    key = key.get<int64_t>() + static_cast<int64_t>(cycle) * table.keySpan;
+                }
+            }
+        }
+
+        // Processes recorded by the dbsync_test_tool inputs.
+        static Fixture inventoryFixture(const std::string& inputFolder)
+        {
+            std::ifstream configFile { inputFolder + "/config.json" };
+            std::ifstream dataFile { inputFolder + "/insertData.json" };
+
+            if (!configFile.good() || !dataFile.good())
+            {
+                throw std::runtime_error{ "The inventory fixture is not found in " + inputFolder };
+            }
+
+            const auto config = nlohmann::json::parse(configFile);
+            const auto data = nlohmann::json::parse(dataFile).at("body");
+            Fixture fixture { config.at("sql_statement").get<std::string>(), {} };
+            const auto spDb { openDb(fixture.sqlStatement) };
+            fixture.tables.push_back(fixtureTable(spDb, data.at("table").get<std::string>(), data.at("data")));
+            return fixture;
+        }
+
+        // Files recorded by the FIM integration test dump.
+        static Fixture fimFixture()
+        {
+            const auto spDb { openDb(FIM_SQL_DB_DUMP) };
+            Fixture fixture;
+            const auto schema { prepare(spDb, "SELECT type, name, sql FROM sqlite_master WHERE sql IS NOT NULL;") };
+
+            while (SQLITE_ROW == sqlite3_step(schema.get()))
+            {
+                const std::string type { reinterpret_cast<const char*>(sqlite3_column_text(schema.get(), 0)) };
+                const std::string name { reinterpret_cast<const char*>(sqlite3_column_text(schema.get(), 1)) };
+                fixture.sqlStatement += reinterpret_cast<const char*>(sqlite3_column_text(schema.get(), 2));
+                fixture.sqlStatement += ";";
+
+                if ("table" == type)
+                {
+                    fixture.tables.push_back(fixtureTable(spDb, name, tableRows(spDb, name)));
+                }
+            }
+
+            return fixture;
+        }
+
+        static nlohmann::json tableRows(const DbPtr& spDb,
+                                        const std::string& name)
+        {
+            auto rows = nlohmann::json::array();
+            const auto stmt { prepare(spDb, "SELECT * FROM " + name + ";") };
+
+            while (SQLITE_ROW == sqlite3_step(stmt.get()))
+            {
+                nlohmann::json row;
+
+                for (int i = 0; i < sqlite3_column_count(stmt.get()); ++i)
+                {
+                    const std::string column { sqlite3_column_name(stmt.get(), i) };
+
+                    switch (sqlite3_column_type(stmt.get(), i))
+                    {
+                        case SQLITE_INTEGER:
+                            row[column] = sqlite3_column_int64(stmt.get(), i);
+                            break;
+
+                        case SQLITE_FLOAT:
+                            row[column] = sqlite3_column_double(stmt.get(), i);
+                            break;
+
+                        case SQLITE_TEXT:
+                            row[column] = std::string { reinterpret_cast<const char*>(sqlite3_column_text(stmt.get(), i)) };
+                            break;
+
+                        default:
+                            break;
+                    }
+                }
+
+                rows.push_back(std::move(row));
+            }
+
+            return rows;
+        }
+};
+
+#endif // _FIXTURE_H_
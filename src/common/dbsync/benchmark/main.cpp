@@ -0,0 +1,92 @@
+/*
+ * Wazuh DBSYNC
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 19, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include "cmdArgsHelper.h"
+#include "fixture.h"
+#include "replay.h"
+
+static void loggerFunction(const std::string& msg)
+{
+    std::cout << "Msg: " << msg << std::endl;
+}
+
+static double perSecond(const uint64_t count, const double seconds)
+{
+    return seconds > 0 ? count / seconds : 0;
+}
+
+int main(int argc, const char* argv[])
+{
+    try
+    {
+        const CmdLineArgs cmdLineArgs(argc, argv);
+
+        // The counter is installed before dbsync opens any connection.
+        StatementCounter::install();
+        DBSync::initialize(loggerFunction);
+
+        const auto fixture { FixtureFactory::create(cmdLineArgs.fixture(), cmdLineArgs.inputFolder()) };
+        std::cout << "Fixture: " << cmdLineArgs.fixture()
+                  << ", engine: " << cmdLineArgs.engine()
+                  << ", mode: " << cmdLineArgs.mode()
+                  << ", churn: " << cmdLineArgs.churn() << "%"
+                  << ", batch size: " << cmdLineArgs.batchSize()
+                  << ", threads: " << cmdLineArgs.threads() << std::endl;
+
+        for (const auto& table : fixture.tables)
+        {
+            std::cout << "Table " << table.name << ": " << table.rows.size() << " recorded rows, "
+                      << (0 != cmdLineArgs.rows() ? cmdLineArgs.rows() : table.rows.size()) << " replayed." << std::endl;
+        }
+
+        ReplayBenchmark benchmark { fixture, cmdLineArgs };
+        const auto results { benchmark.run() };
+        DBSync::teardown();
+        std::remove(cmdLineArgs.dbPath().c_str());
+
+        std::cout << std::endl << std::left
+                  << std::setw(14) << "phase"
+                  << std::right
+                  << std::setw(10) << "rows"
+                  << std::setw(10) << "seconds"
+                  << std::setw(14) << "rows/sec"
+                  << std::setw(11) << "callbacks"
+                  << std::setw(15) << "callbacks/sec"
+                  << std::setw(12) << "statements"
+                  << std::setw(9) << "commits"
+                  << std::setw(15) << "peak RSS (KB)" << std::endl;
+
+        for (const auto& result : results)
+        {
+            std::cout << std::left << std::setw(14) << result.name
+                      << std::right << std::fixed << std::setprecision(3)
+                      << std::setw(10) << result.rows
+                      << std::setw(10) << result.seconds
+                      << std::setprecision(0)
+                      << std::setw(14) << perSecond(result.rows, result.seconds)
+                      << std::setw(11) << result.callbacks
+                      << std::setw(15) << perSecond(result.callbacks, result.seconds)
+                      << std::setw(12) << result.statements
+                      << std::setw(9) << result.commits
+                      << std::setw(15) << result.peakRssKb << std::endl;
+        }
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        CmdLineArgs::showHelp();
+    }
+
+    return 0;
+}
@@ -0,0 +1,188 @@
+/*
+ * Wazuh DBSYNC
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 19, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _REPLAY_H_
+#define _REPLAY_H_
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <sqlite3.h>
+#include <sys/resource.h>
+#include <nlohmann/json.hpp>
+#include "dbsync.hpp"
+#include "cmdArgsHelper.h"
+#include "fixture.h"
+
+struct PhaseResult final
+{
+    std::string name;
+    size_t rows;
+    uint64_t callbacks;
+    uint64_t statements;
+    uint64_t commits;
+    double seconds;
+    long peakRssKb;
+};
+
+// Counts the SQL statements, and the commits among them, run by every connection opened once it is installed, the trigger programs aside.
+class StatementCounter final
+{
+    public:
+        static void install()
+        {
+            sqlite3_auto_extension(reinterpret_cast<void(*)(void)>(&StatementCounter::onOpen));
+        }
+
+        static uint64_t count()
+        {
+            return s_statements.load();
+        }
+
+        static uint64_t commits()
+        {
+            return s_commits.load();
+        }
+
+    private:
+        static int onOpen(sqlite3* db, char**, const sqlite3_api_routines*)
+        {
+            sqlite3_trace_v2(db, SQLITE_TRACE_STMT, &StatementCounter::onStatement, nullptr);
+            return SQLITE_OK;
+        }
+
+        static int onStatement(unsigned int, void*, void*, void* sql)
+        {
+            const std::string_view statement { static_cast<const char*>(sql) };
+
+            if (0 != statement.rfind("--", 0))
+            {
+                ++s_statements;
+            }
+
+            if (0 == statement.rfind("COMMIT", 0))
+            {
+                ++s_commits;
+            }
+
+            return 0;
+        }
+
+        static inline std::atomic<uint64_t> s_statements { 0 };
+        static inline std::atomic<uint64_t> s_commits { 0 };
+};
+
+class ReplayBenchmark final
+{
+    public:
+        ReplayBenchmark(const Fixture& fixture,
+                        const CmdLineArgs& args)
+            : m_fixture{ fixture }
+            , m_args{ args }
+            , m_callbacks{ 0 }
+        {}
+
+        // Replays a first scan of an empty database, the same scan again, then the scan with the churned rows.
+        std::vector<PhaseResult> run()
+        {
+            DBSync dbSync
+            {
+                HostType::AGENT,
+                "memory" == m_args.engine() ? DbEngineType::MEMORY : DbEngineType::SQLITE3,
+                m_args.dbPath(),
+                m_fixture.sqlStatement
+            };
+
+            return
+            {
+                replay(dbSync, "first scan", 0),
+                replay(dbSync, "steady state", 0),
+                replay(dbSync, "churn", m_args.churn())
+            };
+        }
+
+    private:
+        PhaseResult replay(DBSync& dbSync,
+                           const std::string& name,
+                           const size_t churn)
+        {
+            // The inputs are built before the clock starts, so only dbsync is measured.
+            std::vector<std::pair<const FixtureTable*, std::vector<nlohmann::json>>> inputs;
+            size_t rows { 0 };
+
+            for (const auto& table : m_fixture.tables)
+            {
+                const auto rowCount { 0 != m_args.rows() ? m_args.rows() : table.rows.size() };
+                const auto data = FixtureFactory::rows(table, rowCount, churn);
+                std::vector<nlohmann::json> batches;
+
+                for (size_t i = 0; i < data.size(); i += m_args.batchSize())
+                {
+                    nlohmann::json input;
+                    input["table"] = table.name;
+                    input["data"] = nlohmann::json(data.begin() + i, data.begin() + std::min(i + m_args.batchSize(), data.size()));
+                    batches.push_back(std::move(input));
+                }
+
+                rows += data.size();
+                inputs.emplace_back(&table, std::move(batches));
+            }
+
+            const ResultCallbackData callbackData
+            {
+                [this](ReturnTypeCallback, const nlohmann::json&)
+                {
+                    ++m_callbacks;
+                }
+            };
+
+            const auto callbacks { m_callbacks.load() };
+            const auto statements { StatementCounter::count() };
+            const auto commits { StatementCounter::commits() };
+            const auto start { std::chrono::steady_clock::now() };
+
+            for (const auto& [table, batches] : inputs)
+            {
+                nlohmann::json tables;
+                tables["table"] = table->name;
+
+                if ("snapshot" == m_args.mode())
+                {
+                    tables["options"]["snapshot"] = true;
+                }
+
+                DBSyncTxn txn { dbSync.handle(), tables, m_args.threads(), QUEUE_SIZE, callbackData };
+
+                for (const auto& input : batches)
+                {
+                    txn.syncTxnRow(input);
+                }
+
+                txn.getDeletedRows(callbackData);
+            }
+
+            const std::chrono::duration<double> elapsed { std::chrono::steady_clock::now() - start };
+            struct rusage usage {};
+            getrusage(RUSAGE_SELF, &usage);
+
+            return { name, rows, m_callbacks.load() - callbacks, StatementCounter::count() - statements, StatementCounter::commits() - commits, elapsed.count(), usage.ru_maxrss };
+        }
+
+        static constexpr auto QUEUE_SIZE { 1000u };
+
+        const Fixture& m_fixture;
+        const CmdLineArgs& m_args;
+        std::atomic<uint64_t> m_callbacks;
+};
+
+#endif // _REPLAY_H_
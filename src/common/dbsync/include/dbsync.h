@@ -29,7 +29,7 @@ void dbsync_initialize(log_fnc_t log_function);
  * @brief Creates a new DBSync instance (wrapper)
  *
  * @param host_type          Dynamic library host type to be used.
- * @param db_type            Database type to be used (currently only supported SQLITE3)
+ * @param db_type            Database type to be used (SQLITE3, or MEMORY for VOLATILE databases)
  * @param path               Path where the local database will be created.
  * @param sql_statement      SQL sentence to create tables in a SQL engine.
  *
@@ -46,7 +46,7 @@ DBSYNC_HANDLE dbsync_create(const HostType      host_type,
  * @brief Creates a new DBSync instance (wrapper)
  *
  * @param host_type          Dynamic library host type to be used.
- * @param db_type            Database type to be used (currently only supported SQLITE3)
+ * @param db_type            Database type to be used (SQLITE3, or MEMORY for VOLATILE databases)
  * @param path               Path where the local database will be created.
  * @param sql_statement      SQL sentence to create tables in a SQL engine.
  * @param upgrade_statements SQL sentences to upgrade tables in a SQL engine.
@@ -70,7 +70,12 @@ void dbsync_teardown(void);
  * @brief Creates a database transaction based on the supplied information.
  *
  * @param handle         Handle obtained from the \ref dbsync_create method call.
- * @param tables         Tables to be created in the transaction.
+ * @param tables         Tables to be created in the transaction. With "options":{"snapshot":true}
+ *                       the synced rows are a full snapshot of the tables: they are diffed with
+ *                       set based statements when the deleted rows are requested, or when the
+ *                       transaction is closed, and the inserted and modified rows are reported then.
+ *                       A snapshot known to be partial is synced last with "options":{"keep_unseen":true},
+ *                       so the rows it does not have are kept instead of deleted.
  * @param thread_number  Number of worker threads for processing data. If 0 hardware concurrency
  *                       value will be used.
  * @param max_queue_size Max data number to hold/queue to be processed.
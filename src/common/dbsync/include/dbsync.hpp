@@ -13,11 +13,13 @@
 #define _DBSYNC_HPP_
 
 #include <functional>
+#include <vector>
 #include <nlohmann/json.hpp>
 #include "commonDefs.h"
 #include "builder.hpp"
 
 using ResultCallbackData = const std::function<void(ReturnTypeCallback, const nlohmann::json&) >;
+using ResultBatchCallbackData = const std::function<void(const std::vector<std::pair<ReturnTypeCallback, nlohmann::json>>&) >;
 
 class DBSync
 {
@@ -33,7 +35,7 @@ class DBSync
          * @brief Explicit DBSync Constructor.
          *
          * @param hostType          Dynamic library host type to be used.
-         * @param dbType            Database type to be used (currently only supported SQLITE3)
+         * @param dbType            Database type to be used (SQLITE3, or MEMORY for VOLATILE databases)
          * @param path              Path where the local database will be created.
          * @param sqlStatement      SQL sentence to create tables in a SQL engine.
          * @param dbManagement      Database management type to be used at startup.
@@ -114,6 +116,16 @@ class DBSync
          */
         virtual void deleteRows(const nlohmann::json& jsInput);
 
+        /**
+         * @brief Deletes a database table record and its relationships based on \p jsInput value.
+         *
+         * @param jsInput       JSON information to be applied/deleted in the database.
+         * @param callbackData  Result callback(std::function) will be called for each deleted row, with all its data.
+         *
+         */
+        virtual void deleteRows(const nlohmann::json& jsInput,
+                                ResultCallbackData    callbackData);
+
         /**
          * @brief Updates data table with \p jsInput information. \p jsResult value will
          *  hold/contain the results of this operation (rows insertion, modification and/or deletion).
@@ -161,7 +173,12 @@ class DBSyncTxn
          * @brief DBSync Transaction constructor
          *
          * @param handle         Handle obtained from the \ref DBSync instance.
-         * @param tables         Tables to be created in the transaction.
+         * @param tables         Tables to be created in the transaction. With "options":{"snapshot":true}
+         *                       the synced rows are a full snapshot of the tables: they are diffed with
+         *                       set based statements when the deleted rows are requested, or when the
+         *                       transaction is closed, and the inserted and modified rows are reported then.
+         *                       A snapshot known to be partial is synced last with "options":{"keep_unseen":true},
+         *                       so the rows it does not have are kept instead of deleted.
          * @param threadNumber   Number of worker threads for processing data. If 0 hardware concurrency
          *                       value will be used.
          * @param maxQueueSize   Max data number to hold/queue to be processed.
@@ -174,6 +191,25 @@ class DBSyncTxn
                            const unsigned int    threadNumber,
                            const unsigned int    maxQueueSize,
                            ResultCallbackData    callbackData);
+
+        /**
+         * @brief DBSync Transaction constructor, delivering the results in order and in batches.
+         *
+         * @param handle         Handle obtained from the \ref DBSync instance.
+         * @param tables         Tables to be created in the transaction, as in the constructor above.
+         * @param callbackData   Result callback(std::function) called from a single worker thread with
+         *                       the results queued since its previous call, in the order they were found.
+         * @param batchSize      Max number of results per callback call.
+         * @param maxQueueSize   Max number of results queued. If 0 the queue is not limited.
+         *
+         * @details Once the queue is full, the synchronization waits for the callback to catch up.
+         * The deleted rows are not batched, they are delivered to the \ref getDeletedRows callback.
+         */
+        explicit DBSyncTxn(const DBSYNC_HANDLE      handle,
+                           const nlohmann::json&    tables,
+                           ResultBatchCallbackData  callbackData,
+                           const unsigned int       batchSize,
+                           const unsigned int       maxQueueSize);
         /**
          * @brief DBSync transaction Constructor.
          *
@@ -58,13 +58,38 @@ namespace DbSync
             virtual void selectData(const std::string& table,
                                     const nlohmann::json& query,
                                     const ResultCallback& callback,
-                                    std::unique_lock<std::shared_timed_mutex>& lock) = 0;
+                                    Utils::ILocking& lock) = 0;
 
+            // Whether selectData can run under a shared lock, alongside the writer.
+            virtual bool concurrentReads() const = 0;
+
+            // Makes the rows written so far visible to the concurrent readers. Called at the batch and txn boundaries.
+            virtual void publishWrites() = 0;
+
+            // Called around each row sync. Its rows are only published once the sync ends, when a reader needs them.
+            virtual void beginRowWrite() = 0;
+
+            virtual void endRowWrite() = 0;
+
+            // The callback, when given, is called with each deleted row.
             virtual void deleteTableRowsData(const std::string& table,
-                                             const nlohmann::json& jsDeletionData) = 0;
+                                             const nlohmann::json& jsDeletionData,
+                                             const ResultCallback callback,
+                                             std::unique_lock<std::shared_timed_mutex>& lock) = 0;
 
             virtual void addTableRelationship(const nlohmann::json& data) = 0;
 
+            virtual void initializeSnapshot(const nlohmann::json& tableNames) = 0;
+
+            virtual void appendSnapshotData(const std::string& table,
+                                            const nlohmann::json& data) = 0;
+
+            virtual void applySnapshot(const std::string& table,
+                                       const nlohmann::json& options,
+                                       const ResultCallback changesCallback,
+                                       const ResultCallback deletedCallback,
+                                       std::unique_lock<std::shared_timed_mutex>& lock) = 0;
+
         protected:
             IDbEngine() = default;
     };
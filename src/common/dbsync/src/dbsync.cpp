@@ -462,7 +462,7 @@ int dbsync_delete_rows(const DBSYNC_HANDLE handle,
         try
         {
             const std::unique_ptr<char, CJsonSmartFree> spJsonBytes{ cJSON_PrintUnformatted(js_key_values) };
-            DBSyncImplementation::instance().deleteRowsData(handle, nlohmann::json::parse(spJsonBytes.get()));
+            DBSyncImplementation::instance().deleteRowsData(handle, nlohmann::json::parse(spJsonBytes.get()), nullptr);
             retVal = 0;
         }
         catch (const nlohmann::detail::exception& ex)
@@ -741,7 +741,20 @@ void DBSync::selectRows(const nlohmann::json& jsInput,
 
 void DBSync::deleteRows(const nlohmann::json& jsInput)
 {
-    DBSyncImplementation::instance().deleteRowsData(m_dbsyncHandle, jsInput);
+    DBSyncImplementation::instance().deleteRowsData(m_dbsyncHandle, jsInput, nullptr);
+}
+
+void DBSync::deleteRows(const nlohmann::json& jsInput,
+                        ResultCallbackData    callbackData)
+{
+    const auto callbackWrapper
+    {
+        [callbackData](ReturnTypeCallback result, const nlohmann::json & jsonResult)
+        {
+            callbackData(result, jsonResult);
+        }
+    };
+    DBSyncImplementation::instance().deleteRowsData(m_dbsyncHandle, jsInput, callbackWrapper);
 }
 
 void DBSync::updateWithSnapshot(const nlohmann::json& jsInput,
@@ -796,6 +809,16 @@ DBSyncTxn::DBSyncTxn(const DBSYNC_HANDLE   handle,
     m_txn = PipelineFactory::instance().create(handle, tables, threadNumber, maxQueueSize, callbackWrapper);
 }
 
+DBSyncTxn::DBSyncTxn(const DBSYNC_HANDLE      handle,
+                     const nlohmann::json&    tables,
+                     ResultBatchCallbackData  callbackData,
+                     const unsigned int       batchSize,
+                     const unsigned int       maxQueueSize)
+    : m_shouldBeRemoved {true}
+{
+    m_txn = PipelineFactory::instance().create(handle, tables, callbackData, batchSize, maxQueueSize);
+}
+
 DBSyncTxn::DBSyncTxn(const TXN_HANDLE handle)
     : m_txn { handle }
     , m_shouldBeRemoved {false}
@@ -14,6 +14,7 @@
 #include "dbsyncPipelineFactory.h"
 #include "dbsync_implementation.h"
 #include "pipelineNodesImp.h"
+#include "threadDispatcher.h"
 
 namespace DbSync
 {
@@ -40,6 +41,27 @@ namespace DbSync
                     };
                 }
             }
+            Pipeline(const DBSYNC_HANDLE handle,
+                     const nlohmann::json& tables,
+                     const ResultBatchCallback callback,
+                     const unsigned int batchSize,
+                     const unsigned int maxQueueSize)
+                : m_handle{ handle }
+                , m_txnContext{ DBSyncImplementation::instance().createTransaction(handle, tables) }
+                , m_maxQueueSize{ maxQueueSize }
+                , m_callback{ nullptr }
+                , m_spDispatchNode{ nullptr }
+            {
+                if (!callback || !m_handle || !m_txnContext)
+                {
+                    throw dbsync_error
+                    {
+                        INVALID_PARAMETERS
+                    };
+                }
+
+                m_spBatchNode = std::make_unique<BatchCallbackNode>(callback, batchSize, maxQueueSize);
+            }
             ~Pipeline()
             {
                 if (m_spDispatchNode)
@@ -54,10 +76,18 @@ namespace DbSync
 
                 try
                 {
-                    DBSyncImplementation::instance().closeTransaction(m_handle, m_txnContext);
+                    DBSyncImplementation::instance().closeTransaction(m_handle,
+                                                                      m_txnContext,
+                                                                      std::bind(&Pipeline::dispatchChange, this, std::placeholders::_1, std::placeholders::_2));
                 }
                 catch (...)
                 {}
+
+                // The changes found when the transaction is closed are delivered in the last batches.
+                if (m_spBatchNode)
+                {
+                    m_spBatchNode->rundown();
+                }
             }
             void syncRow(const nlohmann::json& value) override
             {
@@ -84,7 +114,7 @@ namespace DbSync
                     result.first = DB_ERROR;
                     result.second = value;
                     result.second["exception"] = ex.what();
-                    pushResult(result);
+                    pushResult(std::move(result));
                 }
             }
             void getDeleted(ResultCallback callback) override
@@ -94,11 +124,25 @@ namespace DbSync
                     m_spDispatchNode->rundown();
                 }
 
-                DBSyncImplementation::instance().getDeleted(m_handle, m_txnContext, callback);
+                // The synced rows are delivered before the deleted ones are looked for.
+                if (m_spBatchNode)
+                {
+                    m_spBatchNode->flush();
+                }
+
+                DBSyncImplementation::instance().getDeleted(m_handle,
+                                                            m_txnContext,
+                                                            callback,
+                                                            std::bind(&Pipeline::dispatchChange, this, std::placeholders::_1, std::placeholders::_2));
+
+                if (m_spBatchNode)
+                {
+                    m_spBatchNode->flush();
+                }
             }
         private:
-            using SyncResult = std::pair<ReturnTypeCallback, nlohmann::json>;
             using DispatchCallbackNode = Utils::ReadNode<SyncResult>;
+            using BatchCallbackNode = Utils::BatchDispatcher<SyncResult, ResultBatchCallback>;
 
             std::shared_ptr<DispatchCallbackNode> getDispatchNode(const int threadNumber)
             {
@@ -109,8 +153,19 @@ namespace DbSync
                        );
             }
 
-            void pushResult(const SyncResult& result)
+            void pushResult(SyncResult&& result)
             {
+                if (m_spBatchNode)
+                {
+                    // Producers wait for room in the queue, so results are never delivered out of order.
+                    if (!result.second.empty())
+                    {
+                        m_spBatchNode->push(std::move(result));
+                    }
+
+                    return;
+                }
+
                 const auto async{ m_spDispatchNode&& m_spDispatchNode->size() < m_maxQueueSize };
 
                 if (async)
@@ -123,6 +178,19 @@ namespace DbSync
                 }
             }
 
+            // Changes found when a snapshot txn is applied, the dispatch node is already down by then.
+            void dispatchChange(ReturnTypeCallback resType, const nlohmann::json& resValue)
+            {
+                if (m_spBatchNode)
+                {
+                    pushResult(SyncResult{resType, resValue});
+                }
+                else
+                {
+                    dispatchResult(SyncResult{resType, resValue});
+                }
+            }
+
             void dispatchResult(const SyncResult& result)
             {
                 const auto& value{ result.second };
@@ -137,6 +205,7 @@ namespace DbSync
             const unsigned int m_maxQueueSize;
             const ResultCallback m_callback;
             const std::shared_ptr<DispatchCallbackNode> m_spDispatchNode;
+            std::unique_ptr<BatchCallbackNode> m_spBatchNode;
     };
     //----------------------------------------------------------------------------------------
     PipelineFactory& PipelineFactory::instance() noexcept
@@ -164,6 +233,21 @@ namespace DbSync
         m_contexts.emplace(ret, spContext);
         return ret;
     }
+    PipelineCtxHandle PipelineFactory::create(const DBSYNC_HANDLE        handle,
+                                              const nlohmann::json&      tables,
+                                              const ResultBatchCallback  callback,
+                                              const unsigned int         batchSize,
+                                              const unsigned int         maxQueueSize)
+    {
+        const auto spContext
+        {
+            std::make_shared<Pipeline>(handle, tables, callback, batchSize, maxQueueSize)
+        };
+        const auto ret { spContext.get() };
+        std::lock_guard<std::mutex> lock{ m_contextsMutex };
+        m_contexts.emplace(ret, spContext);
+        return ret;
+    }
     const std::shared_ptr<IPipeline>& PipelineFactory::pipeline(const PipelineCtxHandle handle)
     {
         std::lock_guard<std::mutex> lock{ m_contextsMutex };
@@ -14,6 +14,7 @@
 #include <mutex>
 #include <memory>
 #include <functional>
+#include <vector>
 #include "dbengine.h"
 #include "commonDefs.h"
 
@@ -21,6 +22,8 @@ namespace DbSync
 {
     using TxnContext = void*;
     using PipelineCtxHandle = void*;
+    using SyncResult = std::pair<ReturnTypeCallback, nlohmann::json>;
+    using ResultBatchCallback = std::function<void(const std::vector<SyncResult>&)>;
     struct IPipeline
     {
         // LCOV_EXCL_START
@@ -40,6 +43,11 @@ namespace DbSync
                                      const unsigned int     threadNumber,
                                      const unsigned int     maxQueueSize,
                                      const ResultCallback   callback);
+            PipelineCtxHandle create(const DBSYNC_HANDLE        handle,
+                                     const nlohmann::json&      tables,
+                                     const ResultBatchCallback  callback,
+                                     const unsigned int         batchSize,
+                                     const unsigned int         maxQueueSize);
             const std::shared_ptr<IPipeline>& pipeline(const PipelineCtxHandle handle);
             void destroy(const PipelineCtxHandle handle);
         private:
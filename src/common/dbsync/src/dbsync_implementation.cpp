@@ -15,6 +15,28 @@
 
 using namespace DbSync;
 
+// Marks a row sync in progress, so its rows are not published halfway, even if the sync throws.
+class RowWriteGuard final
+{
+    public:
+        explicit RowWriteGuard(IDbEngine& dbEngine)
+            : m_dbEngine{ dbEngine }
+        {
+            m_dbEngine.beginRowWrite();
+        }
+
+        ~RowWriteGuard()
+        {
+            m_dbEngine.endRowWrite();
+        }
+
+        RowWriteGuard(const RowWriteGuard&) = delete;
+        RowWriteGuard& operator=(const RowWriteGuard&) = delete;
+
+    private:
+        IDbEngine& m_dbEngine;
+};
+
 DBSYNC_HANDLE DBSyncImplementation::initialize(const HostType                  hostType,
                                                const DbEngineType              dbType,
                                                const std::string&              path,
@@ -51,6 +73,7 @@ void DBSyncImplementation::insertBulkData(const DBSYNC_HANDLE   handle,
     const auto ctx{ dbEngineContext(handle) };
     std::lock_guard<std::shared_timed_mutex> lock{ ctx->m_syncMutex };
     ctx->m_dbEngine->bulkInsert(json.at("table"), json.at("data"));
+    ctx->m_dbEngine->publishWrites();
 }
 
 void DBSyncImplementation::syncRowData(const DBSYNC_HANDLE      handle,
@@ -59,6 +82,7 @@ void DBSyncImplementation::syncRowData(const DBSYNC_HANDLE      handle,
 {
     const auto ctx{ dbEngineContext(handle) };
     Utils::ExclusiveLocking lock{ ctx->m_syncMutex };
+    const RowWriteGuard rowWrite{ *ctx->m_dbEngine };
 
     ctx->m_dbEngine->syncTableRowData(json,
                                       callback,
@@ -79,7 +103,39 @@ void DBSyncImplementation::syncRowData(const DBSYNC_HANDLE      handle,
         throw dbsync_error{INVALID_TABLE};
     }
 
+    if (tnxCtx->m_snapshot)
+    {
+        // Snapshot rows are only diffed when the txn is applied, so they are appended in large batches.
+        std::lock_guard<std::mutex> snapshotLock{ tnxCtx->m_snapshotMutex };
+        const auto& table { json.at("table").get_ref<const std::string&>() };
+        auto& rows { tnxCtx->m_snapshotRows[table] };
+
+        if (rows.is_null())
+        {
+            rows = nlohmann::json::array();
+        }
+
+        rows.insert(rows.end(), json.at("data").begin(), json.at("data").end());
+
+        if (json.contains("options"))
+        {
+            tnxCtx->m_snapshotOptions[table] = json.at("options");
+        }
+
+        tnxCtx->m_snapshotApplied = false;
+
+        if (rows.size() >= SNAPSHOT_BATCH_ROWS)
+        {
+            std::lock_guard<std::shared_timed_mutex> lock{ ctx->m_syncMutex };
+            ctx->m_dbEngine->appendSnapshotData(table, rows);
+            rows = nlohmann::json::array();
+        }
+
+        return;
+    }
+
     Utils::SharedLocking lock{ ctx->m_syncMutex };
+    const RowWriteGuard rowWrite{ *ctx->m_dbEngine };
     ctx->m_dbEngine->syncTableRowData(json,
                                       callback,
                                       true,
@@ -87,13 +143,17 @@ void DBSyncImplementation::syncRowData(const DBSYNC_HANDLE      handle,
 }
 
 void DBSyncImplementation::deleteRowsData(const DBSYNC_HANDLE   handle,
-                                          const nlohmann::json& json)
+                                          const nlohmann::json& json,
+                                          const ResultCallback  callback)
 {
     const auto ctx{ dbEngineContext(handle) };
-    std::lock_guard<std::shared_timed_mutex> lock{ ctx->m_syncMutex };
+    std::unique_lock<std::shared_timed_mutex> lock{ ctx->m_syncMutex };
 
     ctx->m_dbEngine->deleteTableRowsData(json.at("table"),
-                                         json.at("query"));
+                                         json.at("query"),
+                                         callback,
+                                         lock);
+    ctx->m_dbEngine->publishWrites();
 }
 
 void DBSyncImplementation::updateSnapshotData(const DBSYNC_HANDLE   handle,
@@ -104,6 +164,7 @@ void DBSyncImplementation::updateSnapshotData(const DBSYNC_HANDLE   handle,
 
     std::unique_lock<std::shared_timed_mutex> lock{ ctx->m_syncMutex };
     ctx->m_dbEngine->refreshTableData(json, callback, lock);
+    ctx->m_dbEngine->publishWrites();
 }
 
 std::shared_ptr<DBSyncImplementation::DbEngineContext> DBSyncImplementation::dbEngineContext(const DBSYNC_HANDLE handle)
@@ -140,31 +201,96 @@ TXN_HANDLE DBSyncImplementation::createTransaction(const DBSYNC_HANDLE      hand
 
     std::lock_guard<std::shared_timed_mutex> lock{ ctx->m_syncMutex };
     ctx->addTransactionContext(spTransactionContext);
-    ctx->m_dbEngine->initializeStatusField(spTransactionContext->m_tables);
+
+    if (spTransactionContext->m_snapshot)
+    {
+        ctx->m_dbEngine->initializeSnapshot(spTransactionContext->m_tables);
+    }
+    else
+    {
+        ctx->m_dbEngine->initializeStatusField(spTransactionContext->m_tables);
+    }
+
+    ctx->m_dbEngine->publishWrites();
 
     return spTransactionContext.get();
 }
 
-void DBSyncImplementation::closeTransaction(const DBSYNC_HANDLE handle,
-                                            const TXN_HANDLE txn)
+void DBSyncImplementation::closeTransaction(const DBSYNC_HANDLE   handle,
+                                            const TXN_HANDLE      txn,
+                                            const ResultCallback  changesCallback)
 {
     const auto& ctx{ dbEngineContext(handle) };
     const auto& tnxCtx { ctx->transactionContext(txn) };
 
-    std::lock_guard<std::shared_timed_mutex> lock{ ctx->m_syncMutex };
-    ctx->m_dbEngine->deleteRowsByStatusField(tnxCtx->m_tables);
+    if (tnxCtx->m_snapshot)
+    {
+        // A snapshot not applied yet is applied now, without reporting the deleted rows.
+        applySnapshot(ctx, tnxCtx, changesCallback, nullptr);
+    }
+    else
+    {
+        std::lock_guard<std::shared_timed_mutex> lock{ ctx->m_syncMutex };
+        ctx->m_dbEngine->deleteRowsByStatusField(tnxCtx->m_tables);
+        ctx->m_dbEngine->publishWrites();
+    }
+
     ctx->deleteTransactionContext(txn);
 }
 
 void DBSyncImplementation::getDeleted(const DBSYNC_HANDLE   handle,
                                       const TXN_HANDLE      txnHandle,
-                                      const ResultCallback  callback)
+                                      const ResultCallback  callback,
+                                      const ResultCallback  changesCallback)
 {
     const auto& ctx{ dbEngineContext(handle) };
     const auto& tnxCtx { ctx->transactionContext(txnHandle) };
 
-    std::unique_lock<std::shared_timed_mutex> lock{ ctx->m_syncMutex };
-    ctx->m_dbEngine->returnRowsMarkedForDelete(tnxCtx->m_tables, callback, lock);
+    if (tnxCtx->m_snapshot)
+    {
+        applySnapshot(ctx, tnxCtx, changesCallback, callback);
+    }
+    else
+    {
+        std::unique_lock<std::shared_timed_mutex> lock{ ctx->m_syncMutex };
+        ctx->m_dbEngine->returnRowsMarkedForDelete(tnxCtx->m_tables, callback, lock);
+        ctx->m_dbEngine->publishWrites();
+    }
+}
+
+void DBSyncImplementation::applySnapshot(const std::shared_ptr<DbEngineContext>& ctx,
+                                         const std::shared_ptr<TransactionContext>& txnCtx,
+                                         const ResultCallback changesCallback,
+                                         const ResultCallback deletedCallback)
+{
+    std::lock_guard<std::mutex> snapshotLock{ txnCtx->m_snapshotMutex };
+
+    if (!txnCtx->m_snapshotApplied)
+    {
+        std::unique_lock<std::shared_timed_mutex> lock{ ctx->m_syncMutex };
+
+        for (const auto& tableValue : txnCtx->m_tables)
+        {
+            const auto& table { tableValue.get_ref<const std::string&>() };
+            auto& rows { txnCtx->m_snapshotRows[table] };
+
+            if (!rows.empty())
+            {
+                ctx->m_dbEngine->appendSnapshotData(table, rows);
+                rows = nlohmann::json::array();
+            }
+
+            const auto itOptions { txnCtx->m_snapshotOptions.find(table) };
+            ctx->m_dbEngine->applySnapshot(table,
+                                           txnCtx->m_snapshotOptions.end() != itOptions ? itOptions->second : nlohmann::json::object(),
+                                           changesCallback,
+                                           deletedCallback,
+                                           lock);
+        }
+
+        ctx->m_dbEngine->publishWrites();
+        txnCtx->m_snapshotApplied = true;
+    }
 }
 
 void DBSyncImplementation::selectData(const DBSYNC_HANDLE   handle,
@@ -173,11 +299,23 @@ void DBSyncImplementation::selectData(const DBSYNC_HANDLE   handle,
 {
     const auto ctx{ dbEngineContext(handle) };
 
-    std::unique_lock<std::shared_timed_mutex> lock{ ctx->m_syncMutex };
-    ctx->m_dbEngine->selectData(json.at("table"),
-                                json.at("query"),
-                                callback,
-                                lock);
+    if (ctx->m_dbEngine->concurrentReads())
+    {
+        // The writes are published at the batch and txn boundaries, or by the select itself, so the rows are read from their own connection alongside the writers.
+        Utils::SharedLocking lock{ ctx->m_syncMutex };
+        ctx->m_dbEngine->selectData(json.at("table"),
+                                    json.at("query"),
+                                    callback,
+                                    lock);
+    }
+    else
+    {
+        Utils::ExclusiveLocking lock{ ctx->m_syncMutex };
+        ctx->m_dbEngine->selectData(json.at("table"),
+                                    json.at("query"),
+                                    callback,
+                                    lock);
+    }
 }
 
 void DBSyncImplementation::addTableRelationship(const DBSYNC_HANDLE   handle,
@@ -20,6 +20,12 @@
 #include "commonDefs.h"
 #include <nlohmann/json.hpp>
 
+// Rows of a snapshot txn appended to the engine at once.
+constexpr auto SNAPSHOT_BATCH_ROWS
+{
+    1000ull
+};
+
 namespace DbSync
 {
     class DBSyncImplementation final
@@ -44,7 +50,8 @@ namespace DbSync
                              const ResultCallback   callback);
 
             void deleteRowsData(const DBSYNC_HANDLE     handle,
-                                const nlohmann::json&   json);
+                                const nlohmann::json&   json,
+                                const ResultCallback    callback);
 
             void updateSnapshotData(const DBSYNC_HANDLE     handle,
                                     const nlohmann::json&   json,
@@ -64,12 +71,14 @@ namespace DbSync
             TXN_HANDLE createTransaction(const DBSYNC_HANDLE    handle,
                                          const nlohmann::json&  json);
 
-            void closeTransaction(const DBSYNC_HANDLE handle,
-                                  const TXN_HANDLE txnHandle);
+            void closeTransaction(const DBSYNC_HANDLE   handle,
+                                  const TXN_HANDLE      txnHandle,
+                                  const ResultCallback  changesCallback);
 
             void getDeleted(const DBSYNC_HANDLE   handle,
                             const TXN_HANDLE      txnHandle,
-                            const ResultCallback  callback);
+                            const ResultCallback  callback,
+                            const ResultCallback  changesCallback);
 
             void selectData(const DBSYNC_HANDLE    handle,
                             const nlohmann::json&  json,
@@ -86,9 +95,29 @@ namespace DbSync
             struct TransactionContext final
             {
                 explicit TransactionContext(const nlohmann::json& tables)
-                    : m_tables(std::move(tables))
-                {}
+                    : m_tables(nlohmann::json::array())
+                    , m_snapshot{ false }
+                    , m_snapshotApplied{ false }
+                {
+                    // The txn options are given along with its tables.
+                    for (auto it = tables.begin(); it != tables.end(); ++it)
+                    {
+                        if (tables.is_object() && "options" == it.key())
+                        {
+                            m_snapshot = it->value("snapshot", false);
+                        }
+                        else
+                        {
+                            m_tables.push_back(*it);
+                        }
+                    }
+                }
                 nlohmann::json m_tables;
+                bool m_snapshot;
+                bool m_snapshotApplied;
+                std::mutex m_snapshotMutex;
+                std::map<std::string, nlohmann::json> m_snapshotRows;
+                std::map<std::string, nlohmann::json> m_snapshotOptions;
             };
             class DbEngineContext final
             {
@@ -134,6 +163,11 @@ namespace DbSync
 
             std::shared_ptr<DbEngineContext> dbEngineContext(const DBSYNC_HANDLE handle);
 
+            void applySnapshot(const std::shared_ptr<DbEngineContext>& ctx,
+                               const std::shared_ptr<TransactionContext>& txnCtx,
+                               const ResultCallback changesCallback,
+                               const ResultCallback deletedCallback);
+
             DBSyncImplementation() = default;
             ~DBSyncImplementation() = default;
             DBSyncImplementation(const DBSyncImplementation&) = delete;
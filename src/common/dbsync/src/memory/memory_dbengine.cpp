@@ -0,0 +1,1235 @@
+/*
+ * Wazuh DBSYNC
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 19, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include <algorithm>
+#include "db_exception.h"
+#include "memory_dbengine.h"
+#include "stringHelper.h"
+#include "commonDefs.h"
+
+namespace
+{
+    // Values of a column always hold the same type, so the rows with the same values have the same key.
+    void appendKeyValue(std::string& key, const ColumnValue& value)
+    {
+        key.push_back(static_cast<char>(value.index()));
+
+        std::visit([&key](const auto & typedValue)
+        {
+            using ValueType = std::decay_t<decltype(typedValue)>;
+
+            if constexpr (std::is_same_v<ValueType, std::string>)
+            {
+                const auto size { typedValue.size() };
+                key.append(reinterpret_cast<const char*>(&size), sizeof(size));
+                key.append(typedValue);
+            }
+            else if constexpr (std::is_arithmetic_v<ValueType>)
+            {
+                key.append(reinterpret_cast<const char*>(&typedValue), sizeof(typedValue));
+            }
+        }, value);
+    }
+
+    // NULL values are sorted first, as SQLite does.
+    bool isLessValue(const ColumnValue& left, const ColumnValue& right)
+    {
+        if (left.index() != right.index())
+        {
+            return left.index() < right.index();
+        }
+
+        return std::visit([&right](const auto & typedValue)
+        {
+            using ValueType = std::decay_t<decltype(typedValue)>;
+
+            if constexpr (std::is_same_v<ValueType, std::monostate> || std::is_same_v<ValueType, std::nullptr_t>)
+            {
+                return false;
+            }
+            else
+            {
+                return typedValue < std::get<ValueType>(right);
+            }
+        }, left);
+    }
+
+    bool isNullValue(const ColumnValue& value)
+    {
+        return std::holds_alternative<std::monostate>(value) || std::holds_alternative<std::nullptr_t>(value);
+    }
+}
+
+MemoryDBEngine::MemoryDBEngine(const std::shared_ptr<ISQLiteFactory>& sqliteFactory,
+                               const std::string&                     tableStmtCreation,
+                               const DbManagement                     dbManagement)
+{
+    // The rows are lost with the engine, so the database can't be kept between runs.
+    if (DbManagement::VOLATILE != dbManagement)
+    {
+        throw dbengine_error { INVALID_PARAMETERS };
+    }
+
+    loadSchema(sqliteFactory, tableStmtCreation);
+}
+
+void MemoryDBEngine::bulkInsert(const std::string& table,
+                                const nlohmann::json& data)
+{
+    std::lock_guard<std::mutex> dataLock { m_dataMutex };
+    auto& memory { memoryTable(table) };
+
+    for (const auto& element : data)
+    {
+        auto row { typedRow(memory, element) };
+        const auto key { rowKey(memory, row) };
+        insertRow(memory, key, std::move(row));
+    }
+}
+
+void MemoryDBEngine::refreshTableData(const nlohmann::json& data,
+                                      const DbSync::ResultCallback callback,
+                                      std::unique_lock<std::shared_timed_mutex>& lock)
+{
+    const std::string table { data.at("table").is_string() ? data.at("table").get_ref<const std::string&>() : "" };
+    std::unique_lock<std::mutex> dataLock { m_dataMutex };
+    const auto it { m_tables.find(table) };
+
+    // Same as the SQLite engine, unknown tables and tables without primary key are not refreshed.
+    if (m_tables.end() == it || it->second.schema->primaryKeys.empty())
+    {
+        return;
+    }
+
+    auto& memory { it->second };
+    const auto& schema { *memory.schema };
+    MemoryRows input;
+
+    for (const auto& element : data.at("data"))
+    {
+        auto row { typedRow(memory, element) };
+        const auto key { rowKey(memory, row) };
+
+        if (!input.emplace(key, std::move(row)).second)
+        {
+            throw dbengine_error { BIND_FIELDS_DOES_NOT_MATCH };
+        }
+    }
+
+    Results results;
+    std::vector<std::string> deletedKeys;
+
+    for (const auto& [key, row] : memory.rows)
+    {
+        if (input.end() == input.find(key))
+        {
+            nlohmann::json object;
+
+            for (const auto& pkIndex : schema.primaryKeyIndexes)
+            {
+                object[std::get<TableHeader::Name>(schema.columns[pkIndex])] = getJsonValue(row[pkIndex]);
+            }
+
+            results.emplace_back(DELETED, std::move(object));
+            deletedKeys.push_back(key);
+        }
+    }
+
+    for (const auto& key : deletedKeys)
+    {
+        eraseRow(memory, key);
+    }
+
+    std::vector<std::string> insertedKeys;
+
+    for (const auto& [key, row] : input)
+    {
+        const auto current { memory.rows.find(key) };
+
+        if (memory.rows.end() == current)
+        {
+            insertedKeys.push_back(key);
+        }
+        else
+        {
+            // Changes from or to NULL are not reported, as in the SQLite engine.
+            nlohmann::json object;
+
+            for (size_t index = 0; index < schema.columns.size(); ++index)
+            {
+                if (!isNullValue(row[index]) && !isNullValue(current->second[index]) && row[index] != current->second[index])
+                {
+                    object[std::get<TableHeader::Name>(schema.columns[index])] = getJsonValue(row[index]);
+                    current->second[index] = row[index];
+                }
+            }
+
+            if (!object.empty())
+            {
+                for (const auto& pkIndex : schema.primaryKeyIndexes)
+                {
+                    object["PK_" + std::get<TableHeader::Name>(schema.columns[pkIndex])] = getJsonValue(row[pkIndex]);
+                }
+
+                results.emplace_back(MODIFIED, std::move(object));
+            }
+        }
+    }
+
+    for (const auto& key : insertedKeys)
+    {
+        auto& row { input.at(key) };
+        nlohmann::json object;
+        getRowObject(schema, row, object);
+        insertRow(memory, key, std::move(row));
+        results.emplace_back(INSERTED, std::move(object));
+    }
+
+    emitResults(results, callback, callback, dataLock, lock);
+}
+
+void MemoryDBEngine::syncTableRowData(const nlohmann::json& jsInput,
+                                      const DbSync::ResultCallback callback,
+                                      const bool inTransaction,
+                                      Utils::ILocking& lock)
+{
+    const auto& table { jsInput.at("table").get_ref<const std::string&>() };
+    const auto& data { jsInput.at("data") };
+
+    auto it { jsInput.find("options") };
+    auto returnOldData { false };
+    nlohmann::json ignoredColumns { };
+
+    if (jsInput.end() != it)
+    {
+        auto itOldData { it->find("return_old_data") };
+
+        if (it->end() != itOldData)
+        {
+            returnOldData = itOldData->is_boolean() ? itOldData.value().get<bool>() : returnOldData;
+        }
+
+        auto itIgnoredFields { it->find("ignore") };
+
+        if (it->end() != itIgnoredFields)
+        {
+            ignoredColumns = itIgnoredFields->is_array() ? itIgnoredFields.value() : ignoredColumns;
+        }
+    }
+
+    std::unique_lock<std::mutex> dataLock { m_dataMutex };
+    auto& memory { memoryTable(table) };
+    const auto& schema { *memory.schema };
+
+    for (const auto& entry : data)
+    {
+        const auto key { rowKey(schema, entry) };
+        const auto current { memory.rows.find(key) };
+
+        if (memory.rows.end() != current)
+        {
+            nlohmann::json updated;
+            nlohmann::json oldData;
+            getRowDiff(schema, ignoredColumns, current->second, entry, updated, oldData);
+
+            for (auto field = updated.begin(); field != updated.end(); ++field)
+            {
+                const auto index { schema.columnIndexes.at(field.key()) };
+
+                if (!std::get<TableHeader::PK>(schema.columns[index]))
+                {
+                    current->second[index] = columnValue(schema.columns[index], field.value());
+                }
+            }
+
+            if (inTransaction && memory.inTransaction)
+            {
+                memory.seen.insert(key);
+            }
+
+            if (callback && !updated.empty())
+            {
+                dataLock.unlock();
+                lock.unlock();
+
+                if (returnOldData)
+                {
+                    nlohmann::json diff;
+                    diff["old"] = oldData;
+                    diff["new"] = updated;
+                    callback(MODIFIED, diff);
+                }
+                else
+                {
+                    callback(MODIFIED, updated);
+                }
+
+                lock.lock();
+                dataLock.lock();
+            }
+        }
+        else
+        {
+            insertRow(memory, key, typedRow(memory, entry));
+
+            if (callback)
+            {
+                dataLock.unlock();
+                lock.unlock();
+                callback(INSERTED, entry);
+                lock.lock();
+                dataLock.lock();
+            }
+        }
+    }
+}
+
+void MemoryDBEngine::setMaxRows(const std::string& table,
+                                const int64_t maxRows)
+{
+    std::lock_guard<std::mutex> dataLock { m_dataMutex };
+    auto& memory { memoryTable(table) };
+
+    if (maxRows < 0)
+    {
+        throw dbengine_error { MIN_ROW_LIMIT_BELOW_ZERO };
+    }
+
+    memory.maxRows = static_cast<size_t>(maxRows);
+}
+
+void MemoryDBEngine::initializeStatusField(const nlohmann::json& tableNames)
+{
+    std::lock_guard<std::mutex> dataLock { m_dataMutex };
+
+    for (const auto& tableValue : tableNames)
+    {
+        auto& memory { memoryTable(tableValue.get<std::string>()) };
+
+        if (memory.schema->primaryKeys.empty())
+        {
+            throw dbengine_error { SQL_STMT_ERROR };
+        }
+
+        memory.seen.clear();
+        memory.inTransaction = true;
+    }
+}
+
+void MemoryDBEngine::deleteRowsByStatusField(const nlohmann::json& tableNames)
+{
+    std::lock_guard<std::mutex> dataLock { m_dataMutex };
+
+    for (const auto& tableValue : tableNames)
+    {
+        auto& memory { memoryTable(tableValue.get<std::string>()) };
+        std::vector<std::string> deletedKeys;
+
+        for (const auto& row : memory.rows)
+        {
+            if (memory.seen.end() == memory.seen.find(row.first))
+            {
+                deletedKeys.push_back(row.first);
+            }
+        }
+
+        for (const auto& key : deletedKeys)
+        {
+            eraseRow(memory, key);
+        }
+
+        memory.seen.clear();
+        memory.inTransaction = false;
+    }
+}
+
+void MemoryDBEngine::returnRowsMarkedForDelete(const nlohmann::json& tableNames,
+                                               const DbSync::ResultCallback callback,
+                                               std::unique_lock<std::shared_timed_mutex>& lock)
+{
+    std::unique_lock<std::mutex> dataLock { m_dataMutex };
+
+    for (const auto& tableValue : tableNames)
+    {
+        const auto& memory { memoryTable(tableValue.get<std::string>()) };
+        Results results;
+
+        for (const auto& [key, row] : memory.rows)
+        {
+            if (memory.seen.end() == memory.seen.find(key))
+            {
+                nlohmann::json object {};
+                getRowObject(*memory.schema, row, object);
+                results.emplace_back(DELETED, std::move(object));
+            }
+        }
+
+        emitResults(results, callback, callback, dataLock, lock);
+    }
+}
+
+void MemoryDBEngine::selectData(const std::string& table,
+                                const nlohmann::json& query,
+                                const DbSync::ResultCallback& callback,
+                                Utils::ILocking& lock)
+{
+    std::unique_lock<std::mutex> dataLock { m_dataMutex };
+    const auto& memory { memoryTable(table) };
+    const auto& schema { *memory.schema };
+    const auto& itFilter { query.find("row_filter") };
+    const auto& itDistinct { query.find("distinct_opt") };
+    const auto& itOrderBy { query.find("order_by_opt") };
+    const auto& itCount { query.find("count_opt") };
+
+    // Row filters are SQL expressions, which this engine does not evaluate.
+    if (itFilter != query.end() && !itFilter->get<std::string>().empty())
+    {
+        throw dbengine_error { OPERATION_NOT_SUPPORTED };
+    }
+
+    const auto& columns { query.at("column_list") };
+
+    // The count of rows is the only aggregate supported.
+    if (1 == columns.size() && Utils::startsWith(Utils::toUpperCase(columns.at(0).get<std::string>()), "COUNT(*)"))
+    {
+        const auto& column { columns.at(0).get_ref<const std::string&>() };
+        const auto aliasPosition { Utils::toUpperCase(column).find(" AS ") };
+        const auto alias { std::string::npos == aliasPosition ? column : Utils::trim(column.substr(aliasPosition + 4)) };
+        const Results results { { SELECTED, nlohmann::json { { alias, memory.rows.size() } } } };
+        emitResults(results, callback, callback, dataLock, lock);
+        return;
+    }
+
+    std::vector<size_t> fields;
+
+    for (const auto& column : columns)
+    {
+        const auto& name { column.get_ref<const std::string&>() };
+
+        if ("*" == name)
+        {
+            for (size_t index = 0; index < schema.columns.size(); ++index)
+            {
+                fields.push_back(index);
+            }
+        }
+        else
+        {
+            const auto it { schema.columnIndexes.find(name) };
+
+            if (schema.columnIndexes.end() == it)
+            {
+                throw dbengine_error { OPERATION_NOT_SUPPORTED };
+            }
+
+            fields.push_back(it->second);
+        }
+    }
+
+    std::vector<const TypedRow*> rows;
+    rows.reserve(memory.rows.size());
+
+    for (const auto& row : memory.rows)
+    {
+        rows.push_back(&row.second);
+    }
+
+    if (itOrderBy != query.end() && !itOrderBy->get<std::string>().empty())
+    {
+        // Only lists of columns are supported, each one optionally followed by ASC or DESC.
+        std::vector<std::pair<size_t, bool>> order;
+
+        for (const auto& term : Utils::split(itOrderBy->get<std::string>(), ','))
+        {
+            auto name { Utils::trim(term) };
+            const auto upperName { Utils::toUpperCase(name) };
+            const auto descending { Utils::endsWith(upperName, " DESC") };
+
+            if (descending || Utils::endsWith(upperName, " ASC"))
+            {
+                name = Utils::trim(name.substr(0, name.rfind(' ')));
+            }
+
+            const auto it { schema.columnIndexes.find(name) };
+
+            if (schema.columnIndexes.end() == it)
+            {
+                throw dbengine_error { OPERATION_NOT_SUPPORTED };
+            }
+
+            order.emplace_back(it->second, descending);
+        }
+
+        std::stable_sort(rows.begin(), rows.end(), [&order](const TypedRow * left, const TypedRow * right)
+        {
+            for (const auto& [index, descending] : order)
+            {
+                if (isLessValue((*left)[index], (*right)[index]))
+                {
+                    return !descending;
+                }
+
+                if (isLessValue((*right)[index], (*left)[index]))
+                {
+                    return descending;
+                }
+            }
+
+            return false;
+        });
+    }
+
+    const auto distinct { itDistinct != query.end() && itDistinct->get<bool>() };
+    const auto limit { itCount != query.end() ? itCount->get<unsigned int>() : rows.size() };
+    std::unordered_set<std::string> selected;
+    size_t count { 0 };
+    Results results;
+
+    for (const auto* row : rows)
+    {
+        if (count >= limit)
+        {
+            break;
+        }
+
+        if (distinct)
+        {
+            std::string key;
+
+            for (const auto& field : fields)
+            {
+                appendKeyValue(key, (*row)[field]);
+            }
+
+            if (!selected.insert(std::move(key)).second)
+            {
+                continue;
+            }
+        }
+
+        ++count;
+        nlohmann::json object;
+
+        for (const auto& field : fields)
+        {
+            const auto& value { (*row)[field] };
+
+            if (!isNullValue(value) && !std::get<TableHeader::TXNStatusField>(schema.columns[field]))
+            {
+                object[std::get<TableHeader::Name>(schema.columns[field])] = getJsonValue(value);
+            }
+        }
+
+        if (!object.empty())
+        {
+            results.emplace_back(SELECTED, std::move(object));
+        }
+    }
+
+    emitResults(results, callback, callback, dataLock, lock);
+}
+
+bool MemoryDBEngine::concurrentReads() const
+{
+    return false;
+}
+
+void MemoryDBEngine::publishWrites()
+{
+    // The rows are visible as soon as they are written.
+}
+
+void MemoryDBEngine::beginRowWrite()
+{
+}
+
+void MemoryDBEngine::endRowWrite()
+{
+}
+
+void MemoryDBEngine::deleteTableRowsData(const std::string& table,
+                                         const nlohmann::json& jsDeletionData,
+                                         const DbSync::ResultCallback callback,
+                                         std::unique_lock<std::shared_timed_mutex>& lock)
+{
+    std::unique_lock<std::mutex> dataLock { m_dataMutex };
+    auto& memory { memoryTable(table) };
+    const auto& itData { jsDeletionData.find("data") };
+    const auto& itFilter { jsDeletionData.find("where_filter_opt") };
+
+    if (itData != jsDeletionData.end() && itData->size() > 0)
+    {
+        Results results;
+
+        for (const auto& jsRow : itData.value())
+        {
+            const auto key { rowKey(*memory.schema, jsRow) };
+            const auto it { memory.rows.find(key) };
+
+            if (callback && memory.rows.end() != it)
+            {
+                nlohmann::json object {};
+                getRowObject(*memory.schema, it->second, object);
+                results.emplace_back(DELETED, std::move(object));
+            }
+
+            eraseRow(memory, key);
+        }
+
+        emitResults(results, callback, callback, dataLock, lock);
+    }
+    else if (itFilter != jsDeletionData.end() && !itFilter->get<std::string>().empty())
+    {
+        // Filters are SQL expressions, which this engine does not evaluate.
+        throw dbengine_error { OPERATION_NOT_SUPPORTED };
+    }
+    else
+    {
+        throw dbengine_error { INVALID_DELETE_INFO };
+    }
+}
+
+void MemoryDBEngine::addTableRelationship(const nlohmann::json& data)
+{
+    std::lock_guard<std::mutex> dataLock { m_dataMutex };
+    auto& base { memoryTable(data.at("base_table").get<std::string>()) };
+
+    // As the triggers of the SQLite engine, a relationship is only added once.
+    if (base.schema->primaryKeys.empty() || !base.relationships.empty())
+    {
+        return;
+    }
+
+    for (const auto& relation : data.at("relationed_tables"))
+    {
+        const auto it { m_tables.find(relation.at("table").get<std::string>()) };
+
+        if (m_tables.end() == it)
+        {
+            throw dbengine_error { INVALID_TABLE };
+        }
+
+        for (const auto& match : relation.at("field_match").items())
+        {
+            if (!it->second.schema->column(match.key()) || !base.schema->column(match.value().get<std::string>()))
+            {
+                throw dbengine_error { INVALID_PARAMETERS };
+            }
+        }
+    }
+
+    base.relationships = data.at("relationed_tables");
+}
+
+void MemoryDBEngine::initializeSnapshot(const nlohmann::json& tableNames)
+{
+    std::lock_guard<std::mutex> dataLock { m_dataMutex };
+
+    for (const auto& tableValue : tableNames)
+    {
+        auto& memory { memoryTable(tableValue.get<std::string>()) };
+
+        if (memory.schema->primaryKeys.empty())
+        {
+            throw dbengine_error { EMPTY_TABLE_METADATA };
+        }
+
+        memory.snapshot.clear();
+        memory.inSnapshot = true;
+    }
+}
+
+void MemoryDBEngine::appendSnapshotData(const std::string& table,
+                                        const nlohmann::json& data)
+{
+    std::lock_guard<std::mutex> dataLock { m_dataMutex };
+    auto& memory { memoryTable(table) };
+
+    if (!memory.inSnapshot)
+    {
+        throw dbengine_error { EMPTY_TABLE_METADATA };
+    }
+
+    for (const auto& element : data)
+    {
+        // The last copy of a row wins, as a snapshot holds a single copy of each row.
+        auto row { typedRow(memory, element) };
+        const auto key { rowKey(memory, row) };
+        memory.snapshot.insert_or_assign(key, std::move(row));
+    }
+}
+
+void MemoryDBEngine::applySnapshot(const std::string& table,
+                                   const nlohmann::json& options,
+                                   const DbSync::ResultCallback changesCallback,
+                                   const DbSync::ResultCallback deletedCallback,
+                                   std::unique_lock<std::shared_timed_mutex>& lock)
+{
+    std::unique_lock<std::mutex> dataLock { m_dataMutex };
+    auto& memory { memoryTable(table) };
+    const auto& schema { *memory.schema };
+
+    if (schema.primaryKeys.empty() || !memory.inSnapshot)
+    {
+        throw dbengine_error { EMPTY_TABLE_METADATA };
+    }
+
+    const auto returnOldData { options.contains("return_old_data") && options.at("return_old_data").is_boolean() && options.at("return_old_data").get<bool>() };
+    const auto ignoredColumns { options.contains("ignore") && options.at("ignore").is_array() ? options.at("ignore") : nlohmann::json::array() };
+    // A partial snapshot keeps the rows it does not have.
+    const auto keepUnseen { options.contains("keep_unseen") && options.at("keep_unseen").is_boolean() && options.at("keep_unseen").get<bool>() };
+    std::vector<size_t> updatedFields;
+    std::vector<size_t> comparedFields;
+
+    for (size_t index = 0; index < schema.columns.size(); ++index)
+    {
+        const auto& field { schema.columns[index] };
+
+        if (!std::get<TableHeader::PK>(field) && !std::get<TableHeader::TXNStatusField>(field))
+        {
+            updatedFields.push_back(index);
+
+            if (std::find(ignoredColumns.begin(), ignoredColumns.end(), std::get<TableHeader::Name>(field)) == ignoredColumns.end())
+            {
+                comparedFields.push_back(index);
+            }
+        }
+    }
+
+    // The three result sets are found before the table is changed, and reported in the same order as the SQLite engine.
+    Results results;
+    std::vector<std::string> deletedKeys;
+    std::vector<std::string> modifiedKeys;
+    std::vector<std::string> insertedKeys;
+
+    for (const auto& [key, row] : memory.rows)
+    {
+        if (!keepUnseen && memory.snapshot.end() == memory.snapshot.find(key))
+        {
+            nlohmann::json object;
+            getRowObject(schema, row, object);
+            results.emplace_back(DELETED, std::move(object));
+            deletedKeys.push_back(key);
+        }
+    }
+
+    for (const auto& [key, row] : memory.snapshot)
+    {
+        const auto current { memory.rows.find(key) };
+
+        if (memory.rows.end() == current)
+        {
+            insertedKeys.push_back(key);
+            continue;
+        }
+
+        const auto& oldRow { current->second };
+        const auto isModified
+        {
+            std::any_of(comparedFields.begin(), comparedFields.end(), [&row, &oldRow](const size_t index)
+            {
+                return row[index] != oldRow[index];
+            })
+        };
+
+        if (isModified)
+        {
+            nlohmann::json object;
+            getRowObject(schema, row, object);
+
+            if (returnOldData)
+            {
+                nlohmann::json oldData;
+
+                for (size_t index = 0; index < schema.columns.size(); ++index)
+                {
+                    const auto& field { schema.columns[index] };
+
+                    if (!std::get<TableHeader::TXNStatusField>(field) && (std::get<TableHeader::PK>(field) || oldRow[index] != row[index]))
+                    {
+                        oldData[std::get<TableHeader::Name>(field)] = getJsonValue(oldRow[index]);
+                    }
+                }
+
+                object = { { "old", std::move(oldData) }, { "new", std::move(object) } };
+            }
+
+            results.emplace_back(MODIFIED, std::move(object));
+            modifiedKeys.push_back(key);
+        }
+    }
+
+    for (const auto& key : deletedKeys)
+    {
+        eraseRow(memory, key);
+    }
+
+    for (const auto& key : modifiedKeys)
+    {
+        const auto current { memory.rows.find(key) };
+
+        if (memory.rows.end() != current)
+        {
+            const auto& row { memory.snapshot.at(key) };
+
+            for (const auto& index : updatedFields)
+            {
+                current->second[index] = row[index];
+            }
+        }
+    }
+
+    // Rows over the limit of the table are not inserted, and are reported as such.
+    for (const auto& key : insertedKeys)
+    {
+        auto& row { memory.snapshot.at(key) };
+        nlohmann::json object;
+        getRowObject(schema, row, object);
+
+        if (0 != memory.maxRows && memory.rows.size() >= memory.maxRows)
+        {
+            // Same information the row at a time sync reports.
+            results.emplace_back(MAX_ROWS, nlohmann::json { { "table", table }, { "data", nlohmann::json::array({ object }) } });
+        }
+        else
+        {
+            insertRow(memory, key, std::move(row));
+            results.emplace_back(INSERTED, std::move(object));
+        }
+    }
+
+    memory.snapshot.clear();
+    emitResults(results, changesCallback, deletedCallback, dataLock, lock);
+}
+
+///
+/// Private functions section
+///
+
+void MemoryDBEngine::loadSchema(const std::shared_ptr<ISQLiteFactory>& sqliteFactory,
+                                const std::string&                     tableStmtCreation)
+{
+    // The statements are only run to learn the schema, on a database that is released right after.
+    auto connection { sqliteFactory->createConnection(DB_MEMORY) };
+    connection->execute(tableStmtCreation);
+
+    const auto tables { sqliteFactory->createStatement(connection, "SELECT name FROM sqlite_master WHERE type='table';") };
+
+    while (SQLITE_ROW == tables->step())
+    {
+        const auto table { tables->column(0)->value(std::string{}) };
+        const auto stmt { sqliteFactory->createStatement(connection, "PRAGMA table_info(" + table + ");") };
+        auto schema { std::make_shared<TableSchema>() };
+        TypedRow defaults;
+
+        while (SQLITE_ROW == stmt->step())
+        {
+            const auto& fieldName { stmt->column(1)->value(std::string{}) };
+            const auto& typeName { stmt->column(2)->value(std::string{}) };
+            const auto isPrimaryKey { 0 != stmt->column(5)->value(int32_t{}) };
+            const auto hiddenIt { typeName.find(" HIDDEN") };
+            const auto typeIt { ColumnTypeNames.find(typeName.substr(0, hiddenIt)) };
+            const auto type { ColumnTypeNames.end() != typeIt ? typeIt->second : Unknown };
+
+            if (isPrimaryKey)
+            {
+                schema->primaryKeys.push_back(fieldName);
+                schema->primaryKeyIndexes.push_back(schema->columns.size());
+            }
+
+            schema->columnIndexes.emplace(fieldName, schema->columns.size());
+            schema->columns.push_back(std::make_tuple(stmt->column(0)->value(int32_t{}),
+                                                      fieldName,
+                                                      type,
+                                                      isPrimaryKey,
+                                                      InternalColumnNames.end() != std::find(InternalColumnNames.begin(),
+                                                                                             InternalColumnNames.end(), fieldName)));
+
+            // The default of a column is evaluated once, then copied to each new row.
+            ColumnValue value { nullptr };
+
+            if (stmt->column(4)->hasValue())
+            {
+                const auto defaultStmt { sqliteFactory->createStatement(connection, "SELECT " + stmt->column(4)->value(std::string{}) + ";") };
+
+                if (SQLITE_ROW == defaultStmt->step() && defaultStmt->column(0)->hasValue())
+                {
+                    const auto column { defaultStmt->column(0) };
+
+                    switch (type)
+                    {
+                        case Text:
+                            value = column->value(std::string{});
+                            break;
+
+                        case Integer:
+                            value = column->value(int32_t{});
+                            break;
+
+                        case BigInt:
+                            value = column->value(int64_t{});
+                            break;
+
+                        case UnsignedBigInt:
+                            value = column->value(uint64_t{});
+                            break;
+
+                        case Double:
+                            value = column->value(double_t{});
+                            break;
+
+                        default:
+                            break;
+                    }
+                }
+            }
+
+            defaults.push_back(std::move(value));
+        }
+
+        if (!schema->columns.empty())
+        {
+            m_tables.emplace(table, MemoryTable { schema, std::move(defaults), {}, {}, false, {}, false, 0ull, 0ull, nlohmann::json::array() });
+        }
+    }
+}
+
+MemoryTable& MemoryDBEngine::memoryTable(const std::string& table)
+{
+    const auto it { m_tables.find(table) };
+
+    if (m_tables.end() == it)
+    {
+        throw dbengine_error { EMPTY_TABLE_METADATA };
+    }
+
+    return it->second;
+}
+
+ColumnValue MemoryDBEngine::columnValue(const ColumnData& cd,
+                                        const nlohmann::json& jsData) const
+{
+    // Values are converted as the SQLite engine binds them, so both engines store the same data.
+    const auto type { std::get<TableHeader::Type>(cd) };
+    const auto isString { jsData.is_string() && !jsData.get_ref<const std::string&>().empty() };
+    ColumnValue value;
+
+    if (jsData.is_null())
+    {
+        if (std::get<TableHeader::PK>(cd))
+        {
+            throw dbengine_error { INVALID_DATA_BIND };
+        }
+
+        value = nullptr;
+    }
+    else if (ColumnType::BigInt == type)
+    {
+        value = jsData.is_number() ? jsData.get<int64_t>() : isString ? std::stoll(jsData.get_ref<const std::string&>()) : 0ll;
+    }
+    else if (ColumnType::UnsignedBigInt == type)
+    {
+        value = jsData.is_number_unsigned() ? jsData.get<uint64_t>() : isString ? std::stoull(jsData.get_ref<const std::string&>()) : 0ull;
+    }
+    else if (ColumnType::Integer == type)
+    {
+        value = jsData.is_number() ? jsData.get<int32_t>() : isString ? std::stoi(jsData.get_ref<const std::string&>()) : 0;
+    }
+    else if (ColumnType::Text == type)
+    {
+        value = jsData.is_string() ? jsData.get<std::string>() : std::string{};
+    }
+    else if (ColumnType::Double == type)
+    {
+        value = jsData.is_number_float() ? jsData.get<double_t>() : isString ? std::stod(jsData.get_ref<const std::string&>()) : .0;
+    }
+    else
+    {
+        throw dbengine_error { INVALID_COLUMN_TYPE };
+    }
+
+    return value;
+}
+
+TypedRow MemoryDBEngine::typedRow(const MemoryTable& table,
+                                  const nlohmann::json& data) const
+{
+    const auto& schema { *table.schema };
+    TypedRow row { table.defaults };
+
+    for (size_t index = 0; index < schema.columns.size(); ++index)
+    {
+        const auto it { data.find(std::get<TableHeader::Name>(schema.columns[index])) };
+
+        if (data.end() != it)
+        {
+            row[index] = columnValue(schema.columns[index], *it);
+        }
+    }
+
+    return row;
+}
+
+std::string MemoryDBEngine::rowKey(const TableSchema& schema,
+                                   const nlohmann::json& data) const
+{
+    if (schema.primaryKeys.empty())
+    {
+        throw dbengine_error { INVALID_PK_DATA };
+    }
+
+    std::string key;
+
+    for (const auto& pkIndex : schema.primaryKeyIndexes)
+    {
+        const auto& column { schema.columns[pkIndex] };
+        appendKeyValue(key, columnValue(column, data.at(std::get<TableHeader::Name>(column))));
+    }
+
+    return key;
+}
+
+std::string MemoryDBEngine::rowKey(MemoryTable& table,
+                                   const TypedRow& row)
+{
+    std::string key;
+
+    if (table.schema->primaryKeys.empty())
+    {
+        appendKeyValue(key, ++table.nextRowId);
+    }
+
+    for (const auto& pkIndex : table.schema->primaryKeyIndexes)
+    {
+        appendKeyValue(key, row[pkIndex]);
+    }
+
+    return key;
+}
+
+void MemoryDBEngine::insertRow(MemoryTable& table,
+                               const std::string& key,
+                               TypedRow&& row)
+{
+    if (0 != table.maxRows && table.rows.size() >= table.maxRows)
+    {
+        throw DbSync::max_rows_error { SQLiteLegacy::MAX_ROWS_ERROR_STRING };
+    }
+
+    if (!table.rows.emplace(key, std::move(row)).second)
+    {
+        throw dbengine_error { BIND_FIELDS_DOES_NOT_MATCH };
+    }
+
+    // Inserted rows are kept when the txn closes, as the insert trigger of the SQLite engine does.
+    if (table.inTransaction)
+    {
+        table.seen.insert(key);
+    }
+}
+
+void MemoryDBEngine::eraseRow(MemoryTable& table,
+                              const std::string& key)
+{
+    const auto it { table.rows.find(key) };
+
+    if (table.rows.end() == it)
+    {
+        return;
+    }
+
+    const auto row { std::move(it->second) };
+    table.rows.erase(it);
+
+    // Rows of the related tables are deleted with the row, as the delete trigger of the SQLite engine does.
+    for (const auto& relation : table.relationships)
+    {
+        auto& related { m_tables.at(relation.at("table").get<std::string>()) };
+        std::vector<std::pair<size_t, size_t>> matches;
+
+        for (const auto& match : relation.at("field_match").items())
+        {
+            matches.emplace_back(related.schema->columnIndexes.at(match.key()),
+                                 table.schema->columnIndexes.at(match.value().get<std::string>()));
+        }
+
+        std::vector<std::string> relatedKeys;
+
+        for (const auto& [relatedKey, relatedRow] : related.rows)
+        {
+            const auto isMatch
+            {
+                std::all_of(matches.begin(), matches.end(), [&](const std::pair<size_t, size_t>& match)
+                {
+                    const auto& value { relatedRow[match.first] };
+                    const auto& baseValue { row[match.second] };
+
+                    return !isNullValue(value) && !isNullValue(baseValue) &&
+                           (value == baseValue || (value.index() != baseValue.index() && getJsonValue(value) == getJsonValue(baseValue)));
+                })
+            };
+
+            if (isMatch)
+            {
+                relatedKeys.push_back(relatedKey);
+            }
+        }
+
+        for (const auto& relatedKey : relatedKeys)
+        {
+            eraseRow(related, relatedKey);
+        }
+    }
+}
+
+void MemoryDBEngine::getRowDiff(const TableSchema& schema,
+                                const nlohmann::json& ignoredColumns,
+                                const TypedRow& row,
+                                const nlohmann::json& data,
+                                nlohmann::json& updatedData,
+                                nlohmann::json& oldData) const
+{
+    bool isModified { false };
+
+    // Always include primary keys
+    for (const auto& pkValue : schema.primaryKeys)
+    {
+        updatedData[pkValue] = data.at(pkValue);
+        oldData[pkValue] = data.at(pkValue);
+    }
+
+    for (size_t index = 0; index < schema.columns.size(); ++index)
+    {
+        const auto& name { std::get<TableHeader::Name>(schema.columns[index]) };
+        const auto& it { data.find(name) };
+
+        if (data.end() != it)
+        {
+            if (!isSameValue(row[index], *it))
+            {
+                // Diff found
+                isModified = true;
+                oldData[name] = getJsonValue(row[index]);
+            }
+
+            updatedData[name] = *it;
+        }
+    }
+
+    // Same filter as the SQLite engine, a change only on ignored columns is not a modification.
+    const auto haveDiffOnNonIgnored
+    {
+        [&ignoredColumns, &schema, &oldData]()
+        {
+            for (const auto& field : oldData.items())
+            {
+                if (std::find(ignoredColumns.begin(), ignoredColumns.end(), field.key()) == ignoredColumns.end())
+                {
+                    const auto column { schema.column(field.key()) };
+
+                    if (!column || !std::get<TableHeader::PK>(*column))
+                    {
+                        return true;
+                    }
+                }
+            }
+
+            return false;
+        }
+    };
+
+    if (!isModified || (!ignoredColumns.empty() && !haveDiffOnNonIgnored()))
+    {
+        updatedData.clear();
+        oldData.clear();
+    }
+}
+
+nlohmann::json MemoryDBEngine::getJsonValue(const ColumnValue& value) const
+{
+    return std::visit([](const auto & typedValue) -> nlohmann::json
+    {
+        using ValueType = std::decay_t<decltype(typedValue)>;
+
+        if constexpr (std::is_same_v<ValueType, std::monostate> || std::is_same_v<ValueType, std::nullptr_t>)
+        {
+            return nullptr;
+        }
+        else
+        {
+            return typedValue;
+        }
+    }, value);
+}
+
+bool MemoryDBEngine::isSameValue(const ColumnValue& value,
+                                 const nlohmann::json& jsValue) const
+{
+    return std::visit([&jsValue](const auto & typedValue)
+    {
+        using ValueType = std::decay_t<decltype(typedValue)>;
+
+        if constexpr (std::is_same_v<ValueType, std::monostate> || std::is_same_v<ValueType, std::nullptr_t>)
+        {
+            return jsValue.is_null();
+        }
+        else if constexpr (std::is_same_v<ValueType, std::string>)
+        {
+            return jsValue.is_string() && jsValue.get_ref<const std::string&>() == typedValue;
+        }
+        else
+        {
+            return jsValue == typedValue;
+        }
+    }, value);
+}
+
+void MemoryDBEngine::getRowObject(const TableSchema& schema,
+                                  const TypedRow& row,
+                                  nlohmann::json& object,
+                                  const std::string& prefix) const
+{
+    for (size_t index = 0; index < row.size() && index < schema.columns.size(); ++index)
+    {
+        if (!std::holds_alternative<std::monostate>(row[index]) && !std::get<TableHeader::TXNStatusField>(schema.columns[index]))
+        {
+            object[prefix + std::get<TableHeader::Name>(schema.columns[index])] = getJsonValue(row[index]);
+        }
+    }
+}
+
+template<typename TLock>
+void MemoryDBEngine::emitResults(const Results& results,
+                                 const DbSync::ResultCallback& changesCallback,
+                                 const DbSync::ResultCallback& deletedCallback,
+                                 std::unique_lock<std::mutex>& dataLock,
+                                 TLock& lock) const
+{
+    if (!results.empty())
+    {
+        // The results were copied out of the tables, so the callbacks run without any lock held.
+        dataLock.unlock();
+        lock.unlock();
+
+        for (const auto& result : results)
+        {
+            const auto& callback { DELETED == result.first ? deletedCallback : changesCallback };
+
+            if (callback)
+            {
+                callback(result.first, result.second);
+            }
+        }
+
+        lock.lock();
+        dataLock.lock();
+    }
+}
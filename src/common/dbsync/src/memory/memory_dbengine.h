@@ -0,0 +1,165 @@
+/*
+ * Wazuh DBSYNC
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 19, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _MEMORY_DBENGINE_H
+#define _MEMORY_DBENGINE_H
+
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include "dbengine.h"
+#include "sqlite/sqlite_dbengine.h"
+
+// Rows of a table, keyed by the encoded values of their primary key.
+using MemoryRows = std::unordered_map<std::string, TypedRow>;
+
+struct MemoryTable final
+{
+    TableSchemaPtr schema;
+    // Values of a new row, before the columns of the input are set.
+    TypedRow defaults;
+    MemoryRows rows;
+    // Keys of the rows synced since the txn started, when 'inTransaction' is set.
+    std::unordered_set<std::string> seen;
+    bool inTransaction;
+    MemoryRows snapshot;
+    bool inSnapshot;
+    // Rows of the tables without primary key are keyed by their insertion order.
+    uint64_t nextRowId;
+    size_t maxRows;
+    // Tables whose rows are deleted with the rows of this table, with the columns that match them.
+    nlohmann::json relationships;
+};
+
+// Engine for volatile databases, where each table is a hash map and no SQL is run after the schema is loaded.
+class MemoryDBEngine final : public DbSync::IDbEngine
+{
+    public:
+        MemoryDBEngine(const std::shared_ptr<ISQLiteFactory>& sqliteFactory,
+                       const std::string&                     tableStmtCreation,
+                       const DbManagement                     dbManagement = DbManagement::VOLATILE);
+        ~MemoryDBEngine() = default;
+
+        void bulkInsert(const std::string& table,
+                        const nlohmann::json& data) override;
+
+        void refreshTableData(const nlohmann::json& data,
+                              const DbSync::ResultCallback callback,
+                              std::unique_lock<std::shared_timed_mutex>& lock) override;
+
+        void syncTableRowData(const nlohmann::json& jsInput,
+                              const DbSync::ResultCallback callback,
+                              const bool inTransaction,
+                              Utils::ILocking& mutex) override;
+
+        void setMaxRows(const std::string& table,
+                        const int64_t maxRows) override;
+
+        void initializeStatusField(const nlohmann::json& tableNames) override;
+
+        void deleteRowsByStatusField(const nlohmann::json& tableNames) override;
+
+        void returnRowsMarkedForDelete(const nlohmann::json& tableNames,
+                                       const DbSync::ResultCallback callback,
+                                       std::unique_lock<std::shared_timed_mutex>& lock) override;
+
+        void selectData(const std::string& table,
+                        const nlohmann::json& query,
+                        const DbSync::ResultCallback& callback,
+                        Utils::ILocking& lock) override;
+
+        bool concurrentReads() const override;
+
+        void publishWrites() override;
+
+        void beginRowWrite() override;
+
+        void endRowWrite() override;
+
+        void deleteTableRowsData(const std::string& table,
+                                 const nlohmann::json& jsDeletionData,
+                                 const DbSync::ResultCallback callback,
+                                 std::unique_lock<std::shared_timed_mutex>& lock) override;
+
+        void addTableRelationship(const nlohmann::json& data) override;
+
+        void initializeSnapshot(const nlohmann::json& tableNames) override;
+
+        void appendSnapshotData(const std::string& table,
+                                const nlohmann::json& data) override;
+
+        void applySnapshot(const std::string& table,
+                           const nlohmann::json& options,
+                           const DbSync::ResultCallback changesCallback,
+                           const DbSync::ResultCallback deletedCallback,
+                           std::unique_lock<std::shared_timed_mutex>& lock) override;
+
+    private:
+        using Results = std::vector<std::pair<ReturnTypeCallback, nlohmann::json>>;
+
+        void loadSchema(const std::shared_ptr<ISQLiteFactory>& sqliteFactory,
+                        const std::string&                     tableStmtCreation);
+
+        MemoryTable& memoryTable(const std::string& table);
+
+        ColumnValue columnValue(const ColumnData& cd,
+                                const nlohmann::json& jsData) const;
+
+        TypedRow typedRow(const MemoryTable& table,
+                          const nlohmann::json& data) const;
+
+        std::string rowKey(const TableSchema& schema,
+                           const nlohmann::json& data) const;
+
+        std::string rowKey(MemoryTable& table,
+                           const TypedRow& row);
+
+        void insertRow(MemoryTable& table,
+                       const std::string& key,
+                       TypedRow&& row);
+
+        void eraseRow(MemoryTable& table,
+                      const std::string& key);
+
+        void getRowDiff(const TableSchema& schema,
+                        const nlohmann::json& ignoredColumns,
+                        const TypedRow& row,
+                        const nlohmann::json& data,
+                        nlohmann::json& updatedData,
+                        nlohmann::json& oldData) const;
+
+        nlohmann::json getJsonValue(const ColumnValue& value) const;
+
+        bool isSameValue(const ColumnValue& value,
+                         const nlohmann::json& jsValue) const;
+
+        void getRowObject(const TableSchema& schema,
+                          const TypedRow& row,
+                          nlohmann::json& object,
+                          const std::string& prefix = "") const;
+
+        template<typename TLock>
+        void emitResults(const Results& results,
+                         const DbSync::ResultCallback& changesCallback,
+                         const DbSync::ResultCallback& deletedCallback,
+                         std::unique_lock<std::mutex>& dataLock,
+                         TLock& lock) const;
+
+        MemoryDBEngine(const MemoryDBEngine&) = delete;
+
+        MemoryDBEngine& operator=(const MemoryDBEngine&) = delete;
+
+        // The tables are only added when the engine is created, then the mutex guards their rows.
+        std::unordered_map<std::string, MemoryTable> m_tables;
+        std::mutex m_dataMutex;
+};
+
+#endif // _MEMORY_DBENGINE_H
@@ -26,7 +26,14 @@ SQLiteDBEngine::SQLiteDBEngine(const std::shared_ptr<ISQLiteFactory>& sqliteFact
                                const std::string&                     tableStmtCreation,
                                const DbManagement                     dbManagement,
                                const std::vector<std::string>&        upgradeStatements)
-    : m_sqliteFactory(sqliteFactory)
+    : m_statementsStats { 0ull, 0ull }
+    , m_sqliteFactory(sqliteFactory)
+    , m_hasRelationships { false }
+    , m_path { path }
+    , m_concurrentReads { 0 != path.compare(DB_MEMORY) }
+    , m_activeRowWrites { 0 }
+    , m_unpublishedRows { false }
+    , m_publishRequested { false }
 {
     initialize(path, tableStmtCreation, dbManagement, upgradeStatements);
 }
@@ -34,6 +41,7 @@ SQLiteDBEngine::SQLiteDBEngine(const std::shared_ptr<ISQLiteFactory>& sqliteFact
 SQLiteDBEngine::~SQLiteDBEngine()
 {
     std::lock_guard<std::mutex> lock(m_stmtMutex);
+    m_statementsLru.clear();
     m_statementsCache.clear();
 
     if (m_transaction)
@@ -88,13 +96,13 @@ void SQLiteDBEngine::setMaxRows(const std::string& table,
 void SQLiteDBEngine::bulkInsert(const std::string& table,
                                 const nlohmann::json& data)
 {
-    if (0 != loadTableData(table))
-    {
-        const auto& tableFieldsMetaData { m_tableFields[table] };
+    const auto schema { tableSchema(table) };
 
+    if (schema)
+    {
         for (const auto& element : data)
         {
-            insertElement(table, tableFieldsMetaData, element);
+            insertElement(table, *schema, element);
         }
     }
     else
@@ -108,6 +116,7 @@ void SQLiteDBEngine::refreshTableData(const nlohmann::json& data,
                                       std::unique_lock<std::shared_timed_mutex>& lock)
 {
     const std::string table { data.at("table").is_string() ? data.at("table").get_ref<const std::string&>() : "" };
+    invalidateRowDigests(table);
 
     if (createCopyTempTable(table))
     {
@@ -156,7 +165,7 @@ void SQLiteDBEngine::syncTableRowData(const nlohmann::json& jsInput,
                                       const bool inTransaction,
                                       Utils::ILocking& lock)
 {
-    const auto& table { jsInput.at("table") };
+    const auto& table { jsInput.at("table").get_ref<const std::string&>() };
     const auto& data { jsInput.at("data") };
 
     auto it { jsInput.find("options") };
@@ -180,102 +189,83 @@ void SQLiteDBEngine::syncTableRowData(const nlohmann::json& jsInput,
         }
     }
 
-    static const auto getDataToUpdate
+    // The schema is taken once for the whole batch, every row is synced against the same snapshot.
+    const auto schema { tableSchema(table) };
+
+    if (schema)
     {
-        [](const std::vector<std::string>& primaryKeyList,
-           const nlohmann::json & result,
-           const nlohmann::json & dataParam,
-           const bool inTransactionParam)
+        for (const auto& entry : data)
         {
-            nlohmann::json ret;
+            nlohmann::json updated;
+            nlohmann::json oldData;
+            const auto digest { rowDigest(*schema, entry) };
 
-            if (inTransactionParam)
+            // A row with the same digest as when it was last synced exists and is not modified.
+            const bool unchanged { isRowUnchanged(table, digest) };
+            const bool diffExist { unchanged || getRowDiff(*schema, ignoredColumns, table, entry, updated, oldData) };
+
+            if (diffExist)
             {
-                // No changes detected, only update the status field to avoid row deletion during the txn close.
-                if (result.empty())
+                if (!updated.empty())
                 {
-                    std::for_each(primaryKeyList.begin(),
-                                  primaryKeyList.end(),
-                                  [&dataParam, &ret](const std::string & pKey)
-                    {
-                        if (dataParam.find(pKey) != dataParam.end())
-                        {
-                            ret[pKey] = dataParam[pKey];
-                        }
-                    });
+                    updateSingleRow(table, *schema, updated);
                 }
-                else // Changes detected, update the row with the new values.
+
+                // The digest has to match the stored row. A diff only found in ignored columns is not written, so the
+                // incoming row may differ from the stored one and its digest is dropped.
+                if (unchanged || !updated.empty() || ignoredColumns.empty())
+                {
+                    updateRowDigest(table, digest);
+                }
+                else
                 {
-                    ret = result;
+                    eraseRowDigest(table, digest);
                 }
 
-                ret[STATUS_FIELD_NAME] = 1;
-            }
-            else if (!result.empty())
-            {
-                ret = result;
-            }
+                if (callback && !updated.empty())
+                {
+                    lock.unlock();
 
-            return ret;
-        }
-    };
-    std::vector<std::string> primaryKeyList;
+                    if (returnOldData)
+                    {
+                        nlohmann::json diff;
+                        diff["old"] = oldData;
+                        diff["new"] = updated;
+                        callback(MODIFIED, diff);
+                    }
+                    else
+                    {
+                        callback(MODIFIED, updated);
+                    }
 
-    if (0 != loadTableData(table))
-    {
-        if (getPrimaryKeysFromTable(table, primaryKeyList))
-        {
-            for (const auto& entry : data)
+                    lock.lock();
+                }
+            }
+            else
             {
-                nlohmann::json updated;
-                nlohmann::json oldData;
-                const bool diffExist { getRowDiff(primaryKeyList, ignoredColumns, table, entry, updated, oldData) };
-
-                if (diffExist)
+                insertElement(table, *schema, entry,
+                              [&]()
                 {
-                    const auto& jsDataToUpdate{getDataToUpdate(primaryKeyList, updated, entry, inTransaction)};
+                    updateRowDigest(table, digest);
 
-                    if (!jsDataToUpdate.empty())
+                    // LCOV_EXCL_START
+                    if (callback)
                     {
-                        updateSingleRow(table, jsDataToUpdate);
-
-                        if (callback && !updated.empty())
-                        {
-
-                            lock.unlock();
+                        lock.unlock();
+                        callback(INSERTED, entry);
+                        lock.lock();
+                    }
 
-                            if (returnOldData)
-                            {
-                                nlohmann::json diff;
-                                diff["old"] = oldData;
-                                diff["new"] = updated;
-                                callback(MODIFIED, diff);
-                            }
-                            else
-                            {
-                                callback(MODIFIED, updated);
-                            }
+                    // LCOV_EXCL_STOP
+                });
+            }
 
-                            lock.lock();
-                        }
-                    }
-                }
-                else
-                {
-                    insertElement(table, m_tableFields[table], entry,
-                                  [&]()
-                    {
-                        // LCOV_EXCL_START
-                        if (callback)
-                        {
-                            lock.unlock();
-                            callback(INSERTED, entry);
-                            lock.lock();
-                        }
 
-                        // LCOV_EXCL_STOP
-                    });
-                }
+            // Unchanged rows are not written, they are only kept from being deleted when the txn closes.
+            // Inserted rows are kept by the insert trigger of the txn.
+            if (inTransaction && diffExist)
+            {
+                markRowSeen(table, *schema, entry);
             }
         }
     }
@@ -290,50 +280,83 @@ void SQLiteDBEngine::initializeStatusField(const nlohmann::json& tableNames)
     for (const auto& tableValue : tableNames)
     {
         const auto table { tableValue.get<std::string>() };
+        const auto schema { tableSchema(table) };
 
-        if (0 != loadTableData(table))
+        if (schema)
         {
-            const auto& fields { m_tableFields[table] };
-            const auto& it { std::find_if(fields.begin(),
-                                          fields.end(),
-                                          [](const ColumnData & column)
+            if (schema->primaryKeys.empty())
             {
-                return 0 == std::get<Name>(column).compare(STATUS_FIELD_NAME);
-            })};
+                throw dbengine_error { SQL_STMT_ERROR };
+            }
+
+            // The primary keys of the rows synced or inserted in the txn are kept in a temp table, held in memory.
+            std::string primaryKeys;
+            std::string newPrimaryKeys;
 
-            if (fields.end() == it)
+            for (const auto& pkValue : schema->primaryKeys)
             {
-                m_tableFields.erase(table);
-                const auto stmtAdd { getStatement("ALTER TABLE " +
-                                                  table +
-                                                  " ADD COLUMN " +
-                                                  STATUS_FIELD_NAME +
-                                                  " " +
-                                                  STATUS_FIELD_TYPE +
-                                                  " DEFAULT 1;")};
+                primaryKeys.append(pkValue + ",");
+                newPrimaryKeys.append("NEW." + pkValue + ",");
+            }
 
-                // LCOV_EXCL_START
-                if (SQLITE_ERROR == stmtAdd->step())
-                {
-                    throw dbengine_error{ STEP_ERROR_UPDATE_STATUS_FIELD };
-                }
+            primaryKeys = primaryKeys.substr(0, primaryKeys.size() - 1);
+            newPrimaryKeys = newPrimaryKeys.substr(0, newPrimaryKeys.size() - 1);
 
-                // LCOV_EXCL_STOP
+            const auto stmtAdd { getStatement("CREATE TEMP TABLE IF NOT EXISTS " +
+                                              table +
+                                              SEEN_TABLE_SUBFIX +
+                                              "(" +
+                                              primaryKeys +
+                                              ", PRIMARY KEY (" +
+                                              primaryKeys +
+                                              ")) WITHOUT ROWID;")};
+
+            // LCOV_EXCL_START
+            if (SQLITE_ERROR == stmtAdd->step())
+            {
+                throw dbengine_error{ STEP_ERROR_ADD_STATUS_FIELD };
+            }
+
+            // LCOV_EXCL_STOP
+
+            const auto stmtTrigger { getStatement("CREATE TEMP TRIGGER IF NOT EXISTS " +
+                                                  table +
+                                                  SEEN_TABLE_SUBFIX +
+                                                  "_INSERT AFTER INSERT ON main." +
+                                                  table +
+                                                  " BEGIN INSERT OR IGNORE INTO " +
+                                                  table +
+                                                  SEEN_TABLE_SUBFIX +
+                                                  " (" +
+                                                  primaryKeys +
+                                                  ") VALUES (" +
+                                                  newPrimaryKeys +
+                                                  "); END;")};
+
+            // LCOV_EXCL_START
+            if (SQLITE_ERROR == stmtTrigger->step())
+            {
+                throw dbengine_error{ STEP_ERROR_ADD_STATUS_FIELD };
             }
 
-            const auto& stmtInit { getStatement("UPDATE " +
+            // LCOV_EXCL_STOP
+
+            const auto& stmtInit { getStatement("DELETE FROM temp." +
                                                 table +
-                                                " SET " +
-                                                STATUS_FIELD_NAME +
-                                                "=0;")};
+                                                SEEN_TABLE_SUBFIX +
+                                                ";")};
 
             // LCOV_EXCL_START
             if (SQLITE_ERROR == stmtInit->step())
             {
-                throw dbengine_error{ STEP_ERROR_ADD_STATUS_FIELD };
+                throw dbengine_error{ STEP_ERROR_UPDATE_STATUS_FIELD };
             }
 
             // LCOV_EXCL_STOP
+
+            // Rows synced from now on belong to a new generation, the others are deleted when the txn closes.
+            std::lock_guard<std::mutex> lock(m_rowDigestsMutex);
+            ++m_rowDigests[table].generation;
         }
         else
         {
@@ -348,13 +371,14 @@ void SQLiteDBEngine::deleteRowsByStatusField(const nlohmann::json& tableNames)
     {
         const auto table { tableValue.get<std::string>() };
 
-        if (0 != loadTableData(table))
+        const auto schema { tableSchema(table) };
+
+        if (schema)
         {
+            // A single statement deletes every row not synced in the txn.
             const auto stmt { getStatement("DELETE FROM " +
                                            table +
-                                           " WHERE " +
-                                           STATUS_FIELD_NAME +
-                                           "=0;")};
+                                           buildNotSeenFilter(table, *schema))};
 
             // LCOV_EXCL_START
             if (SQLITE_ERROR == stmt->step())
@@ -364,7 +388,35 @@ void SQLiteDBEngine::deleteRowsByStatusField(const nlohmann::json& tableNames)
 
             // LCOV_EXCL_STOP
 
-            updateTableRowCounter(table, m_sqliteConnection->changes() * -1ll);
+            const auto deletedRows { m_sqliteConnection->changes() };
+            removeStaleRowDigests(table, deletedRows);
+            updateTableRowCounter(table, deletedRows * -1ll);
+
+            const auto stmtDrop { getStatement("DROP TRIGGER IF EXISTS temp." +
+                                               table +
+                                               SEEN_TABLE_SUBFIX +
+                                               "_INSERT;")};
+
+            // LCOV_EXCL_START
+            if (SQLITE_ERROR == stmtDrop->step())
+            {
+                throw dbengine_error{ STEP_ERROR_DELETE_STATUS_FIELD };
+            }
+
+            // LCOV_EXCL_STOP
+
+            const auto stmtClear { getStatement("DELETE FROM temp." +
+                                                table +
+                                                SEEN_TABLE_SUBFIX +
+                                                ";")};
+
+            // LCOV_EXCL_START
+            if (SQLITE_ERROR == stmtClear->step())
+            {
+                throw dbengine_error{ STEP_ERROR_DELETE_STATUS_FIELD };
+            }
+
+            // LCOV_EXCL_STOP
         }
         else
         {
@@ -387,36 +439,28 @@ void SQLiteDBEngine::returnRowsMarkedForDelete(const nlohmann::json& tableNames,
     {
         const auto& table { tableValue.get<std::string>() };
 
-        if (0 != loadTableData(table))
+        const auto schema { tableSchema(table) };
+
+        if (schema)
         {
-            auto tableFields { m_tableFields[table] };
-            const auto stmt { getStatement(getSelectAllQuery(table, tableFields)) };
+            const auto stmt { getStatement(getSelectAllQuery(table, *schema)) };
 
             while (SQLITE_ROW == stmt->step())
             {
-                Row registerFields;
-                auto index { 0 };
+                TypedRow row(schema->columns.size());
 
-                for (const auto& field : tableFields)
+                for (size_t index = 0; index < schema->columns.size(); ++index)
                 {
+                    const auto& field { schema->columns[index] };
+
                     if (!std::get<TableHeader::TXNStatusField>(field))
                     {
-                        getTableData(stmt,
-                                     index,
-                                     std::get<TableHeader::Type>(field),
-                                     std::get<TableHeader::Name>(field),
-                                     registerFields);
+                        row[index] = getColumnValue(stmt, index, std::get<TableHeader::Type>(field));
                     }
-
-                    ++index;
                 }
 
                 nlohmann::json object {};
-
-                for (const auto& value : registerFields)
-                {
-                    getFieldValueFromTuple(value, object);
-                }
+                getRowObject(*schema, row, object);
 
                 lock.unlock();
                 callback(ReturnTypeCallback::DELETED, object);
@@ -433,52 +477,66 @@ void SQLiteDBEngine::returnRowsMarkedForDelete(const nlohmann::json& tableNames,
 void SQLiteDBEngine::selectData(const std::string& table,
                                 const nlohmann::json& query,
                                 const DbSync::ResultCallback& callback,
-                                std::unique_lock<std::shared_timed_mutex>& lock)
+                                Utils::ILocking& lock)
 {
     if (0 != loadTableData(table))
     {
-        const auto& stmt { m_sqliteFactory->createStatement(m_sqliteConnection, buildSelectQuery(table, query)) };
+        if (m_concurrentReads)
+        {
+            publishRowWrites();
+        }
+
+        auto connection { m_concurrentReads ? acquireReader() : m_sqliteConnection };
 
-        while (SQLITE_ROW == stmt->step())
         {
-            nlohmann::json object;
+            const auto& stmt { m_sqliteFactory->createStatement(connection, buildSelectQuery(table, query)) };
 
-            for (int i = 0; i < stmt->columnsCount(); ++i)
+            while (SQLITE_ROW == stmt->step())
             {
-                const auto& column{ stmt->column(i) };
-                const auto& name{ column->name() };
+                nlohmann::json object;
 
-                if (column->hasValue() && name != STATUS_FIELD_NAME)
+                for (int i = 0; i < stmt->columnsCount(); ++i)
                 {
-                    switch (column->type())
+                    const auto& column{ stmt->column(i) };
+                    const auto& name{ column->name() };
+
+                    if (column->hasValue() && name != STATUS_FIELD_NAME)
                     {
-                        case SQLITE_TEXT:
-                            object[name] = column->value(std::string{});
-                            break;
-
-                        case SQLITE_INTEGER:
-                            object[name] = column->value(int64_t{});
-                            break;
-
-                        case SQLITE_FLOAT:
-                            object[name] = column->value(double_t{});
-                            break;
-
-                        // LCOV_EXCL_START
-                        default:
-                            throw dbengine_error{INVALID_COLUMN_TYPE};
-                            // LCOV_EXCL_STOP
+                        switch (column->type())
+                        {
+                            case SQLITE_TEXT:
+                                object[name] = column->value(std::string{});
+                                break;
+
+                            case SQLITE_INTEGER:
+                                object[name] = column->value(int64_t{});
+                                break;
+
+                            case SQLITE_FLOAT:
+                                object[name] = column->value(double_t{});
+                                break;
+
+                            // LCOV_EXCL_START
+                            default:
+                                throw dbengine_error{INVALID_COLUMN_TYPE};
+                                // LCOV_EXCL_STOP
+                        }
                     }
                 }
-            }
 
-            if (callback && !object.empty())
-            {
-                lock.unlock();
-                callback(SELECTED, object);
-                lock.lock();
+                if (callback && !object.empty())
+                {
+                    lock.unlock();
+                    callback(SELECTED, object);
+                    lock.lock();
+                }
             }
         }
+
+        if (m_concurrentReads)
+        {
+            releaseReader(connection);
+        }
     }
     else
     {
@@ -486,29 +544,128 @@ void SQLiteDBEngine::selectData(const std::string& table,
     }
 }
 
+bool SQLiteDBEngine::concurrentReads() const
+{
+    return m_concurrentReads;
+}
+
+void SQLiteDBEngine::publishWrites()
+{
+    if (m_concurrentReads)
+    {
+        std::lock_guard<std::mutex> lock(m_transactionMutex);
+        commitTransaction();
+    }
+}
+
+void SQLiteDBEngine::beginRowWrite()
+{
+    if (m_concurrentReads)
+    {
+        std::lock_guard<std::mutex> lock(m_transactionMutex);
+        ++m_activeRowWrites;
+    }
+}
+
+void SQLiteDBEngine::endRowWrite()
+{
+    if (m_concurrentReads)
+    {
+        std::lock_guard<std::mutex> lock(m_transactionMutex);
+        --m_activeRowWrites;
+        m_unpublishedRows = true;
+
+        // A reader found other row syncs in progress, so the last one to end publishes the rows for the next read.
+        if (m_publishRequested && 0 == m_activeRowWrites)
+        {
+            commitTransaction();
+        }
+    }
+}
+
+void SQLiteDBEngine::publishRowWrites()
+{
+    // The row syncs are not committed one by one, so a reader commits the ones that ended before it reads.
+    // A row sync still in progress is not committed halfway, the reader only sees the rows committed before it.
+    std::lock_guard<std::mutex> lock(m_transactionMutex);
+
+    if (m_unpublishedRows)
+    {
+        if (0 == m_activeRowWrites)
+        {
+            commitTransaction();
+        }
+        else
+        {
+            m_publishRequested = true;
+        }
+    }
+}
+
+void SQLiteDBEngine::commitTransaction()
+{
+    // Txn syncs share the sync lock, so the open transaction is swapped under m_transactionMutex.
+    if (m_transaction)
+    {
+        m_transaction->commit();
+        m_transaction = m_sqliteFactory->createTransaction(m_sqliteConnection);
+    }
+
+    m_unpublishedRows = false;
+    m_publishRequested = false;
+}
+
 void SQLiteDBEngine::deleteTableRowsData(const std::string&    table,
-                                         const nlohmann::json& jsDeletionData)
+                                         const nlohmann::json& jsDeletionData,
+                                         const DbSync::ResultCallback callback,
+                                         std::unique_lock<std::shared_timed_mutex>& lock)
 {
     if (0 != loadTableData(table))
     {
+        invalidateRowDigests(table);
         const auto& itData{ jsDeletionData.find("data")};
         const auto& itFilter{ jsDeletionData.find("where_filter_opt")};
+        std::vector<nlohmann::json> deletedRows;
 
         if (itData != jsDeletionData.end() && itData->size() > 0)
         {
             // Deletion via primary keys on "data" json field.
-            deleteRowsbyPK(table, itData.value());
+            deleteRowsbyPK(table, itData.value(), callback ? &deletedRows : nullptr);
         }
         else if (itFilter != jsDeletionData.end() && !itFilter->get<std::string>().empty())
         {
             // Deletion via condition on "where_filter_opt" json field.
-            m_sqliteConnection->execute("DELETE FROM " + table + " WHERE " + itFilter->get<std::string>());
+            const auto sql { "DELETE FROM " + table + " WHERE " + itFilter->get<std::string>() };
+            const auto schema { tableSchema(table) };
+
+            if (callback && schema)
+            {
+                const std::shared_ptr<SQLiteLegacy::IStatement> stmt { m_sqliteFactory->createStatement(m_sqliteConnection, sql + buildReturningClause(*schema) + ";") };
+                getReturnedRows(stmt, *schema, deletedRows);
+            }
+            else
+            {
+                m_sqliteConnection->execute(sql);
+            }
+
             updateTableRowCounter(table, m_sqliteConnection->changes() * -1ll);
         }
         else
         {
             throw dbengine_error{ INVALID_DELETE_INFO };
         }
+
+        if (!deletedRows.empty())
+        {
+            lock.unlock();
+
+            for (const auto& row : deletedRows)
+            {
+                callback(DELETED, row);
+            }
+
+            lock.lock();
+        }
     }
     else
     {
@@ -528,6 +685,10 @@ void SQLiteDBEngine::addTableRelationship(const nlohmann::json& data)
         {
             m_sqliteConnection->execute(buildDeleteRelationTrigger(data, baseTable));
             m_sqliteConnection->execute(buildUpdateRelationTrigger(data, baseTable, primaryKeys));
+
+            // Deletions now cascade to other tables, whose row digests can no longer be trusted.
+            std::lock_guard<std::mutex> lock(m_rowDigestsMutex);
+            m_hasRelationships = true;
         }
     }
     else
@@ -536,72 +697,307 @@ void SQLiteDBEngine::addTableRelationship(const nlohmann::json& data)
     }
 }
 
-///
-/// Private functions section
-///
-
-void SQLiteDBEngine::initialize(const std::string&              path,
-                                const std::string&              tableStmtCreation,
-                                const DbManagement              dbManagement,
-                                const std::vector<std::string>& upgradeStatements)
+void SQLiteDBEngine::initializeSnapshot(const nlohmann::json& tableNames)
 {
-    if (path.empty())
+    for (const auto& tableValue : tableNames)
     {
-        throw dbengine_error {EMPTY_DATABASE_PATH};
-    }
-
-    auto currentDbsyncVersion = upgradeStatements.size() + 1;
+        const auto table { tableValue.get<std::string>() };
+        const auto schema { tableSchema(table) };
 
-    auto reCreateDbLambda = [&]()
-    {
-        if (!cleanDB(path))
+        if (!schema || schema->primaryKeys.empty() || !createCopyTempTable(table))
         {
-            throw dbengine_error {DELETE_OLD_DB_ERROR};
+            throw dbengine_error { EMPTY_TABLE_METADATA };
         }
 
-        m_sqliteConnection = m_sqliteFactory->createConnection(path);
-        const auto createDBQueryList {Utils::split(tableStmtCreation, ';')};
-        m_sqliteConnection->execute("PRAGMA temp_store = memory;");
-        m_sqliteConnection->execute("PRAGMA journal_mode = truncate;");
-        m_sqliteConnection->execute("PRAGMA synchronous = OFF;");
-        m_sqliteConnection->execute("PRAGMA user_version = " + std::to_string(currentDbsyncVersion) + ";");
+        // The results of the snapshot are staged in a temp table, together with the old values of the modified rows.
+        std::string columns;
+        std::string oldColumns;
 
-        for (const auto& query : createDBQueryList)
+        for (const auto& field : schema->columns)
         {
-            const auto stmt {getStatement(query)};
-
-            if (SQLITE_DONE != stmt->step())
+            if (!std::get<TableHeader::TXNStatusField>(field))
             {
-                throw dbengine_error {STEP_ERROR_CREATE_STMT};
+                columns.append(std::get<TableHeader::Name>(field) + ",");
+                oldColumns.append(DIFF_OLD_FIELD_PREFIX + std::get<TableHeader::Name>(field) + ",");
             }
         }
 
-        m_transaction = m_sqliteFactory->createTransaction(m_sqliteConnection);
-    };
-
-    size_t dbVersion = 0;
+        oldColumns = oldColumns.substr(0, oldColumns.size() - 1);
 
-    if (DbManagement::PERSISTENT == dbManagement)
-    {
-        m_sqliteConnection = m_sqliteFactory->createConnection(path);
-        dbVersion = getDbVersion();
+        executeStatement("CREATE TEMP TABLE IF NOT EXISTS " +
+                         table +
+                         DIFF_TABLE_SUBFIX +
+                         "(" +
+                         DIFF_OPERATION_FIELD_NAME +
+                         "," +
+                         columns +
+                         oldColumns +
+                         ");",
+                         STEP_ERROR_CREATE_STMT);
+        executeStatement("DELETE FROM temp." + table + DIFF_TABLE_SUBFIX + ";", STEP_ERROR_CREATE_STMT);
+    }
+}
 
-        if (0 == dbVersion)
-        {
-            m_sqliteConnection.reset();
-            reCreateDbLambda();
-        }
+void SQLiteDBEngine::appendSnapshotData(const std::string& table,
+                                        const nlohmann::json& data)
+{
+    const auto tempTable { table + TEMP_TABLE_SUBFIX };
+    const auto schema { tableSchema(tempTable) };
 
-        else if (dbVersion < currentDbsyncVersion)
+    if (schema)
+    {
+        for (const auto& element : data)
         {
-            for (size_t i = dbVersion - 1; i < upgradeStatements.size(); ++i)
+            // The last copy of a row wins, as a snapshot holds a single copy of each row.
+            const auto stmt
             {
-                auto transaction = m_sqliteFactory->createTransaction(m_sqliteConnection);
-                const auto stmt {m_sqliteFactory->createStatement(m_sqliteConnection, upgradeStatements[i])};
+                getStatement({ tempTable, StatementType::InsertSnapshot, columnsMask(*schema, element) }, [&]()
+                {
+                    auto sql { buildInsertDataSqlQuery(tempTable, *schema, element) };
+                    Utils::replaceFirst(sql, "INSERT INTO", "INSERT OR REPLACE INTO");
+                    return sql;
+                })
+            };
+            int32_t index { 1l };
 
-                if (SQLITE_DONE != stmt->step())
+            for (const auto& field : schema->columns)
+            {
+                if (bindJsonData(stmt, field, element, index))
                 {
-                    throw dbengine_error {STEP_ERROR_UPDATE_STMT};
+                    ++index;
+                }
+            }
+
+            // LCOV_EXCL_START
+            if (SQLITE_ERROR == stmt->step())
+            {
+                throw dbengine_error{ BIND_FIELDS_DOES_NOT_MATCH };
+            }
+
+            // LCOV_EXCL_STOP
+        }
+    }
+    else
+    {
+        throw dbengine_error { EMPTY_TABLE_METADATA };
+    }
+}
+
+void SQLiteDBEngine::applySnapshot(const std::string& table,
+                                   const nlohmann::json& options,
+                                   const DbSync::ResultCallback changesCallback,
+                                   const DbSync::ResultCallback deletedCallback,
+                                   std::unique_lock<std::shared_timed_mutex>& lock)
+{
+    const auto schema { tableSchema(table) };
+
+    if (!schema || schema->primaryKeys.empty())
+    {
+        throw dbengine_error { EMPTY_TABLE_METADATA };
+    }
+
+    const auto returnOldData { options.contains("return_old_data") && options.at("return_old_data").is_boolean() && options.at("return_old_data").get<bool>() };
+    const auto ignoredColumns { options.contains("ignore") && options.at("ignore").is_array() ? options.at("ignore") : nlohmann::json::array() };
+    // A partial snapshot keeps the rows it does not have.
+    const auto keepUnseen { options.contains("keep_unseen") && options.at("keep_unseen").is_boolean() && options.at("keep_unseen").get<bool>() };
+    const auto tempTable { "temp." + table + TEMP_TABLE_SUBFIX };
+    const auto diffTable { "temp." + table + DIFF_TABLE_SUBFIX };
+
+    std::string columns;
+    std::string newColumns;
+    std::string oldColumns;
+    std::string updateColumns;
+    std::string updateValues;
+    std::string modifiedFilter;
+    std::string tableMatch;
+    std::string deleteMatch;
+    std::string diffMatch;
+
+    for (const auto& field : schema->columns)
+    {
+        const auto& name { std::get<TableHeader::Name>(field) };
+
+        if (!std::get<TableHeader::TXNStatusField>(field))
+        {
+            columns.append(name + ",");
+            newColumns.append("s." + name + ",");
+            oldColumns.append("t." + name + ",");
+
+            if (std::get<TableHeader::PK>(field))
+            {
+                tableMatch.append("s." + name + "=t." + name + " AND ");
+                deleteMatch.append("s." + name + "=" + table + "." + name + " AND ");
+                diffMatch.append("d." + name + "=" + table + "." + name + " AND ");
+            }
+            else
+            {
+                updateColumns.append(name + ",");
+                updateValues.append("d." + name + ",");
+
+                if (std::find(ignoredColumns.begin(), ignoredColumns.end(), name) == ignoredColumns.end())
+                {
+                    modifiedFilter.append("s." + name + " IS NOT t." + name + " OR ");
+                }
+            }
+        }
+    }
+
+    columns = columns.substr(0, columns.size() - 1);
+    newColumns = newColumns.substr(0, newColumns.size() - 1);
+    oldColumns = oldColumns.substr(0, oldColumns.size() - 1);
+    tableMatch = tableMatch.substr(0, tableMatch.size() - 5);
+    deleteMatch = deleteMatch.substr(0, deleteMatch.size() - 5);
+    diffMatch = diffMatch.substr(0, diffMatch.size() - 5);
+
+    std::string diffColumns { DIFF_OPERATION_FIELD_NAME };
+    diffColumns.append("," + columns);
+    const auto diffInsert { "INSERT INTO " + diffTable + " (" + diffColumns };
+    const auto notInSnapshot { " WHERE NOT EXISTS (SELECT 1 FROM " + tempTable + " s WHERE " + tableMatch + ");" };
+
+    // The three result sets are staged before the table is changed.
+    executeStatement("DELETE FROM " + diffTable + ";", STEP_ERROR_UPDATE_STMT);
+
+    if (!keepUnseen)
+    {
+        executeStatement(diffInsert + ") SELECT " + std::to_string(DELETED) + "," + oldColumns + " FROM " + table + " t" + notInSnapshot,
+                         STEP_ERROR_UPDATE_STMT);
+    }
+
+    if (!modifiedFilter.empty())
+    {
+        std::string diffOldColumns;
+
+        for (const auto& field : schema->columns)
+        {
+            if (!std::get<TableHeader::TXNStatusField>(field))
+            {
+                diffOldColumns.append(std::string{ "," } + DIFF_OLD_FIELD_PREFIX + std::get<TableHeader::Name>(field));
+            }
+        }
+
+        modifiedFilter = modifiedFilter.substr(0, modifiedFilter.size() - 4);
+        executeStatement(diffInsert + diffOldColumns + ") SELECT " + std::to_string(MODIFIED) + "," + newColumns + "," + oldColumns +
+                         " FROM " + tempTable + " s INNER JOIN " + table + " t ON " + tableMatch + " WHERE " + modifiedFilter + ";",
+                         STEP_ERROR_UPDATE_STMT);
+    }
+
+    executeStatement(diffInsert + ") SELECT " + std::to_string(INSERTED) + "," + newColumns + " FROM " + tempTable +
+                     " s WHERE NOT EXISTS (SELECT 1 FROM " + table + " t WHERE " + tableMatch + ");",
+                     STEP_ERROR_UPDATE_STMT);
+
+    // Then each result set is applied to the table with a single statement.
+    if (!keepUnseen)
+    {
+        const auto deletedRows { executeStatement("DELETE FROM " + table + " WHERE NOT EXISTS (SELECT 1 FROM " + tempTable + " s WHERE " +
+                                                  deleteMatch + ");",
+                                                  STEP_ERROR_DELETE_STATUS_FIELD) };
+        updateTableRowCounter(table, deletedRows * -1ll);
+    }
+
+    if (!updateColumns.empty())
+    {
+        updateColumns = updateColumns.substr(0, updateColumns.size() - 1);
+        updateValues = updateValues.substr(0, updateValues.size() - 1);
+        // The staged rows drive the update, so each modified row is looked up by its primary key.
+        executeStatement("UPDATE " + table + " SET (" + updateColumns + ")=(" + updateValues + ") FROM " + diffTable + " d WHERE d." +
+                         DIFF_OPERATION_FIELD_NAME + "=" + std::to_string(MODIFIED) + " AND " + diffMatch + ";",
+                         STEP_ERROR_UPDATE_STATUS_FIELD);
+    }
+
+    // Rows over the limit of the table are not inserted, and are reported as such.
+    const auto available { availableRows(table) };
+
+    if (available >= 0)
+    {
+        executeStatement("UPDATE " + diffTable + " SET " + DIFF_OPERATION_FIELD_NAME + "=" + std::to_string(MAX_ROWS) + " WHERE rowid IN (SELECT rowid FROM " +
+                         diffTable + " WHERE " + DIFF_OPERATION_FIELD_NAME + "=" + std::to_string(INSERTED) + " ORDER BY rowid LIMIT -1 OFFSET " +
+                         std::to_string(available) + ");",
+                         STEP_ERROR_UPDATE_STMT);
+    }
+
+    const auto insertedRows { executeStatement("INSERT INTO " + table + " (" + columns + ") SELECT " + columns + " FROM " + diffTable + " WHERE " +
+                                               DIFF_OPERATION_FIELD_NAME + "=" + std::to_string(INSERTED) + ";",
+                                               STEP_ERROR_ADD_STATUS_FIELD) };
+    updateTableRowCounter(table, insertedRows);
+
+    executeStatement("DELETE FROM " + tempTable + ";", STEP_ERROR_UPDATE_STMT);
+    invalidateRowDigests(table);
+
+    emitSnapshotChanges(table, *schema, returnOldData, changesCallback, deletedCallback, lock);
+}
+
+///
+/// Private functions section
+///
+
+void SQLiteDBEngine::initialize(const std::string&              path,
+                                const std::string&              tableStmtCreation,
+                                const DbManagement              dbManagement,
+                                const std::vector<std::string>& upgradeStatements)
+{
+    if (path.empty())
+    {
+        throw dbengine_error {EMPTY_DATABASE_PATH};
+    }
+
+    auto currentDbsyncVersion = upgradeStatements.size() + 1;
+
+    auto reCreateDbLambda = [&]()
+    {
+        if (!cleanDB(path))
+        {
+            throw dbengine_error {DELETE_OLD_DB_ERROR};
+        }
+
+        m_sqliteConnection = m_sqliteFactory->createConnection(path);
+        const auto createDBQueryList {Utils::split(tableStmtCreation, ';')};
+        m_sqliteConnection->execute("PRAGMA temp_store = memory;");
+        m_sqliteConnection->execute(m_concurrentReads ? "PRAGMA journal_mode = WAL;" : "PRAGMA journal_mode = truncate;");
+        m_sqliteConnection->execute("PRAGMA synchronous = OFF;");
+        m_sqliteConnection->execute("PRAGMA user_version = " + std::to_string(currentDbsyncVersion) + ";");
+
+        for (const auto& query : createDBQueryList)
+        {
+            const auto stmt {getStatement(query)};
+
+            if (SQLITE_DONE != stmt->step())
+            {
+                throw dbengine_error {STEP_ERROR_CREATE_STMT};
+            }
+        }
+
+        m_transaction = m_sqliteFactory->createTransaction(m_sqliteConnection);
+    };
+
+    size_t dbVersion = 0;
+
+    if (DbManagement::PERSISTENT == dbManagement)
+    {
+        m_sqliteConnection = m_sqliteFactory->createConnection(path);
+
+        if (m_concurrentReads)
+        {
+            m_sqliteConnection->execute("PRAGMA journal_mode = WAL;");
+        }
+
+        dbVersion = getDbVersion();
+
+        if (0 == dbVersion)
+        {
+            m_sqliteConnection.reset();
+            reCreateDbLambda();
+        }
+
+        else if (dbVersion < currentDbsyncVersion)
+        {
+            for (size_t i = dbVersion - 1; i < upgradeStatements.size(); ++i)
+            {
+                auto transaction = m_sqliteFactory->createTransaction(m_sqliteConnection);
+                const auto stmt {m_sqliteFactory->createStatement(m_sqliteConnection, upgradeStatements[i])};
+
+                if (SQLITE_DONE != stmt->step())
+                {
+                    throw dbengine_error {STEP_ERROR_UPDATE_STMT};
                 }
 
                 transaction->commit();
@@ -624,6 +1020,10 @@ bool SQLiteDBEngine::cleanDB(const std::string& path)
 
     if (path.compare(":memory") != 0)
     {
+        // The WAL files of a previous run are not valid for the new database.
+        std::remove((path + "-wal").c_str());
+        std::remove((path + "-shm").c_str());
+
         if (std::ifstream(path))
         {
             isRemoved = std::remove(path.c_str());
@@ -645,6 +1045,34 @@ bool SQLiteDBEngine::cleanDB(const std::string& path)
     return ret;
 }
 
+std::shared_ptr<SQLiteLegacy::IConnection> SQLiteDBEngine::acquireReader()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_readersMutex);
+
+        if (!m_readers.empty())
+        {
+            auto reader { m_readers.back() };
+            m_readers.pop_back();
+            return reader;
+        }
+    }
+
+    auto reader { m_sqliteFactory->createConnection(m_path) };
+    reader->execute("PRAGMA query_only = ON;");
+    return reader;
+}
+
+void SQLiteDBEngine::releaseReader(const std::shared_ptr<SQLiteLegacy::IConnection>& reader)
+{
+    std::lock_guard<std::mutex> lock(m_readersMutex);
+
+    if (m_readers.size() < READ_CONNECTIONS_LIMIT)
+    {
+        m_readers.push_back(reader);
+    }
+}
+
 size_t SQLiteDBEngine::getDbVersion()
 {
     const auto stmt {m_sqliteFactory->createStatement(m_sqliteConnection, "PRAGMA user_version;")};
@@ -660,14 +1088,20 @@ size_t SQLiteDBEngine::getDbVersion()
 }
 
 void SQLiteDBEngine::insertElement(const std::string& table,
-                                   const TableColumns& tableFieldsMetaData,
+                                   const TableSchema& schema,
                                    const nlohmann::json& element,
                                    const std::function<void()> callback)
 {
-    const auto stmt { getStatement(buildInsertDataSqlQuery(table, element)) };
+    const auto stmt
+    {
+        getStatement({ table, StatementType::Insert, columnsMask(schema, element) }, [&]()
+        {
+            return buildInsertDataSqlQuery(table, schema, element);
+        })
+    };
     int32_t index { 1l };
 
-    for (const auto& field : tableFieldsMetaData)
+    for (const auto& field : schema.columns)
     {
         if (bindJsonData(stmt, field, element, index))
         {
@@ -693,25 +1127,25 @@ void SQLiteDBEngine::insertElement(const std::string& table,
 
 size_t SQLiteDBEngine::loadTableData(const std::string& table)
 {
-    size_t fieldsNumber { 0ull };
-    const auto& tableFields{ m_tableFields[table] };
+    const auto schema { tableSchema(table) };
 
-    if (0 == tableFields.size())
-    {
-        if (loadFieldData(table))
-        {
-            fieldsNumber = m_tableFields[table].size();
-        }
-    }
-    else
+    return schema ? schema->columns.size() : 0ull;
+}
+
+TableSchemaPtr SQLiteDBEngine::tableSchema(const std::string& table)
+{
+    auto schema { m_tableSchemas[table] };
+
+    if (!schema && loadFieldData(table))
     {
-        fieldsNumber = tableFields.size();
+        schema = m_tableSchemas[table];
     }
 
-    return fieldsNumber;
+    return schema;
 }
 
 std::string SQLiteDBEngine::buildInsertDataSqlQuery(const std::string& table,
+                                                    const TableSchema& schema,
                                                     const nlohmann::json& data)
 {
     //
@@ -721,11 +1155,9 @@ std::string SQLiteDBEngine::buildInsertDataSqlQuery(const std::string& table,
     std::string sql   {"INSERT INTO " + table + " ("};
     std::string binds {") VALUES ("};
 
-    const auto tableFields{ m_tableFields[table] };
-
-    if (!tableFields.empty())
+    if (!schema.columns.empty())
     {
-        for (const auto& field : tableFields)
+        for (const auto& field : schema.columns)
         {
             const auto& fieldName { std::get<TableHeader::Name>(field) };
 
@@ -762,21 +1194,37 @@ bool SQLiteDBEngine::loadFieldData(const std::string& table)
 
     if (ret)
     {
-        TableColumns fieldList;
+        auto schema { std::make_shared<TableSchema>() };
         auto stmt { m_sqliteFactory->createStatement(m_sqliteConnection, sql) };
 
         while (SQLITE_ROW == stmt->step())
         {
             const auto& fieldName { stmt->column(1)->value(std::string{}) };
-            fieldList.push_back(std::make_tuple(stmt->column(0)->value(int32_t{}),
-                                                fieldName,
-                                                columnTypeName(stmt->column(2)->value(std::string{})),
-                                                0 != stmt->column(5)->value(int32_t{}),
-                                                InternalColumnNames.end() != std::find(InternalColumnNames.begin(),
-                                                                                       InternalColumnNames.end(), fieldName)));
+            const auto isPrimaryKey { 0 != stmt->column(5)->value(int32_t{}) };
+
+            if (isPrimaryKey)
+            {
+                schema->primaryKeys.push_back(fieldName);
+                schema->primaryKeyIndexes.push_back(schema->columns.size());
+            }
+
+            schema->columnIndexes.emplace(fieldName, schema->columns.size());
+            schema->columns.push_back(std::make_tuple(stmt->column(0)->value(int32_t{}),
+                                                      fieldName,
+                                                      columnTypeName(stmt->column(2)->value(std::string{})),
+                                                      isPrimaryKey,
+                                                      InternalColumnNames.end() != std::find(InternalColumnNames.begin(),
+                                                                                             InternalColumnNames.end(), fieldName)));
         }
 
-        m_tableFields.insert(table, fieldList);
+        // Tables without columns are not cached, so they are looked up again.
+        if (!schema->columns.empty())
+        {
+            m_tableSchemas.insert(table, schema);
+
+            std::lock_guard<std::mutex> lock(m_stmtMutex);
+            m_statementsTables.insert(table);
+        }
     }
 
     return ret;
@@ -856,11 +1304,14 @@ bool SQLiteDBEngine::bindJsonData(const std::shared_ptr<SQLiteLegacy::IStatement
         }
         else if (ColumnType::Text == type)
         {
-            std::string value
+            if (jsData.is_string())
             {
-                jsData.is_string() ? jsData.get_ref<const std::string&>() : ""
-            };
-            stmt->bind(cid, value);
+                stmt->bind(cid, jsData.get_ref<const std::string&>());
+            }
+            else
+            {
+                stmt->bind(cid, std::string{});
+            }
         }
         else if (ColumnType::Double == type)
         {
@@ -948,20 +1399,17 @@ bool SQLiteDBEngine::removeNotExistsRows(const std::string& table,
                                          std::unique_lock<std::shared_timed_mutex>& lock)
 {
     auto ret { true };
-    std::vector<Row> rowKeysValue;
+    std::vector<TypedRow> rowKeysValue;
+    const auto schema { tableSchema(table) };
 
-    if (getPKListLeftOnly(table, table + TEMP_TABLE_SUBFIX, primaryKeyList, rowKeysValue))
+    if (schema && getPKListLeftOnly(table, table + TEMP_TABLE_SUBFIX, primaryKeyList, rowKeysValue))
     {
         if (deleteRows(table, primaryKeyList, rowKeysValue))
         {
             for (const auto& row : rowKeysValue)
             {
                 nlohmann::json object;
-
-                for (const auto& value : row)
-                {
-                    getFieldValueFromTuple(value, object);
-                }
+                getRowObject(*schema, row, object);
 
                 if (callback)
                 {
@@ -984,63 +1432,56 @@ bool SQLiteDBEngine::getPrimaryKeysFromTable(const std::string& table,
                                              std::vector<std::string>& primaryKeyList)
 {
     auto retVal { false };
-    const auto tableFields { m_tableFields[table] };
+    const auto schema { m_tableSchemas[table] };
 
-    for (const auto& value : tableFields)
+    if (schema)
     {
-        if (std::get<TableHeader::PK>(value) == true)
-        {
-            primaryKeyList.push_back(std::get<TableHeader::Name>(value));
-        }
-
+        primaryKeyList.insert(primaryKeyList.end(), schema->primaryKeys.begin(), schema->primaryKeys.end());
         retVal = true;
     }
 
     return retVal;
 }
 
-void SQLiteDBEngine::getTableData(std::shared_ptr<SQLiteLegacy::IStatement>const stmt,
-                                  const int32_t index,
-                                  const ColumnType& type,
-                                  const std::string& fieldName,
-                                  Row& row)
+ColumnValue SQLiteDBEngine::getColumnValue(std::shared_ptr<SQLiteLegacy::IStatement>const stmt,
+                                           const int32_t index,
+                                           const ColumnType& type)
 {
-    if (!stmt->column(index)->hasValue())
+    const auto column { stmt->column(index) };
+
+    if (!column->hasValue())
     {
-        row[fieldName] = std::make_tuple(type, std::nullopt, std::nullopt, std::nullopt, std::nullopt, std::nullopt);
-        return;
+        return nullptr;
     }
 
     if (ColumnType::BigInt == type)
     {
-        row[fieldName] = std::make_tuple(type, std::nullopt, std::nullopt, stmt->column(index)->value(int64_t{}), std::nullopt, std::nullopt);
+        return column->value(int64_t{});
     }
     else if (ColumnType::UnsignedBigInt == type)
     {
-        row[fieldName] = std::make_tuple(type, std::nullopt, std::nullopt, std::nullopt, stmt->column(index)->value(uint64_t{}), std::nullopt);
+        return column->value(uint64_t{});
     }
     else if (ColumnType::Integer == type)
     {
-        row[fieldName] = std::make_tuple(type, std::nullopt, stmt->column(index)->value(int32_t{}), std::nullopt, std::nullopt, std::nullopt);
+        return column->value(int32_t{});
     }
     else if (ColumnType::Text == type)
     {
-        row[fieldName] = std::make_tuple(type, stmt->column(index)->value(std::string{}), std::nullopt, std::nullopt, std::nullopt, std::nullopt);
+        return column->value(std::string{});
     }
     else if (ColumnType::Double == type)
     {
-        row[fieldName] = std::make_tuple(type, std::nullopt, std::nullopt, std::nullopt, std::nullopt, stmt->column(index)->value(double_t{}));
-    }
-    else
-    {
-        throw dbengine_error { INVALID_COLUMN_TYPE };
+        return column->value(double_t{});
     }
+
+    throw dbengine_error { INVALID_COLUMN_TYPE };
 }
 
 bool SQLiteDBEngine::getLeftOnly(const std::string& t1,
                                  const std::string& t2,
                                  const std::vector<std::string>& primaryKeyList,
-                                 std::vector<Row>& returnRows)
+                                 std::vector<TypedRow>& returnRows)
 {
     auto ret { false };
     const std::string query { buildLeftOnlyQuery(t1, t2, primaryKeyList) };
@@ -1048,22 +1489,19 @@ bool SQLiteDBEngine::getLeftOnly(const std::string& t1,
     if (!t1.empty() && !query.empty())
     {
         const auto stmt { getStatement(query) };
-        const auto tableFields { m_tableFields[t1] };
+        const auto schema { tableSchema(t1) };
 
-        while (SQLITE_ROW == stmt->step())
+        while (schema && SQLITE_ROW == stmt->step())
         {
-            Row registerFields;
+            TypedRow row(schema->columns.size());
 
-            for (const auto& field : tableFields)
+            for (size_t index = 0; index < schema->columns.size(); ++index)
             {
-                getTableData(stmt,
-                             std::get<TableHeader::CID>(field),
-                             std::get<TableHeader::Type>(field),
-                             std::get<TableHeader::Name>(field),
-                             registerFields);
+                const auto& field { schema->columns[index] };
+                row[index] = getColumnValue(stmt, std::get<TableHeader::CID>(field), std::get<TableHeader::Type>(field));
             }
 
-            returnRows.push_back(std::move(registerFields));
+            returnRows.push_back(std::move(row));
         }
 
         ret = true;
@@ -1075,7 +1513,7 @@ bool SQLiteDBEngine::getLeftOnly(const std::string& t1,
 bool SQLiteDBEngine::getPKListLeftOnly(const std::string& t1,
                                        const std::string& t2,
                                        const std::vector<std::string>& primaryKeyList,
-                                       std::vector<Row>& returnRows)
+                                       std::vector<TypedRow>& returnRows)
 {
     auto ret { false };
     const std::string sql { buildLeftOnlyQuery(t1, t2, primaryKeyList, true) };
@@ -1083,37 +1521,26 @@ bool SQLiteDBEngine::getPKListLeftOnly(const std::string& t1,
     if (!t1.empty() && !sql.empty())
     {
         const auto stmt { getStatement(sql) };
-        const auto tableFields { m_tableFields[t1] };
+        const auto schema { tableSchema(t1) };
 
-        while (SQLITE_ROW == stmt->step())
+        while (schema && SQLITE_ROW == stmt->step())
         {
-            Row registerFields;
+            TypedRow row(schema->columns.size());
+            int32_t index { 0l };
 
             for (const auto& pkValue : primaryKeyList)
             {
-                auto index { 0ull };
-                const auto& it
-                {
-                    std::find_if(tableFields.begin(), tableFields.end(),
-                                 [&pkValue](const ColumnData & columnData)
-                    {
-                        return std::get<TableHeader::Name>(columnData) == pkValue;
-                    })
-                };
+                const auto it { schema->columnIndexes.find(pkValue) };
 
-                if (tableFields.end() != it)
+                if (schema->columnIndexes.end() != it)
                 {
-                    getTableData(stmt,
-                                static_cast<int32_t>(index),
-                                 std::get<TableHeader::Type>(*it),
-                                 std::get<TableHeader::Name>(*it),
-                                 registerFields);
+                    row[it->second] = getColumnValue(stmt, index, std::get<TableHeader::Type>(schema->columns[it->second]));
                 }
 
                 ++index;
             }
 
-            returnRows.push_back(std::move(registerFields));
+            returnRows.push_back(std::move(row));
         }
 
         ret = true;
@@ -1152,12 +1579,13 @@ std::string SQLiteDBEngine::buildDeleteBulkDataSqlQuery(const std::string& table
 
 bool SQLiteDBEngine::deleteRows(const std::string& table,
                                 const std::vector<std::string>& primaryKeyList,
-                                const std::vector<Row>& rowsToRemove)
+                                const std::vector<TypedRow>& rowsToRemove)
 {
     auto ret { false };
     const auto sql { buildDeleteBulkDataSqlQuery(table, primaryKeyList) };
+    const auto schema { tableSchema(table) };
 
-    if (!sql.empty())
+    if (schema && !sql.empty())
     {
         const auto stmt { getStatement(sql) };
 
@@ -1167,7 +1595,7 @@ bool SQLiteDBEngine::deleteRows(const std::string& table,
 
             for (const auto& value : primaryKeyList)
             {
-                bindFieldData(stmt, index, row.at(value));
+                bindColumnValue(stmt, index, row.at(schema->columnIndexes.at(value)));
                 ++index;
             }
 
@@ -1196,126 +1624,127 @@ bool SQLiteDBEngine::deleteRows(const std::string& table,
 }
 
 void SQLiteDBEngine::deleteRowsbyPK(const std::string& table,
-                                    const nlohmann::json& data)
+                                    const nlohmann::json& data,
+                                    std::vector<nlohmann::json>* deletedRows)
 {
-    std::vector<std::string> primaryKeyList;
+    const auto schema { tableSchema(table) };
 
-    if (getPrimaryKeysFromTable(table, primaryKeyList))
+    if (schema)
     {
-        const auto& tableFields { m_tableFields[table] };
         const auto stmt
         {
-            getStatement(buildDeleteBulkDataSqlQuery(table, primaryKeyList))
+            deletedRows
+            ? getStatement({ table, StatementType::DeleteByPKReturning, {} }, [&]()
+            {
+                auto sql { buildDeleteBulkDataSqlQuery(table, schema->primaryKeys) };
+                return sql.substr(0, sql.size() - 1) + buildReturningClause(*schema) + ";";
+            })
+            : getStatement({ table, StatementType::DeleteByPK, {} }, [&]()
+            {
+                return buildDeleteBulkDataSqlQuery(table, schema->primaryKeys);
+            })
         };
 
         for (const auto& jsRow : data)
         {
             int32_t index { 1l };
 
-            for (const auto& pkValue : primaryKeyList)
+            for (const auto& pkIndex : schema->primaryKeyIndexes)
             {
-                const auto& it
+                if (bindJsonData(stmt, schema->columns[pkIndex], jsRow, index))
                 {
-                    std::find_if(tableFields.begin(), tableFields.end(),
-                                 [&pkValue](const ColumnData & column)
-                    {
-                        return 0 == std::get<Name>(column).compare(pkValue);
-                    })
-                };
-
-                if (it != tableFields.end())
-                {
-                    if (bindJsonData(stmt, *it, jsRow, index))
-                    {
-                        ++index;
-                    }
+                    ++index;
                 }
             }
 
-            // LCOV_EXCL_START
-            if (SQLITE_ERROR == stmt->step())
+            if (deletedRows)
+            {
+                getReturnedRows(stmt, *schema, *deletedRows);
+            }
+            else if (SQLITE_ERROR == stmt->step())
             {
+                // LCOV_EXCL_START
                 throw dbengine_error{ BIND_FIELDS_DOES_NOT_MATCH };
+                // LCOV_EXCL_STOP
             }
 
             updateTableRowCounter(table, m_sqliteConnection->changes() * -1ll);
-
-            // LCOV_EXCL_STOP
             stmt->reset();
         }
     }
 }
 
-void SQLiteDBEngine::bindFieldData(const std::shared_ptr<SQLiteLegacy::IStatement> stmt,
-                                   const int32_t index,
-                                   const TableField& fieldData)
+std::string SQLiteDBEngine::buildReturningClause(const TableSchema& schema) const
 {
-    const auto type { std::get<GenericTupleIndex::GenType>(fieldData) };
+    std::string sql { " RETURNING " };
 
-    if (ColumnType::BigInt == type)
+    for (const auto& field : schema.columns)
     {
-        const auto value { std::get<GenericTupleIndex::GenBigInt>(fieldData) };
-        if (value.has_value())
+        if (!std::get<TableHeader::TXNStatusField>(field))
         {
-            stmt->bind(index, value.value());
-        }
-        else
-        {
-            stmt->bind(index);
+            sql.append(std::get<TableHeader::Name>(field) + ",");
         }
     }
-    else if (ColumnType::UnsignedBigInt == type)
+
+    return sql.substr(0, sql.size() - 1);
+}
+
+void SQLiteDBEngine::getReturnedRows(const std::shared_ptr<SQLiteLegacy::IStatement>& stmt,
+                                     const TableSchema& schema,
+                                     std::vector<nlohmann::json>& deletedRows)
+{
+    auto result { stmt->step() };
+
+    // The deleted rows are returned in the order of the columns, the status field aside.
+    for (; SQLITE_ROW == result; result = stmt->step())
     {
-        const auto value { std::get<GenericTupleIndex::GenUnsignedBigInt>(fieldData) };
-        if (value.has_value())
-        {
-            stmt->bind(index, value.value());
-        }
-        else
+        TypedRow row(schema.columns.size());
+        int32_t index { 0l };
+
+        for (size_t field = 0; field < schema.columns.size(); ++field)
         {
-            stmt->bind(index);
+            if (!std::get<TableHeader::TXNStatusField>(schema.columns[field]))
+            {
+                row[field] = getColumnValue(stmt, index, std::get<TableHeader::Type>(schema.columns[field]));
+                ++index;
+            }
         }
+
+        nlohmann::json object;
+        getRowObject(schema, row, object);
+        deletedRows.push_back(std::move(object));
     }
-    else if (ColumnType::Integer == type)
+
+    // LCOV_EXCL_START
+    if (SQLITE_DONE != result)
+    {
+        throw dbengine_error{ BIND_FIELDS_DOES_NOT_MATCH };
+    }
+
+    // LCOV_EXCL_STOP
+}
+
+void SQLiteDBEngine::bindColumnValue(const std::shared_ptr<SQLiteLegacy::IStatement> stmt,
+                                     const int32_t index,
+                                     const ColumnValue& value)
+{
+    std::visit([&stmt, index](const auto & typedValue)
     {
-        const auto value { std::get<GenericTupleIndex::GenInteger>(fieldData) };
-        if (value.has_value())
+        using ValueType = std::decay_t<decltype(typedValue)>;
+
+        if constexpr (std::is_same_v<ValueType, std::monostate>)
         {
-            stmt->bind(index, value.value());
+            throw dbengine_error { INVALID_DATA_BIND };
         }
-        else
+        else if constexpr (std::is_same_v<ValueType, std::nullptr_t>)
         {
             stmt->bind(index);
         }
-    }
-    else if (ColumnType::Text == type)
-    {
-        const auto value { std::get<GenericTupleIndex::GenString>(fieldData) };
-        if (value.has_value())
-        {
-            stmt->bind(index, value.value());
-        }
-        else
-        {
-            stmt->bind(index);
-        }
-    }
-    else if (ColumnType::Double == type)
-    {
-        const auto value { std::get<GenericTupleIndex::GenDouble>(fieldData) };
-        if (value.has_value())
-        {
-            stmt->bind(index, value.value());
-        }
         else
         {
-            stmt->bind(index);
+            stmt->bind(index, typedValue);
         }
-    }
-    else
-    {
-        throw dbengine_error { INVALID_DATA_BIND };
-    }
+    }, value);
 }
 
 std::string SQLiteDBEngine::buildSelectQuery(const std::string& table,
@@ -1401,7 +1830,7 @@ std::string SQLiteDBEngine::buildLeftOnlyQuery(const std::string& t1,
     return "SELECT " + fieldsList + " FROM " + t1 + " t1 LEFT JOIN " + t2 + " t2 ON " + onMatchList + " WHERE " + nullFilterList + ";";
 }
 
-bool SQLiteDBEngine::getRowDiff(const std::vector<std::string>& primaryKeyList,
+bool SQLiteDBEngine::getRowDiff(const TableSchema& schema,
                                 const nlohmann::json& ignoredColumns,
                                 const std::string& table,
                                 const nlohmann::json& data,
@@ -1412,72 +1841,47 @@ bool SQLiteDBEngine::getRowDiff(const std::vector<std::string>& primaryKeyList,
     bool isModified { false };
     const auto stmt
     {
-        getStatement(buildSelectMatchingPKsSqlQuery(table, primaryKeyList))
+        getStatement({ table, StatementType::SelectByPK, {} }, [&]()
+        {
+            return buildSelectMatchingPKsSqlQuery(table, schema.primaryKeys);
+        })
     };
 
-    const auto& tableFields { m_tableFields[table] };
     int32_t index { 1l };
 
     // Always include primary keys
-    for (const auto& pkValue : primaryKeyList)
+    for (const auto& pkIndex : schema.primaryKeyIndexes)
     {
-        const auto& it
-        {
-            std::find_if(tableFields.begin(), tableFields.end(),
-                         [&pkValue](const ColumnData & column)
-            {
-                return 0 == std::get<Name>(column).compare(pkValue);
-            })
-        };
-
-        if (it != tableFields.end())
-        {
-            updatedData[pkValue] = data.at(pkValue);
-            oldData[pkValue] = data.at(pkValue);
-            bindJsonData(stmt, *it, data, index);
-            ++index;
-        }
+        const auto& column { schema.columns[pkIndex] };
+        const auto& pkValue { std::get<TableHeader::Name>(column) };
+        updatedData[pkValue] = data.at(pkValue);
+        oldData[pkValue] = data.at(pkValue);
+        bindJsonData(stmt, column, data, index);
+        ++index;
     }
 
     diffExist = SQLITE_ROW == stmt->step();
 
     if (diffExist)
     {
-        // The row exists, so let's generate the diff
-        Row registryFields;
-
-        for (const auto& field : tableFields)
+        // The row exists, so let's generate the diff. Only the columns present in the input are read.
+        for (const auto& field : schema.columns)
         {
-            getTableData(stmt,
-                         std::get<TableHeader::CID>(field),
-                         std::get<TableHeader::Type>(field),
-                         std::get<TableHeader::Name>(field),
-                         registryFields);
-        }
+            const auto& name { std::get<TableHeader::Name>(field) };
+            const auto& it { data.find(name) };
 
-        if (!registryFields.empty())
-        {
-            for (const auto& value : registryFields)
+            if (data.end() != it)
             {
-                nlohmann::json object;
-                getFieldValueFromTuple(value, object);
-                const auto& it
-                {
-                    data.find(value.first)
-                };
+                const auto value { getColumnValue(stmt, std::get<TableHeader::CID>(field), std::get<TableHeader::Type>(field)) };
 
-                if (data.end() != it)
+                if (!isSameValue(value, *it))
                 {
-                    // Only compare if not in ignore set
-                    if (*it != object.at(value.first))
-                    {
-                        // Diff found
-                        isModified = true;
-                        oldData[value.first] = object[value.first];
-                    }
-
-                    updatedData[value.first] = *it;
+                    // Diff found
+                    isModified = true;
+                    oldData[name] = getJsonValue(value);
                 }
+
+                updatedData[name] = *it;
             }
         }
     }
@@ -1494,7 +1898,7 @@ bool SQLiteDBEngine::getRowDiff(const std::vector<std::string>& primaryKeyList,
         {
             auto haveDiffOnNonIgnored
             {
-                [&ignoredColumns, primaryKeyList](const nlohmann::json & rowToBeUpdated) -> bool
+                [&ignoredColumns, &schema](const nlohmann::json & rowToBeUpdated) -> bool
                 {
                     bool haveDiff { false };
 
@@ -1503,8 +1907,9 @@ bool SQLiteDBEngine::getRowDiff(const std::vector<std::string>& primaryKeyList,
                         if (std::find(ignoredColumns.begin(), ignoredColumns.end(),
                                       fieldToBeUpdated.key()) == ignoredColumns.end())
                         {
-                            if (std::find(primaryKeyList.begin(), primaryKeyList.end(),
-                                          fieldToBeUpdated.key()) == primaryKeyList.end())
+                            const auto column { schema.column(fieldToBeUpdated.key()) };
+
+                            if (!column || !std::get<TableHeader::PK>(*column))
                             {
                                 haveDiff = true;
                                 break;
@@ -1533,20 +1938,17 @@ bool SQLiteDBEngine::insertNewRows(const std::string& table,
                                    std::unique_lock<std::shared_timed_mutex>& lock)
 {
     auto ret { true };
-    std::vector<Row> rowValues;
+    std::vector<TypedRow> rowValues;
+    const auto schema { tableSchema(table) };
 
-    if (getLeftOnly(table + TEMP_TABLE_SUBFIX, table, primaryKeyList, rowValues))
+    if (schema && getLeftOnly(table + TEMP_TABLE_SUBFIX, table, primaryKeyList, rowValues))
     {
         bulkInsert(table, rowValues);
 
         for (const auto& row : rowValues)
         {
             nlohmann::json object;
-
-            for (const auto& value : row)
-            {
-                getFieldValueFromTuple(value, object);
-            }
+            getRowObject(*schema, row, object);
 
             if (callback)
             {
@@ -1561,21 +1963,33 @@ bool SQLiteDBEngine::insertNewRows(const std::string& table,
 }
 
 void SQLiteDBEngine::bulkInsert(const std::string& table,
-                                const std::vector<Row>& data)
+                                const std::vector<TypedRow>& data)
 {
-    const auto stmt { getStatement(buildInsertDataSqlQuery(table)) };
+    const auto schema { tableSchema(table) };
 
-    for (const auto& row : data)
+    // LCOV_EXCL_START
+    if (!schema)
     {
-        const auto tableFields { m_tableFields[table] };
+        throw dbengine_error { SQL_STMT_ERROR };
+    }
 
-        for (const auto& value : tableFields)
+    // LCOV_EXCL_STOP
+    const auto stmt
+    {
+        getStatement({ table, StatementType::Insert, columnsMask(*schema, {}) }, [&]()
         {
-            auto it { row.find(std::get<TableHeader::Name>(value))};
+            return buildInsertDataSqlQuery(table, *schema);
+        })
+    };
 
-            if (row.end() != it)
+    for (const auto& row : data)
+    {
+        // The temporary copy of the table has the same columns, so the rows are bound by position.
+        for (size_t index = 0; index < schema->columns.size() && index < row.size(); ++index)
+        {
+            if (!std::holds_alternative<std::monostate>(row[index]))
             {
-                bindFieldData(stmt, std::get<TableHeader::CID>(value) + 1, (*it).second);
+                bindColumnValue(stmt, std::get<TableHeader::CID>(schema->columns[index]) + 1, row[index]);
             }
         }
 
@@ -1600,20 +2014,18 @@ int SQLiteDBEngine::changeModifiedRows(const std::string& table,
                                        std::unique_lock<std::shared_timed_mutex>& lock)
 {
     auto ret { true };
-    std::vector<Row> rowKeysValue;
+    std::vector<std::pair<TypedRow, TypedRow>> rowKeysValue;
+    const auto schema { tableSchema(table) };
 
-    if (getRowsToModify(table, primaryKeyList, rowKeysValue))
+    if (schema && getRowsToModify(table, primaryKeyList, rowKeysValue))
     {
         if (updateRows(table, primaryKeyList, rowKeysValue))
         {
             for (const auto& row : rowKeysValue)
             {
                 nlohmann::json object;
-
-                for (const auto& value : row)
-                {
-                    getFieldValueFromTuple(value, object);
-                }
+                getRowObject(*schema, row.first, object, "PK_");
+                getRowObject(*schema, row.second, object);
 
                 if (callback)
                 {
@@ -1704,44 +2116,24 @@ std::string SQLiteDBEngine::buildSelectMatchingPKsSqlQuery(const std::string& ta
 
 std::string SQLiteDBEngine::buildUpdateDataSqlQuery(const std::string& table,
                                                     const std::vector<std::string>& primaryKeyList,
-                                                    const Row& row,
-                                                    const std::pair<const std::string, TableField>& field)
+                                                    const std::string& field)
 {
     std::string sql{ "UPDATE " };
     sql.append(table);
     sql.append(" SET ");
-    sql.append(field.first);
-    sql.append("=");
-    getFieldValueFromTuple(field, sql, true);
-    sql.append(" WHERE ");
+    sql.append(field);
+    sql.append("=? WHERE ");
 
     if (0 != primaryKeyList.size())
     {
         for (const auto& value : primaryKeyList)
         {
-            const auto it { row.find("PK_" + value) };
-
-            if (it != row.end())
-            {
-                sql.append(value);
-                sql.append("=");
-                getFieldValueFromTuple((*it), sql, true);
-            }
-            else
-            {
-                sql.clear();
-                break;
-            }
-
-            sql.append(" AND ");
+            sql.append(value);
+            sql.append("=? AND ");
         }
 
         sql = sql.substr(0, sql.length() - 5);
-
-        if (sql.length() > 0)
-        {
-            sql.append(";");
-        }
+        sql.append(";");
     }
     // LCOV_EXCL_START
     else
@@ -1766,20 +2158,23 @@ std::string SQLiteDBEngine::buildModifiedRowsQuery(const std::string& t1,
         onMatchList.append("t1." + value + "=t2." + value + " AND ");
     }
 
-    const auto tableFields { m_tableFields[t1] };
+    const auto schema { tableSchema(t1) };
 
-    for (const auto& value : tableFields)
+    if (schema)
     {
-        const auto fieldName {std::get<TableHeader::Name>(value)};
-        fieldsList.append("CASE WHEN t1.");
-        fieldsList.append(fieldName);
-        fieldsList.append("<>t2.");
-        fieldsList.append(fieldName);
-        fieldsList.append(" THEN t1.");
-        fieldsList.append(fieldName);
-        fieldsList.append(" ELSE NULL END AS DIF_");
-        fieldsList.append(fieldName);
-        fieldsList.append(",");
+        for (const auto& value : schema->columns)
+        {
+            const auto& fieldName {std::get<TableHeader::Name>(value)};
+            fieldsList.append("CASE WHEN t1.");
+            fieldsList.append(fieldName);
+            fieldsList.append("<>t2.");
+            fieldsList.append(fieldName);
+            fieldsList.append(" THEN t1.");
+            fieldsList.append(fieldName);
+            fieldsList.append(" ELSE NULL END AS DIF_");
+            fieldsList.append(fieldName);
+            fieldsList.append(",");
+        }
     }
 
     fieldsList  = fieldsList.substr(0, fieldsList.size() - 1);
@@ -1807,7 +2202,7 @@ std::string SQLiteDBEngine::buildModifiedRowsQuery(const std::string& t1,
 
 bool SQLiteDBEngine::getRowsToModify(const std::string& table,
                                      const std::vector<std::string>& primaryKeyList,
-                                     std::vector<Row>& rowKeysValue)
+                                     std::vector<std::pair<TypedRow, TypedRow>>& rowKeysValue)
 {
     auto ret { false };
     auto sql { buildModifiedRowsQuery(table, table + TEMP_TABLE_SUBFIX, primaryKeyList) };
@@ -1815,47 +2210,34 @@ bool SQLiteDBEngine::getRowsToModify(const std::string& table,
     if (!sql.empty())
     {
         const auto stmt { getStatement(sql) };
+        const auto schema { tableSchema(table) };
 
-        while (SQLITE_ROW == stmt->step())
+        while (schema && SQLITE_ROW == stmt->step())
         {
             bool dataModified{false};
-            const auto tableFields { m_tableFields[table] };
-            Row registerFields;
+            TypedRow keys(schema->columns.size());
+            TypedRow values(schema->columns.size());
             int32_t index {0l};
 
             for (const auto& pkValue : primaryKeyList)
             {
-                const auto it
-                {
-                    std::find_if(tableFields.begin(), tableFields.end(),
-                                 [&pkValue] (const ColumnData & cd)
-                    {
-                        return std::get<TableHeader::Name>(cd).compare(pkValue) == 0;
-                    })
-                };
+                const auto it { schema->columnIndexes.find(pkValue) };
 
-                if (tableFields.end() != it)
+                if (schema->columnIndexes.end() != it)
                 {
-                    getTableData(stmt,
-                                 index,
-                                 std::get<TableHeader::Type>(*it),
-                                 "PK_" + std::get<TableHeader::Name>(*it),
-                                 registerFields);
+                    keys[it->second] = getColumnValue(stmt, index, std::get<TableHeader::Type>(schema->columns[it->second]));
                 }
 
                 ++index;
             }
 
-            for (const auto& field : tableFields)
+            // Columns that did not change are read as null, and left out of the row.
+            for (size_t column = 0; column < schema->columns.size(); ++column)
             {
-                if (registerFields.end() == registerFields.find(std::get<TableHeader::Name>(field)))
+                if (stmt->column(index)->hasValue())
                 {
-                    if (stmt->column(index)->hasValue())
-                    {
-                        dataModified = true;
-                        getTableData(stmt, index, std::get<TableHeader::Type>(field),
-                                     std::get<TableHeader::Name>(field), registerFields);
-                    }
+                    dataModified = true;
+                    values[column] = getColumnValue(stmt, index, std::get<TableHeader::Type>(schema->columns[column]));
                 }
 
                 ++index;
@@ -1863,7 +2245,7 @@ bool SQLiteDBEngine::getRowsToModify(const std::string& table,
 
             if (dataModified)
             {
-                rowKeysValue.push_back(std::move(registerFields));
+                rowKeysValue.emplace_back(std::move(keys), std::move(values));
             }
         }
 
@@ -1880,50 +2262,43 @@ bool SQLiteDBEngine::getRowsToModify(const std::string& table,
 }
 
 void SQLiteDBEngine::updateSingleRow(const std::string& table,
+                                     const TableSchema& schema,
                                      const nlohmann::json& jsData)
 {
-    std::vector<std::string> primaryKeyList;
-
-    if (getPrimaryKeysFromTable(table, primaryKeyList))
+    if (!schema.columns.empty())
     {
-        const auto& tableFields { m_tableFields[table] };
-        const auto stmt { getStatement(buildUpdatePartialDataSqlQuery(table, jsData, primaryKeyList)) };
+        const auto stmt
+        {
+            getStatement({ table, StatementType::Update, columnsMask(schema, jsData) }, [&]()
+            {
+                return buildUpdatePartialDataSqlQuery(table, jsData, schema.primaryKeys);
+            })
+        };
         int32_t index { 1l };
 
         for (auto it = jsData.begin(); it != jsData.end(); ++it)
         {
-            if (std::find(primaryKeyList.begin(), primaryKeyList.end(), it.key()) == primaryKeyList.end())
-            {
-                const auto it1{std::find_if(tableFields.begin(), tableFields.end(), [&it](const auto & value)
-                {
-                    return std::get<GenericTupleIndex::GenString>(value) == it.key();
-                })};
+            const auto column { schema.column(it.key()) };
 
-                if (it1 == tableFields.end())
-                {
-                    throw dbengine_error{ BIND_FIELDS_DOES_NOT_MATCH };
-                }
+            if (!column)
+            {
+                throw dbengine_error{ BIND_FIELDS_DOES_NOT_MATCH };
+            }
 
-                bindJsonData(stmt, *it1, jsData, index);
+            if (!std::get<TableHeader::PK>(*column))
+            {
+                bindJsonData(stmt, *column, jsData, index);
                 ++index;
             }
         }
 
         for (auto it = jsData.begin(); it != jsData.end(); ++it)
         {
-            if (std::find(primaryKeyList.begin(), primaryKeyList.end(), it.key()) != primaryKeyList.end())
-            {
-                const auto it1{std::find_if(tableFields.begin(), tableFields.end(), [&it](const auto & value)
-                {
-                    return std::get<GenericTupleIndex::GenString>(value) == it.key();
-                })};
-
-                if (it1 == tableFields.end())
-                {
-                    throw dbengine_error{ BIND_FIELDS_DOES_NOT_MATCH };
-                }
+            const auto column { schema.column(it.key()) };
 
-                bindJsonData(stmt, *it1, jsData, index);
+            if (std::get<TableHeader::PK>(*column))
+            {
+                bindJsonData(stmt, *column, jsData, index);
                 ++index;
             }
         }
@@ -1941,23 +2316,38 @@ void SQLiteDBEngine::updateSingleRow(const std::string& table,
 
 bool SQLiteDBEngine::updateRows(const std::string& table,
                                 const std::vector<std::string>& primaryKeyList,
-                                const std::vector<Row>& rowKeysValue)
+                                const std::vector<std::pair<TypedRow, TypedRow>>& rowKeysValue)
 {
+    const auto schema { tableSchema(table) };
 
     for (const auto& row : rowKeysValue)
     {
-        for (const auto& field : row)
+        for (size_t column = 0; schema && column < row.second.size(); ++column)
         {
-            if (0 != field.first.substr(0, 3).compare("PK_"))
+            if (!std::holds_alternative<std::monostate>(row.second[column]))
             {
-                const auto sql
+                const auto stmt
                 {
-                    buildUpdateDataSqlQuery(table,
-                                            primaryKeyList,
-                                            row,
-                                            field)
+                    getStatement(buildUpdateDataSqlQuery(table,
+                                                         primaryKeyList,
+                                                         std::get<TableHeader::Name>(schema->columns[column])))
                 };
-                m_sqliteConnection->execute(sql);
+                int32_t index { 1l };
+                bindColumnValue(stmt, index, row.second[column]);
+
+                for (const auto& value : primaryKeyList)
+                {
+                    bindColumnValue(stmt, ++index, row.first.at(schema->columnIndexes.at(value)));
+                }
+
+                // LCOV_EXCL_START
+                if (SQLITE_ERROR == stmt->step())
+                {
+                    throw dbengine_error{ BIND_FIELDS_DOES_NOT_MATCH };
+                }
+
+                // LCOV_EXCL_STOP
+                stmt->reset();
             }
         }
     }
@@ -1965,132 +2355,132 @@ bool SQLiteDBEngine::updateRows(const std::string& table,
     return true;
 }
 
-void SQLiteDBEngine::getFieldValueFromTuple(const Field& value,
-                                            nlohmann::json& object)
+nlohmann::json SQLiteDBEngine::getJsonValue(const ColumnValue& value)
 {
-    const auto rowType { std::get<GenericTupleIndex::GenType>(value.second) };
-
-    if (ColumnType::BigInt == rowType)
-    {
-        const auto& optValue = std::get<ColumnType::BigInt>(value.second);
-        object[value.first] = optValue.has_value() ? nlohmann::json(optValue.value()) : nlohmann::json(nullptr);
-    }
-    else if (ColumnType::UnsignedBigInt == rowType)
-    {
-        const auto& optValue = std::get<ColumnType::UnsignedBigInt>(value.second);
-        object[value.first] = optValue.has_value() ? nlohmann::json(optValue.value()) : nlohmann::json(nullptr);
-    }
-    else if (ColumnType::Integer == rowType)
+    return std::visit([](const auto & typedValue) -> nlohmann::json
     {
-        const auto& optValue = std::get<ColumnType::Integer>(value.second);
-        object[value.first] = optValue.has_value() ? nlohmann::json(optValue.value()) : nlohmann::json(nullptr);
-    }
-    else if (ColumnType::Text == rowType)
-    {
-        const auto& optValue = std::get<ColumnType::Text>(value.second);
-        object[value.first] = optValue.has_value() ? nlohmann::json(optValue.value()) : nlohmann::json(nullptr);
-    }
-    else if (ColumnType::Double == rowType)
-    {
-        const auto& optValue = std::get<ColumnType::Double>(value.second);
-        object[value.first] = optValue.has_value() ? nlohmann::json(optValue.value()) : nlohmann::json(nullptr);
-    }
-    else
-    {
-        throw dbengine_error { DATATYPE_NOT_IMPLEMENTED };
-    }
+        using ValueType = std::decay_t<decltype(typedValue)>;
+
+        if constexpr (std::is_same_v<ValueType, std::monostate> || std::is_same_v<ValueType, std::nullptr_t>)
+        {
+            return nullptr;
+        }
+        else
+        {
+            return typedValue;
+        }
+    }, value);
 }
 
-void SQLiteDBEngine::getFieldValueFromTuple(const Field& value,
-                                            std::string& resultValue,
-                                            const bool quotationMarks)
+bool SQLiteDBEngine::isSameValue(const ColumnValue& value,
+                                 const nlohmann::json& jsValue)
 {
-    const auto rowType { std::get<GenericTupleIndex::GenType>(value.second) };
-
-    if (ColumnType::BigInt == rowType)
-    {
-        const auto& optValue = std::get<ColumnType::BigInt>(value.second);
-        resultValue.append(optValue.has_value() ? std::to_string(optValue.value()) : "null");
-    }
-    else if (ColumnType::UnsignedBigInt == rowType)
-    {
-        const auto& optValue = std::get<ColumnType::UnsignedBigInt>(value.second);
-        resultValue.append(optValue.has_value() ? std::to_string(optValue.value()) : "null");
-    }
-    else if (ColumnType::Integer == rowType)
-    {
-        const auto& optValue = std::get<ColumnType::Integer>(value.second);
-        resultValue.append(optValue.has_value() ? std::to_string(optValue.value()) : "null");
-    }
-    else if (ColumnType::Text == rowType)
+    // Same result as comparing against getJsonValue, without building a json value per column.
+    return std::visit([&jsValue](const auto & typedValue)
     {
-        const auto& optValue = std::get<ColumnType::Text>(value.second);
-        if (optValue.has_value())
+        using ValueType = std::decay_t<decltype(typedValue)>;
+
+        if constexpr (std::is_same_v<ValueType, std::monostate> || std::is_same_v<ValueType, std::nullptr_t>)
         {
-            if (quotationMarks)
-            {
-                resultValue.append("'" + optValue.value() + "'");
-            }
-            else
-            {
-                resultValue.append(optValue.value());
-            }
+            return jsValue.is_null();
+        }
+        else if constexpr (std::is_same_v<ValueType, std::string>)
+        {
+            return jsValue.is_string() && jsValue.get_ref<const std::string&>() == typedValue;
         }
         else
         {
-            resultValue.append("null");
+            return jsValue == typedValue;
         }
-    }
-    else if (ColumnType::Double == rowType)
-    {
-        const auto& optValue = std::get<ColumnType::Double>(value.second);
-        resultValue.append(optValue.has_value() ? std::to_string(optValue.value()) : "null");
-    }
-    else
+    }, value);
+}
+
+void SQLiteDBEngine::getRowObject(const TableSchema& schema,
+                                  const TypedRow& row,
+                                  nlohmann::json& object,
+                                  const std::string& prefix)
+{
+    for (size_t index = 0; index < row.size() && index < schema.columns.size(); ++index)
     {
-        throw dbengine_error { DATATYPE_NOT_IMPLEMENTED };
+        if (!std::holds_alternative<std::monostate>(row[index]))
+        {
+            object[prefix + std::get<TableHeader::Name>(schema.columns[index])] = getJsonValue(row[index]);
+        }
     }
 }
 
 std::shared_ptr<SQLiteLegacy::IStatement>const SQLiteDBEngine::getStatement(const std::string& sql)
 {
-    std::lock_guard<std::mutex> lock(m_stmtMutex);
-    const auto it
+    return getStatement({ sql, StatementType::Raw, {} }, [&sql]()
     {
-        std::find_if(m_statementsCache.begin(),
-                     m_statementsCache.end(),
-                     [sql](const std::pair<std::string, std::shared_ptr<SQLiteLegacy::IStatement>>& pair)
-        {
-            return 0 == pair.first.compare(sql);
-        })
-    };
+        return sql;
+    });
+}
+
+std::shared_ptr<SQLiteLegacy::IStatement>const SQLiteDBEngine::getStatement(const StatementKey& key,
+                                                                            const std::function<std::string()>& buildSql)
+{
+    std::lock_guard<std::mutex> lock(m_stmtMutex);
+    const auto it { m_statementsCache.find(key) };
 
     if (m_statementsCache.end() != it)
     {
-        it->second->reset();
-        return it->second;
+        ++m_statementsStats.hits;
+        m_statementsLru.splice(m_statementsLru.begin(), m_statementsLru, it->second.lruPosition);
+        it->second.statement->reset();
+        return it->second.statement;
     }
-    else
+
+    ++m_statementsStats.misses;
+    const std::shared_ptr<SQLiteLegacy::IStatement> stmt { m_sqliteFactory->createStatement(m_sqliteConnection, buildSql()) };
+    const auto limit { CACHE_STMT_LIMIT + CACHE_STMT_PER_TABLE * m_statementsTables.size() };
+
+    // The least recently used statement is finalized to make room for the new one.
+    while (!m_statementsLru.empty() && m_statementsCache.size() >= limit)
     {
-        m_statementsCache.emplace_back(sql, m_sqliteFactory->createStatement(m_sqliteConnection, sql));
+        const auto evicted { m_statementsLru.back() };
+        m_statementsLru.pop_back();
+        m_statementsCache.erase(*evicted);
+    }
+
+    const auto inserted { m_statementsCache.emplace(key, CachedStatement { stmt, {} }).first };
+    m_statementsLru.push_front(&inserted->first);
+    inserted->second.lruPosition = m_statementsLru.begin();
+
+    return stmt;
+}
+
+std::vector<bool> SQLiteDBEngine::columnsMask(const TableSchema& schema,
+                                              const nlohmann::json& data) const
+{
+    // Empty data stands for every column, as in buildInsertDataSqlQuery.
+    std::vector<bool> mask(schema.columns.size(), data.empty());
 
-        if (CACHE_STMT_LIMIT <= m_statementsCache.size())
+    if (!data.empty())
+    {
+        for (size_t i = 0; i < schema.columns.size(); ++i)
         {
-            m_statementsCache.pop_front();
+            mask[i] = data.end() != data.find(std::get<TableHeader::Name>(schema.columns[i]));
         }
-
-        return m_statementsCache.back().second;
     }
+
+    return mask;
+}
+
+StatementCacheStats SQLiteDBEngine::statementCacheStats()
+{
+    std::lock_guard<std::mutex> lock(m_stmtMutex);
+    return m_statementsStats;
 }
 
 std::string SQLiteDBEngine::getSelectAllQuery(const std::string& table,
-                                              const TableColumns& tableFields) const
+                                              const TableSchema& schema) const
 {
     std::string retVal { "SELECT " };
 
-    if (!tableFields.empty() && !table.empty())
+    if (!schema.columns.empty() && !table.empty())
     {
-        for (const auto& field : tableFields)
+        for (const auto& field : schema.columns)
         {
             if (!std::get<TableHeader::TXNStatusField>(field))
             {
@@ -2103,9 +2493,7 @@ std::string SQLiteDBEngine::getSelectAllQuery(const std::string& table,
         retVal = retVal.substr(0, retVal.size() - 1);
         retVal.append(" FROM ");
         retVal.append(table);
-        retVal.append(" WHERE ");
-        retVal.append(STATUS_FIELD_NAME);
-        retVal.append("=0;");
+        retVal.append(buildNotSeenFilter(table, schema));
     }
     else
     {
@@ -2115,6 +2503,74 @@ std::string SQLiteDBEngine::getSelectAllQuery(const std::string& table,
     return retVal;
 }
 
+std::string SQLiteDBEngine::buildNotSeenFilter(const std::string& table,
+                                               const TableSchema& schema) const
+{
+    //
+    // The filter will be as the following:
+    //  WHERE NOT EXISTS (SELECT 1 FROM temp.table_SEEN s WHERE s.pk1=table.pk1 AND ...);
+    //
+    std::string sql { " WHERE NOT EXISTS (SELECT 1 FROM temp." + table + SEEN_TABLE_SUBFIX + " s WHERE " };
+
+    if (!schema.primaryKeys.empty())
+    {
+        for (const auto& pkValue : schema.primaryKeys)
+        {
+            sql.append("s." + pkValue + "=" + table + "." + pkValue + " AND ");
+        }
+
+        sql = sql.substr(0, sql.size() - 5);
+        sql.append(");");
+    }
+    // LCOV_EXCL_START
+    else
+    {
+        throw dbengine_error { SQL_STMT_ERROR };
+    }
+
+    // LCOV_EXCL_STOP
+    return sql;
+}
+
+void SQLiteDBEngine::markRowSeen(const std::string& table,
+                                 const TableSchema& schema,
+                                 const nlohmann::json& data)
+{
+    const auto stmt
+    {
+        getStatement({ table, StatementType::InsertSeen, {} }, [&]()
+        {
+            std::string sql { "INSERT OR IGNORE INTO temp." + table + SEEN_TABLE_SUBFIX + " (" };
+            std::string binds { ") VALUES (" };
+
+            for (const auto& pkValue : schema.primaryKeys)
+            {
+                sql.append(pkValue + ",");
+                binds.append("?,");
+            }
+
+            return sql.substr(0, sql.size() - 1) + binds.substr(0, binds.size() - 1) + ");";
+        })
+    };
+    int32_t index { 1l };
+
+    for (const auto& pkIndex : schema.primaryKeyIndexes)
+    {
+        if (bindJsonData(stmt, schema.columns[pkIndex], data, index))
+        {
+            ++index;
+        }
+    }
+
+    // LCOV_EXCL_START
+    if (SQLITE_ERROR == stmt->step())
+    {
+        throw dbengine_error{ STEP_ERROR_UPDATE_STATUS_FIELD };
+    }
+
+    // LCOV_EXCL_STOP
+}
+
 std::string SQLiteDBEngine::buildDeleteRelationTrigger(const nlohmann::json& data,
                                                        const std::string&    baseTable)
 {
@@ -2220,3 +2676,286 @@ void SQLiteDBEngine::updateTableRowCounter(const std::string& table, const long
         }
     }
 }
+
+int64_t SQLiteDBEngine::availableRows(const std::string& table)
+{
+    std::lock_guard<std::mutex> lock(m_maxRowsMutex);
+    const auto it { m_maxRows.find(table) };
+
+    return m_maxRows.end() == it ? -1 : std::max<int64_t>(it->second.maxRows - it->second.currentRows, 0);
+}
+
+int64_t SQLiteDBEngine::executeStatement(const std::string& sql,
+                                         const std::pair<int, std::string>& error)
+{
+    const auto stmt { getStatement(sql) };
+
+    // LCOV_EXCL_START
+    if (SQLITE_ERROR == stmt->step())
+    {
+        throw dbengine_error{ error };
+    }
+
+    // LCOV_EXCL_STOP
+    return m_sqliteConnection->changes();
+}
+
+void SQLiteDBEngine::emitSnapshotChanges(const std::string& table,
+                                         const TableSchema& schema,
+                                         const bool returnOldData,
+                                         const DbSync::ResultCallback changesCallback,
+                                         const DbSync::ResultCallback deletedCallback,
+                                         std::unique_lock<std::shared_timed_mutex>& lock)
+{
+    std::vector<size_t> fields;
+    std::string sql { "SELECT rowid," };
+    sql.append(DIFF_OPERATION_FIELD_NAME);
+
+    for (size_t index = 0; index < schema.columns.size(); ++index)
+    {
+        if (!std::get<TableHeader::TXNStatusField>(schema.columns[index]))
+        {
+            fields.push_back(index);
+            sql.append("," + std::get<TableHeader::Name>(schema.columns[index]));
+        }
+    }
+
+    for (const auto& field : fields)
+    {
+        sql.append(std::string{ "," } + DIFF_OLD_FIELD_PREFIX + std::get<TableHeader::Name>(schema.columns[field]));
+    }
+
+    sql.append(" FROM temp." + table + DIFF_TABLE_SUBFIX + " WHERE rowid>? ORDER BY rowid LIMIT " + std::to_string(SNAPSHOT_CALLBACK_CHUNK) + ";");
+
+    // The results are read a chunk at a time, so the lock is only released between two statements.
+    int64_t lastRowId { 0ll };
+    int64_t rowsRead { SNAPSHOT_CALLBACK_CHUNK };
+
+    while (SNAPSHOT_CALLBACK_CHUNK == rowsRead)
+    {
+        std::vector<std::pair<ReturnTypeCallback, nlohmann::json>> chunk;
+        const auto stmt { getStatement(sql) };
+        stmt->bind(1, lastRowId);
+
+        for (rowsRead = 0; SQLITE_ROW == stmt->step(); ++rowsRead)
+        {
+            lastRowId = stmt->column(0)->value(int64_t{});
+            const auto operation { static_cast<ReturnTypeCallback>(stmt->column(1)->value(int32_t{})) };
+            const auto& callback { DELETED == operation ? deletedCallback : changesCallback };
+            TypedRow newRow(schema.columns.size());
+            TypedRow oldRow(schema.columns.size());
+            int32_t index { 2l };
+
+            for (const auto& field : fields)
+            {
+                newRow[field] = getColumnValue(stmt, index, std::get<TableHeader::Type>(schema.columns[field]));
+                ++index;
+            }
+
+            for (const auto& field : fields)
+            {
+                oldRow[field] = getColumnValue(stmt, index, std::get<TableHeader::Type>(schema.columns[field]));
+                ++index;
+            }
+
+            if (callback)
+            {
+                nlohmann::json object;
+                getRowObject(schema, newRow, object);
+
+                if (MAX_ROWS == operation)
+                {
+                    // Same information the row at a time sync reports.
+                    object = { { "table", table }, { "data", nlohmann::json::array({ object }) } };
+                }
+                else if (MODIFIED == operation && returnOldData)
+                {
+                    nlohmann::json oldData;
+
+                    for (const auto& field : fields)
+                    {
+                        if (std::get<TableHeader::PK>(schema.columns[field]) || oldRow[field] != newRow[field])
+                        {
+                            oldData[std::get<TableHeader::Name>(schema.columns[field])] = getJsonValue(oldRow[field]);
+                        }
+                    }
+
+                    object = { { "old", std::move(oldData) }, { "new", std::move(object) } };
+                }
+
+                chunk.emplace_back(operation, std::move(object));
+            }
+        }
+
+        stmt->reset();
+
+        if (!chunk.empty())
+        {
+            lock.unlock();
+
+            for (const auto& result : chunk)
+            {
+                (DELETED == result.first ? deletedCallback : changesCallback)(result.first, result.second);
+            }
+
+            lock.lock();
+        }
+    }
+
+    executeStatement("DELETE FROM temp." + table + DIFF_TABLE_SUBFIX + ";", STEP_ERROR_UPDATE_STMT);
+}
+
+RowDigest SQLiteDBEngine::rowDigest(const TableSchema& schema,
+                                    const nlohmann::json& data) const
+{
+    std::string key;
+    std::string value;
+
+    if (schema.primaryKeyIndexes.empty())
+    {
+        return { 0, 0, false };
+    }
+
+    // Rows are only digested when their primary keys have the type of the column, so that a row has a single key.
+    for (const auto& pkIndex : schema.primaryKeyIndexes)
+    {
+        const auto& column { schema.columns[pkIndex] };
+        const auto type { std::get<TableHeader::Type>(column) };
+        const auto it { data.find(std::get<TableHeader::Name>(column)) };
+
+        if (data.end() == it ||
+                !((ColumnType::Text == type && it->is_string()) ||
+                  (ColumnType::Double == type && it->is_number_float()) ||
+                  ((ColumnType::Integer == type || ColumnType::BigInt == type || ColumnType::UnsignedBigInt == type) &&
+                   it->is_number_integer())))
+        {
+            return { 0, 0, false };
+        }
+
+        key.append(it->dump());
+        key.push_back('\0');
+    }
+
+    // The fields are digested in column order, as only the ones present in the data are compared.
+    for (size_t i = 0; i < schema.columns.size(); ++i)
+    {
+        const auto& column { schema.columns[i] };
+
+        if (!std::get<TableHeader::TXNStatusField>(column))
+        {
+            const auto it { data.find(std::get<TableHeader::Name>(column)) };
+
+            if (data.end() != it)
+            {
+                value.append(std::to_string(i));
+                value.push_back('=');
+                value.append(it->dump());
+                value.push_back('\0');
+            }
+        }
+    }
+
+    return { std::hash<std::string> {}(key), std::hash<std::string> {}(value), true };
+}
+
+bool SQLiteDBEngine::isRowUnchanged(const std::string& table,
+                                    const RowDigest& digest)
+{
+    auto ret { false };
+
+    if (digest.valid)
+    {
+        std::lock_guard<std::mutex> lock(m_rowDigestsMutex);
+        const auto itTable { m_rowDigests.find(table) };
+
+        if (m_rowDigests.end() != itTable)
+        {
+            const auto itRow { itTable->second.rows.find(digest.key) };
+            ret = itTable->second.rows.end() != itRow && itRow->second.value == digest.value;
+        }
+    }
+
+    return ret;
+}
+
+void SQLiteDBEngine::updateRowDigest(const std::string& table,
+                                     const RowDigest& digest)
+{
+    std::lock_guard<std::mutex> lock(m_rowDigestsMutex);
+    auto& digests { m_rowDigests[table] };
+
+    if (digest.valid)
+    {
+        digests.rows[digest.key] = { digest.value, digests.generation };
+    }
+    else
+    {
+        // The row may be known by another key, so none of the table is trusted.
+        digests.rows.clear();
+    }
+}
+
+void SQLiteDBEngine::eraseRowDigest(const std::string& table,
+                                    const RowDigest& digest)
+{
+    std::lock_guard<std::mutex> lock(m_rowDigestsMutex);
+    auto& digests { m_rowDigests[table] };
+
+    if (digest.valid)
+    {
+        digests.rows.erase(digest.key);
+    }
+    else
+    {
+        digests.rows.clear();
+    }
+}
+
+void SQLiteDBEngine::invalidateRowDigests(const std::string& table)
+{
+    std::lock_guard<std::mutex> lock(m_rowDigestsMutex);
+
+    if (m_hasRelationships)
+    {
+        for (auto& digests : m_rowDigests)
+        {
+            digests.second.rows.clear();
+        }
+    }
+    else
+    {
+        m_rowDigests[table].rows.clear();
+    }
+}
+
+void SQLiteDBEngine::removeStaleRowDigests(const std::string& table,
+                                           const int64_t      deletedRows)
+{
+    std::lock_guard<std::mutex> lock(m_rowDigestsMutex);
+
+    if (m_hasRelationships && 0 != deletedRows)
+    {
+        // The deletion may have cascaded to rows of other tables.
+        for (auto& digests : m_rowDigests)
+        {
+            digests.second.rows.clear();
+        }
+    }
+    else
+    {
+        // The rows deleted are the ones not synced since the txn was opened.
+        auto& digests { m_rowDigests[table] };
+
+        for (auto it = digests.rows.begin(); it != digests.rows.end();)
+        {
+            if (it->second.generation != digests.generation)
+            {
+                it = digests.rows.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+}
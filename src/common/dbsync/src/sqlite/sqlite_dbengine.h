@@ -14,14 +14,22 @@
 
 #include <tuple>
 #include <iostream>
+#include <list>
 #include <mutex>
 #include <queue>
+#include <unordered_map>
+#include <unordered_set>
+#include <variant>
 #include "dbengine.h"
 #include "sqlite_wrapper_factory.h"
 #include "isqlite_wrapper.h"
 #include "mapWrapperSafe.h"
 
 constexpr auto TEMP_TABLE_SUBFIX {"_TEMP"};
+constexpr auto SEEN_TABLE_SUBFIX {"_SEEN"};
+constexpr auto DIFF_TABLE_SUBFIX {"_DIFF"};
+constexpr auto DIFF_OPERATION_FIELD_NAME {"dbsync_op"};
+constexpr auto DIFF_OLD_FIELD_PREFIX {"OLD_"};
 
 constexpr auto STATUS_FIELD_NAME {"db_status_field_dm"};
 constexpr auto STATUS_FIELD_TYPE {"INTEGER"};
@@ -31,6 +39,24 @@ constexpr auto CACHE_STMT_LIMIT
     30ull
 };
 
+// Statements kept for each loaded table, on top of CACHE_STMT_LIMIT.
+constexpr auto CACHE_STMT_PER_TABLE
+{
+    8ull
+};
+
+// Idle read-only connections kept open for the selects of a WAL database.
+constexpr auto READ_CONNECTIONS_LIMIT
+{
+    4ull
+};
+
+// Snapshot results emitted between two releases of the sync lock.
+constexpr auto SNAPSHOT_CALLBACK_CHUNK
+{
+    512ll
+};
+
 const std::vector<std::string> InternalColumnNames =
 {
     { STATUS_FIELD_NAME }
@@ -67,32 +93,98 @@ enum TableHeader
     TXNStatusField
 };
 
-enum GenericTupleIndex
-{
-    GenType = 0,
-    GenString,
-    GenInteger,
-    GenBigInt,
-    GenUnsignedBigInt,
-    GenDouble
-};
-
 using ColumnData =
     std::tuple<int32_t, std::string, ColumnType, bool, bool>;
 
 using TableColumns =
     std::vector<ColumnData>;
 
-using TableField =  std::tuple<int32_t,         // Type
-                    std::optional<std::string>, // Text or null
-                    std::optional<int32_t>,     // Integer or null
-                    std::optional<int64_t>,     // BigInt or null
-                    std::optional<uint64_t>,    // UnsignedBigInt or null
-                    std::optional<double_t>>;   // Double or null
+// Immutable metadata of a table. Snapshots are shared, so the columns are never copied per row.
+struct TableSchema final
+{
+    TableColumns columns;
+    std::unordered_map<std::string, size_t> columnIndexes;
+    std::vector<std::string> primaryKeys;
+    std::vector<size_t> primaryKeyIndexes;
+
+    const ColumnData* column(const std::string& name) const
+    {
+        const auto it { columnIndexes.find(name) };
+        return columnIndexes.end() != it ? &columns[it->second] : nullptr;
+    }
+};
+
+using TableSchemaPtr = std::shared_ptr<const TableSchema>;
+
+enum class StatementType
+{
+    Raw = 0,
+    Insert,
+    Update,
+    SelectByPK,
+    DeleteByPK,
+    DeleteByPKReturning,
+    InsertSeen,
+    InsertSnapshot
+};
+
+// Shape of a cached statement. Raw statements are keyed by their SQL text, held in 'table'.
+struct StatementKey final
+{
+    std::string table;
+    StatementType type;
+    std::vector<bool> columns;
+
+    bool operator==(const StatementKey& other) const
+    {
+        return type == other.type && table == other.table && columns == other.columns;
+    }
+};
+
+struct StatementKeyHash final
+{
+    size_t operator()(const StatementKey& key) const
+    {
+        auto hash { std::hash<std::string> {}(key.table) };
+        hash ^= std::hash<int> {}(static_cast<int>(key.type)) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        hash ^= std::hash<std::vector<bool>> {}(key.columns) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+};
+
+// Content digest of a synced row, and of its primary key. Rows whose key types are not canonical have no digest.
+// The digests are 64-bit hashes and the row content includes its key, so a change is only missed if the new content
+// hashes like the stored one. That risk (about 2^-64 per modified row) is accepted to keep one word per row in memory.
+struct RowDigest final
+{
+    size_t key;
+    size_t value;
+    bool valid;
+};
+
+struct RowDigestEntry final
+{
+    size_t value;
+    uint64_t generation;
+};
+
+struct TableRowDigests final
+{
+    uint64_t generation;
+    std::unordered_map<size_t, RowDigestEntry> rows;
+};
+
+struct StatementCacheStats final
+{
+    uint64_t hits;
+    uint64_t misses;
+};
 
-using Row = std::map<std::string, TableField>;
+// Value of a column, typed after the table schema. Columns that were not read hold std::monostate.
+using ColumnValue = std::variant<std::monostate, std::nullptr_t, std::string, int32_t, int64_t, uint64_t, double_t>;
 
-using Field = std::pair<const std::string, TableField>;
+// Values of a row, indexed by the position of each column in the table schema.
+using TypedRow = std::vector<ColumnValue>;
 
 enum ResponseType
 {
@@ -153,13 +245,36 @@ class SQLiteDBEngine final : public DbSync::IDbEngine
         void selectData(const std::string& table,
                         const nlohmann::json& query,
                         const DbSync::ResultCallback& callback,
-                        std::unique_lock<std::shared_timed_mutex>& lock) override;
+                        Utils::ILocking& lock) override;
+
+        bool concurrentReads() const override;
+
+        void publishWrites() override;
+
+        void beginRowWrite() override;
+
+        void endRowWrite() override;
 
         void deleteTableRowsData(const std::string& table,
-                                 const nlohmann::json& jsDeletionData) override;
+                                 const nlohmann::json& jsDeletionData,
+                                 const DbSync::ResultCallback callback,
+                                 std::unique_lock<std::shared_timed_mutex>& lock) override;
 
         void addTableRelationship(const nlohmann::json& data) override;
 
+        void initializeSnapshot(const nlohmann::json& tableNames) override;
+
+        void appendSnapshotData(const std::string& table,
+                                const nlohmann::json& data) override;
+
+        void applySnapshot(const std::string& table,
+                           const nlohmann::json& options,
+                           const DbSync::ResultCallback changesCallback,
+                           const DbSync::ResultCallback deletedCallback,
+                           std::unique_lock<std::shared_timed_mutex>& lock) override;
+
+        StatementCacheStats statementCacheStats();
+
     private:
         void initialize(const std::string&              path,
                         const std::string&              tableStmtCreation,
@@ -168,13 +283,24 @@ class SQLiteDBEngine final : public DbSync::IDbEngine
 
         bool cleanDB(const std::string& path);
 
+        std::shared_ptr<SQLiteLegacy::IConnection> acquireReader();
+
+        void releaseReader(const std::shared_ptr<SQLiteLegacy::IConnection>& reader);
+
+        void publishRowWrites();
+
+        void commitTransaction();
+
         size_t getDbVersion();
 
         size_t loadTableData(const std::string& table);
 
+        TableSchemaPtr tableSchema(const std::string& table);
+
         bool loadFieldData(const std::string& table);
 
         std::string buildInsertDataSqlQuery(const std::string& table,
+                                            const TableSchema& schema,
                                             const nlohmann::json& data = {});
 
         std::string buildDeleteBulkDataSqlQuery(const std::string& table,
@@ -203,7 +329,7 @@ class SQLiteDBEngine final : public DbSync::IDbEngine
                                  const DbSync::ResultCallback callback,
                                  std::unique_lock<std::shared_timed_mutex>& lock);
 
-        bool getRowDiff(const std::vector<std::string>& primaryKeyList,
+        bool getRowDiff(const TableSchema& schema,
                         const nlohmann::json& ignoredColumns,
                         const std::string& table,
                         const nlohmann::json& data,
@@ -217,24 +343,29 @@ class SQLiteDBEngine final : public DbSync::IDbEngine
 
         bool deleteRows(const std::string& table,
                         const std::vector<std::string>& primaryKeyList,
-                        const std::vector<Row>& rowsToRemove);
+                        const std::vector<TypedRow>& rowsToRemove);
 
         void deleteRows(const std::string& table,
                         const nlohmann::json& data,
                         const std::vector<std::string>& primaryKeyList);
 
         void deleteRowsbyPK(const std::string& table,
-                            const nlohmann::json& data);
+                            const nlohmann::json& data,
+                            std::vector<nlohmann::json>* deletedRows);
+
+        std::string buildReturningClause(const TableSchema& schema) const;
 
-        void getTableData(std::shared_ptr<SQLiteLegacy::IStatement>const stmt,
-                          const int32_t index,
-                          const ColumnType& type,
-                          const std::string& fieldName,
-                          Row& row);
+        void getReturnedRows(const std::shared_ptr<SQLiteLegacy::IStatement>& stmt,
+                             const TableSchema& schema,
+                             std::vector<nlohmann::json>& deletedRows);
 
-        void bindFieldData(const std::shared_ptr<SQLiteLegacy::IStatement> stmt,
-                           const int32_t index,
-                           const TableField& fieldData);
+        ColumnValue getColumnValue(std::shared_ptr<SQLiteLegacy::IStatement>const stmt,
+                                   const int32_t index,
+                                   const ColumnType& type);
+
+        void bindColumnValue(const std::shared_ptr<SQLiteLegacy::IStatement> stmt,
+                             const int32_t index,
+                             const ColumnValue& value);
 
         std::string buildLeftOnlyQuery(const std::string& t1,
                                        const std::string& t2,
@@ -244,15 +375,15 @@ class SQLiteDBEngine final : public DbSync::IDbEngine
         bool getLeftOnly(const std::string& t1,
                          const std::string& t2,
                          const std::vector<std::string>& primaryKeyList,
-                         std::vector<Row>& returnRows);
+                         std::vector<TypedRow>& returnRows);
 
         bool getPKListLeftOnly(const std::string& t1,
                                const std::string& t2,
                                const std::vector<std::string>& primaryKeyList,
-                               std::vector<Row>& returnRows);
+                               std::vector<TypedRow>& returnRows);
 
         void bulkInsert(const std::string& table,
-                        const std::vector<Row>& data);
+                        const std::vector<TypedRow>& data);
 
         void deleteTempTable(const std::string& table);
 
@@ -270,8 +401,7 @@ class SQLiteDBEngine final : public DbSync::IDbEngine
 
         std::string buildUpdateDataSqlQuery(const std::string& table,
                                             const std::vector<std::string>& primaryKeyList,
-                                            const Row& row,
-                                            const std::pair<const std::string, TableField>& field);
+                                            const std::string& field);
 
         std::string buildUpdatePartialDataSqlQuery(const std::string& table,
                                                    const nlohmann::json& data,
@@ -279,21 +409,25 @@ class SQLiteDBEngine final : public DbSync::IDbEngine
 
         bool getRowsToModify(const std::string& table,
                              const std::vector<std::string>& primaryKeyList,
-                             std::vector<Row>& rowKeysValue);
+                             std::vector<std::pair<TypedRow, TypedRow>>& rowKeysValue);
 
         void updateSingleRow(const std::string& table,
+                             const TableSchema& schema,
                              const nlohmann::json& jsData);
 
         bool updateRows(const std::string& table,
                         const std::vector<std::string>& primaryKeyList,
-                        const std::vector<Row>& rowKeysValue);
+                        const std::vector<std::pair<TypedRow, TypedRow>>& rowKeysValue);
+
+        nlohmann::json getJsonValue(const ColumnValue& value);
 
-        void getFieldValueFromTuple(const Field& value,
-                                    std::string& resultValue,
-                                    const bool quotationMarks = false);
+        bool isSameValue(const ColumnValue& value,
+                         const nlohmann::json& jsValue);
 
-        void getFieldValueFromTuple(const Field& value,
-                                    nlohmann::json& object);
+        void getRowObject(const TableSchema& schema,
+                          const TypedRow& row,
+                          nlohmann::json& object,
+                          const std::string& prefix = "");
 
         SQLiteDBEngine(const SQLiteDBEngine&) = delete;
 
@@ -301,8 +435,21 @@ class SQLiteDBEngine final : public DbSync::IDbEngine
 
         std::shared_ptr<SQLiteLegacy::IStatement>const getStatement(const std::string& sql);
 
+        std::shared_ptr<SQLiteLegacy::IStatement>const getStatement(const StatementKey& key,
+                                                                    const std::function<std::string()>& buildSql);
+
+        std::vector<bool> columnsMask(const TableSchema& schema,
+                                      const nlohmann::json& data) const;
+
         std::string getSelectAllQuery(const std::string& table,
-                                      const TableColumns& tableFields) const;
+                                      const TableSchema& schema) const;
+
+        std::string buildNotSeenFilter(const std::string& table,
+                                       const TableSchema& schema) const;
+
+        void markRowSeen(const std::string& table,
+                         const TableSchema& schema,
+                         const nlohmann::json& data);
 
         std::string buildDeleteRelationTrigger(const nlohmann::json& data,
                                                const std::string&    baseTable);
@@ -314,19 +461,70 @@ class SQLiteDBEngine final : public DbSync::IDbEngine
         void updateTableRowCounter(const std::string& table,
                                    const long long    rowModifyCount);
 
+        int64_t availableRows(const std::string& table);
+
+        int64_t executeStatement(const std::string& sql,
+                                 const std::pair<int, std::string>& error);
+
+        void emitSnapshotChanges(const std::string& table,
+                                 const TableSchema& schema,
+                                 const bool returnOldData,
+                                 const DbSync::ResultCallback changesCallback,
+                                 const DbSync::ResultCallback deletedCallback,
+                                 std::unique_lock<std::shared_timed_mutex>& lock);
+
+        RowDigest rowDigest(const TableSchema& schema,
+                            const nlohmann::json& data) const;
+
+        bool isRowUnchanged(const std::string& table,
+                            const RowDigest& digest);
+
+        void updateRowDigest(const std::string& table,
+                             const RowDigest& digest);
+
+        void eraseRowDigest(const std::string& table,
+                            const RowDigest& digest);
+
+        void invalidateRowDigests(const std::string& table);
+
+        void removeStaleRowDigests(const std::string& table,
+                                   const int64_t      deletedRows);
+
         void insertElement(const std::string& table,
-                           const TableColumns& tableColumns,
+                           const TableSchema& schema,
                            const nlohmann::json& element,
                            const std::function<void()> callback = {});
 
-        Utils::MapWrapperSafe<std::string, TableColumns> m_tableFields;
-        std::deque<std::pair<std::string, std::shared_ptr<SQLiteLegacy::IStatement>>> m_statementsCache;
+        Utils::MapWrapperSafe<std::string, TableSchemaPtr> m_tableSchemas;
+        struct CachedStatement final
+        {
+            std::shared_ptr<SQLiteLegacy::IStatement> statement;
+            std::list<const StatementKey*>::iterator lruPosition;
+        };
+
+        std::unordered_map<StatementKey, CachedStatement, StatementKeyHash> m_statementsCache;
+        std::list<const StatementKey*> m_statementsLru;
+        std::unordered_set<std::string> m_statementsTables;
+        StatementCacheStats m_statementsStats;
         const std::shared_ptr<ISQLiteFactory> m_sqliteFactory;
         std::shared_ptr<SQLiteLegacy::IConnection> m_sqliteConnection;
         std::mutex m_stmtMutex;
         std::unique_ptr<SQLiteLegacy::ITransaction> m_transaction;
         std::mutex m_maxRowsMutex;
         std::map<std::string, MaxRows> m_maxRows;
+        std::mutex m_rowDigestsMutex;
+        std::unordered_map<std::string, TableRowDigests> m_rowDigests;
+        bool m_hasRelationships;
+        // File backed databases are opened in WAL mode, so the selects read from their own connections.
+        const std::string m_path;
+        const bool m_concurrentReads;
+        // Row syncs in progress, and whether the ones that ended left rows not committed yet.
+        size_t m_activeRowWrites;
+        bool m_unpublishedRows;
+        bool m_publishRequested;
+        std::mutex m_transactionMutex;
+        std::mutex m_readersMutex;
+        std::vector<std::shared_ptr<SQLiteLegacy::IConnection>> m_readers;
 };
 
 #endif // _SQLITE_DBENGINE_H
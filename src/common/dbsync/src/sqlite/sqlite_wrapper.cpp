@@ -17,7 +17,6 @@
 #include <sys/stat.h>
 
 constexpr auto DB_DEFAULT_PATH {"temp.db"};
-constexpr auto DB_MEMORY {":memory:"};
 constexpr auto DB_PERMISSIONS
 {
     0640
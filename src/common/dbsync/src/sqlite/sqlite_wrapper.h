@@ -17,6 +17,9 @@
 
 #include <string>
 #include <memory>
+
+constexpr auto DB_MEMORY {":memory:"};
+
 namespace SQLiteLegacy
 {
     class Connection : public IConnection
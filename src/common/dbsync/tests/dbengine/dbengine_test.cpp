@@ -41,7 +41,7 @@ static void initNoMetaDataMocks(std::unique_ptr<SQLiteDBEngine>& spEngine)
     .WillOnce(Return(ByMove(std::move(mockStatement_1))));
 
     EXPECT_CALL(*mockConnection, execute("PRAGMA temp_store = memory;")).Times(1);
-    EXPECT_CALL(*mockConnection, execute("PRAGMA journal_mode = truncate;")).Times(1);
+    EXPECT_CALL(*mockConnection, execute("PRAGMA journal_mode = WAL;")).Times(1);
     EXPECT_CALL(*mockConnection, execute("PRAGMA synchronous = OFF;")).Times(1);
     EXPECT_CALL(*mockConnection, execute("PRAGMA user_version = 1;")).Times(1);
 
@@ -74,7 +74,7 @@ TEST_F(DBEngineTest, Initialization)
     EXPECT_CALL(*mockFactory, createStatement(_, _))
     .WillOnce(Return(ByMove(std::move(mockStatement))));
     EXPECT_CALL(*mockConnection, execute("PRAGMA temp_store = memory;")).Times(1);
-    EXPECT_CALL(*mockConnection, execute("PRAGMA journal_mode = truncate;")).Times(1);
+    EXPECT_CALL(*mockConnection, execute("PRAGMA journal_mode = WAL;")).Times(1);
     EXPECT_CALL(*mockConnection, execute("PRAGMA synchronous = OFF;")).Times(1);
     EXPECT_CALL(*mockConnection, execute("PRAGMA user_version = 1;")).Times(1);
 
@@ -97,7 +97,7 @@ TEST_F(DBEngineTest, InitializationSQLError)
     EXPECT_CALL(*mockFactory, createStatement(_, _))
     .WillOnce(Return(ByMove(std::move(mockStatement))));
     EXPECT_CALL(*mockConnection, execute("PRAGMA temp_store = memory;")).Times(1);
-    EXPECT_CALL(*mockConnection, execute("PRAGMA journal_mode = truncate;")).Times(1);
+    EXPECT_CALL(*mockConnection, execute("PRAGMA journal_mode = WAL;")).Times(1);
     EXPECT_CALL(*mockConnection, execute("PRAGMA synchronous = OFF;")).Times(1);
     EXPECT_CALL(*mockConnection, execute("PRAGMA user_version = 1;")).Times(1);
 
@@ -118,7 +118,7 @@ TEST_F(DBEngineTest, InitializationEmptyQuery)
     EXPECT_CALL(*mockFactory, createConnection(_))
     .WillOnce(Return(mockConnection));
     EXPECT_CALL(*mockConnection, execute("PRAGMA temp_store = memory;")).Times(1);
-    EXPECT_CALL(*mockConnection, execute("PRAGMA journal_mode = truncate;")).Times(1);
+    EXPECT_CALL(*mockConnection, execute("PRAGMA journal_mode = WAL;")).Times(1);
     EXPECT_CALL(*mockConnection, execute("PRAGMA synchronous = OFF;")).Times(1);
     EXPECT_CALL(*mockConnection, execute("PRAGMA user_version = 1;")).Times(1);
 
@@ -156,7 +156,7 @@ TEST_F(DBEngineTest, InitializeStatusField)
 
 
     EXPECT_CALL(*mockConnection, execute("PRAGMA temp_store = memory;")).Times(1);
-    EXPECT_CALL(*mockConnection, execute("PRAGMA journal_mode = truncate;")).Times(1);
+    EXPECT_CALL(*mockConnection, execute("PRAGMA journal_mode = WAL;")).Times(1);
     EXPECT_CALL(*mockConnection, execute("PRAGMA synchronous = OFF;")).Times(1);
     EXPECT_CALL(*mockConnection, execute("PRAGMA user_version = 1;")).Times(1);
 
@@ -200,18 +200,25 @@ TEST_F(DBEngineTest, InitializeStatusField)
                 step())
     .WillOnce(Return(0));
     EXPECT_CALL(*mockFactory,
-                createStatement(_, "ALTER TABLE dummy ADD COLUMN db_status_field_dm INTEGER DEFAULT 1;"))
+                createStatement(_, "CREATE TEMP TABLE IF NOT EXISTS dummy_SEEN(PID, PRIMARY KEY (PID)) WITHOUT ROWID;"))
     .WillOnce(Return(ByMove(std::move(mockStatement_3))));
 
     auto mockStatement_4 { std::make_unique<MockStatement>() };
     EXPECT_CALL(*mockStatement_4,
                 step())
     .WillOnce(Return(0));
-
     EXPECT_CALL(*mockFactory,
-                createStatement(_, "UPDATE dummy SET db_status_field_dm=0;"))
+                createStatement(_, "CREATE TEMP TRIGGER IF NOT EXISTS dummy_SEEN_INSERT AFTER INSERT ON main.dummy BEGIN INSERT OR IGNORE INTO dummy_SEEN (PID) VALUES (NEW.PID); END;"))
     .WillOnce(Return(ByMove(std::move(mockStatement_4))));
 
+    auto mockStatement_5 { std::make_unique<MockStatement>() };
+    EXPECT_CALL(*mockStatement_5,
+                step())
+    .WillOnce(Return(0));
+    EXPECT_CALL(*mockFactory,
+                createStatement(_, "DELETE FROM temp.dummy_SEEN;"))
+    .WillOnce(Return(ByMove(std::move(mockStatement_5))));
+
 
     EXPECT_NO_THROW(spEngine->initializeStatusField(std::vector<std::string> {"dummy"}));
 }
@@ -237,7 +244,7 @@ TEST_F(DBEngineTest, InitializeStatusFieldNoMetadata)
 
 
     EXPECT_CALL(*mockConnection, execute("PRAGMA temp_store = memory;")).Times(1);
-    EXPECT_CALL(*mockConnection, execute("PRAGMA journal_mode = truncate;")).Times(1);
+    EXPECT_CALL(*mockConnection, execute("PRAGMA journal_mode = WAL;")).Times(1);
     EXPECT_CALL(*mockConnection, execute("PRAGMA synchronous = OFF;")).Times(1);
     EXPECT_CALL(*mockConnection, execute("PRAGMA user_version = 1;")).Times(1);
 
@@ -278,7 +285,7 @@ TEST_F(DBEngineTest, InitializeStatusFieldPreExistent)
 
 
     EXPECT_CALL(*mockConnection, execute("PRAGMA temp_store = memory;")).Times(1);
-    EXPECT_CALL(*mockConnection, execute("PRAGMA journal_mode = truncate;")).Times(1);
+    EXPECT_CALL(*mockConnection, execute("PRAGMA journal_mode = WAL;")).Times(1);
     EXPECT_CALL(*mockConnection, execute("PRAGMA synchronous = OFF;")).Times(1);
     EXPECT_CALL(*mockConnection, execute("PRAGMA user_version = 1;")).Times(1);
 
@@ -312,7 +319,7 @@ TEST_F(DBEngineTest, InitializeStatusFieldPreExistent)
     .WillOnce(Return(STATUS_FIELD_TYPE));
     auto mockColumn_8 { std::make_unique<MockColumn>() };
     EXPECT_CALL(*mockColumn_8, value(An<const int32_t&>()))
-    .WillOnce(Return(1));
+    .WillOnce(Return(0));
 
     auto mockStatement_2 { std::make_unique<MockStatement>() };
     EXPECT_CALL(*mockStatement_2, step())
@@ -335,15 +342,30 @@ TEST_F(DBEngineTest, InitializeStatusFieldPreExistent)
                 createStatement(_, "PRAGMA table_info(dummy);"))
     .WillOnce(Return(ByMove(std::move(mockStatement_2))));
 
+    auto mockStatement_3 { std::make_unique<MockStatement>() };
+    EXPECT_CALL(*mockStatement_3,
+                step())
+    .WillOnce(Return(0));
+    EXPECT_CALL(*mockFactory,
+                createStatement(_, "CREATE TEMP TABLE IF NOT EXISTS dummy_SEEN(PID, PRIMARY KEY (PID)) WITHOUT ROWID;"))
+    .WillOnce(Return(ByMove(std::move(mockStatement_3))));
+
     auto mockStatement_4 { std::make_unique<MockStatement>() };
     EXPECT_CALL(*mockStatement_4,
                 step())
     .WillOnce(Return(0));
-
     EXPECT_CALL(*mockFactory,
-                createStatement(_, "UPDATE dummy SET db_status_field_dm=0;"))
+                createStatement(_, "CREATE TEMP TRIGGER IF NOT EXISTS dummy_SEEN_INSERT AFTER INSERT ON main.dummy BEGIN INSERT OR IGNORE INTO dummy_SEEN (PID) VALUES (NEW.PID); END;"))
     .WillOnce(Return(ByMove(std::move(mockStatement_4))));
 
+    auto mockStatement_5 { std::make_unique<MockStatement>() };
+    EXPECT_CALL(*mockStatement_5,
+                step())
+    .WillOnce(Return(0));
+    EXPECT_CALL(*mockFactory,
+                createStatement(_, "DELETE FROM temp.dummy_SEEN;"))
+    .WillOnce(Return(ByMove(std::move(mockStatement_5))));
+
     EXPECT_NO_THROW(spEngine->initializeStatusField(std::vector<std::string> {"dummy"}));
 }
 
@@ -367,7 +389,7 @@ TEST_F(DBEngineTest, DeleteRowsByStatusField)
     .WillOnce(Return(ByMove(std::move(mockStatement_1))));
 
     EXPECT_CALL(*mockConnection, execute("PRAGMA temp_store = memory;")).Times(1);
-    EXPECT_CALL(*mockConnection, execute("PRAGMA journal_mode = truncate;")).Times(1);
+    EXPECT_CALL(*mockConnection, execute("PRAGMA journal_mode = WAL;")).Times(1);
     EXPECT_CALL(*mockConnection, execute("PRAGMA synchronous = OFF;")).Times(1);
     EXPECT_CALL(*mockConnection, execute("PRAGMA user_version = 1;")).Times(1);
 
@@ -404,7 +426,7 @@ TEST_F(DBEngineTest, DeleteRowsByStatusField)
     .WillOnce(Return(STATUS_FIELD_TYPE));
     auto mockColumn_8 { std::make_unique<MockColumn>() };
     EXPECT_CALL(*mockColumn_8, value(An<const int32_t&>()))
-    .WillOnce(Return(1));
+    .WillOnce(Return(0));
 
     auto mockStatement_2 { std::make_unique<MockStatement>() };
     EXPECT_CALL(*mockStatement_2, step())
@@ -431,11 +453,26 @@ TEST_F(DBEngineTest, DeleteRowsByStatusField)
     EXPECT_CALL(*mockStatement_3,
                 step())
     .WillOnce(Return(0));
-
     EXPECT_CALL(*mockFactory,
-                createStatement(_, "DELETE FROM dummy WHERE db_status_field_dm=0;"))
+                createStatement(_, "DELETE FROM dummy WHERE NOT EXISTS (SELECT 1 FROM temp.dummy_SEEN s WHERE s.PID=dummy.PID);"))
     .WillOnce(Return(ByMove(std::move(mockStatement_3))));
 
+    auto mockStatement_4 { std::make_unique<MockStatement>() };
+    EXPECT_CALL(*mockStatement_4,
+                step())
+    .WillOnce(Return(0));
+    EXPECT_CALL(*mockFactory,
+                createStatement(_, "DROP TRIGGER IF EXISTS temp.dummy_SEEN_INSERT;"))
+    .WillOnce(Return(ByMove(std::move(mockStatement_4))));
+
+    auto mockStatement_5 { std::make_unique<MockStatement>() };
+    EXPECT_CALL(*mockStatement_5,
+                step())
+    .WillOnce(Return(0));
+    EXPECT_CALL(*mockFactory,
+                createStatement(_, "DELETE FROM temp.dummy_SEEN;"))
+    .WillOnce(Return(ByMove(std::move(mockStatement_5))));
+
     EXPECT_NO_THROW(spEngine->deleteRowsByStatusField(std::vector<std::string> {"dummy"}));
 }
 
@@ -458,7 +495,7 @@ TEST_F(DBEngineTest, DeleteRowsByStatusFieldNoMetadata)
     .WillOnce(Return(ByMove(std::move(mockStatement_1))));
 
     EXPECT_CALL(*mockConnection, execute("PRAGMA temp_store = memory;")).Times(1);
-    EXPECT_CALL(*mockConnection, execute("PRAGMA journal_mode = truncate;")).Times(1);
+    EXPECT_CALL(*mockConnection, execute("PRAGMA journal_mode = WAL;")).Times(1);
     EXPECT_CALL(*mockConnection, execute("PRAGMA synchronous = OFF;")).Times(1);
     EXPECT_CALL(*mockConnection, execute("PRAGMA user_version = 1;")).Times(1);
 
@@ -498,7 +535,7 @@ TEST_F(DBEngineTest, GetRowsToBeDeletedByStatusFieldNoMetadata)
     .WillOnce(Return(ByMove(std::move(mockStatement_1))));
 
     EXPECT_CALL(*mockConnection, execute("PRAGMA temp_store = memory;")).Times(1);
-    EXPECT_CALL(*mockConnection, execute("PRAGMA journal_mode = truncate;")).Times(1);
+    EXPECT_CALL(*mockConnection, execute("PRAGMA journal_mode = WAL;")).Times(1);
     EXPECT_CALL(*mockConnection, execute("PRAGMA synchronous = OFF;")).Times(1);
     EXPECT_CALL(*mockConnection, execute("PRAGMA user_version = 1;")).Times(1);
 
@@ -544,7 +581,7 @@ TEST_F(DBEngineTest, GetRowsToBeDeletedByStatusField)
 
 
     EXPECT_CALL(*mockConnection, execute("PRAGMA temp_store = memory;")).Times(1);
-    EXPECT_CALL(*mockConnection, execute("PRAGMA journal_mode = truncate;")).Times(1);
+    EXPECT_CALL(*mockConnection, execute("PRAGMA journal_mode = WAL;")).Times(1);
     EXPECT_CALL(*mockConnection, execute("PRAGMA synchronous = OFF;")).Times(1);
     EXPECT_CALL(*mockConnection, execute("PRAGMA user_version = 1;")).Times(1);
 
@@ -578,7 +615,7 @@ TEST_F(DBEngineTest, GetRowsToBeDeletedByStatusField)
     .WillOnce(Return(STATUS_FIELD_TYPE));
     auto mockColumn_8 { std::make_unique<MockColumn>() };
     EXPECT_CALL(*mockColumn_8, value(An<const int32_t&>()))
-    .WillOnce(Return(1));
+    .WillOnce(Return(0));
 
     auto mockStatement_2 { std::make_unique<MockStatement>() };
     EXPECT_CALL(*mockStatement_2, step())
@@ -609,15 +646,13 @@ TEST_F(DBEngineTest, GetRowsToBeDeletedByStatusField)
 
     auto mockColumn_9 = std::make_unique<MockColumn>();
     EXPECT_CALL(*mockColumn_9, hasValue()).WillOnce(Return(true));
-    auto mockColumn_10 = std::make_unique<MockColumn>();
-    EXPECT_CALL(*mockColumn_10, value(An<const int32_t&>())).WillOnce(Return(1));
+    EXPECT_CALL(*mockColumn_9, value(An<const int32_t&>())).WillOnce(Return(1));
 
     EXPECT_CALL(*mockStatement_3, column(0))
-    .WillOnce(Return(ByMove(std::move(mockColumn_9))))
-    .WillOnce(Return(ByMove(std::move(mockColumn_10))));
+    .WillOnce(Return(ByMove(std::move(mockColumn_9))));
 
     EXPECT_CALL(*mockFactory,
-                createStatement(_, "SELECT PID FROM dummy WHERE db_status_field_dm=0;"))
+                createStatement(_, "SELECT PID FROM dummy WHERE NOT EXISTS (SELECT 1 FROM temp.dummy_SEEN s WHERE s.PID=dummy.PID);"))
     .WillOnce(Return(ByMove(std::move(mockStatement_3))));
 
     std::shared_timed_mutex mutex;
@@ -641,8 +676,11 @@ TEST_F(DBEngineTest, deleteTableRowsDataWithoutMetadataShouldThrow)
     std::unique_ptr<SQLiteDBEngine> spEngine;
     initNoMetaDataMocks(spEngine);
 
+    std::shared_timed_mutex mutex;
+    std::unique_lock<std::shared_timed_mutex> lock(mutex);
+
     // Due to the no metadata this should throw
-    EXPECT_THROW(spEngine->deleteTableRowsData("dummy", {}), dbengine_error);
+    EXPECT_THROW(spEngine->deleteTableRowsData("dummy", {}, nullptr, lock), dbengine_error);
 }
 
 TEST_F(DBEngineTest, selectDataWithoutMetadataShouldThrow)
@@ -652,7 +690,7 @@ TEST_F(DBEngineTest, selectDataWithoutMetadataShouldThrow)
 
     // Due to the no metadata this should throw
     std::shared_timed_mutex mutex;
-    std::unique_lock<std::shared_timed_mutex> lock(mutex);
+    Utils::ExclusiveLocking lock(mutex);
     EXPECT_THROW(spEngine->selectData("dummy", {}, nullptr, lock), dbengine_error);
 }
 
@@ -708,7 +746,7 @@ TEST_F(DBEngineTest, AddTableRelationship)
 
 
     EXPECT_CALL(*mockConnection, execute("PRAGMA temp_store = memory;")).Times(1);
-    EXPECT_CALL(*mockConnection, execute("PRAGMA journal_mode = truncate;")).Times(1);
+    EXPECT_CALL(*mockConnection, execute("PRAGMA journal_mode = WAL;")).Times(1);
     EXPECT_CALL(*mockConnection, execute("PRAGMA synchronous = OFF;")).Times(1);
     EXPECT_CALL(*mockConnection, execute("PRAGMA user_version = 1;")).Times(1);
 
@@ -839,7 +877,7 @@ TEST_F(DBEngineTest, AddTableRelationshipNoMetadata)
 
 
     EXPECT_CALL(*mockConnection, execute("PRAGMA temp_store = memory;")).Times(1);
-    EXPECT_CALL(*mockConnection, execute("PRAGMA journal_mode = truncate;")).Times(1);
+    EXPECT_CALL(*mockConnection, execute("PRAGMA journal_mode = WAL;")).Times(1);
     EXPECT_CALL(*mockConnection, execute("PRAGMA synchronous = OFF;")).Times(1);
     EXPECT_CALL(*mockConnection, execute("PRAGMA user_version = 1;")).Times(1);
 
@@ -859,3 +897,20 @@ TEST_F(DBEngineTest, AddTableRelationshipNoMetadata)
 
     EXPECT_THROW(spEngine->addTableRelationship(relationshipJSON), dbengine_error);
 }
+
+TEST_F(DBEngineTest, StatementCacheReusesRowShapes)
+{
+    const auto sql { "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, `tid` BIGINT, PRIMARY KEY (`pid`)) WITHOUT ROWID;" };
+    std::unique_ptr<SQLiteDBEngine> spEngine;
+    EXPECT_NO_THROW(spEngine = std::make_unique<SQLiteDBEngine>(std::make_shared<SQLiteFactory>(), ":memory:", sql));
+
+    const auto before { spEngine->statementCacheStats() };
+
+    // Two shapes: all the columns, and the rows without 'tid'.
+    spEngine->bulkInsert("processes", nlohmann::json::parse(R"([{"pid":1,"name":"a","tid":1},{"pid":2,"name":"b"},
+                                                                {"pid":3,"name":"c","tid":3},{"pid":4,"name":"d"}])"));
+
+    const auto after { spEngine->statementCacheStats() };
+    EXPECT_EQ(2u, after.misses - before.misses);
+    EXPECT_EQ(2u, after.hits - before.hits);
+}
@@ -10,6 +10,11 @@
  */
 
 #include <iostream>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <sqlite3.h>
 #include <nlohmann/json.hpp>
 #include "dbsync_test.h"
 #include "dbsync.h"
@@ -502,6 +507,30 @@ TEST_F(DBSyncTest, UpdateDataCb)
     EXPECT_EQ(0, dbsync_update_with_snapshot_cb(handle, jsInsert.get(), callbackData));
 }
 
+TEST_F(DBSyncTest, UpdateDataCbWithCompoundPKs)
+{
+    const auto sql{ "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, `tid` BIGINT, PRIMARY KEY (`pid`, `name`)) WITHOUT ROWID;"};
+    const auto insertionSqlStmt{ R"({"table":"processes","data":[{"pid":4,"name":"System","tid":100},{"pid":7,"name":"Guake","tid":101}]})"};
+    const auto updateSqlStmt{ R"({"table":"processes","data":[{"pid":7,"name":"Guake","tid":102}]})"};
+
+    const auto handle { dbsync_create(HostType::AGENT, DbEngineType::SQLITE3, DATABASE_TEMP, sql) };
+    ASSERT_NE(nullptr, handle);
+
+    const std::unique_ptr<cJSON, CJsonSmartDeleter> jsInsert{ cJSON_Parse(insertionSqlStmt) };
+    const std::unique_ptr<cJSON, CJsonSmartDeleter> jsUpdate{ cJSON_Parse(updateSqlStmt) };
+
+    CallbackMock wrapper;
+    callback_data_t callbackData { callback, &wrapper };
+
+    EXPECT_CALL(wrapper, callbackMock(INSERTED, nlohmann::json::parse(R"({"pid":4,"name":"System","tid":100})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(INSERTED, nlohmann::json::parse(R"({"pid":7,"name":"Guake","tid":101})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(DELETED, nlohmann::json::parse(R"({"pid":4,"name":"System"})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(MODIFIED, nlohmann::json::parse(R"({"PK_pid":7,"PK_name":"Guake","tid":102})"))).Times(1);
+
+    EXPECT_EQ(0, dbsync_update_with_snapshot_cb(handle, jsInsert.get(), callbackData));
+    EXPECT_EQ(0, dbsync_update_with_snapshot_cb(handle, jsUpdate.get(), callbackData));
+}
+
 TEST_F(DBSyncTest, UpdateDataCbBadInputs)
 {
     const auto sql{ "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, PRIMARY KEY (`pid`)) WITHOUT ROWID;"};
@@ -729,6 +758,372 @@ TEST_F(DBSyncTest, syncRowInsertAndModified)
     EXPECT_NE(0, dbsync_sync_row(handle, jsInsert2.get(), callbackEmpty));
 }
 
+TEST_F(DBSyncTest, syncRowAfterTxnDeletion)
+{
+    const auto sql{ "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, `tid` BIGINT, PRIMARY KEY (`pid`)) WITHOUT ROWID;"};
+    const auto handle { dbsync_create(HostType::AGENT, DbEngineType::SQLITE3, DATABASE_TEMP, sql) };
+    ASSERT_NE(nullptr, handle);
+
+    CallbackMock wrapper;
+    EXPECT_CALL(wrapper, callbackMock(INSERTED, nlohmann::json::parse(R"({"pid":4,"name":"System","tid":100})"))).Times(2);
+    EXPECT_CALL(wrapper, callbackMock(INSERTED, nlohmann::json::parse(R"({"pid":5,"name":"System","tid":101})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(DELETED, nlohmann::json::parse(R"({"pid":4,"name":"System","tid":100})"))).Times(1);
+
+    const auto syncSqlStmt1{ R"({"table":"processes","data":[{"pid":4,"name":"System","tid":100}]})"};
+    const auto syncSqlStmt2{ R"({"table":"processes","data":[{"pid":5,"name":"System","tid":101}]})"};
+    const auto table { R"({"table":"processes"})" };
+
+    const std::unique_ptr<cJSON, CJsonSmartDeleter> jsSync1{ cJSON_Parse(syncSqlStmt1) };
+    const std::unique_ptr<cJSON, CJsonSmartDeleter> jsSync2{ cJSON_Parse(syncSqlStmt2) };
+    const std::unique_ptr<cJSON, CJsonSmartDeleter> jsTables{ cJSON_Parse(table) };
+
+    callback_data_t callbackData { callback, &wrapper };
+
+    EXPECT_EQ(0, dbsync_sync_row(handle, jsSync1.get(), callbackData));  // Expect an insert event
+    EXPECT_EQ(0, dbsync_sync_row(handle, jsSync1.get(), callbackData));  // Unchanged, no event
+
+    // The row not synced in the txn is deleted, so syncing it again must insert it.
+    const auto txnHandle { dbsync_create_txn(handle, jsTables.get(), 0, 100, callbackData) };
+    ASSERT_NE(nullptr, txnHandle);
+    EXPECT_EQ(0, dbsync_sync_txn_row(txnHandle, jsSync2.get()));
+    EXPECT_EQ(0, dbsync_get_deleted_rows(txnHandle, callbackData));
+    EXPECT_EQ(0, dbsync_close_txn(txnHandle));
+
+    EXPECT_EQ(0, dbsync_sync_row(handle, jsSync1.get(), callbackData));  // Expect an insert event
+}
+
+TEST_F(DBSyncTest, txnKeepsUnchangedRows)
+{
+    const auto sql{ "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, `tid` BIGINT, PRIMARY KEY (`pid`)) WITHOUT ROWID;"};
+    const auto tables { R"({"table":"processes"})" };
+    std::unique_ptr<DBSync> dbSync;
+
+    EXPECT_NO_THROW(dbSync = std::make_unique<DBSync>(HostType::AGENT, DbEngineType::SQLITE3, DATABASE_TEMP, sql));
+
+    CallbackMock wrapper;
+    EXPECT_CALL(wrapper, callbackMock(INSERTED, nlohmann::json::parse(R"({"pid":4,"name":"System","tid":100})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(INSERTED, nlohmann::json::parse(R"({"pid":5,"name":"System","tid":101})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(INSERTED, nlohmann::json::parse(R"({"pid":6,"name":"System","tid":102})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(MODIFIED, nlohmann::json::parse(R"({"pid":5,"name":"System","tid":111})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(DELETED, nlohmann::json::parse(R"({"pid":6,"name":"System","tid":102})"))).Times(1);
+
+    ResultCallbackData callbackData
+    {
+        [&wrapper](ReturnTypeCallback type, const nlohmann::json & jsonResult)
+        {
+            wrapper.callbackMock(type, jsonResult);
+        }
+    };
+
+    const auto insertionSqlStmt{ R"({"table":"processes","data":[{"pid":4,"name":"System","tid":100},{"pid":5,"name":"System","tid":101},{"pid":6,"name":"System","tid":102}]})"};
+    EXPECT_NO_THROW(dbSync->syncRow(nlohmann::json::parse(insertionSqlStmt), callbackData));
+
+    // The unchanged row and the modified one are kept, the row not synced in the txn is deleted.
+    std::unique_ptr<DBSyncTxn> dbSyncTxn;
+    EXPECT_NO_THROW(dbSyncTxn = std::make_unique<DBSyncTxn>(dbSync->handle(), nlohmann::json::parse(tables), 0, 100, callbackData));
+
+    const auto syncTxnData{ R"({"table":"processes","data":[{"pid":4,"name":"System","tid":100},{"pid":5,"name":"System","tid":111}]})"};
+    EXPECT_NO_THROW(dbSyncTxn->syncTxnRow(nlohmann::json::parse(syncTxnData)));
+    EXPECT_NO_THROW(dbSyncTxn->getDeletedRows(callbackData));
+    dbSyncTxn.reset();
+
+    // No internal column is added to the table.
+    EXPECT_CALL(wrapper, callbackMock(SELECTED, nlohmann::json::parse(R"({"pid":4,"name":"System","tid":100})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(SELECTED, nlohmann::json::parse(R"({"pid":5,"name":"System","tid":111})"))).Times(1);
+
+    const auto selectData
+    {
+        R"({"table":"processes",
+           "query":{"column_list":["*"],
+           "row_filter":"",
+           "distinct_opt":false,
+           "order_by_opt":"",
+           "count_opt":100}})"
+    };
+
+    EXPECT_NO_THROW(dbSync->selectRows(nlohmann::json::parse(selectData), callbackData));
+}
+
+TEST_F(DBSyncTest, syncRowIgnoredDiffIsNotDigested)
+{
+    const auto sql{ "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, `tid` BIGINT, PRIMARY KEY (`pid`)) WITHOUT ROWID;"};
+    std::unique_ptr<DBSync> dbSync;
+
+    EXPECT_NO_THROW(dbSync = std::make_unique<DBSync>(HostType::AGENT, DbEngineType::SQLITE3, DATABASE_TEMP, sql));
+
+    CallbackMock wrapper;
+    EXPECT_CALL(wrapper, callbackMock(INSERTED, nlohmann::json::parse(R"({"pid":4,"name":"System","tid":100})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(MODIFIED, nlohmann::json::parse(R"({"pid":4,"name":"System","tid":101})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(SELECTED, nlohmann::json::parse(R"({"pid":4,"name":"System","tid":101})"))).Times(1);
+
+    ResultCallbackData callbackData
+    {
+        [&wrapper](ReturnTypeCallback type, const nlohmann::json & jsonResult)
+        {
+            wrapper.callbackMock(type, jsonResult);
+        }
+    };
+
+    EXPECT_NO_THROW(dbSync->syncRow(nlohmann::json::parse(R"({"table":"processes","data":[{"pid":4,"name":"System","tid":100}]})"), callbackData));
+
+    // The diff is only in an ignored column, so the row is not written.
+    auto ignoredSync = SyncRowQuery::builder().table("processes")
+                       .ignoreColumn("tid")
+                       .data(nlohmann::json::parse(R"({"pid":4,"name":"System","tid":101})"));
+    EXPECT_NO_THROW(dbSync->syncRow(ignoredSync.query(), callbackData));
+
+    // The same row synced without ignored columns is still found modified, and stored.
+    EXPECT_NO_THROW(dbSync->syncRow(nlohmann::json::parse(R"({"table":"processes","data":[{"pid":4,"name":"System","tid":101}]})"), callbackData));
+
+    const auto selectData
+    {
+        R"({"table":"processes",
+           "query":{"column_list":["*"],
+           "row_filter":"",
+           "distinct_opt":false,
+           "order_by_opt":"",
+           "count_opt":100}})"
+    };
+
+    EXPECT_NO_THROW(dbSync->selectRows(nlohmann::json::parse(selectData), callbackData));
+}
+
+TEST_F(DBSyncTest, txnBatchedResults)
+{
+    const auto sql{ "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, `tid` BIGINT, PRIMARY KEY (`pid`)) WITHOUT ROWID;"};
+    const auto tables { R"({"table":"processes"})" };
+    constexpr auto BATCH_SIZE { 4u };
+    constexpr auto MAX_QUEUE_SIZE { 8u };
+    constexpr auto ROWS { 50 };
+    std::unique_ptr<DBSync> dbSync;
+
+    EXPECT_NO_THROW(dbSync = std::make_unique<DBSync>(HostType::AGENT, DbEngineType::SQLITE3, DATABASE_TEMP, sql));
+
+    CallbackMock wrapper;
+    EXPECT_CALL(wrapper, callbackMock(INSERTED, nlohmann::json::parse(R"({"pid":1000,"name":"System","tid":100})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(DELETED, nlohmann::json::parse(R"({"pid":1000,"name":"System","tid":100})"))).Times(1);
+
+    ResultCallbackData callbackData
+    {
+        [&wrapper](ReturnTypeCallback type, const nlohmann::json & jsonResult)
+        {
+            wrapper.callbackMock(type, jsonResult);
+        }
+    };
+
+    EXPECT_NO_THROW(dbSync->syncRow(nlohmann::json::parse(R"({"table":"processes","data":[{"pid":1000,"name":"System","tid":100}]})"), callbackData));
+
+    std::vector<std::pair<ReturnTypeCallback, nlohmann::json>> results;
+    size_t largestBatch { 0 };
+    ResultBatchCallbackData batchCallbackData
+    {
+        [&results, &largestBatch](const std::vector<std::pair<ReturnTypeCallback, nlohmann::json>>& batch)
+        {
+            largestBatch = std::max(largestBatch, batch.size());
+            results.insert(results.end(), batch.begin(), batch.end());
+        }
+    };
+
+    std::unique_ptr<DBSyncTxn> dbSyncTxn;
+    EXPECT_NO_THROW(dbSyncTxn = std::make_unique<DBSyncTxn>(dbSync->handle(), nlohmann::json::parse(tables), batchCallbackData, BATCH_SIZE, MAX_QUEUE_SIZE));
+
+    for (auto pid = 0; pid < ROWS; ++pid)
+    {
+        nlohmann::json input;
+        input["table"] = "processes";
+        input["data"] = nlohmann::json::array({ { { "pid", pid % (ROWS / 2) }, { "name", "System" }, { "tid", pid } } });
+        EXPECT_NO_THROW(dbSyncTxn->syncTxnRow(input));
+    }
+
+    EXPECT_NO_THROW(dbSyncTxn->getDeletedRows(callbackData));
+    dbSyncTxn.reset();
+
+    // Every row is inserted, then modified, in the order it was synced.
+    ASSERT_EQ(static_cast<size_t>(ROWS), results.size());
+    EXPECT_LE(largestBatch, BATCH_SIZE);
+
+    for (auto pid = 0; pid < ROWS; ++pid)
+    {
+        EXPECT_EQ(pid < ROWS / 2 ? INSERTED : MODIFIED, results[pid].first);
+        EXPECT_EQ(pid, results[pid].second.at("tid"));
+    }
+}
+
+TEST_F(DBSyncTest, snapshotTxn)
+{
+    const auto sql{ "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, `tid` BIGINT, PRIMARY KEY (`pid`)) WITHOUT ROWID;"};
+    const auto tables { R"({"table":"processes","options":{"snapshot":true}})" };
+    std::unique_ptr<DBSync> dbSync;
+
+    EXPECT_NO_THROW(dbSync = std::make_unique<DBSync>(HostType::AGENT, DbEngineType::SQLITE3, DATABASE_TEMP, sql));
+
+    CallbackMock wrapper;
+    EXPECT_CALL(wrapper, callbackMock(INSERTED, nlohmann::json::parse(R"({"pid":4,"name":"System","tid":100})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(INSERTED, nlohmann::json::parse(R"({"pid":5,"name":"System","tid":101})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(INSERTED, nlohmann::json::parse(R"({"pid":6,"name":"System","tid":102})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(INSERTED, nlohmann::json::parse(R"({"pid":7,"name":"Guake","tid":103})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(MODIFIED, nlohmann::json::parse(R"({"new":{"pid":5,"name":"System","tid":111},"old":{"pid":5,"tid":101}})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(DELETED, nlohmann::json::parse(R"({"pid":6,"name":"System","tid":102})"))).Times(1);
+
+    ResultCallbackData callbackData
+    {
+        [&wrapper](ReturnTypeCallback type, const nlohmann::json & jsonResult)
+        {
+            wrapper.callbackMock(type, jsonResult);
+        }
+    };
+
+    const auto insertionSqlStmt{ R"({"table":"processes","data":[{"pid":4,"name":"System","tid":100},{"pid":5,"name":"System","tid":101},{"pid":6,"name":"System","tid":102}]})"};
+    EXPECT_NO_THROW(dbSync->syncRow(nlohmann::json::parse(insertionSqlStmt), callbackData));
+
+    // The changes are only found when the snapshot is applied.
+    std::unique_ptr<DBSyncTxn> dbSyncTxn;
+    EXPECT_NO_THROW(dbSyncTxn = std::make_unique<DBSyncTxn>(dbSync->handle(), nlohmann::json::parse(tables), 0, 100, callbackData));
+
+    const auto syncTxnData1{ R"({"table":"processes","data":[{"pid":4,"name":"System","tid":100},{"pid":5,"name":"System","tid":111}],"options":{"return_old_data":true}})"};
+    const auto syncTxnData2{ R"({"table":"processes","data":[{"pid":7,"name":"Guake","tid":103}],"options":{"return_old_data":true}})"};
+    EXPECT_NO_THROW(dbSyncTxn->syncTxnRow(nlohmann::json::parse(syncTxnData1)));
+    EXPECT_NO_THROW(dbSyncTxn->syncTxnRow(nlohmann::json::parse(syncTxnData2)));
+    EXPECT_NO_THROW(dbSyncTxn->getDeletedRows(callbackData));
+    dbSyncTxn.reset();
+
+    EXPECT_CALL(wrapper, callbackMock(SELECTED, nlohmann::json::parse(R"({"pid":4,"name":"System","tid":100})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(SELECTED, nlohmann::json::parse(R"({"pid":5,"name":"System","tid":111})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(SELECTED, nlohmann::json::parse(R"({"pid":7,"name":"Guake","tid":103})"))).Times(1);
+
+    const auto selectData
+    {
+        R"({"table":"processes",
+           "query":{"column_list":["*"],
+           "row_filter":"",
+           "distinct_opt":false,
+           "order_by_opt":"",
+           "count_opt":100}})"
+    };
+
+    EXPECT_NO_THROW(dbSync->selectRows(nlohmann::json::parse(selectData), callbackData));
+}
+
+TEST_F(DBSyncTest, snapshotTxnKeepUnseen)
+{
+    const auto sql{ "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, `tid` BIGINT, PRIMARY KEY (`pid`)) WITHOUT ROWID;"};
+    const auto tables { R"({"table":"processes","options":{"snapshot":true}})" };
+
+    for (const auto engine : { DbEngineType::SQLITE3, DbEngineType::MEMORY })
+    {
+        std::unique_ptr<DBSync> dbSync;
+        EXPECT_NO_THROW(dbSync = std::make_unique<DBSync>(HostType::AGENT, engine, DATABASE_TEMP, sql));
+
+        CallbackMock wrapper;
+        EXPECT_CALL(wrapper, callbackMock(INSERTED, nlohmann::json::parse(R"({"pid":4,"name":"System","tid":100})"))).Times(1);
+        EXPECT_CALL(wrapper, callbackMock(INSERTED, nlohmann::json::parse(R"({"pid":5,"name":"System","tid":101})"))).Times(1);
+        EXPECT_CALL(wrapper, callbackMock(INSERTED, nlohmann::json::parse(R"({"pid":7,"name":"Guake","tid":103})"))).Times(1);
+        EXPECT_CALL(wrapper, callbackMock(MODIFIED, nlohmann::json::parse(R"({"pid":5,"name":"System","tid":111})"))).Times(1);
+        EXPECT_CALL(wrapper, callbackMock(DELETED, ::testing::_)).Times(0);
+
+        ResultCallbackData callbackData
+        {
+            [&wrapper](ReturnTypeCallback type, const nlohmann::json & jsonResult)
+            {
+                wrapper.callbackMock(type, jsonResult);
+            }
+        };
+
+        const auto insertionSqlStmt{ R"({"table":"processes","data":[{"pid":4,"name":"System","tid":100},{"pid":5,"name":"System","tid":101}]})"};
+        EXPECT_NO_THROW(dbSync->syncRow(nlohmann::json::parse(insertionSqlStmt), callbackData));
+
+        // The snapshot is partial, so the row it does not have is kept.
+        std::unique_ptr<DBSyncTxn> dbSyncTxn;
+        EXPECT_NO_THROW(dbSyncTxn = std::make_unique<DBSyncTxn>(dbSync->handle(), nlohmann::json::parse(tables), 0, 100, callbackData));
+        EXPECT_NO_THROW(dbSyncTxn->syncTxnRow(nlohmann::json::parse(R"({"table":"processes","data":[{"pid":5,"name":"System","tid":111},{"pid":7,"name":"Guake","tid":103}]})")));
+        EXPECT_NO_THROW(dbSyncTxn->syncTxnRow(nlohmann::json::parse(R"({"table":"processes","data":[],"options":{"keep_unseen":true}})")));
+        EXPECT_NO_THROW(dbSyncTxn->getDeletedRows(callbackData));
+        dbSyncTxn.reset();
+
+        EXPECT_CALL(wrapper, callbackMock(SELECTED, nlohmann::json::parse(R"({"pid":4,"name":"System","tid":100})"))).Times(1);
+        EXPECT_CALL(wrapper, callbackMock(SELECTED, nlohmann::json::parse(R"({"pid":5,"name":"System","tid":111})"))).Times(1);
+        EXPECT_CALL(wrapper, callbackMock(SELECTED, nlohmann::json::parse(R"({"pid":7,"name":"Guake","tid":103})"))).Times(1);
+
+        const auto selectData
+        {
+            R"({"table":"processes",
+               "query":{"column_list":["*"],
+               "row_filter":"",
+               "distinct_opt":false,
+               "order_by_opt":"",
+               "count_opt":100}})"
+        };
+
+        EXPECT_NO_THROW(dbSync->selectRows(nlohmann::json::parse(selectData), callbackData));
+        dbSync.reset();
+        std::remove(DATABASE_TEMP);
+    }
+}
+
+TEST_F(DBSyncTest, snapshotTxnLargeTable)
+{
+    const auto sql{ "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, `tid` BIGINT, PRIMARY KEY (`pid`)) WITHOUT ROWID;"};
+    const auto tables { R"({"table":"processes","options":{"snapshot":true}})" };
+    std::unique_ptr<DBSync> dbSync;
+
+    EXPECT_NO_THROW(dbSync = std::make_unique<DBSync>(HostType::AGENT, DbEngineType::SQLITE3, DATABASE_TEMP, sql));
+
+    std::map<ReturnTypeCallback, size_t> results;
+    ResultCallbackData callbackData
+    {
+        [&results](ReturnTypeCallback type, const nlohmann::json&)
+        {
+            ++results[type];
+        }
+    };
+
+    const auto syncSnapshot
+    {
+        [&](const int rows, const int tid)
+        {
+            DBSyncTxn dbSyncTxn { dbSync->handle(), nlohmann::json::parse(tables), 0, 100, callbackData };
+
+            for (auto pid = 0; pid < rows; ++pid)
+            {
+                dbSyncTxn.syncTxnRow({ { "table", "processes" }, { "data", { { { "pid", pid }, { "name", "System" }, { "tid", tid + pid % 2 } } } } });
+            }
+
+            // Nothing is reported until the snapshot is applied.
+            EXPECT_TRUE(results.empty());
+            dbSyncTxn.getDeletedRows(callbackData);
+        }
+    };
+
+    // Rows are appended and reported across several batches and chunks.
+    EXPECT_NO_THROW(syncSnapshot(5000, 0));
+    EXPECT_EQ(5000u, results[INSERTED]);
+
+    // Every row is modified, and each one is updated from its own staged result.
+    results.clear();
+    EXPECT_NO_THROW(syncSnapshot(5000, 10));
+    EXPECT_EQ(0u, results[INSERTED]);
+    EXPECT_EQ(5000u, results[MODIFIED]);
+    EXPECT_EQ(0u, results[DELETED]);
+
+    const auto selectModified{ R"({"table":"processes","query":{"column_list":["count(*) AS count"],"row_filter":"WHERE tid >= 10","distinct_opt":false,"order_by_opt":"","count_opt":1}})"};
+    int64_t modified { 0 };
+    ResultCallbackData selectCallback
+    {
+        [&modified](ReturnTypeCallback, const nlohmann::json & jsonResult)
+        {
+            modified = jsonResult.at("count").get<int64_t>();
+        }
+    };
+    EXPECT_NO_THROW(dbSync->selectRows(nlohmann::json::parse(selectModified), selectCallback));
+    EXPECT_EQ(5000, modified);
+
+    results.clear();
+    EXPECT_NO_THROW(syncSnapshot(2000, 10));
+    EXPECT_EQ(0u, results[INSERTED]);
+    EXPECT_EQ(0u, results[MODIFIED]);
+    EXPECT_EQ(3000u, results[DELETED]);
+}
+
 TEST_F(DBSyncTest, syncRowInsertAndModifiedWithOldData)
 {
     const auto sql{ "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, `tid` BIGINT, PRIMARY KEY (`pid`)) WITHOUT ROWID;"};
@@ -1491,6 +1886,41 @@ TEST_F(DBSyncTest, deleteRowsByFilter)
     EXPECT_EQ(0, dbsync_delete_rows(handle, jsrowDeleteByNameFilter.get()));
 }
 
+TEST_F(DBSyncTest, deleteRowsWithCallback)
+{
+    const auto sql{ "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, `tid` BIGINT, PRIMARY KEY (`pid`)) WITHOUT ROWID;"};
+    std::unique_ptr<DBSync> dbSync;
+
+    EXPECT_NO_THROW(dbSync = std::make_unique<DBSync>(HostType::AGENT, DbEngineType::SQLITE3, DATABASE_TEMP, sql));
+
+    const auto initialData{ R"({"table":"processes","data":[{"pid":4,"name":"System","tid":100},
+                                                            {"pid":5,"name":"User1","tid":101},
+                                                            {"pid":6,"name":"User2","tid":102}]})"};
+    EXPECT_NO_THROW(dbSync->insertData(nlohmann::json::parse(initialData)));
+
+    // Each deleted row is reported with all its data, the rows not found are not reported.
+    CallbackMock wrapper;
+    EXPECT_CALL(wrapper, callbackMock(DELETED, nlohmann::json::parse(R"({"pid":4,"name":"System","tid":100})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(DELETED, nlohmann::json::parse(R"({"pid":6,"name":"User2","tid":102})"))).Times(1);
+
+    ResultCallbackData callbackData
+    {
+        [&wrapper](ReturnTypeCallback type, const nlohmann::json & jsonResult)
+        {
+            wrapper.callbackMock(type, jsonResult);
+        }
+    };
+
+    const auto rowDeleteByPK{ R"({"table":"processes","query":{"data":[{"pid":4},{"pid":7}],"where_filter_opt":""}})"};
+    const auto rowDeleteByFilter{ R"({"table":"processes","query":{"data":[],"where_filter_opt":"tid=102"}})"};
+    EXPECT_NO_THROW(dbSync->deleteRows(nlohmann::json::parse(rowDeleteByPK), callbackData));
+    EXPECT_NO_THROW(dbSync->deleteRows(nlohmann::json::parse(rowDeleteByFilter), callbackData));
+
+    EXPECT_CALL(wrapper, callbackMock(SELECTED, nlohmann::json::parse(R"({"pid":5,"name":"User1","tid":101})"))).Times(1);
+    const auto selectData{ R"({"table":"processes","query":{"column_list":["*"],"row_filter":"","distinct_opt":false,"order_by_opt":"","count_opt":100}})"};
+    EXPECT_NO_THROW(dbSync->selectRows(nlohmann::json::parse(selectData), callbackData));
+}
+
 TEST_F(DBSyncTest, deleteRowsWithDataMorePriorityThanFilter)
 {
     const auto sql{ "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, `tid` BIGINT, PRIMARY KEY (`pid`)) WITHOUT ROWID;"};
@@ -2434,3 +2864,361 @@ TEST_F(DBSyncTest, TestUpgrade)
 
     EXPECT_NO_THROW(dbSync->selectRows(selectQuery.query(), selectCallbackData));
 }
+
+TEST_F(DBSyncTest, selectRowsFromReaderWhileTxnIsOpen)
+{
+    const auto sql{ "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, PRIMARY KEY (`pid`)) WITHOUT ROWID;"};
+    const auto tables { R"({"table":"processes"})" };
+    std::unique_ptr<DBSync> dbSync;
+
+    EXPECT_NO_THROW(dbSync = std::make_unique<DBSync>(HostType::AGENT, DbEngineType::SQLITE3, DATABASE_TEMP, sql));
+    EXPECT_NO_THROW(dbSync->insertData(nlohmann::json::parse(R"({"table":"processes","data":[{"pid":4,"name":"System"}]})")));
+
+    CallbackMock wrapper;
+    EXPECT_CALL(wrapper, callbackMock(INSERTED, nlohmann::json::parse(R"({"pid":5,"name":"Guake"})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(SELECTED, nlohmann::json::parse(R"({"pid":4,"name":"System"})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(SELECTED, nlohmann::json::parse(R"({"pid":5,"name":"Guake"})"))).Times(1);
+
+    ResultCallbackData callbackData
+    {
+        [&wrapper](ReturnTypeCallback type, const nlohmann::json & jsonResult)
+        {
+            wrapper.callbackMock(type, jsonResult);
+        }
+    };
+
+    std::unique_ptr<DBSyncTxn> dbSyncTxn;
+    EXPECT_NO_THROW(dbSyncTxn = std::make_unique<DBSyncTxn>(dbSync->handle(), nlohmann::json::parse(tables), 0, 100, callbackData));
+    EXPECT_NO_THROW(dbSyncTxn->syncTxnRow(nlohmann::json::parse(R"({"table":"processes","data":[{"pid":5,"name":"Guake"}]})")));
+
+    // The rows synced so far are read from another connection, while the txn is still open.
+    const auto selectProcesses{ R"({"table":"processes","query":{"column_list":["*"],"row_filter":"","distinct_opt":false,"order_by_opt":"pid","count_opt":100}})"};
+    std::thread reader
+    {
+        [&]()
+        {
+            EXPECT_NO_THROW(dbSync->selectRows(nlohmann::json::parse(selectProcesses), callbackData));
+        }
+    };
+    reader.join();
+
+    EXPECT_NO_THROW(dbSyncTxn->syncTxnRow(nlohmann::json::parse(R"({"table":"processes","data":[{"pid":4,"name":"System"}]})")));
+    EXPECT_NO_THROW(dbSyncTxn->getDeletedRows(callbackData));
+}
+
+TEST_F(DBSyncTest, selectRowsWhileTxnSyncHoldsLock)
+{
+    constexpr auto ROWS { 5000 };
+    const auto sql{ "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, PRIMARY KEY (`pid`)) WITHOUT ROWID;"};
+    const auto tables { R"({"table":"processes"})" };
+    std::unique_ptr<DBSync> dbSync;
+
+    EXPECT_NO_THROW(dbSync = std::make_unique<DBSync>(HostType::AGENT, DbEngineType::SQLITE3, DATABASE_TEMP, sql));
+
+    nlohmann::json rows = nlohmann::json::array();
+
+    for (auto pid = 1; pid <= ROWS; ++pid)
+    {
+        rows.push_back({ { "pid", pid }, { "name", "System" } });
+    }
+
+    nlohmann::json insert;
+    insert["table"] = "processes";
+    insert["data"] = rows;
+    EXPECT_NO_THROW(dbSync->insertData(insert));
+
+    // The first and the last rows are new, every row in between is unchanged, so the sync keeps its lock while it goes through them.
+    std::mutex mutex;
+    std::condition_variable started;
+    auto firstSynced { false };
+    std::atomic<bool> lastSynced { false };
+    ResultCallbackData callbackData
+    {
+        [&](ReturnTypeCallback type, const nlohmann::json & jsonResult)
+        {
+            if (INSERTED == type && 0 == jsonResult.at("pid"))
+            {
+                std::lock_guard<std::mutex> lock{ mutex };
+                firstSynced = true;
+                started.notify_one();
+            }
+            else if (INSERTED == type)
+            {
+                lastSynced = true;
+            }
+        }
+    };
+
+    rows.insert(rows.begin(), nlohmann::json { { "pid", 0 }, { "name", "Idle" } });
+    rows.push_back({ { "pid", ROWS + 1 }, { "name", "Guake" } });
+    nlohmann::json sync;
+    sync["table"] = "processes";
+    sync["data"] = rows;
+
+    std::unique_ptr<DBSyncTxn> dbSyncTxn;
+    EXPECT_NO_THROW(dbSyncTxn = std::make_unique<DBSyncTxn>(dbSync->handle(), nlohmann::json::parse(tables), 1, 0, callbackData));
+    std::thread writer
+    {
+        [&]()
+        {
+            EXPECT_NO_THROW(dbSyncTxn->syncTxnRow(sync));
+        }
+    };
+
+    {
+        std::unique_lock<std::mutex> lock{ mutex };
+        started.wait(lock, [&firstSynced]()
+        {
+            return firstSynced;
+        });
+    }
+
+    // The select only reads the committed rows, and it ends before the sync does.
+    int64_t count { -1 };
+    ResultCallbackData selectCallback
+    {
+        [&count](ReturnTypeCallback, const nlohmann::json & jsonResult)
+        {
+            count = jsonResult.at("count").get<int64_t>();
+        }
+    };
+    const auto selectCount{ R"({"table":"processes","query":{"column_list":["count(*) AS count"],"row_filter":"","distinct_opt":false,"order_by_opt":"","count_opt":1}})"};
+    EXPECT_NO_THROW(dbSync->selectRows(nlohmann::json::parse(selectCount), selectCallback));
+    EXPECT_FALSE(lastSynced);
+    EXPECT_EQ(ROWS, count);
+
+    writer.join();
+    EXPECT_TRUE(lastSynced);
+}
+
+TEST_F(DBSyncTest, rowSyncsAreCommittedWhenRead)
+{
+    constexpr auto ROWS { 1000 };
+    const auto sql{ "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, PRIMARY KEY (`pid`)) WITHOUT ROWID;"};
+    const auto tables { R"({"table":"processes"})" };
+    const auto selectCount{ R"({"table":"processes","query":{"column_list":["count(*) AS count"],"row_filter":"","distinct_opt":false,"order_by_opt":"","count_opt":1}})"};
+    std::unique_ptr<DBSync> dbSync;
+
+    EXPECT_NO_THROW(dbSync = std::make_unique<DBSync>(HostType::AGENT, DbEngineType::SQLITE3, DATABASE_TEMP, sql));
+
+    // Another connection only sees the committed rows.
+    const auto committedRows
+    {
+        []()
+        {
+            sqlite3* db { nullptr };
+            sqlite3_stmt* stmt { nullptr };
+            int64_t count { -1 };
+            EXPECT_EQ(SQLITE_OK, sqlite3_open_v2(DATABASE_TEMP, &db, SQLITE_OPEN_READONLY, nullptr));
+            EXPECT_EQ(SQLITE_OK, sqlite3_prepare_v2(db, "SELECT count(*) FROM processes;", -1, &stmt, nullptr));
+
+            if (SQLITE_ROW == sqlite3_step(stmt))
+            {
+                count = sqlite3_column_int64(stmt, 0);
+            }
+
+            sqlite3_finalize(stmt);
+            sqlite3_close(db);
+            return count;
+        }
+    };
+
+    int64_t count { -1 };
+    ResultCallbackData selectCallback
+    {
+        [&count](ReturnTypeCallback, const nlohmann::json & jsonResult)
+        {
+            count = jsonResult.at("count").get<int64_t>();
+        }
+    };
+    ResultCallbackData callbackData
+    {
+        [](ReturnTypeCallback, const nlohmann::json&)
+        {
+        }
+    };
+
+    // The first scan syncs one row per call, as the modules do, and none of them is committed on its own.
+    for (auto pid = 1; pid <= ROWS; ++pid)
+    {
+        nlohmann::json sync;
+        sync["table"] = "processes";
+        sync["data"] = nlohmann::json::array({ { { "pid", pid }, { "name", "System" } } });
+        EXPECT_NO_THROW(dbSync->syncRow(sync, callbackData));
+    }
+
+    EXPECT_EQ(0, committedRows());
+    EXPECT_NO_THROW(dbSync->selectRows(nlohmann::json::parse(selectCount), selectCallback));
+    EXPECT_EQ(ROWS, count);
+    EXPECT_EQ(ROWS, committedRows());
+
+    std::unique_ptr<DBSyncTxn> dbSyncTxn;
+    EXPECT_NO_THROW(dbSyncTxn = std::make_unique<DBSyncTxn>(dbSync->handle(), nlohmann::json::parse(tables), 0, 0, callbackData));
+
+    for (auto pid = ROWS + 1; pid <= 2 * ROWS; ++pid)
+    {
+        nlohmann::json sync;
+        sync["table"] = "processes";
+        sync["data"] = nlohmann::json::array({ { { "pid", pid }, { "name", "System" } } });
+        EXPECT_NO_THROW(dbSyncTxn->syncTxnRow(sync));
+    }
+
+    EXPECT_EQ(ROWS, committedRows());
+    EXPECT_NO_THROW(dbSync->selectRows(nlohmann::json::parse(selectCount), selectCallback));
+    EXPECT_EQ(2 * ROWS, count);
+    EXPECT_EQ(2 * ROWS, committedRows());
+    EXPECT_NO_THROW(dbSyncTxn->getDeletedRows(callbackData));
+}
+
+TEST_F(DBSyncTest, memoryEngineSyncRow)
+{
+    const auto sql{ "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, `tid` BIGINT, `state` TEXT DEFAULT 'R', PRIMARY KEY (`pid`)) WITHOUT ROWID;"};
+    std::unique_ptr<DBSync> dbSync;
+
+    EXPECT_NO_THROW(dbSync = std::make_unique<DBSync>(HostType::AGENT, DbEngineType::MEMORY, DATABASE_TEMP, sql));
+
+    CallbackMock wrapper;
+    EXPECT_CALL(wrapper, callbackMock(INSERTED, nlohmann::json::parse(R"({"pid":4,"name":"System","tid":100})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(INSERTED, nlohmann::json::parse(R"({"pid":5,"name":"System","tid":101})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(MODIFIED, nlohmann::json::parse(R"({"new":{"pid":5,"name":"System","tid":111},"old":{"pid":5,"tid":101}})"))).Times(1);
+
+    ResultCallbackData callbackData
+    {
+        [&wrapper](ReturnTypeCallback type, const nlohmann::json & jsonResult)
+        {
+            wrapper.callbackMock(type, jsonResult);
+        }
+    };
+
+    EXPECT_NO_THROW(dbSync->syncRow(nlohmann::json::parse(R"({"table":"processes","data":[{"pid":4,"name":"System","tid":100},{"pid":5,"name":"System","tid":101}]})"), callbackData));
+    EXPECT_NO_THROW(dbSync->syncRow(nlohmann::json::parse(R"({"table":"processes","data":[{"pid":4,"name":"System","tid":100},{"pid":5,"name":"System","tid":111}],"options":{"return_old_data":true}})"), callbackData));
+
+    // Rows are selected in order, with the default value of the columns missing in the input.
+    testing::InSequence sequence;
+    EXPECT_CALL(wrapper, callbackMock(SELECTED, nlohmann::json::parse(R"({"pid":5,"name":"System","tid":111,"state":"R"})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(SELECTED, nlohmann::json::parse(R"({"pid":4,"name":"System","tid":100,"state":"R"})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(SELECTED, nlohmann::json::parse(R"({"count":2})"))).Times(1);
+
+    const auto selectAll{ R"({"table":"processes","query":{"column_list":["*"],"row_filter":"","distinct_opt":false,"order_by_opt":"pid DESC","count_opt":100}})"};
+    const auto selectCount{ R"({"table":"processes","query":{"column_list":["count(*) AS count"],"row_filter":"","distinct_opt":false,"order_by_opt":"","count_opt":100}})"};
+    EXPECT_NO_THROW(dbSync->selectRows(nlohmann::json::parse(selectAll), callbackData));
+    EXPECT_NO_THROW(dbSync->selectRows(nlohmann::json::parse(selectCount), callbackData));
+}
+
+TEST_F(DBSyncTest, memoryEngineTxnWithRelationship)
+{
+    const auto sql{ "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, PRIMARY KEY (`pid`)) WITHOUT ROWID;CREATE TABLE processes_sockets(`socket_id` BIGINT, `pid` BIGINT, PRIMARY KEY (`socket_id`)) WITHOUT ROWID;"};
+    const auto tables { R"({"table":"processes"})" };
+    std::unique_ptr<DBSync> dbSync;
+
+    EXPECT_NO_THROW(dbSync = std::make_unique<DBSync>(HostType::AGENT, DbEngineType::MEMORY, DATABASE_TEMP, sql));
+    EXPECT_NO_THROW(dbSync->addTableRelationship(nlohmann::json::parse(R"({"base_table":"processes","relationed_tables":[{"table":"processes_sockets","field_match":{"pid":"pid"}}]})")));
+    EXPECT_NO_THROW(dbSync->insertData(nlohmann::json::parse(R"({"table":"processes","data":[{"pid":4,"name":"System"},{"pid":5,"name":"Guake"}]})")));
+    EXPECT_NO_THROW(dbSync->insertData(nlohmann::json::parse(R"({"table":"processes_sockets","data":[{"socket_id":1,"pid":4},{"socket_id":2,"pid":5}]})")));
+
+    CallbackMock wrapper;
+    EXPECT_CALL(wrapper, callbackMock(INSERTED, nlohmann::json::parse(R"({"pid":6,"name":"Bash"})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(DELETED, nlohmann::json::parse(R"({"pid":5,"name":"Guake"})"))).Times(1);
+
+    ResultCallbackData callbackData
+    {
+        [&wrapper](ReturnTypeCallback type, const nlohmann::json & jsonResult)
+        {
+            wrapper.callbackMock(type, jsonResult);
+        }
+    };
+
+    std::unique_ptr<DBSyncTxn> dbSyncTxn;
+    EXPECT_NO_THROW(dbSyncTxn = std::make_unique<DBSyncTxn>(dbSync->handle(), nlohmann::json::parse(tables), 0, 100, callbackData));
+    EXPECT_NO_THROW(dbSyncTxn->syncTxnRow(nlohmann::json::parse(R"({"table":"processes","data":[{"pid":4,"name":"System"},{"pid":6,"name":"Bash"}]})")));
+    EXPECT_NO_THROW(dbSyncTxn->getDeletedRows(callbackData));
+    dbSyncTxn.reset();
+
+    // The socket of the deleted process is deleted with it.
+    EXPECT_CALL(wrapper, callbackMock(SELECTED, nlohmann::json::parse(R"({"socket_id":1,"pid":4})"))).Times(1);
+
+    const auto selectSockets{ R"({"table":"processes_sockets","query":{"column_list":["*"],"row_filter":"","distinct_opt":false,"order_by_opt":"","count_opt":100}})"};
+    EXPECT_NO_THROW(dbSync->selectRows(nlohmann::json::parse(selectSockets), callbackData));
+}
+
+TEST_F(DBSyncTest, memoryEngineSnapshotTxn)
+{
+    const auto sql{ "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, `tid` BIGINT, PRIMARY KEY (`pid`)) WITHOUT ROWID;"};
+    const auto tables { R"({"table":"processes","options":{"snapshot":true}})" };
+    std::unique_ptr<DBSync> dbSync;
+
+    EXPECT_NO_THROW(dbSync = std::make_unique<DBSync>(HostType::AGENT, DbEngineType::MEMORY, DATABASE_TEMP, sql));
+    EXPECT_NO_THROW(dbSync->insertData(nlohmann::json::parse(R"({"table":"processes","data":[{"pid":4,"name":"System","tid":100},{"pid":5,"name":"System","tid":101},{"pid":6,"name":"System","tid":102}]})")));
+    EXPECT_NO_THROW(dbSync->setTableMaxRow("processes", 3));
+
+    CallbackMock wrapper;
+    EXPECT_CALL(wrapper, callbackMock(MODIFIED, nlohmann::json::parse(R"({"new":{"pid":5,"name":"System","tid":111},"old":{"pid":5,"tid":101}})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(DELETED, nlohmann::json::parse(R"({"pid":6,"name":"System","tid":102})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(INSERTED, testing::_)).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(MAX_ROWS, testing::_)).Times(1);
+
+    ResultCallbackData callbackData
+    {
+        [&wrapper](ReturnTypeCallback type, const nlohmann::json & jsonResult)
+        {
+            wrapper.callbackMock(type, jsonResult);
+        }
+    };
+
+    // One of the two new rows is over the limit of the table.
+    std::unique_ptr<DBSyncTxn> dbSyncTxn;
+    EXPECT_NO_THROW(dbSyncTxn = std::make_unique<DBSyncTxn>(dbSync->handle(), nlohmann::json::parse(tables), 0, 100, callbackData));
+    EXPECT_NO_THROW(dbSyncTxn->syncTxnRow(nlohmann::json::parse(R"({"table":"processes","data":[{"pid":4,"name":"System","tid":100},{"pid":5,"name":"System","tid":111},{"pid":7,"name":"Guake","tid":103},{"pid":8,"name":"Bash","tid":104}],"options":{"return_old_data":true}})")));
+    EXPECT_NO_THROW(dbSyncTxn->getDeletedRows(callbackData));
+}
+
+TEST_F(DBSyncTest, memoryEngineDeleteRowsWithCallback)
+{
+    const auto sql{ "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, PRIMARY KEY (`pid`)) WITHOUT ROWID;"};
+    std::unique_ptr<DBSync> dbSync;
+
+    EXPECT_NO_THROW(dbSync = std::make_unique<DBSync>(HostType::AGENT, DbEngineType::MEMORY, DATABASE_TEMP, sql));
+    EXPECT_NO_THROW(dbSync->insertData(nlohmann::json::parse(R"({"table":"processes","data":[{"pid":4,"name":"System"},{"pid":5,"name":"Guake"}]})")));
+
+    CallbackMock wrapper;
+    EXPECT_CALL(wrapper, callbackMock(DELETED, nlohmann::json::parse(R"({"pid":5,"name":"Guake"})"))).Times(1);
+
+    ResultCallbackData callbackData
+    {
+        [&wrapper](ReturnTypeCallback type, const nlohmann::json & jsonResult)
+        {
+            wrapper.callbackMock(type, jsonResult);
+        }
+    };
+
+    EXPECT_NO_THROW(dbSync->deleteRows(nlohmann::json::parse(R"({"table":"processes","query":{"data":[{"pid":5},{"pid":6}],"where_filter_opt":""}})"), callbackData));
+}
+
+TEST_F(DBSyncTest, memoryEngineUnsupportedOperations)
+{
+    const auto sql{ "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, PRIMARY KEY (`pid`)) WITHOUT ROWID;"};
+    const auto insertionSqlStmt{ R"({"table":"processes","data":[{"pid":4,"name":"System"}, {"pid":3,"name":"cmd"}]})"};
+    std::unique_ptr<DBSync> dbSync;
+
+    // The rows are not kept, so the database can't be persistent.
+    EXPECT_ANY_THROW(std::make_unique<DBSync>(HostType::AGENT, DbEngineType::MEMORY, DATABASE_TEMP, sql, DbManagement::PERSISTENT));
+    EXPECT_NO_THROW(dbSync = std::make_unique<DBSync>(HostType::AGENT, DbEngineType::MEMORY, DATABASE_TEMP, sql));
+
+    EXPECT_NO_THROW(dbSync->setTableMaxRow("processes", 1));
+    EXPECT_ANY_THROW(dbSync->insertData(nlohmann::json::parse(insertionSqlStmt)));
+    EXPECT_NO_THROW(dbSync->setTableMaxRow("processes", 0));
+
+    ResultCallbackData callbackData
+    {
+        [](ReturnTypeCallback, const nlohmann::json&)
+        {
+        }
+    };
+
+    // SQL filters are not evaluated by the engine.
+    const auto selectFiltered{ R"({"table":"processes","query":{"column_list":["*"],"row_filter":"WHERE pid=4","distinct_opt":false,"order_by_opt":"","count_opt":100}})"};
+    const auto deleteFiltered{ R"({"table":"processes","query":{"data":[],"where_filter_opt":"pid=4"}})"};
+    EXPECT_ANY_THROW(dbSync->selectRows(nlohmann::json::parse(selectFiltered), callbackData));
+    EXPECT_ANY_THROW(dbSync->deleteRows(nlohmann::json::parse(deleteFiltered)));
+    EXPECT_NO_THROW(dbSync->deleteRows(nlohmann::json::parse(R"({"table":"processes","query":{"data":[{"pid":4}],"where_filter_opt":""}})")));
+}
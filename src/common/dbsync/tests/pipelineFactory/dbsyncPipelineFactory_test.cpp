@@ -287,3 +287,52 @@ TEST_F(DBSyncPipelineFactoryTest, DestroyInvalidPipeline)
         DbSync::dbsync_error
     );
 }
+
+TEST_F(DBSyncPipelineFactoryTest, CreateBatchPipelineInvalidCallback)
+{
+    const auto& json{ nlohmann::json::parse(R"({"tables": ["processes"]})") };
+    const unsigned int batchSize{ 10 };
+    const unsigned int maxQueueSize{ 1000 };
+    EXPECT_THROW(m_pipelineFactory.create(m_dbHandle, json["tables"], nullptr, batchSize, maxQueueSize), DbSync::dbsync_error);
+}
+
+TEST_F(DBSyncPipelineFactoryTest, BatchPipelineSyncRow)
+{
+    CallbackWrapper wrapper;
+    const auto& jsonInput{ R"({"table":"processes","data":[{"pid":4, "tid":100, "name":"System"}]})"};
+    const auto& jsonInput1{ R"({"table":"processes","data":[{"pid":4, "tid":101, "name":"System1"}]})"};
+    const auto& jsonInput2{ R"({"table":"processes","data":[{"pid":5, "tid":102, "name":"System2"}]})"};
+    const auto resultFnc
+    {
+        [&wrapper](const std::vector<SyncResult>& results)
+        {
+            for (const auto& result : results)
+            {
+                wrapper.callback(result.first, result.second);
+            }
+        }
+    };
+    const auto& json{ nlohmann::json::parse(R"({"tables": ["processes"]})") };
+    const unsigned int batchSize{ 2 };
+    const unsigned int maxQueueSize{ 1 };
+    const auto pipeHandle
+    {
+        m_pipelineFactory.create(m_dbHandle,
+                                 json["tables"],
+                                 resultFnc,
+                                 batchSize,
+                                 maxQueueSize)
+    };
+    ASSERT_NE(nullptr, pipeHandle);
+    const auto pipeline{ m_pipelineFactory.pipeline(pipeHandle) };
+    testing::InSequence sequence;
+    EXPECT_CALL(wrapper, callback(INSERTED, nlohmann::json::parse(R"({"pid":4,"name":"System","tid":100})"))).Times(1);
+    EXPECT_CALL(wrapper, callback(MODIFIED, nlohmann::json::parse(R"({"pid":4,"name":"System1","tid":101})"))).Times(1);
+    EXPECT_CALL(wrapper, callback(INSERTED, nlohmann::json::parse(R"({"pid":5,"name":"System2","tid":102})"))).Times(1);
+    pipeline->syncRow(nlohmann::json::parse(jsonInput));
+    pipeline->syncRow(nlohmann::json::parse(jsonInput));
+    pipeline->syncRow(nlohmann::json::parse(jsonInput1));
+    pipeline->syncRow(nlohmann::json::parse(jsonInput2));
+    pipeline->getDeleted(nullptr);
+    m_pipelineFactory.destroy(pipeHandle);
+}
@@ -12,9 +12,12 @@
 #ifndef THREAD_DISPATCHER_H
 #define THREAD_DISPATCHER_H
 #include <vector>
+#include <deque>
 #include <thread>
 #include <atomic>
 #include <future>
+#include <algorithm>
+#include <iterator>
 #include <functional>
 #include <iostream>
 #include "threadSafeQueue.h"
@@ -180,6 +183,164 @@ namespace Utils
             const size_t m_maxQueueSize;
     };
 
+    /**
+     * @brief Dispatches the messages in order and in batches, from a single thread.
+     * @details The functor receives the messages queued since its previous call, up to the batch size.
+     * When the queue is full, push blocks until the dispatching thread makes room.
+     *
+     * @tparam Type Messages types.
+     * @tparam Functor Entity that processes a vector of messages.
+     */
+    template
+    <
+        typename Type,
+        typename Functor = std::function<void(const std::vector<Type>&)>
+        >
+    class BatchDispatcher
+    {
+        public:
+            BatchDispatcher(Functor functor, const size_t batchSize, const size_t maxQueueSize = UNLIMITED_QUEUE_SIZE)
+                : m_functor{ functor }
+                , m_batchSize{ batchSize ? batchSize : 1 }
+                , m_maxQueueSize{ maxQueueSize }
+                , m_running{ true }
+                , m_busy{ false }
+                , m_thread{ &BatchDispatcher<Type, Functor>::dispatch, this }
+            {
+            }
+            BatchDispatcher& operator=(const BatchDispatcher&) = delete;
+            BatchDispatcher(BatchDispatcher& other) = delete;
+            ~BatchDispatcher()
+            {
+                cancel();
+            }
+
+            void push(const Type& value)
+            {
+                std::unique_lock<std::mutex> lock{ m_mutex };
+
+                if (waitForRoom(lock))
+                {
+                    m_queue.push_back(value);
+                    m_cv.notify_all();
+                }
+            }
+
+            void push(Type&& value)
+            {
+                std::unique_lock<std::mutex> lock{ m_mutex };
+
+                if (waitForRoom(lock))
+                {
+                    m_queue.push_back(std::move(value));
+                    m_cv.notify_all();
+                }
+            }
+
+            // Blocks until every message pushed so far was dispatched. It must not be called from the functor.
+            void flush()
+            {
+                std::unique_lock<std::mutex> lock{ m_mutex };
+                m_cv.wait(lock, [this]()
+                {
+                    return !m_running || (m_queue.empty() && !m_busy);
+                });
+            }
+
+            void rundown()
+            {
+                flush();
+                cancel();
+            }
+            void cancel()
+            {
+                {
+                    std::lock_guard<std::mutex> lock{ m_mutex };
+                    m_running = false;
+                    m_queue.clear();
+                    m_cv.notify_all();
+                }
+
+                if (m_thread.joinable())
+                {
+                    m_thread.join();
+                }
+            }
+
+            bool cancelled() const
+            {
+                return !m_running;
+            }
+            size_t batchSize() const
+            {
+                return m_batchSize;
+            }
+            size_t size() const
+            {
+                std::lock_guard<std::mutex> lock{ m_mutex };
+                return m_queue.size();
+            }
+
+        private:
+            bool waitForRoom(std::unique_lock<std::mutex>& lock)
+            {
+                m_cv.wait(lock, [this]()
+                {
+                    return !m_running || UNLIMITED_QUEUE_SIZE == m_maxQueueSize || m_queue.size() < m_maxQueueSize;
+                });
+                return m_running;
+            }
+
+            void dispatch()
+            {
+                std::vector<Type> batch;
+                batch.reserve(m_batchSize);
+                std::unique_lock<std::mutex> lock{ m_mutex };
+
+                while (m_running)
+                {
+                    m_cv.wait(lock, [this]()
+                    {
+                        return !m_running || !m_queue.empty();
+                    });
+
+                    if (m_running)
+                    {
+                        const auto end { m_queue.begin() + std::min(m_batchSize, m_queue.size()) };
+                        batch.assign(std::make_move_iterator(m_queue.begin()), std::make_move_iterator(end));
+                        m_queue.erase(m_queue.begin(), end);
+                        m_busy = true;
+                        m_cv.notify_all();
+                        lock.unlock();
+
+                        try
+                        {
+                            m_functor(batch);
+                        }
+                        catch (const std::exception& ex)
+                        {
+                            std::cerr << "Dispatch handler error, " << ex.what() << std::endl;
+                        }
+
+                        batch.clear();
+                        lock.lock();
+                        m_busy = false;
+                        m_cv.notify_all();
+                    }
+                }
+            }
+
+            Functor m_functor;
+            const size_t m_batchSize;
+            const size_t m_maxQueueSize;
+            mutable std::mutex m_mutex;
+            std::condition_variable m_cv;
+            std::deque<Type> m_queue;
+            std::atomic_bool m_running;
+            bool m_busy;
+            std::thread m_thread;
+    };
+
     template <typename Input, typename Functor>
     class SyncDispatcher
     {
@@ -126,3 +126,129 @@ TEST_F(ThreadDispatcherTest, AsyncDispatcherQueue)
     dispatcher.rundown();
 }
 
+
+TEST_F(ThreadDispatcherTest, BatchDispatcherKeepsOrder)
+{
+    constexpr auto BATCH_SIZE { 4ull };
+    constexpr auto NUMBER_OF_ITEMS { 1000 };
+    std::vector<int> received;
+    auto batchesOverSize { 0 };
+
+    BatchDispatcher<int> dispatcher
+    {
+        [&received, &batchesOverSize](const std::vector<int>& batch)
+        {
+            if (batch.empty() || batch.size() > BATCH_SIZE)
+            {
+                ++batchesOverSize;
+            }
+
+            received.insert(received.end(), batch.begin(), batch.end());
+        }
+        , BATCH_SIZE
+    };
+    EXPECT_EQ(BATCH_SIZE, dispatcher.batchSize());
+
+    for (int i = 0; i < NUMBER_OF_ITEMS; ++i)
+    {
+        dispatcher.push(i);
+    }
+
+    dispatcher.flush();
+    EXPECT_FALSE(dispatcher.cancelled());
+    ASSERT_EQ(static_cast<size_t>(NUMBER_OF_ITEMS), received.size());
+
+    for (int i = 0; i < NUMBER_OF_ITEMS; ++i)
+    {
+        EXPECT_EQ(i, received[i]);
+    }
+
+    EXPECT_EQ(0, batchesOverSize);
+    dispatcher.rundown();
+    EXPECT_TRUE(dispatcher.cancelled());
+}
+
+TEST_F(ThreadDispatcherTest, BatchDispatcherBlocksWhenFull)
+{
+    constexpr auto BATCH_SIZE { 2ull };
+    constexpr auto MAX_QUEUE_SIZE { 3ull };
+    constexpr auto NUMBER_OF_ITEMS { 10 };
+    std::promise<void> started;
+    std::promise<void> release;
+    auto releaseFuture { release.get_future().share() };
+    std::atomic<bool> firstCall { true };
+    std::vector<int> received;
+
+    BatchDispatcher<int> dispatcher
+    {
+        [&](const std::vector<int>& batch)
+        {
+            if (firstCall)
+            {
+                firstCall = false;
+                started.set_value();
+                releaseFuture.wait();
+            }
+
+            received.insert(received.end(), batch.begin(), batch.end());
+        }
+        , BATCH_SIZE
+        , MAX_QUEUE_SIZE
+    };
+
+    dispatcher.push(0);
+    started.get_future().wait();
+
+    std::atomic<bool> producerDone { false };
+    std::thread producer
+    {
+        [&dispatcher, &producerDone]()
+        {
+            for (int i = 1; i < NUMBER_OF_ITEMS; ++i)
+            {
+                dispatcher.push(i);
+            }
+
+            producerDone = true;
+        }
+    };
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100)); // NOLINT(cppcoreguidelines-avoid-magic-numbers)
+    EXPECT_EQ(MAX_QUEUE_SIZE, dispatcher.size());
+    EXPECT_FALSE(producerDone);
+
+    release.set_value();
+    producer.join();
+    dispatcher.rundown();
+
+    ASSERT_EQ(static_cast<size_t>(NUMBER_OF_ITEMS), received.size());
+
+    for (int i = 0; i < NUMBER_OF_ITEMS; ++i)
+    {
+        EXPECT_EQ(i, received[i]);
+    }
+}
+
+TEST_F(ThreadDispatcherTest, BatchDispatcherCancel)
+{
+    auto calls { 0 };
+    BatchDispatcher<int> dispatcher
+    {
+        [&calls](const std::vector<int>&)
+        {
+            ++calls;
+        }
+        , 1
+    };
+    dispatcher.cancel();
+
+    for (int i = 0; i < 10; ++i) // NOLINT(cppcoreguidelines-avoid-magic-numbers)
+    {
+        dispatcher.push(i);
+    }
+
+    EXPECT_TRUE(dispatcher.cancelled());
+    dispatcher.rundown();
+    EXPECT_EQ(0ul, dispatcher.size());
+    EXPECT_EQ(0, calls);
+}
@@ -3,8 +3,10 @@
 #include <chrono>
 #include <condition_variable>
 #include <ctime>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <stack>
 #include <string>
 #include <thread>
@@ -12,6 +14,7 @@
 #include <commonDefs.h>
 #include <dbsync.hpp>
 #include <inventoryNormalizer.hpp>
+#include <scanBudget.hpp>
 #include <sysInfoInterface.hpp>
 
 #include <command_entry.hpp>
@@ -67,13 +70,6 @@ private:
     void Destroy();
 
     std::string GetCreateStatement() const;
-    nlohmann::json EcsProcessesData(const nlohmann::json& originalData, bool createFields = true);
-    nlohmann::json EcsSystemData(const nlohmann::json& originalData, bool createFields = true);
-    nlohmann::json EcsHotfixesData(const nlohmann::json& originalData, bool createFields = true);
-    nlohmann::json EcsHardwareData(const nlohmann::json& originalData, bool createFields = true);
-    nlohmann::json EcsPackageData(const nlohmann::json& originalData, bool createFields = true);
-    nlohmann::json EcsPortData(const nlohmann::json& originalData, bool createFields = true);
-    nlohmann::json EcsNetworkData(const nlohmann::json& originalData, bool createFields = true);
     nlohmann::json GetNetworkData();
     nlohmann::json GetPortsData();
 
@@ -81,17 +77,20 @@ private:
     void NotifyChange(ReturnTypeCallback result,
                       const nlohmann::json& data,
                       const std::string& table,
-                      const bool isFirstScan);
+                      const bool isFirstScan,
+                      const std::string& timestamp);
     void ProcessEvent(ReturnTypeCallback result,
                       const nlohmann::json& item,
                       const std::string& table,
-                      const bool isFirstScan);
+                      const bool isFirstScan,
+                      const std::string& timestamp);
     nlohmann::json GenerateMessage(ReturnTypeCallback result, const nlohmann::json& item, const std::string& table);
     void NotifyEvent(ReturnTypeCallback result,
                      nlohmann::json& msg,
                      const nlohmann::json& item,
                      const std::string& table,
-                     const bool isFirstScan);
+                     const bool isFirstScan,
+                     const std::string& timestamp);
 
     void TryCatchTask(const std::function<void()>& task) const;
     void ScanHardware();
@@ -101,6 +100,7 @@ private:
     void ScanHotfixes();
     void ScanPorts();
     void ScanProcesses();
+    void TrackProcesses();
     void Scan();
     void SyncLoop();
     void ShowConfig();
@@ -110,30 +110,21 @@ private:
     std::string GetPrimaryKeys(const nlohmann::json& data, const std::string& table);
     std::string CalculateHashId(const nlohmann::json& data, const std::string& table);
     nlohmann::json AddPreviousFields(nlohmann::json& current, const nlohmann::json& previous);
-    nlohmann::json
-    GenerateStatelessEvent(const std::string& operation, const std::string& type, const nlohmann::json& data);
+    nlohmann::json GenerateStatelessEvent(const std::string& operation,
+                                          const std::string& type,
+                                          const nlohmann::json& data,
+                                          const std::string& timestamp);
 
     void WriteMetadata(const std::string& key, const std::string& value);
     std::string ReadMetadata(const std::string& key);
     void DeleteMetadata(const std::string& key);
     void CleanMetadata();
 
-    void SetJsonField(nlohmann::json& target,
-                      const nlohmann::json& source,
-                      const std::string& keyPath,
-                      const std::string& jsonKey,
-                      const std::optional<std::string>& defaultValue,
-                      bool createFields);
-    void SetJsonFieldArray(nlohmann::json& target,
-                           const nlohmann::json& source,
-                           const std::string& destPath,
-                           const std::string& sourceKey,
-                           bool createFields);
-
     const std::string m_moduleName {"inventory"};
     std::string m_agentUUID {""}; // Agent UUID
     std::shared_ptr<ISysInfo> m_spInfo;
     std::function<void(const std::string&)> m_reportDiffFunction;
+    std::mutex m_reportMutex;    // Serializes the reports of the scan threads and the process events
     bool m_enabled;              // Main switch
     std::string m_dbFilePath;    // Database path
     std::time_t m_intervalValue; // Scan interval
@@ -145,14 +136,27 @@ private:
     bool m_ports;                // Opened ports inventory
     bool m_portsAll;             // Scan only listening ports or all
     bool m_processes;            // Running processes inventory
+    bool m_processesEvents;      // Track process starts and exits as they happen
+    // Process attributes to collect
+    std::set<std::string> m_processesFields;
     bool m_hotfixes;             // Windows hotfixes installed
+    unsigned int m_cpuLimit;     // Maximum CPU usage of a scan, as a percentage of one CPU
+    int m_niceLevel;             // Nice level of the scan threads
+    std::string m_ioPriority;    // I/O priority of the scan threads
+    std::time_t m_scanJitter;    // Maximum random delay before the first scan
     std::atomic<bool> m_stopping;
     bool m_notify;
     std::unique_ptr<DBSync> m_spDBSync;
     std::condition_variable m_cv;
     std::mutex m_mutex;
+    // Serializes the transactions of each table. DBSyncTxns of different tables still run concurrently: they share
+    // the single SQLite connection of m_spDBSync, and each of their operations takes the sync lock of its handle.
+    // A transaction that ends also commits the rows written so far by the others.
+    std::map<std::string, std::mutex> m_tableMutexes;
     std::unique_ptr<InvNormalizer> m_spNormalizer;
-    std::string m_scanTime;
+    std::unique_ptr<ScanBudget> m_spScanBudget;
+    std::string m_scanTime;               // Time of the running scan, only read by its scan threads
+    nlohmann::json m_packagesFingerprint; // Package sources fingerprint of the last complete scan
     std::function<int(Message)> m_pushMessage;
     bool m_hardwareFirstScan;  // Hardware first scan flag
     bool m_systemFirstScan;    // System first scan flag
@@ -1,7 +1,10 @@
 #pragma once
 #include <map>
 #include <nlohmann/json.hpp>
+#include <optional>
+#include <regex>
 #include <string>
+#include <vector>
 
 class InvNormalizer
 {
@@ -12,8 +15,55 @@ public:
     void RemoveExcluded(const std::string& type, nlohmann::json& data) const;
 
 private:
+    /// @brief Configuration pattern compiled once, matched as a plain string when it has no regex syntax
+    class Pattern
+    {
+    public:
+        explicit Pattern(const std::string& pattern);
+        bool Match(const std::string& value) const;
+        std::string Replace(const std::string& value, const std::string& format) const;
+
+    private:
+        enum class Kind
+        {
+            Equals,
+            StartsWith,
+            EndsWith,
+            Contains,
+            Regex
+        };
+
+        Kind m_kind;
+        std::string m_literal;
+        std::optional<std::regex> m_regex;
+    };
+
+    struct ExclusionRule
+    {
+        std::string fieldName;
+        Pattern pattern;
+    };
+
+    struct DictionaryRule
+    {
+        std::optional<std::string> findField;
+        std::optional<Pattern> findPattern;
+        std::optional<std::string> replaceField;
+        std::optional<Pattern> replacePattern;
+        std::string replaceValue;
+        std::optional<std::string> addField;
+        std::string addValue;
+    };
+
     static std::map<std::string, nlohmann::json>
     GetTypeValues(const std::string& configFile, const std::string& target, const std::string& type);
-    const std::map<std::string, nlohmann::json> m_typeExclusions;
-    const std::map<std::string, nlohmann::json> m_typeDictionary;
+    static std::map<std::string, std::vector<ExclusionRule>>
+    CompileExclusions(const std::map<std::string, nlohmann::json>& typeExclusions);
+    static std::map<std::string, std::vector<DictionaryRule>>
+    CompileDictionary(const std::map<std::string, nlohmann::json>& typeDictionary);
+    static bool IsExcluded(const std::vector<ExclusionRule>& exclusions, const nlohmann::json& item);
+    static void NormalizeItem(const std::vector<DictionaryRule>& dictionary, nlohmann::json& item);
+
+    const std::map<std::string, std::vector<ExclusionRule>> m_typeExclusions;
+    const std::map<std::string, std::vector<DictionaryRule>> m_typeDictionary;
 };
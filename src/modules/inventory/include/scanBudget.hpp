@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <string>
+
+/// @brief Resources used by a complete scan.
+struct ScanMetrics
+{
+    std::chrono::milliseconds duration {0}; ///< Wall-clock time of the scan
+    std::chrono::milliseconds cpuTime {0};  ///< CPU time of the scan threads
+};
+
+/// @brief Limits the resources used by the inventory scans.
+/// @details Scan threads run with the configured nice level and I/O priority. While the CPU time used by a scan
+/// exceeds the configured share of one CPU, the scan threads sleep between items, where they hold no locks.
+class ScanBudget
+{
+public:
+    /// @brief Constructor.
+    /// @param cpuLimit Maximum CPU usage of a scan, as a percentage of one CPU. 0 disables the limit.
+    /// @param niceLevel Nice level of the scan threads. 0 keeps the inherited one.
+    /// @param ioPriority I/O priority of the scan threads: "normal", "low" or "idle".
+    /// @param jitter Maximum random delay before the first scan, in milliseconds.
+    ScanBudget(unsigned int cpuLimit, int niceLevel, std::string ioPriority, std::time_t jitter);
+
+    /// @brief Returns a random delay, up to the configured jitter.
+    std::chrono::milliseconds StartDelay() const;
+
+    /// @brief Starts accounting a new scan.
+    void Start();
+
+    /// @brief Applies the nice level and I/O priority to the calling thread and starts accounting its CPU time.
+    void EnterThread();
+
+    /// @brief Accounts the CPU time of the calling thread, and sleeps while the scan exceeds the CPU limit.
+    /// @param stopping Returns true when the scan is being stopped, which interrupts the sleep.
+    void Throttle(const std::function<bool()>& stopping);
+
+    /// @brief Accounts the CPU time left of the calling thread, which is done with the scan.
+    void LeaveThread();
+
+    /// @brief Ends the scan.
+    /// @return The resources used by the scan.
+    ScanMetrics Finish();
+
+private:
+    /// @brief Adds the CPU time used by the calling thread since it was last accounted.
+    void Account();
+
+    unsigned int m_cpuLimit;
+    int m_niceLevel;
+    std::string m_ioPriority;
+    std::time_t m_jitter;
+    std::atomic<uint64_t> m_scanId;
+    std::atomic<int64_t> m_cpuTime; // Nanoseconds
+    std::chrono::steady_clock::time_point m_start;
+};
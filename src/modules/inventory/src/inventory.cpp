@@ -3,10 +3,14 @@
 #include <config.h>
 #include <defs.h>
 #include <logger.hpp>
+#include <stringHelper.h>
 #include <sysInfo.hpp>
 
 #include <cjson/cJSON.h>
 
+#include <limits>
+#include <optional>
+
 void Inventory::Start()
 {
 
@@ -65,7 +69,38 @@ void Inventory::Setup(std::shared_ptr<const configuration::ConfigurationParser>
         configurationParser->GetConfigOrDefault(config::inventory::DEFAULT_PORTS_ALL, "inventory", "ports_all");
     m_processes =
         configurationParser->GetConfigOrDefault(config::inventory::DEFAULT_PROCESSES, "inventory", "processes");
+    m_processesEvents = configurationParser->GetConfigOrDefault(
+        config::inventory::DEFAULT_PROCESSES_EVENTS, "inventory", "processes_events");
+    const auto processesFields = configurationParser->GetConfigOrDefault(
+        Utils::split(config::inventory::DEFAULT_PROCESSES_FIELDS, ','), "inventory", "processes_fields");
+    m_processesFields = std::set<std::string>(processesFields.begin(), processesFields.end());
+    // The pid identifies the process, so it is always collected
+    m_processesFields.insert("pid");
     m_hotfixes = configurationParser->GetConfigOrDefault(config::inventory::DEFAULT_HOTFIXES, "inventory", "hotfixes");
+    m_cpuLimit = configurationParser->GetConfigInRangeOrDefault<unsigned int>(config::inventory::DEFAULT_CPU_LIMIT,
+                                                                             std::optional<unsigned int>(0),
+                                                                             std::optional<unsigned int>(100),
+                                                                             "inventory",
+                                                                             "cpu_limit");
+    m_niceLevel = configurationParser->GetConfigInRangeOrDefault<int>(config::inventory::DEFAULT_NICE,
+                                                                      std::optional<int>(0),
+                                                                      std::optional<int>(19),
+                                                                      "inventory",
+                                                                      "nice");
+    m_ioPriority =
+        configurationParser->GetConfigOrDefault(config::inventory::DEFAULT_IO_PRIORITY, "inventory", "io_priority");
+
+    if (m_ioPriority != "normal" && m_ioPriority != "low" && m_ioPriority != "idle")
+    {
+        LogWarn("Invalid inventory I/O priority '{}', using '{}'.", m_ioPriority, config::inventory::DEFAULT_IO_PRIORITY);
+        m_ioPriority = config::inventory::DEFAULT_IO_PRIORITY;
+    }
+
+    m_scanJitter = configurationParser->GetTimeConfigInRangeOrDefault(config::inventory::DEFAULT_SCAN_JITTER,
+                                                                      0,
+                                                                      std::numeric_limits<std::time_t>::max(),
+                                                                      "inventory",
+                                                                      "scan_jitter");
 }
 
 void Inventory::Stop()
@@ -235,6 +270,24 @@ cJSON* Inventory::Dump() const
     {
         cJSON_AddStringToObject(invJson, "processes", "no");
     }
+    if (m_processesEvents)
+    {
+        cJSON_AddStringToObject(invJson, "processes_events", "yes");
+    }
+    else
+    {
+        cJSON_AddStringToObject(invJson, "processes_events", "no");
+    }
+    std::string processesFields;
+    for (const auto& field : m_processesFields)
+    {
+        processesFields += (processesFields.empty() ? "" : ",") + field;
+    }
+    cJSON_AddStringToObject(invJson, "processes_fields", processesFields.c_str());
+    cJSON_AddNumberToObject(invJson, "cpu_limit", static_cast<double>(m_cpuLimit));
+    cJSON_AddNumberToObject(invJson, "nice", static_cast<double>(m_niceLevel));
+    cJSON_AddStringToObject(invJson, "io_priority", m_ioPriority.c_str());
+    cJSON_AddNumberToObject(invJson, "scan_jitter", static_cast<double>(m_scanJitter));
 #ifdef WIN32
     if (m_hotfixes)
     {
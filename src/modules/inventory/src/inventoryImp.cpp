@@ -1,5 +1,8 @@
 #include "statelessEvent.hpp"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <commonDefs.h>
 #include <config.h>
 #include <defs.h>
@@ -9,6 +12,7 @@
 #include <nlohmann/json.hpp>
 #include <stringHelper.h>
 #include <timeHelper.h>
+#include <unordered_set>
 
 constexpr auto EMPTY_VALUE {""};
 
@@ -16,6 +20,7 @@ constexpr std::time_t INVENTORY_DEFAULT_INTERVAL {3600000};
 constexpr size_t MAX_ID_SIZE = 512;
 
 constexpr auto QUEUE_SIZE {4096};
+constexpr unsigned int MAX_SCAN_WORKERS {4};
 
 static const std::map<ReturnTypeCallback, std::string> OPERATION_MAP {
     // LCOV_EXCL_START
@@ -151,6 +156,145 @@ const std::unordered_map<std::string, std::string> TABLE_TO_KEY_MAP = {{NETWORKS
                                                                        {SYSTEM_TABLE, "system-first-scan"},
                                                                        {HARDWARE_TABLE, "hardware-first-scan"}};
 
+enum class InventoryTable
+{
+    HARDWARE,
+    SYSTEM,
+    PACKAGES,
+    PROCESSES,
+    HOTFIXES,
+    PORTS,
+    NETWORKS,
+    SIZE
+};
+
+static const std::unordered_map<std::string, InventoryTable> TABLE_IDS = {{HARDWARE_TABLE, InventoryTable::HARDWARE},
+                                                                          {SYSTEM_TABLE, InventoryTable::SYSTEM},
+                                                                          {PACKAGES_TABLE, InventoryTable::PACKAGES},
+                                                                          {PROCESSES_TABLE, InventoryTable::PROCESSES},
+                                                                          {HOTFIXES_TABLE, InventoryTable::HOTFIXES},
+                                                                          {PORTS_TABLE, InventoryTable::PORTS},
+                                                                          {NETWORKS_TABLE, InventoryTable::NETWORKS}};
+
+/// @brief Destination in the ECS document of a table column
+struct EcsField
+{
+    nlohmann::json::json_pointer pointer;
+    std::string column;
+    bool isArray;
+};
+
+/// @brief Column used to build the hash id of a row
+struct PrimaryKeyField
+{
+    std::string column;
+    bool isNumber;
+};
+
+/// @brief ECS fields and primary key of a table, with the JSON pointers parsed once
+struct TableMapping
+{
+    std::vector<EcsField> ecsFields;
+    std::vector<PrimaryKeyField> primaryKeys;
+};
+
+static EcsField Ecs(const std::string& path, const std::string& column, bool isArray = false)
+{
+    return {nlohmann::json::json_pointer(path), column, isArray};
+}
+
+static const std::array<TableMapping, static_cast<size_t>(InventoryTable::SIZE)> TABLE_MAPPINGS {{
+    // HARDWARE
+    {{Ecs("/observer/serial_number", "board_serial"),
+      Ecs("/host/cpu/name", "cpu_name"),
+      Ecs("/host/cpu/cores", "cpu_cores"),
+      Ecs("/host/cpu/speed", "cpu_mhz"),
+      Ecs("/host/memory/total", "ram_total"),
+      Ecs("/host/memory/free", "ram_free"),
+      Ecs("/host/memory/used/percentage", "ram_usage")},
+     {{"board_serial", false}}},
+    // SYSTEM
+    {{Ecs("/host/architecture", "architecture"),
+      Ecs("/host/hostname", "hostname"),
+      Ecs("/host/os/kernel", "os_build"),
+      Ecs("/host/os/full", "os_codename"),
+      Ecs("/host/os/name", "os_name"),
+      Ecs("/host/os/platform", "os_platform"),
+      Ecs("/host/os/version", "os_version"),
+      Ecs("/host/os/type", "sysname")},
+     {{"os_name", false}}},
+    // PACKAGES
+    {{Ecs("/package/architecture", "architecture"),
+      Ecs("/package/description", "description"),
+      Ecs("/package/installed", "install_time"),
+      Ecs("/package/name", "name"),
+      Ecs("/package/path", "location"),
+      Ecs("/package/size", "size"),
+      Ecs("/package/type", "format"),
+      Ecs("/package/version", "version")},
+     {{"name", false}, {"version", false}, {"architecture", false}, {"format", false}, {"location", false}}},
+    // PROCESSES
+    {{Ecs("/process/pid", "pid"),
+      Ecs("/process/name", "name"),
+      Ecs("/process/parent/pid", "ppid"),
+      Ecs("/process/command_line", "cmd"),
+      Ecs("/process/args", "argvs"),
+      Ecs("/process/user/id", "euser"),
+      Ecs("/process/real_user/id", "ruser"),
+      Ecs("/process/saved_user/id", "suser"),
+      Ecs("/process/group/id", "egroup"),
+      Ecs("/process/real_group/id", "rgroup"),
+      Ecs("/process/saved_group/id", "sgroup"),
+      Ecs("/process/start", "start_time"),
+      Ecs("/process/thread/id", "tgid"),
+      Ecs("/process/tty/char_device/major", "tty")},
+     {{"pid", false}}},
+    // HOTFIXES
+    {{Ecs("/package/hotfix/name", "hotfix")}, {{"hotfix", false}}},
+    // PORTS
+    {{Ecs("/network/protocol", "protocol"),
+      Ecs("/source/ip", "local_ip", true),
+      Ecs("/source/port", "local_port"),
+      Ecs("/destination/ip", "remote_ip", true),
+      Ecs("/destination/port", "remote_port"),
+      Ecs("/host/network/egress/queue", "tx_queue"),
+      Ecs("/host/network/ingress/queue", "rx_queue"),
+      Ecs("/file/inode", "inode"),
+      Ecs("/interface/state", "state"),
+      Ecs("/process/pid", "pid"),
+      Ecs("/process/name", "process")},
+     {{"inode", true}, {"protocol", false}, {"local_ip", false}, {"local_port", true}}},
+    // NETWORKS
+    {{Ecs("/host/ip", "address", true),
+      Ecs("/host/mac", "mac"),
+      Ecs("/host/network/egress/bytes", "tx_bytes"),
+      Ecs("/host/network/egress/packets", "tx_packets"),
+      Ecs("/host/network/ingress/bytes", "rx_bytes"),
+      Ecs("/host/network/ingress/packets", "rx_packets"),
+      Ecs("/host/network/egress/drops", "tx_dropped"),
+      Ecs("/host/network/egress/errors", "tx_errors"),
+      Ecs("/host/network/ingress/drops", "rx_dropped"),
+      Ecs("/host/network/ingress/errors", "rx_errors"),
+      Ecs("/interface/mtu", "mtu"),
+      Ecs("/interface/state", "state"),
+      Ecs("/interface/type", "iface_type"),
+      Ecs("/network/netmask", "netmask", true),
+      Ecs("/network/gateway", "gateway", true),
+      Ecs("/network/broadcast", "broadcast", true),
+      Ecs("/network/dhcp", "dhcp"),
+      Ecs("/network/type", "proto_type"),
+      Ecs("/network/metric", "metric"),
+      Ecs("/observer/ingress/interface/alias", "adapter"),
+      Ecs("/observer/ingress/interface/name", "iface")},
+     {{"iface", false}, {"adapter", false}, {"iface_type", false}, {"proto_type", false}, {"address", false}}},
+}};
+
+static const TableMapping* GetTableMapping(const std::string& table)
+{
+    const auto it {TABLE_IDS.find(table)};
+    return it != TABLE_IDS.end() ? &TABLE_MAPPINGS.at(static_cast<size_t>(it->second)) : nullptr;
+}
+
 static std::string GetItemId(const nlohmann::json& item, const std::vector<std::string>& idFields)
 {
     Utils::HashData hash;
@@ -178,84 +322,89 @@ static std::string GetItemId(const nlohmann::json& item, const std::vector<std::
     return Utils::asciiToHex(hash.hash());
 }
 
-static bool IsElementDuplicated(const nlohmann::json& input, const std::pair<std::string, std::string>& keyValue)
+static std::set<std::string> GetTableColumns(const std::string& createStatement)
 {
-    const auto it {std::find_if(input.begin(),
-                                input.end(),
-                                [&keyValue](const auto& elem) { return elem.at(keyValue.first) == keyValue.second; })};
-    return it != input.end();
+    std::set<std::string> columns;
+
+    // Each column is declared on its own line, between the table name and the primary key
+    for (const auto& line : Utils::split(createStatement, '\n'))
+    {
+        const auto declaration {Utils::trim(line)};
+
+        if (!declaration.empty() && !Utils::startsWith(declaration, "CREATE") &&
+            !Utils::startsWith(declaration, "PRIMARY KEY"))
+        {
+            columns.insert(declaration.substr(0, declaration.find(' ')));
+        }
+    }
+
+    return columns;
 }
 
 nlohmann::json Inventory::EcsData(const nlohmann::json& data, const std::string& table, bool createFields)
 {
     nlohmann::json ret;
-    if (table == HARDWARE_TABLE)
-    {
-        ret = EcsHardwareData(data, createFields);
-    }
-    else if (table == SYSTEM_TABLE)
-    {
-        ret = EcsSystemData(data, createFields);
-    }
-    else if (table == PACKAGES_TABLE)
-    {
-        ret = EcsPackageData(data, createFields);
-    }
-    else if (table == PROCESSES_TABLE)
-    {
-        ret = EcsProcessesData(data, createFields);
-    }
-    else if (table == HOTFIXES_TABLE)
-    {
-        ret = EcsHotfixesData(data, createFields);
-    }
-    else if (table == PORTS_TABLE)
+    const auto mapping {GetTableMapping(table)};
+
+    if (mapping == nullptr)
     {
-        ret = EcsPortData(data, createFields);
+        return ret;
     }
-    else if (table == NETWORKS_TABLE)
+
+    for (const auto& field : mapping->ecsFields)
     {
-        ret = EcsNetworkData(data, createFields);
+        const auto it {data.find(field.column)};
+        const auto found {it != data.end()};
+
+        if (!createFields && !found)
+        {
+            continue;
+        }
+
+        auto& value {ret[field.pointer]};
+
+        if (field.isArray)
+        {
+            value = nlohmann::json::array();
+
+            if (found && !it->empty() && *it != EMPTY_VALUE)
+            {
+                value.push_back(*it);
+            }
+        }
+        else if (found && *it != EMPTY_VALUE)
+        {
+            value = *it;
+        }
+        else
+        {
+            value = nullptr;
+        }
     }
+
     return ret;
 }
 
-std::string Inventory::GetPrimaryKeys([[maybe_unused]] const nlohmann::json& data, const std::string& table)
+std::string Inventory::GetPrimaryKeys(const nlohmann::json& data, const std::string& table)
 {
     std::string ret;
-    if (table == HARDWARE_TABLE)
-    {
-        ret = data["board_serial"];
-    }
-    else if (table == SYSTEM_TABLE)
-    {
-        ret = data["os_name"];
-    }
-    else if (table == PACKAGES_TABLE)
-    {
-        ret = data["name"].get<std::string>() + ":" + data["version"].get<std::string>() + ":" +
-              data["architecture"].get<std::string>() + ":" + data["format"].get<std::string>() + ":" +
-              data["location"].get<std::string>();
-    }
-    else if (table == PROCESSES_TABLE)
-    {
-        ret = data["pid"];
-    }
-    else if (table == HOTFIXES_TABLE)
-    {
-        ret = data["hotfix"];
-    }
-    else if (table == PORTS_TABLE)
+    const auto mapping {GetTableMapping(table)};
+
+    if (mapping == nullptr)
     {
-        ret = std::to_string(data["inode"].get<int>()) + ":" + data["protocol"].get<std::string>() + ":" +
-              data["local_ip"].get<std::string>() + ":" + std::to_string(data["local_port"].get<int>());
+        return ret;
     }
-    else if (table == NETWORKS_TABLE)
+
+    std::string separator;
+
+    for (const auto& key : mapping->primaryKeys)
     {
-        ret = data["iface"].get<std::string>() + ":" + data["adapter"].get<std::string>() + ":" +
-              data["iface_type"].get<std::string>() + ":" + data["proto_type"].get<std::string>() + ":" +
-              data["address"].get<std::string>();
+        const auto& value {data.at(key.column)};
+        ret += separator;
+        ret += key.isNumber ? std::to_string(value.get<int>()) : value.get<std::string>();
+        separator = ":";
     }
+
     return ret;
 }
 
@@ -273,7 +422,8 @@ std::string Inventory::CalculateHashId(const nlohmann::json& data, const std::st
 void Inventory::NotifyChange(ReturnTypeCallback result,
                              const nlohmann::json& data,
                              const std::string& table,
-                             const bool isFirstScan)
+                             const bool isFirstScan,
+                             const std::string& timestamp)
 {
     if (DB_ERROR == result)
     {
@@ -290,25 +440,26 @@ void Inventory::NotifyChange(ReturnTypeCallback result,
     {
         for (const auto& item : data)
         {
-            ProcessEvent(result, item, table, isFirstScan);
+            ProcessEvent(result, item, table, isFirstScan, timestamp);
         }
     }
     else
     {
-        ProcessEvent(result, data, table, isFirstScan);
+        ProcessEvent(result, data, table, isFirstScan, timestamp);
     }
 }
 
 void Inventory::ProcessEvent(ReturnTypeCallback result,
                              const nlohmann::json& item,
                              const std::string& table,
-                             const bool isFirstScan)
+                             const bool isFirstScan,
+                             const std::string& timestamp)
 {
     nlohmann::json msg = GenerateMessage(result, item, table);
 
     if (msg["metadata"]["id"].is_string() && msg["metadata"]["id"].get<std::string>().size() <= MAX_ID_SIZE)
     {
-        NotifyEvent(result, msg, item, table, isFirstScan);
+        NotifyEvent(result, msg, item, table, isFirstScan, timestamp);
     }
     else
     {
@@ -333,13 +484,14 @@ void Inventory::NotifyEvent(ReturnTypeCallback result,
                             nlohmann::json& msg,
                             const nlohmann::json& item,
                             const std::string& table,
-                            const bool isFirstScan)
+                            const bool isFirstScan,
+                            const std::string& timestamp)
 {
     if (!isFirstScan)
     {
         const nlohmann::json oldData = (result == MODIFIED) ? EcsData(item["old"], table, false) : nlohmann::json {};
 
-        nlohmann::json stateless = GenerateStatelessEvent(OPERATION_MAP.at(result), table, msg["data"]);
+        nlohmann::json stateless = GenerateStatelessEvent(OPERATION_MAP.at(result), table, msg["data"], timestamp);
         nlohmann::json eventWithChanges = msg["data"];
 
         if (!oldData.empty())
@@ -351,9 +503,10 @@ void Inventory::NotifyEvent(ReturnTypeCallback result,
         msg["stateless"] = stateless;
     }
 
-    msg["data"]["@timestamp"] = m_scanTime;
+    msg["data"]["@timestamp"] = timestamp;
 
     const auto msgToSend = msg.dump();
+    const std::lock_guard<std::mutex> lock {m_reportMutex};
     m_reportDiffFunction(msgToSend);
 }
 
@@ -361,10 +514,10 @@ void Inventory::UpdateChanges(const std::string& table, const nlohmann::json& va
 {
     const auto callback {[this, table, isFirstScan](ReturnTypeCallback result, const nlohmann::json& data)
                          {
-                             NotifyChange(result, data, table, isFirstScan);
+                             NotifyChange(result, data, table, isFirstScan, m_scanTime);
                          }};
 
-    const std::unique_lock<std::mutex> lock {m_mutex};
+    const std::unique_lock<std::mutex> lock {m_tableMutexes.at(table)};
     DBSyncTxn txn {m_spDBSync->handle(), nlohmann::json {table}, 0, QUEUE_SIZE, callback};
     nlohmann::json input;
     input["table"] = table;
@@ -408,7 +561,12 @@ Inventory::Inventory()
     , m_ports {true}
     , m_portsAll {true}
     , m_processes {true}
+    , m_processesEvents {false}
     , m_hotfixes {true}
+    , m_cpuLimit {0}
+    , m_niceLevel {0}
+    , m_ioPriority {"normal"}
+    , m_scanJitter {0}
     , m_stopping {true}
     , m_notify {true}
     , m_hardwareFirstScan {true}
@@ -419,6 +577,10 @@ Inventory::Inventory()
     , m_processesFirstScan {true}
     , m_hotfixesFirstScan {true}
 {
+    for (const auto& [table, key] : TABLE_TO_KEY_MAP)
+    {
+        m_tableMutexes[table];
+    }
 }
 
 std::string Inventory::GetCreateStatement() const
@@ -443,6 +605,29 @@ void Inventory::Init(const std::shared_ptr<ISysInfo>& spInfo,
                      const std::string& normalizerType)
 {
     m_spInfo = spInfo;
+
+    // Only the columns of the processes table can be collected
+    const auto processesColumns {GetTableColumns(PROCESSES_SQL_STATEMENT)};
+
+    for (auto it = m_processesFields.begin(); it != m_processesFields.end();)
+    {
+        if (processesColumns.find(*it) == processesColumns.end())
+        {
+            LogWarn("Unknown process attribute '{}' in processes_fields, it is ignored.", *it);
+            it = m_processesFields.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    m_spInfo->setProcessesFields(m_processesFields);
+
+    // The worker threads of the data provider are scan threads too. They sleep between items, where no lock is held.
+    m_spInfo->setScanThreadHooks({[this]() { m_spScanBudget->EnterThread(); },
+                                  [this]() { m_spScanBudget->Throttle([this]() { return m_stopping.load(); }); },
+                                  [this]() { m_spScanBudget->LeaveThread(); }});
     m_reportDiffFunction = reportDiffFunction;
 
     {
@@ -451,6 +636,8 @@ void Inventory::Init(const std::shared_ptr<ISysInfo>& spInfo,
         m_spDBSync = std::make_unique<DBSync>(
             HostType::AGENT, DbEngineType::SQLITE3, dbPath, GetCreateStatement(), DbManagement::PERSISTENT);
         m_spNormalizer = std::make_unique<InvNormalizer>(normalizerConfigPath, normalizerType);
+        m_spScanBudget = std::make_unique<ScanBudget>(m_cpuLimit, m_niceLevel, m_ioPriority, m_scanJitter);
+        m_packagesFingerprint = nlohmann::json();
     }
 
     m_hardwareFirstScan = ReadMetadata(TABLE_TO_KEY_MAP.at(HARDWARE_TABLE)).empty() ? false : true;
@@ -512,133 +699,6 @@ void Inventory::Destroy()
     m_cv.notify_all();
 }
 
-nlohmann::json Inventory::EcsHardwareData(const nlohmann::json& originalData, bool createFields)
-{
-    nlohmann::json ret;
-
-    SetJsonField(ret, originalData, "/observer/serial_number", "board_serial", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/cpu/name", "cpu_name", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/cpu/cores", "cpu_cores", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/cpu/speed", "cpu_mhz", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/memory/total", "ram_total", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/memory/free", "ram_free", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/memory/used/percentage", "ram_usage", std::nullopt, createFields);
-
-    return ret;
-}
-
-nlohmann::json Inventory::EcsSystemData(const nlohmann::json& originalData, bool createFields)
-{
-    nlohmann::json ret;
-
-    SetJsonField(ret, originalData, "/host/architecture", "architecture", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/hostname", "hostname", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/os/kernel", "os_build", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/os/full", "os_codename", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/os/name", "os_name", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/os/platform", "os_platform", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/os/version", "os_version", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/os/type", "sysname", std::nullopt, createFields);
-
-    return ret;
-}
-
-nlohmann::json Inventory::EcsPackageData(const nlohmann::json& originalData, bool createFields)
-{
-    nlohmann::json ret;
-
-    SetJsonField(ret, originalData, "/package/architecture", "architecture", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/package/description", "description", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/package/installed", "install_time", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/package/name", "name", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/package/path", "location", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/package/size", "size", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/package/type", "format", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/package/version", "version", std::nullopt, createFields);
-
-    return ret;
-}
-
-nlohmann::json Inventory::EcsProcessesData(const nlohmann::json& originalData, bool createFields)
-{
-    nlohmann::json ret;
-
-    SetJsonField(ret, originalData, "/process/pid", "pid", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/name", "name", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/parent/pid", "ppid", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/command_line", "cmd", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/args", "argvs", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/user/id", "euser", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/real_user/id", "ruser", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/saved_user/id", "suser", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/group/id", "egroup", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/real_group/id", "rgroup", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/saved_group/id", "sgroup", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/start", "start_time", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/thread/id", "tgid", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/tty/char_device/major", "tty", std::nullopt, createFields);
-
-    return ret;
-}
-
-nlohmann::json Inventory::EcsHotfixesData(const nlohmann::json& originalData, bool createFields)
-{
-
-    nlohmann::json ret;
-
-    SetJsonField(ret, originalData, "/package/hotfix/name", "hotfix", std::nullopt, createFields);
-
-    return ret;
-}
-
-nlohmann::json Inventory::EcsPortData(const nlohmann::json& originalData, bool createFields)
-{
-    nlohmann::json ret;
-
-    SetJsonField(ret, originalData, "/network/protocol", "protocol", std::nullopt, createFields);
-    SetJsonFieldArray(ret, originalData, "/source/ip", "local_ip", createFields);
-    SetJsonField(ret, originalData, "/source/port", "local_port", std::nullopt, createFields);
-    SetJsonFieldArray(ret, originalData, "/destination/ip", "remote_ip", createFields);
-    SetJsonField(ret, originalData, "/destination/port", "remote_port", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/network/egress/queue", "tx_queue", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/network/ingress/queue", "rx_queue", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/file/inode", "inode", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/interface/state", "state", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/pid", "pid", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/name", "process", std::nullopt, createFields);
-
-    return ret;
-}
-
-nlohmann::json Inventory::EcsNetworkData(const nlohmann::json& originalData, bool createFields)
-{
-    nlohmann::json ret;
-
-    SetJsonFieldArray(ret, originalData, "/host/ip", "address", createFields);
-    SetJsonField(ret, originalData, "/host/mac", "mac", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/network/egress/bytes", "tx_bytes", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/network/egress/packets", "tx_packets", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/network/ingress/bytes", "rx_bytes", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/network/ingress/packets", "rx_packets", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/network/egress/drops", "tx_dropped", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/network/egress/errors", "tx_errors", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/network/ingress/drops", "rx_dropped", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/network/ingress/errors", "rx_errors", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/interface/mtu", "mtu", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/interface/state", "state", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/interface/type", "iface_type", std::nullopt, createFields);
-    SetJsonFieldArray(ret, originalData, "/network/netmask", "netmask", createFields);
-    SetJsonFieldArray(ret, originalData, "/network/gateway", "gateway", createFields);
-    SetJsonFieldArray(ret, originalData, "/network/broadcast", "broadcast", createFields);
-    SetJsonField(ret, originalData, "/network/dhcp", "dhcp", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/network/type", "proto_type", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/network/metric", "metric", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/observer/ingress/interface/alias", "adapter", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/observer/ingress/interface/name", "iface", std::nullopt, createFields);
-
-    return ret;
-}
-
 void Inventory::ScanHardware()
 {
     if (m_hardware)
@@ -781,16 +841,31 @@ void Inventory::ScanPackages()
 {
     if (m_packages)
     {
+        auto fingerprint = m_spInfo->packagesFingerprint();
+
+        if (m_packagesFirstScan && !fingerprint.is_null() && fingerprint == m_packagesFingerprint)
+        {
+            // Skipping the transaction keeps the stored packages as they are
+            LogTrace("Package sources unchanged, skipping packages scan");
+            return;
+        }
+
         LogTrace("Starting packages scan");
         const auto callback {[this](ReturnTypeCallback result, const nlohmann::json& data)
                              {
-                                 NotifyChange(result, data, PACKAGES_TABLE, !m_packagesFirstScan);
+                                 NotifyChange(result, data, PACKAGES_TABLE, !m_packagesFirstScan, m_scanTime);
                              }};
 
-        const std::unique_lock<std::mutex> lock {m_mutex};
-        DBSyncTxn txn {m_spDBSync->handle(), nlohmann::json {PACKAGES_TABLE}, 0, QUEUE_SIZE, callback};
+        // The packages are a full snapshot of the table, diffed at once when the scan ends
+        const std::unique_lock<std::mutex> lock {m_tableMutexes.at(PACKAGES_TABLE)};
+        DBSyncTxn txn {m_spDBSync->handle(),
+                       nlohmann::json {{"table", PACKAGES_TABLE}, {"options", {{"snapshot", true}}}},
+                       0,
+                       QUEUE_SIZE,
+                       callback};
+        size_t listedPackages {0};
         m_spInfo->packages(
-            [this, &txn](nlohmann::json& rawData)
+            [this, &txn, &listedPackages](nlohmann::json& rawData)
             {
                 if (m_stopping)
                 {
@@ -811,11 +886,41 @@ void Inventory::ScanPackages()
                         input["options"]["return_old_data"] = true;
                     }
                     txn.syncTxnRow(input);
+                    ++listedPackages;
                 }
             });
+
+        // A partial or empty listing would otherwise turn every package it missed into a DELETED event
+        const auto complete {!m_stopping && listedPackages > 0 && m_spInfo->packagesComplete()};
+
+        if (!complete)
+        {
+            if (!m_stopping)
+            {
+                LogWarn("Packages scan incomplete ({} packages listed), the packages not listed are kept.",
+                        listedPackages);
+            }
+
+            nlohmann::json input;
+
+            input["table"] = PACKAGES_TABLE;
+            input["data"] = nlohmann::json::array();
+            input["options"]["keep_unseen"] = true;
+            if (m_packagesFirstScan)
+            {
+                input["options"]["return_old_data"] = true;
+            }
+            txn.syncTxnRow(input);
+        }
+
         txn.getDeletedRows(callback);
 
-        if (!m_packagesFirstScan && !m_stopping)
+        if (complete)
+        {
+            m_packagesFingerprint = std::move(fingerprint);
+        }
+
+        if (!m_packagesFirstScan && complete)
         {
             WriteMetadata(TABLE_TO_KEY_MAP.at(PACKAGES_TABLE), Utils::getCurrentISO8601());
             m_packagesFirstScan = true;
@@ -854,52 +959,36 @@ nlohmann::json Inventory::GetPortsData()
     constexpr auto TCP_PROTOCOL {"tcp"};
     constexpr auto UDP_PROTOCOL {"udp"};
     auto data(m_spInfo->ports());
+    std::unordered_set<std::string> itemIds;
+
+    const auto addPort = [&ret, &itemIds](nlohmann::json& item)
+    {
+        auto itemId {GetItemId(item, PORTS_ITEM_ID_FIELDS)};
+
+        if (itemIds.insert(itemId).second)
+        {
+            item["item_id"] = std::move(itemId);
+            ret.push_back(std::move(item));
+        }
+    };
 
     if (!data.is_null())
     {
         for (auto& item : data)
         {
-            const auto protocol {item.at("protocol").get_ref<const std::string&>()};
+            const auto& protocol {item.at("protocol").get_ref<const std::string&>()};
 
             if (Utils::startsWith(protocol, TCP_PROTOCOL))
             {
-                // All ports.
-                if (m_portsAll)
-                {
-                    const auto& itemId {GetItemId(item, PORTS_ITEM_ID_FIELDS)};
-
-                    if (!IsElementDuplicated(ret, std::make_pair("item_id", itemId)))
-                    {
-                        item["item_id"] = itemId;
-                        ret.push_back(item);
-                    }
-                }
-                else
+                // All ports or only listening ports.
+                if (m_portsAll || item.at("state") == PORT_LISTENING_STATE)
                 {
-                    // Only listening ports.
-                    const auto isListeningState {item.at("state") == PORT_LISTENING_STATE};
-
-                    if (isListeningState)
-                    {
-                        const auto& itemId {GetItemId(item, PORTS_ITEM_ID_FIELDS)};
-
-                        if (!IsElementDuplicated(ret, std::make_pair("item_id", itemId)))
-                        {
-                            item["item_id"] = itemId;
-                            ret.push_back(item);
-                        }
-                    }
+                    addPort(item);
                 }
             }
             else if (Utils::startsWith(protocol, UDP_PROTOCOL))
             {
-                const auto& itemId {GetItemId(item, PORTS_ITEM_ID_FIELDS)};
-
-                if (!IsElementDuplicated(ret, std::make_pair("item_id", itemId)))
-                {
-                    item["item_id"] = itemId;
-                    ret.push_back(item);
-                }
+                addPort(item);
             }
         }
     }
@@ -931,9 +1020,9 @@ void Inventory::ScanProcesses()
         LogTrace("Starting processes scan");
         const auto callback {[this](ReturnTypeCallback result, const nlohmann::json& data)
                              {
-                                 NotifyChange(result, data, PROCESSES_TABLE, !m_processesFirstScan);
+                                 NotifyChange(result, data, PROCESSES_TABLE, !m_processesFirstScan, m_scanTime);
                              }};
-        const std::unique_lock<std::mutex> lock {m_mutex};
+        const std::unique_lock<std::mutex> lock {m_tableMutexes.at(PROCESSES_TABLE)};
         DBSyncTxn txn {m_spDBSync->handle(), nlohmann::json {PROCESSES_TABLE}, 0, QUEUE_SIZE, callback};
         m_spInfo->processes(std::function<void(nlohmann::json&)>(
             [this, &txn](nlohmann::json& rawData)
@@ -966,27 +1055,112 @@ void Inventory::ScanProcesses()
     }
 }
 
+void Inventory::TrackProcesses()
+{
+    // Events are stamped when they are received, the scan time belongs to the scan threads
+    const auto callback {[this](ReturnTypeCallback result, const nlohmann::json& data)
+                         {
+                             NotifyChange(result, data, PROCESSES_TABLE, false, Utils::getCurrentISO8601());
+                         }};
+
+    // Events wait for a running scan of the table, which could otherwise sync a process that has exited since
+    const auto onEvent {[this, &callback](nlohmann::json& rawData, bool exited)
+                        {
+                            TryCatchTask(
+                                [&]()
+                                {
+                                    const std::unique_lock<std::mutex> lock {m_tableMutexes.at(PROCESSES_TABLE)};
+
+                                    if (!exited)
+                                    {
+                                        nlohmann::json input;
+                                        input["table"] = PROCESSES_TABLE;
+                                        input["data"] = nlohmann::json::array({rawData});
+                                        input["options"]["return_old_data"] = true;
+                                        m_spDBSync->syncRow(input, callback);
+                                        return;
+                                    }
+
+                                    // The row is reported with the data it had when it is deleted
+                                    auto deleteQuery {
+                                        DeleteQuery::builder().table(PROCESSES_TABLE).data(rawData).rowFilter("").build()};
+                                    m_spDBSync->deleteRows(deleteQuery.query(), callback);
+                                });
+                        }};
+
+    // Events lost while the socket buffer overflows are reconciled by the next scan
+    if (!m_spInfo->processEvents(onEvent, [this]() { return m_stopping.load(); }))
+    {
+        LogWarn("Process events are not available, processes are only updated on each scan.");
+    }
+}
+
 void Inventory::Scan()
 {
     LogInfo("Starting evaluation.");
     m_scanTime = Utils::getCurrentISO8601();
 
-    TryCatchTask([&]() { ScanHardware(); });
-    TryCatchTask([&]() { ScanSystem(); });
-    TryCatchTask([&]() { ScanPackages(); });
-    TryCatchTask([&]() { ScanProcesses(); });
-    TryCatchTask([&]() { ScanHotfixes(); });
-    TryCatchTask([&]() { ScanPorts(); });
-    TryCatchTask([&]() { ScanNetwork(); });
+    // Each scan syncs its own table, so they run concurrently. The I/O-heavy ones are started first.
+    const std::vector<std::function<void()>> scans {[&]() { ScanPackages(); },
+                                                    [&]() { ScanPorts(); },
+                                                    [&]() { ScanProcesses(); },
+                                                    [&]() { ScanHotfixes(); },
+                                                    [&]() { ScanNetwork(); },
+                                                    [&]() { ScanHardware(); },
+                                                    [&]() { ScanSystem(); }};
+    std::atomic<size_t> next {0};
+
+    const auto worker {[&]()
+                       {
+                           m_spScanBudget->EnterThread();
+
+                           for (auto i {next++}; i < scans.size(); i = next++)
+                           {
+                               TryCatchTask(scans[i]);
+
+                               // Outside the table locks and the data provider callbacks, so nothing waits on the sleep
+                               m_spScanBudget->Throttle([this]() { return m_stopping.load(); });
+                           }
+
+                           m_spScanBudget->LeaveThread();
+                       }};
+
+    const auto workerCount {std::min(MAX_SCAN_WORKERS, std::max(std::thread::hardware_concurrency(), 1U))};
+    std::vector<std::thread> workers;
+
+    m_spScanBudget->Start();
+
+    // Scans run on their own threads, so their nice level and I/O priority do not leak into the caller
+    for (unsigned int i = 0; i < workerCount; ++i)
+    {
+        workers.emplace_back(worker);
+    }
+
+    for (auto& thread : workers)
+    {
+        thread.join();
+    }
+
+    const auto metrics {m_spScanBudget->Finish()};
 
     m_notify = true;
-    LogInfo("Evaluation finished.");
+    LogInfo("Evaluation finished in {} ms, using {} ms of CPU time.", metrics.duration.count(), metrics.cpuTime.count());
 }
 
 void Inventory::SyncLoop()
 {
     LogInfo("Module started.");
 
+    std::thread processesTracker;
+
+    // A random delay keeps a fleet of agents from scanning in lock-step
+    if (const auto startDelay {m_spScanBudget->StartDelay()}; startDelay.count() > 0)
+    {
+        LogDebug("Delaying the first scan by {} ms.", startDelay.count());
+        std::unique_lock<std::mutex> lock {m_mutex};
+        m_cv.wait_for(lock, startDelay, [&]() { return m_stopping.load(); });
+    }
+
     if (m_scanOnStart && !m_stopping)
     {
         Scan();
@@ -994,12 +1168,24 @@ void Inventory::SyncLoop()
 
     while (!m_stopping)
     {
+        // Process events are applied on top of a complete scan
+        if (m_processes && m_processesEvents && m_processesFirstScan && !processesTracker.joinable())
+        {
+            processesTracker = std::thread {[this]() { TrackProcesses(); }};
+        }
+
         {
             std::unique_lock<std::mutex> lock {m_mutex};
             m_cv.wait_for(lock, std::chrono::milliseconds {m_intervalValue}, [&]() { return m_stopping.load(); });
         }
         Scan();
     }
+
+    if (processesTracker.joinable())
+    {
+        processesTracker.join();
+    }
+
     const std::unique_lock<std::mutex> lock {m_mutex};
     m_spDBSync.reset(nullptr);
 }
@@ -1108,54 +1294,11 @@ nlohmann::json Inventory::AddPreviousFields(nlohmann::json& current, const nlohm
     return modifiedKeys;
 }
 
-nlohmann::json
-Inventory::GenerateStatelessEvent(const std::string& operation, const std::string& type, const nlohmann::json& data)
+nlohmann::json Inventory::GenerateStatelessEvent(const std::string& operation,
+                                                 const std::string& type,
+                                                 const nlohmann::json& data,
+                                                 const std::string& timestamp)
 {
-    auto event = CreateStatelessEvent(type, operation, m_scanTime, data);
+    auto event = CreateStatelessEvent(type, operation, timestamp, data);
     return event ? event->generate() : nlohmann::json {};
 }
-
-void Inventory::SetJsonField(nlohmann::json& target,
-                             const nlohmann::json& source,
-                             const std::string& keyPath,
-                             const std::string& jsonKey,
-                             const std::optional<std::string>& defaultValue,
-                             bool createFields)
-{
-    if (createFields || source.contains(jsonKey))
-    {
-        const nlohmann::json::json_pointer pointer(keyPath);
-        if (source.contains(jsonKey) && source[jsonKey] != EMPTY_VALUE)
-        {
-            target[pointer] = source[jsonKey];
-        }
-        else if (defaultValue.has_value())
-        {
-            target[pointer] = *defaultValue;
-        }
-        else
-        {
-            target[pointer] = nullptr;
-        }
-    }
-}
-
-void Inventory::SetJsonFieldArray(nlohmann::json& target,
-                                  const nlohmann::json& source,
-                                  const std::string& destPath,
-                                  const std::string& sourceKey,
-                                  bool createFields)
-{
-    if (createFields || source.contains(sourceKey))
-    {
-        const nlohmann::json::json_pointer destPointer(destPath);
-        target[destPointer.parent_pointer()][destPointer.back()] = nlohmann::json::array();
-        nlohmann::json& destArray = target[destPointer];
-
-        if (source.contains(sourceKey) && !source[sourceKey].empty() && !source[sourceKey].is_null() &&
-            source[sourceKey] != EMPTY_VALUE)
-        {
-            destArray.push_back(source[sourceKey]);
-        }
-    }
-}
@@ -1,109 +1,196 @@
+#include <algorithm>
 #include <fstream>
 #include <inventoryNormalizer.hpp>
 #include <iostream>
-#include <regex>
+#include <string_view>
 
-InvNormalizer::InvNormalizer(const std::string& configFile, const std::string& target)
-    : m_typeExclusions {GetTypeValues(configFile, target, "exclusions")}
-    , m_typeDictionary {GetTypeValues(configFile, target, "dictionary")}
+namespace
 {
-}
+    constexpr std::string_view REGEX_SPECIAL_CHARS {"\\^$.|?*+()[]{}"};
+    constexpr std::string_view REGEX_ANY {".*"};
+    constexpr std::string_view LINE_TERMINATORS {"\r\n"};
 
-void InvNormalizer::RemoveExcluded(const std::string& type, nlohmann::json& data) const
+    const std::string* FindString(const nlohmann::json& item, const std::string& fieldName)
+    {
+        const auto fieldIt {item.find(fieldName)};
+        return fieldIt != item.end() && fieldIt->is_string() ? &fieldIt->get_ref<const std::string&>() : nullptr;
+    }
+
+    std::optional<std::string> GetOptionalString(const nlohmann::json& item, const std::string& key)
+    {
+        const auto it {item.find(key)};
+        return it != item.end() ? std::optional<std::string> {it->get<std::string>()} : std::nullopt;
+    }
+} // namespace
+
+InvNormalizer::Pattern::Pattern(const std::string& pattern)
+    : m_kind {Kind::Regex}
+    , m_regex {std::regex {pattern}}
 {
-    const auto exclusionsIt {m_typeExclusions.find(type)};
+    std::string_view literal {pattern};
+    const bool anyPrefix {literal.starts_with(REGEX_ANY)};
 
-    if (exclusionsIt != m_typeExclusions.cend())
+    if (anyPrefix)
     {
-        for (const auto& exclusionItem : exclusionsIt->second)
-        {
-            try
-            {
-                const std::regex pattern {exclusionItem["pattern"].get_ref<const std::string&>()};
-                const auto& fieldName {exclusionItem["field_name"].get_ref<const std::string&>()};
+        literal.remove_prefix(REGEX_ANY.size());
+    }
 
-                if (data.is_array())
-                {
-                    for (auto item {data.begin()}; item != data.end(); ++item)
-                    {
-                        const auto fieldIt {item->find(fieldName)};
+    const bool anySuffix {literal.ends_with(REGEX_ANY)};
 
-                        if (fieldIt != item->end() && std::regex_match(fieldIt->get_ref<const std::string&>(), pattern))
-                        {
-                            data.erase(item);
-                        }
-                    }
-                }
-                else
-                {
-                    const auto fieldIt {data.find(fieldName)};
+    if (anySuffix)
+    {
+        literal.remove_suffix(REGEX_ANY.size());
+    }
 
-                    if (fieldIt != data.end() && std::regex_match(fieldIt->get_ref<const std::string&>(), pattern))
-                    {
-                        data.clear();
-                    }
-                }
+    // A single capture group around the whole literal does not change what it matches
+    if (literal.size() >= 2 && literal.front() == '(' && literal.back() == ')')
+    {
+        literal = literal.substr(1, literal.size() - 2);
+    }
+
+    if (literal.find_first_of(REGEX_SPECIAL_CHARS) == std::string_view::npos)
+    {
+        m_literal = literal;
+
+        if (anyPrefix && anySuffix)
+        {
+            m_kind = Kind::Contains;
+        }
+        else if (anyPrefix)
+        {
+            m_kind = Kind::EndsWith;
+        }
+        else if (anySuffix)
+        {
+            m_kind = Kind::StartsWith;
+        }
+        else
+        {
+            m_kind = Kind::Equals;
+        }
+    }
+}
+
+bool InvNormalizer::Pattern::Match(const std::string& value) const
+{
+    // ".*" does not match line terminators, so such values are left to the regular expression
+    const bool wildcardSafe {value.find_first_of(LINE_TERMINATORS) == std::string::npos};
+
+    switch (m_kind)
+    {
+        case Kind::Equals: return value == m_literal;
+        case Kind::StartsWith:
+            if (wildcardSafe)
+            {
+                return value.starts_with(m_literal);
             }
-            // LCOV_EXCL_START
-            catch (const std::exception& ex)
+            break;
+        case Kind::EndsWith:
+            if (wildcardSafe)
             {
-                std::cout << "Exception caught in RemoveExcluded: " << ex.what() << '\n';
+                return value.ends_with(m_literal);
             }
-            catch (...)
+            break;
+        case Kind::Contains:
+            if (wildcardSafe)
             {
-                std::cout << "Unknown exception caught in RemoveExcluded." << '\n';
+                return value.find(m_literal) != std::string::npos;
             }
-            // LCOV_EXCL_STOP
-        }
+            break;
+        case Kind::Regex: break;
     }
+
+    return std::regex_match(value, *m_regex);
 }
 
-static void NormalizeItem(const nlohmann::json& dictionary, nlohmann::json& item)
+std::string InvNormalizer::Pattern::Replace(const std::string& value, const std::string& format) const
 {
-    for (const auto& dictItem : dictionary)
+    if (m_kind != Kind::Equals || m_literal.empty() || format.find('$') != std::string::npos)
+    {
+        return std::regex_replace(value, *m_regex, format);
+    }
+
+    std::string result;
+    size_t start {0};
+
+    for (auto pos {value.find(m_literal)}; pos != std::string::npos; pos = value.find(m_literal, start))
     {
-        const auto itFindPattern {dictItem.find("find_pattern")};
-        const auto itFindField {dictItem.find("find_field")};
+        result.append(value, start, pos - start).append(format);
+        start = pos + m_literal.size();
+    }
+
+    return result.append(value, start);
+}
+
+InvNormalizer::InvNormalizer(const std::string& configFile, const std::string& target)
+    : m_typeExclusions {CompileExclusions(GetTypeValues(configFile, target, "exclusions"))}
+    , m_typeDictionary {CompileDictionary(GetTypeValues(configFile, target, "dictionary"))}
+{
+}
 
-        if (itFindPattern != dictItem.end() && itFindField != dictItem.end())
+bool InvNormalizer::IsExcluded(const std::vector<ExclusionRule>& exclusions, const nlohmann::json& item)
+{
+    return std::any_of(exclusions.begin(),
+                       exclusions.end(),
+                       [&item](const ExclusionRule& exclusion)
+                       {
+                           const auto value {FindString(item, exclusion.fieldName)};
+                           return value && exclusion.pattern.Match(*value);
+                       });
+}
+
+void InvNormalizer::RemoveExcluded(const std::string& type, nlohmann::json& data) const
+{
+    const auto exclusionsIt {m_typeExclusions.find(type)};
+
+    if (exclusionsIt != m_typeExclusions.cend())
+    {
+        const auto& exclusions {exclusionsIt->second};
+
+        if (data.is_array())
+        {
+            auto& items {data.get_ref<nlohmann::json::array_t&>()};
+            items.erase(std::remove_if(items.begin(),
+                                       items.end(),
+                                       [&exclusions](const nlohmann::json& item)
+                                       { return IsExcluded(exclusions, item); }),
+                        items.end());
+        }
+        else if (IsExcluded(exclusions, data))
+        {
+            data.clear();
+        }
+    }
+}
+
+void InvNormalizer::NormalizeItem(const std::vector<DictionaryRule>& dictionary, nlohmann::json& item)
+{
+    for (const auto& rule : dictionary)
+    {
+        if (rule.findPattern)
         {
-            const auto fieldIt {item.find(itFindField->get_ref<const std::string&>())};
-            const std::regex pattern {itFindPattern->get_ref<const std::string&>()};
+            const auto value {FindString(item, *rule.findField)};
 
-            if (fieldIt == item.end() || !std::regex_match(fieldIt->get_ref<const std::string&>(), pattern))
+            if (!value || !rule.findPattern->Match(*value))
             {
                 // no field in the item or no matching, we continue
                 continue;
             }
         }
-        else if (itFindPattern != dictItem.end() || itFindField != dictItem.end())
-        {
-            // we won't evaluate an incomplete item.
-            continue;
-        }
-
-        const auto itReplacePattern {dictItem.find("replace_pattern")};
-        const auto itReplaceField {dictItem.find("replace_field")};
-        const auto itReplaceValue {dictItem.find("replace_value")};
 
-        if (itReplacePattern != dictItem.end() && itReplaceField != dictItem.end() && itReplaceValue != dictItem.end())
+        if (rule.replacePattern)
         {
-            const std::regex pattern {itReplacePattern->get_ref<const std::string&>()};
-            const auto fieldIt {item.find(itReplaceField->get_ref<const std::string&>())};
+            const auto fieldIt {item.find(*rule.replaceField)};
 
-            if (fieldIt != item.end())
+            if (fieldIt != item.end() && fieldIt->is_string())
             {
-                *fieldIt = std::regex_replace(
-                    fieldIt->get_ref<const std::string&>(), pattern, itReplaceValue->get_ref<const std::string&>());
+                *fieldIt = rule.replacePattern->Replace(fieldIt->get_ref<const std::string&>(), rule.replaceValue);
             }
         }
 
-        const auto itAddField {dictItem.find("add_field")};
-        const auto itAddValue {dictItem.find("add_value")};
-
-        if (itAddField != dictItem.end() && itAddValue != dictItem.end())
+        if (rule.addField)
         {
-            item[itAddField->get_ref<const std::string&>()] = itAddValue->get_ref<const std::string&>();
+            item[*rule.addField] = rule.addValue;
         }
     }
 }
@@ -128,6 +215,98 @@ void InvNormalizer::Normalize(const std::string& type, nlohmann::json& data) con
     }
 }
 
+std::map<std::string, std::vector<InvNormalizer::ExclusionRule>>
+InvNormalizer::CompileExclusions(const std::map<std::string, nlohmann::json>& typeExclusions)
+{
+    std::map<std::string, std::vector<ExclusionRule>> ret;
+
+    for (const auto& [type, exclusions] : typeExclusions)
+    {
+        auto& rules {ret[type]};
+
+        for (const auto& exclusionItem : exclusions)
+        {
+            try
+            {
+                rules.push_back({exclusionItem.at("field_name").get<std::string>(),
+                                 Pattern {exclusionItem.at("pattern").get_ref<const std::string&>()}});
+            }
+            // LCOV_EXCL_START
+            catch (const std::exception& ex)
+            {
+                std::cout << "Exception caught in CompileExclusions: " << ex.what() << '\n';
+            }
+            // LCOV_EXCL_STOP
+        }
+    }
+
+    return ret;
+}
+
+std::map<std::string, std::vector<InvNormalizer::DictionaryRule>>
+InvNormalizer::CompileDictionary(const std::map<std::string, nlohmann::json>& typeDictionary)
+{
+    std::map<std::string, std::vector<DictionaryRule>> ret;
+
+    for (const auto& [type, dictionary] : typeDictionary)
+    {
+        auto& rules {ret[type]};
+
+        for (const auto& dictItem : dictionary)
+        {
+            try
+            {
+                DictionaryRule rule;
+                rule.findField = GetOptionalString(dictItem, "find_field");
+                const auto findPattern {GetOptionalString(dictItem, "find_pattern")};
+
+                if (rule.findField.has_value() != findPattern.has_value())
+                {
+                    // we won't evaluate an incomplete item.
+                    continue;
+                }
+
+                if (findPattern)
+                {
+                    rule.findPattern.emplace(*findPattern);
+                }
+
+                const auto replacePattern {GetOptionalString(dictItem, "replace_pattern")};
+                const auto replaceValue {GetOptionalString(dictItem, "replace_value")};
+                rule.replaceField = GetOptionalString(dictItem, "replace_field");
+
+                if (replacePattern && rule.replaceField && replaceValue)
+                {
+                    rule.replacePattern.emplace(*replacePattern);
+                    rule.replaceValue = *replaceValue;
+                }
+
+                const auto addValue {GetOptionalString(dictItem, "add_value")};
+                rule.addField = GetOptionalString(dictItem, "add_field");
+
+                if (rule.addField && addValue)
+                {
+                    rule.addValue = *addValue;
+                }
+                else
+                {
+                    rule.addField.reset();
+                }
+
+                rules.push_back(std::move(rule));
+            }
+            // LCOV_EXCL_START
+            catch (const std::exception& ex)
+            {
+                std::cout << "Exception caught in CompileDictionary: " << ex.what() << '\n';
+            }
+            // LCOV_EXCL_STOP
+        }
+    }
+
+    return ret;
+}
+
 std::map<std::string, nlohmann::json>
 InvNormalizer::GetTypeValues(const std::string& configFile, const std::string& target, const std::string& type)
 {
@@ -0,0 +1,217 @@
+#include <scanBudget.hpp>
+
+#include <logger.hpp>
+
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <sys/resource.h>
+#include <time.h>
+#endif
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    // Longest single sleep, so that stopping the module is not delayed
+    constexpr std::chrono::milliseconds MAX_THROTTLE_SLEEP {100};
+
+#if defined(__linux__)
+    // I/O scheduling classes of ioprio_set(2). glibc does not expose them.
+    constexpr int IOPRIO_CLASS_SHIFT {13};
+    constexpr int IOPRIO_CLASS_BE {2};
+    constexpr int IOPRIO_CLASS_IDLE {3};
+    constexpr int IOPRIO_WHO_PROCESS {1};
+    constexpr int IOPRIO_LOWEST_LEVEL {7};
+#endif
+
+    // Scan identifiers are unique across budgets, so that threads never mistake a scan for another
+    std::atomic<uint64_t> g_lastScanId {0};
+
+    struct ThreadAccount
+    {
+        uint64_t scanId {0};
+        std::chrono::nanoseconds cpuTime {0};
+    };
+
+    thread_local ThreadAccount t_account;
+
+    std::chrono::nanoseconds ThreadCpuTime()
+    {
+#ifdef _WIN32
+        FILETIME creation, exit, kernel, user;
+
+        if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user))
+        {
+            return std::chrono::nanoseconds {0};
+        }
+
+        const auto toTicks = [](const FILETIME& time)
+        {
+            return (static_cast<int64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+        };
+
+        // FILETIME counts intervals of 100 nanoseconds
+        return std::chrono::nanoseconds {(toTicks(kernel) + toTicks(user)) * 100};
+#else
+        timespec time {};
+
+        if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) != 0)
+        {
+            return std::chrono::nanoseconds {0};
+        }
+
+        return std::chrono::seconds {time.tv_sec} + std::chrono::nanoseconds {time.tv_nsec};
+#endif
+    }
+
+    void SetScanThreadPriority(int niceLevel, const std::string& ioPriority)
+    {
+#if defined(__linux__)
+        // On Linux, the nice level and the I/O priority of a thread id only apply to that thread
+        const auto tid {static_cast<id_t>(syscall(SYS_gettid))};
+
+        if (niceLevel != 0 && setpriority(PRIO_PROCESS, tid, niceLevel) != 0)
+        {
+            LogWarn("Unable to set the nice level of the scan: {}", std::strerror(errno));
+        }
+
+        if (ioPriority != "normal")
+        {
+            const auto priority {ioPriority == "idle"
+                                     ? IOPRIO_CLASS_IDLE << IOPRIO_CLASS_SHIFT
+                                     : (IOPRIO_CLASS_BE << IOPRIO_CLASS_SHIFT) | IOPRIO_LOWEST_LEVEL};
+
+            if (syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, tid, priority) != 0)
+            {
+                LogWarn("Unable to set the I/O priority of the scan: {}", std::strerror(errno));
+            }
+        }
+#elif defined(__APPLE__)
+        // The nice level applies to the whole process on macOS, so only the I/O policy is set
+        (void)niceLevel;
+
+        if (ioPriority != "normal" &&
+            setiopolicy_np(
+                IOPOL_TYPE_DISK, IOPOL_SCOPE_THREAD, ioPriority == "idle" ? IOPOL_THROTTLE : IOPOL_UTILITY) != 0)
+        {
+            LogWarn("Unable to set the I/O priority of the scan: {}", std::strerror(errno));
+        }
+#elif defined(_WIN32)
+        // Background mode lowers both the CPU and the I/O priority of the thread
+        if (ioPriority != "normal")
+        {
+            if (!::SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN))
+            {
+                LogWarn("Unable to set the I/O priority of the scan: {}", GetLastError());
+            }
+        }
+        else if (niceLevel > 0 && !::SetThreadPriority(GetCurrentThread(),
+                                                        niceLevel >= 10 ? THREAD_PRIORITY_LOWEST
+                                                                        : THREAD_PRIORITY_BELOW_NORMAL))
+        {
+            LogWarn("Unable to set the priority of the scan: {}", GetLastError());
+        }
+#else
+        (void)niceLevel;
+        (void)ioPriority;
+#endif
+    }
+} // namespace
+
+ScanBudget::ScanBudget(unsigned int cpuLimit, int niceLevel, std::string ioPriority, std::time_t jitter)
+    : m_cpuLimit {cpuLimit}
+    , m_niceLevel {niceLevel}
+    , m_ioPriority {std::move(ioPriority)}
+    , m_jitter {jitter}
+    , m_scanId {0}
+    , m_cpuTime {0}
+    , m_start {std::chrono::steady_clock::now()}
+{
+}
+
+std::chrono::milliseconds ScanBudget::StartDelay() const
+{
+    if (m_jitter <= 0)
+    {
+        return std::chrono::milliseconds {0};
+    }
+
+    std::random_device device;
+    std::uniform_int_distribution<std::time_t> distribution {0, m_jitter};
+    return std::chrono::milliseconds {distribution(device)};
+}
+
+void ScanBudget::Start()
+{
+    m_cpuTime = 0;
+    m_start = std::chrono::steady_clock::now();
+    m_scanId = ++g_lastScanId;
+}
+
+void ScanBudget::EnterThread()
+{
+    SetScanThreadPriority(m_niceLevel, m_ioPriority);
+    t_account = ThreadAccount {m_scanId, ThreadCpuTime()};
+}
+
+void ScanBudget::Account()
+{
+    const auto scanId {m_scanId.load()};
+    const auto cpuTime {ThreadCpuTime()};
+
+    // Threads that did not enter the scan start being accounted now
+    if (t_account.scanId == scanId)
+    {
+        m_cpuTime += (cpuTime - t_account.cpuTime).count();
+    }
+
+    t_account = ThreadAccount {scanId, cpuTime};
+}
+
+void ScanBudget::Throttle(const std::function<bool()>& stopping)
+{
+    Account();
+
+    if (m_cpuLimit == 0)
+    {
+        return;
+    }
+
+    // Sleeping until the CPU time of the scan is within its share of the elapsed time
+    const auto cpuTime {std::chrono::nanoseconds {m_cpuTime.load()}};
+    const auto target {m_start + cpuTime * 100 / m_cpuLimit};
+
+    for (auto now {std::chrono::steady_clock::now()}; now < target && !stopping();
+         now = std::chrono::steady_clock::now())
+    {
+        std::this_thread::sleep_for(
+            std::min<std::chrono::steady_clock::duration>(target - now, MAX_THROTTLE_SLEEP));
+    }
+}
+
+void ScanBudget::LeaveThread()
+{
+    Account();
+    t_account = ThreadAccount {};
+}
+
+ScanMetrics ScanBudget::Finish()
+{
+    ScanMetrics metrics;
+    metrics.duration =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_start);
+    metrics.cpuTime =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::nanoseconds {m_cpuTime.load()});
+    return metrics;
+}
@@ -0,0 +1,133 @@
+// Measures a package scan cycle through InvNormalizer against the former approach,
+// which built every dictionary and exclusion regex again for each item.
+// Usage: inv_normalizer_benchmark [packages] [cycles]
+
+#include "inventoryNormalizer.hpp"
+#include "test_config.h"
+#include "test_input.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <regex>
+#include <string>
+
+namespace
+{
+    nlohmann::json CreatePackages(size_t count)
+    {
+        const auto input(nlohmann::json::parse(TEST_INPUT_DATA));
+        nlohmann::json packages = nlohmann::json::array();
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto package(input[i % input.size()]);
+            package["name"] = package["name"].get<std::string>() + " " + std::to_string(i / input.size());
+            packages.push_back(std::move(package));
+        }
+
+        return packages;
+    }
+
+    void LegacyCycle(const nlohmann::json& config, nlohmann::json& data)
+    {
+        for (auto& item : data)
+        {
+            for (const auto& dictItem : config["dictionary"])
+            {
+                if (dictItem.contains("find_pattern") != dictItem.contains("find_field"))
+                {
+                    continue;
+                }
+
+                if (dictItem.contains("find_pattern"))
+                {
+                    const std::regex pattern {dictItem["find_pattern"].get_ref<const std::string&>()};
+                    const auto fieldIt {item.find(dictItem["find_field"].get<std::string>())};
+
+                    if (fieldIt == item.end() || !std::regex_match(fieldIt->get_ref<const std::string&>(), pattern))
+                    {
+                        continue;
+                    }
+                }
+
+                if (dictItem.contains("replace_pattern") && dictItem.contains("replace_field") &&
+                    dictItem.contains("replace_value"))
+                {
+                    const std::regex pattern {dictItem["replace_pattern"].get_ref<const std::string&>()};
+                    auto& field {item[dictItem["replace_field"].get<std::string>()]};
+                    field = std::regex_replace(field.get_ref<const std::string&>(),
+                                               pattern,
+                                               dictItem["replace_value"].get_ref<const std::string&>());
+                }
+
+                if (dictItem.contains("add_field") && dictItem.contains("add_value"))
+                {
+                    item[dictItem["add_field"].get<std::string>()] = dictItem["add_value"];
+                }
+            }
+        }
+
+        for (const auto& exclusion : config["exclusions"])
+        {
+            const std::regex pattern {exclusion["pattern"].get_ref<const std::string&>()};
+            const auto& fieldName {exclusion["field_name"].get_ref<const std::string&>()};
+
+            data.erase(std::remove_if(data.begin(),
+                                      data.end(),
+                                      [&](const nlohmann::json& item) {
+                                          return std::regex_match(item[fieldName].get_ref<const std::string&>(),
+                                                                  pattern);
+                                      }),
+                       data.end());
+        }
+    }
+
+    template<typename Cycle>
+    double Measure(const nlohmann::json& packages, size_t cycles, Cycle cycle)
+    {
+        const auto start {std::chrono::steady_clock::now()};
+
+        for (size_t i = 0; i < cycles; ++i)
+        {
+            auto data(packages);
+            cycle(data);
+        }
+
+        const std::chrono::duration<double, std::milli> elapsed {std::chrono::steady_clock::now() - start};
+        return elapsed.count() / static_cast<double>(cycles);
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const size_t packageCount {argc > 1 ? std::stoul(argv[1]) : 3000};
+    const size_t cycles {argc > 2 ? std::stoul(argv[2]) : 10};
+
+    {
+        std::ofstream testConfigFile {TEST_CONFIG_FILE_NAME};
+        testConfigFile << TEST_CONFIG_FILE_CONTENT;
+    }
+
+    const auto config(nlohmann::json::parse(TEST_CONFIG_FILE_CONTENT));
+    const auto packages(CreatePackages(packageCount));
+    const InvNormalizer normalizer {TEST_CONFIG_FILE_NAME, "macos"};
+    std::remove(TEST_CONFIG_FILE_NAME);
+
+    const auto legacy {Measure(packages, cycles, [&config](nlohmann::json& data) { LegacyCycle(config, data); })};
+    const auto compiled {Measure(packages,
+                                 cycles,
+                                 [&normalizer](nlohmann::json& data)
+                                 {
+                                     normalizer.Normalize("packages", data);
+                                     normalizer.RemoveExcluded("packages", data);
+                                 })};
+
+    std::cout << packageCount << " packages, " << cycles << " cycles\n"
+              << "regex per item:     " << legacy << " ms/cycle\n"
+              << "compiled rules:     " << compiled << " ms/cycle\n"
+              << "speedup:            " << legacy / compiled << "x\n";
+
+    return 0;
+}
@@ -235,6 +235,51 @@ TEST_F(InvNormalizerTest, normalizeItemMatch)
     EXPECT_NE(inputJson, origJson);
 }
 
+TEST_F(InvNormalizerTest, literalAndRegexPatterns)
+{
+    constexpr auto PATTERNS_FILE {"patterns.json"};
+    std::ofstream testConfigFile {PATTERNS_FILE};
+
+    if (testConfigFile.is_open())
+    {
+        testConfigFile << R"DELIMITER({
+            "exclusions": [
+                {"target": "linux", "data_type": "packages", "field_name": "name", "pattern": ".*-dbg"},
+                {"target": "linux", "data_type": "packages", "field_name": "name", "pattern": "lib[0-9]+"}
+            ],
+            "dictionary": [
+                {"target": "linux", "data_type": "packages", "find_field": "name", "find_pattern": "python3.*",
+                 "add_field": "vendor", "add_value": "Python"},
+                {"target": "linux", "data_type": "packages", "replace_field": "name", "replace_pattern": "(-bin)",
+                 "replace_value": ""},
+                {"target": "linux", "data_type": "packages", "replace_field": "name", "replace_pattern": "^(\\w+)-(\\d)$",
+                 "replace_value": "$1$2"}
+            ]
+        })DELIMITER";
+        testConfigFile.close();
+    }
+
+    auto inputJson(nlohmann::json::parse(R"([
+        {"name": "python3-bin-bin"},
+        {"name": "python3\nbin"},
+        {"name": "gdb-dbg"},
+        {"name": "lib64"},
+        {"name": "lib64-dev"},
+        {"name": "qt-5"}
+    ])"));
+    const InvNormalizer normalizer {PATTERNS_FILE, "linux"};
+    normalizer.Normalize("packages", inputJson);
+    normalizer.RemoveExcluded("packages", inputJson);
+    std::remove(PATTERNS_FILE);
+
+    ASSERT_EQ(inputJson.size(), 4);
+    EXPECT_EQ(inputJson[0]["name"], "python3");
+    EXPECT_EQ(inputJson[0]["vendor"], "Python");
+    EXPECT_FALSE(inputJson[1].contains("vendor"));
+    EXPECT_EQ(inputJson[2]["name"], "lib64-dev");
+    EXPECT_EQ(inputJson[3]["name"], "qt5");
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
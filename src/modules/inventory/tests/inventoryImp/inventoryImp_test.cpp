@@ -20,7 +20,11 @@ using ::testing::Return;
 class SysInfoWrapper : public ISysInfo
 {
 public:
-    SysInfoWrapper() = default;
+    SysInfoWrapper()
+    {
+        ON_CALL(*this, packagesComplete()).WillByDefault(Return(true));
+    }
+
     ~SysInfoWrapper() override = default;
 
     SysInfoWrapper(const SysInfoWrapper&) = delete;
@@ -37,6 +41,13 @@ public:
     MOCK_METHOD(void, processes, (std::function<void(nlohmann::json&)>), (override));
     MOCK_METHOD(nlohmann::json, ports, (), (override));
     MOCK_METHOD(nlohmann::json, hotfixes, (), (override));
+    MOCK_METHOD(nlohmann::json, packagesFingerprint, (), (override));
+    MOCK_METHOD(bool, packagesComplete, (), (override));
+    MOCK_METHOD(bool,
+                processEvents,
+                (std::function<void(nlohmann::json&, bool)>, std::function<bool()>),
+                (override));
+    MOCK_METHOD(void, setProcessesFields, (const std::set<std::string>&), (override));
 };
 
 class CallbackMock
@@ -1320,6 +1331,343 @@ TEST_F(InventoryImpTest, PackagesDuplicated)
     }
 }
 
+TEST_F(InventoryImpTest, packagesUnchangedSources)
+{
+    const auto spInfoWrapper {std::make_shared<SysInfoWrapper>()};
+
+    EXPECT_CALL(*spInfoWrapper, packagesFingerprint())
+        .Times(::testing::AtLeast(2))
+        .WillRepeatedly(Return(R"({"/var/lib/dpkg/status":"1700000000.0:1024:42"})"_json));
+    EXPECT_CALL(*spInfoWrapper, packages(testing::_))
+        .Times(1)
+        .WillOnce(::testing::InvokeArgument<0>(
+            R"({"architecture":"amd64","scan_time":"2020/12/28 21:49:50", "group":"x11","name":"xserver-xorg","priority":"optional","size":4111222333,"source":"xorg","version":"1:7.7+19ubuntu14","format":"deb","location":" "})"_json));
+
+    CallbackMock wrapper;
+    std::function<void(const std::string&)> callbackData {[&wrapper](const std::string& data)
+                                                          {
+                                                              auto delta = nlohmann::json::parse(data);
+                                                              delta["data"].erase("@timestamp");
+                                                              delta["metadata"].erase("id");
+                                                              delta.erase("stateless");
+                                                              wrapper.callbackMock(delta.dump());
+                                                          }};
+
+    const auto expectedResult1 {
+        R"({"data":{"package":{"architecture":"amd64","description":null,"installed":null,"name":"xserver-xorg","path":" ","size":4111222333,"type":"deb","version":"1:7.7+19ubuntu14"}},"metadata":{"collector":"packages","module":"inventory","operation":"create"}})"};
+
+    EXPECT_CALL(wrapper, callbackMock(expectedResult1)).Times(1);
+
+    const std::string inventoryConfig = R"(
+        inventory:
+            enabled: true
+            interval: 1
+            scan_on_start: true
+            hardware: false
+            system: false
+            networks: false
+            packages: true
+            ports: false
+            ports_all: false
+            processes: false
+            hotfixes: false
+    )";
+    auto configParser = std::make_shared<configuration::ConfigurationParser>(inventoryConfig);
+    Inventory::Instance().Setup(configParser);
+
+    std::thread t {[&spInfoWrapper, &callbackData]()
+                   {
+                       Inventory::Instance().Init(spInfoWrapper, callbackData, INVENTORY_DB_PATH, "", "");
+                       Inventory::Instance().SetAgentUUID("1234");
+                   }};
+
+    std::this_thread::sleep_for(std::chrono::seconds {SLEEP_DURATION_SECONDS});
+    Inventory::Instance().Stop();
+
+    if (t.joinable())
+    {
+        t.join();
+    }
+}
+
+TEST_F(InventoryImpTest, packagesIncompleteScanKeepsUnlisted)
+{
+    const auto spInfoWrapper {std::make_shared<SysInfoWrapper>()};
+    const auto xserver =
+        R"({"architecture":"amd64","scan_time":"2020/12/28 21:49:50", "group":"x11","name":"xserver-xorg","priority":"optional","size":4111222333,"source":"xorg","version":"1:7.7+19ubuntu14","format":"deb","location":" "})"_json;
+    const auto curl =
+        R"({"architecture":"amd64","scan_time":"2020/12/28 21:49:50", "group":"web","name":"curl","priority":"optional","size":411,"source":"curl","version":"7.81.0","format":"deb","location":" "})"_json;
+    auto scans {0};
+
+    // The later scans hit the enumeration cap before listing curl
+    EXPECT_CALL(*spInfoWrapper, packages(testing::_))
+        .Times(::testing::AtLeast(2))
+        .WillRepeatedly(
+            [&](const std::function<void(nlohmann::json&)>& callback)
+            {
+                auto first = xserver;
+                callback(first);
+
+                if (scans++ == 0)
+                {
+                    auto second = curl;
+                    callback(second);
+                }
+            });
+    EXPECT_CALL(*spInfoWrapper, packagesComplete())
+        .Times(::testing::AtLeast(2))
+        .WillOnce(Return(true))
+        .WillRepeatedly(Return(false));
+
+    CallbackMock wrapper;
+    std::function<void(const std::string&)> callbackData {[&wrapper](const std::string& data)
+                                                          {
+                                                              auto delta = nlohmann::json::parse(data);
+                                                              delta["data"].erase("@timestamp");
+                                                              delta["metadata"].erase("id");
+                                                              delta.erase("stateless");
+                                                              wrapper.callbackMock(delta.dump());
+                                                          }};
+
+    const auto expectedResult1 {
+        R"({"data":{"package":{"architecture":"amd64","description":null,"installed":null,"name":"xserver-xorg","path":" ","size":4111222333,"type":"deb","version":"1:7.7+19ubuntu14"}},"metadata":{"collector":"packages","module":"inventory","operation":"create"}})"};
+    const auto expectedResult2 {
+        R"({"data":{"package":{"architecture":"amd64","description":null,"installed":null,"name":"curl","path":" ","size":411,"type":"deb","version":"7.81.0"}},"metadata":{"collector":"packages","module":"inventory","operation":"create"}})"};
+
+    // No delete event is expected for curl
+    EXPECT_CALL(wrapper, callbackMock(expectedResult1)).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(expectedResult2)).Times(1);
+
+    const std::string inventoryConfig = R"(
+        inventory:
+            enabled: true
+            interval: 1
+            scan_on_start: true
+            hardware: false
+            system: false
+            networks: false
+            packages: true
+            ports: false
+            ports_all: false
+            processes: false
+            hotfixes: false
+    )";
+    auto configParser = std::make_shared<configuration::ConfigurationParser>(inventoryConfig);
+    Inventory::Instance().Setup(configParser);
+
+    std::thread t {[&spInfoWrapper, &callbackData]()
+                   {
+                       Inventory::Instance().Init(spInfoWrapper, callbackData, INVENTORY_DB_PATH, "", "");
+                       Inventory::Instance().SetAgentUUID("1234");
+                   }};
+
+    std::this_thread::sleep_for(std::chrono::seconds {SLEEP_DURATION_SECONDS});
+    Inventory::Instance().Stop();
+
+    if (t.joinable())
+    {
+        t.join();
+    }
+}
+
+TEST_F(InventoryImpTest, processesEvents)
+{
+    const auto spInfoWrapper {std::make_shared<SysInfoWrapper>()};
+
+    EXPECT_CALL(*spInfoWrapper, processes(testing::_))
+        .Times(::testing::AtLeast(1))
+        .WillRepeatedly(::testing::InvokeArgument<0>(
+            R"({"egroup":"root","euser":"root","fgroup":"root","name":"kworker/u256:2-","scan_time":"2020/12/28 21:49:50", "nice":0,"nlwp":1,"pgrp":0,"pid":"431625","ppid":2,"priority":20,"processor":1,"resident":0,"rgroup":"root","ruser":"root","session":0,"sgroup":"root","share":0,"size":0,"start_time":9302261,"state":"I","stime":3,"suser":"root","tgid":431625,"tty":0,"utime":0,"vm_size":0})"_json));
+    EXPECT_CALL(*spInfoWrapper, processEvents(testing::_, testing::_))
+        .WillOnce(
+            [](std::function<void(nlohmann::json&, bool)> callback, std::function<bool()> stop)
+            {
+                auto started =
+                    R"({"egroup":"root","euser":"root","fgroup":"root","name":"sleep","scan_time":"2020/12/28 21:49:50", "nice":0,"nlwp":1,"pgrp":0,"pid":"45","ppid":2,"priority":20,"processor":1,"resident":0,"rgroup":"root","ruser":"root","session":0,"sgroup":"root","share":0,"size":0,"start_time":9302262,"state":"S","stime":3,"suser":"root","tgid":45,"tty":0,"utime":0,"vm_size":0})"_json;
+                callback(started, false);
+
+                auto exited = R"({"pid":"45"})"_json;
+                callback(exited, true);
+
+                // Processes never synced are not reported when they exit
+                auto unknown = R"({"pid":"46"})"_json;
+                callback(unknown, true);
+
+                while (!stop())
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds {10});
+                }
+
+                return true;
+            });
+
+    CallbackMock wrapper;
+    std::function<void(const std::string&)> callbackData {
+        [&wrapper](const std::string& data)
+        {
+            const auto delta = nlohmann::json::parse(data);
+            wrapper.callbackMock(delta["metadata"]["operation"].get<std::string>() + ":" +
+                                 delta["data"]["process"]["pid"].dump());
+        }};
+
+    EXPECT_CALL(wrapper, callbackMock(R"(create:"431625")")).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(R"(create:"45")")).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(R"(delete:"45")")).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(R"(delete:"46")")).Times(0);
+
+    const std::string inventoryConfig = R"(
+        inventory:
+            enabled: true
+            interval: 3600
+            scan_on_start: true
+            hardware: false
+            system: false
+            networks: false
+            packages: false
+            ports: false
+            ports_all: false
+            processes: true
+            processes_events: true
+            hotfixes: false
+    )";
+    auto configParser = std::make_shared<configuration::ConfigurationParser>(inventoryConfig);
+    Inventory::Instance().Setup(configParser);
+
+    std::thread t {[&spInfoWrapper, &callbackData]()
+                   {
+                       Inventory::Instance().Init(spInfoWrapper, callbackData, INVENTORY_DB_PATH, "", "");
+                       Inventory::Instance().SetAgentUUID("1234");
+                   }};
+
+    std::this_thread::sleep_for(std::chrono::seconds {2});
+    Inventory::Instance().Stop();
+
+    if (t.joinable())
+    {
+        t.join();
+    }
+}
+
+TEST_F(InventoryImpTest, processesFields)
+{
+    const auto spInfoWrapper {std::make_shared<SysInfoWrapper>()};
+
+    // Attributes that are not columns of the processes table are dropped
+    EXPECT_CALL(*spInfoWrapper, setProcessesFields(std::set<std::string> {"cmd", "name", "pid"})).Times(1);
+    EXPECT_CALL(*spInfoWrapper, processes(testing::_))
+        .Times(::testing::AtLeast(1))
+        .WillRepeatedly(::testing::InvokeArgument<0>(R"({"pid":"431625","name":"kworker/u256:2-","cmd":""})"_json));
+
+    const std::string inventoryConfig = R"(
+        inventory:
+            enabled: true
+            interval: 3600
+            scan_on_start: true
+            hardware: false
+            system: false
+            networks: false
+            packages: false
+            ports: false
+            ports_all: false
+            processes: true
+            processes_fields: [name, cmd, memory]
+            hotfixes: false
+    )";
+    auto configParser = std::make_shared<configuration::ConfigurationParser>(inventoryConfig);
+    Inventory::Instance().Setup(configParser);
+
+    std::thread t {[&spInfoWrapper]()
+                   {
+                       Inventory::Instance().Init(spInfoWrapper, ReportFunction, INVENTORY_DB_PATH, "", "");
+                       Inventory::Instance().SetAgentUUID("1234");
+                   }};
+
+    std::this_thread::sleep_for(std::chrono::seconds {1});
+    Inventory::Instance().Stop();
+
+    if (t.joinable())
+    {
+        t.join();
+    }
+}
+
+TEST_F(InventoryImpTest, parallelScanReportsOnce)
+{
+    const auto spInfoWrapper {std::make_shared<SysInfoWrapper>()};
+
+    EXPECT_CALL(*spInfoWrapper, hardware())
+        .WillRepeatedly(Return(nlohmann::json::parse(
+            R"({"board_serial":"Intel Corporation","scan_time":"2020/12/28 21:49:50", "cpu_mhz":2904,"cpu_cores":2,"cpu_name":"Intel(R) Core(TM) i5-9400 CPU @ 2.90GHz", "ram_free":2257872,"ram_total":4972208,"ram_usage":54})")));
+    EXPECT_CALL(*spInfoWrapper, os())
+        .WillRepeatedly(Return(nlohmann::json::parse(
+            R"({"architecture":"x86_64","scan_time":"2020/12/28 21:49:50", "hostname":"UBUNTU","os_build":"7601","os_major":"6","os_minor":"1","os_name":"Microsoft Windows 7","os_release":"sp1","os_version":"6.1.7601"})")));
+    EXPECT_CALL(*spInfoWrapper, ports())
+        .WillRepeatedly(Return(nlohmann::json::parse(
+            R"([{"inode":0,"local_ip":"127.0.0.1","scan_time":"2020/12/28 21:49:50", "local_port":631,"pid":0,"process_name":"System Idle Process","protocol":"tcp","remote_ip":"0.0.0.0","remote_port":0,"rx_queue":0,"state":"listening","tx_queue":0}])")));
+    EXPECT_CALL(*spInfoWrapper, packages(testing::_))
+        .WillRepeatedly(::testing::InvokeArgument<0>(
+            R"({"architecture":"amd64","scan_time":"2020/12/28 21:49:50", "group":"x11","name":"xserver-xorg","priority":"optional","size":4111222333,"source":"xorg","version":"1:7.7+19ubuntu14","format":"deb","location":" "})"_json));
+    EXPECT_CALL(*spInfoWrapper, processes(testing::_))
+        .WillRepeatedly(::testing::InvokeArgument<0>(
+            R"({"egroup":"root","euser":"root","fgroup":"root","name":"kworker/u256:2-","scan_time":"2020/12/28 21:49:50", "nice":0,"nlwp":1,"pgrp":0,"pid":"431625","ppid":2,"priority":20,"processor":1,"resident":0,"rgroup":"root","ruser":"root","session":0,"sgroup":"root","share":0,"size":0,"start_time":9302261,"state":"I","stime":3,"suser":"root","tgid":431625,"tty":0,"utime":0,"vm_size":0})"_json));
+    EXPECT_CALL(*spInfoWrapper, hotfixes())
+        .WillRepeatedly(Return(nlohmann::json::parse(R"([{"hotfix":"KB12345678"}])")));
+    EXPECT_CALL(*spInfoWrapper, networks())
+        .WillRepeatedly(Return(nlohmann::json::parse(
+            R"({"iface":[{"IPv4":[{"address":"172.17.0.1","broadcast":"172.17.255.255","dhcp":"unknown","metric":"0","netmask":"255.255.0.0"}],"adapter":"","gateway":"","mac":"02:42:1c:26:13:65","mtu":1500,"name":"docker0","rx_bytes":0,"rx_dropped":0,"rx_errors":0,"rx_packets":0,"state":"down","tx_bytes":0,"tx_dropped":0,"tx_errors":0,"tx_packets":0,"type":"ethernet"}]})")));
+
+    // The scans of the tables run on several threads, while the reports are delivered one at a time
+    std::atomic<int> reporting {0};
+    std::atomic<bool> overlapped {false};
+    std::map<std::string, int> reports;
+    std::function<void(const std::string&)> callbackData {
+        [&](const std::string& data)
+        {
+            if (reporting++ != 0)
+            {
+                overlapped = true;
+            }
+
+            std::this_thread::sleep_for(std::chrono::milliseconds {10});
+            ++reports[nlohmann::json::parse(data)["metadata"]["collector"].get<std::string>()];
+            --reporting;
+        }};
+
+    const std::string inventoryConfig = R"(
+        inventory:
+            enabled: true
+            interval: 3600
+            scan_on_start: true
+            processes: true
+    )";
+    auto configParser = std::make_shared<configuration::ConfigurationParser>(inventoryConfig);
+    Inventory::Instance().Setup(configParser);
+
+    std::thread t {[&spInfoWrapper, &callbackData]()
+                   {
+                       Inventory::Instance().Init(spInfoWrapper, callbackData, INVENTORY_DB_PATH, "", "");
+                       Inventory::Instance().SetAgentUUID("1234");
+                   }};
+
+    std::this_thread::sleep_for(std::chrono::seconds {2});
+    Inventory::Instance().Stop();
+
+    if (t.joinable())
+    {
+        t.join();
+    }
+
+    const std::map<std::string, int> expected {{"hardware", 1},
+                                               {"system", 1},
+                                               {"packages", 1},
+                                               {"processes", 1},
+                                               {"ports", 1},
+                                               {"hotfixes", 1},
+                                               {"networks", 1}};
+    EXPECT_FALSE(overlapped);
+    EXPECT_EQ(expected, reports);
+}
+
 TEST_F(InventoryImpTest, hashId)
 {
     const auto spInfoWrapper {std::make_shared<SysInfoWrapper>()};
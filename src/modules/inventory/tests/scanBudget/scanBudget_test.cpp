@@ -0,0 +1,119 @@
+#include <scanBudget.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+namespace
+{
+    // Keeps the calling thread on the CPU for the given time
+    void BusyWait(std::chrono::milliseconds duration)
+    {
+        const auto end {std::chrono::steady_clock::now() + duration};
+        volatile unsigned int counter {0};
+
+        while (std::chrono::steady_clock::now() < end)
+        {
+            counter = counter + 1;
+        }
+    }
+
+    bool NotStopping()
+    {
+        return false;
+    }
+} // namespace
+
+TEST(ScanBudgetTest, NoJitterNoDelay)
+{
+    const ScanBudget budget {0, 0, "normal", 0};
+    EXPECT_EQ(budget.StartDelay().count(), 0);
+}
+
+TEST(ScanBudgetTest, StartDelayWithinJitter)
+{
+    const ScanBudget budget {0, 0, "normal", 1000};
+
+    for (int i = 0; i < 100; ++i)
+    {
+        const auto delay {budget.StartDelay()};
+        EXPECT_GE(delay.count(), 0);
+        EXPECT_LE(delay.count(), 1000);
+    }
+}
+
+TEST(ScanBudgetTest, MetricsWithoutLimit)
+{
+    ScanBudget budget {0, 0, "normal", 0};
+
+    budget.Start();
+    budget.EnterThread();
+    BusyWait(std::chrono::milliseconds {50});
+    budget.Throttle(NotStopping);
+    budget.LeaveThread();
+    const auto metrics {budget.Finish()};
+
+    EXPECT_GE(metrics.duration.count(), 50);
+    EXPECT_GT(metrics.cpuTime.count(), 0);
+    EXPECT_LE(metrics.cpuTime.count(), metrics.duration.count());
+}
+
+TEST(ScanBudgetTest, ThrottleKeepsCpuShare)
+{
+    ScanBudget budget {50, 0, "normal", 0};
+
+    budget.Start();
+    budget.EnterThread();
+
+    for (int i = 0; i < 5; ++i)
+    {
+        BusyWait(std::chrono::milliseconds {20});
+        budget.Throttle(NotStopping);
+    }
+
+    budget.LeaveThread();
+    const auto metrics {budget.Finish()};
+
+    // At most half of the elapsed time is spent on the CPU
+    EXPECT_GE(metrics.duration.count(), 2 * metrics.cpuTime.count() - 5);
+}
+
+TEST(ScanBudgetTest, ThrottleInterruptedWhenStopping)
+{
+    ScanBudget budget {1, 0, "normal", 0};
+
+    budget.Start();
+    budget.EnterThread();
+    BusyWait(std::chrono::milliseconds {50});
+
+    // A 1% share would sleep for seconds
+    const auto start {std::chrono::steady_clock::now()};
+    budget.Throttle([]() { return true; });
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds {1000});
+
+    budget.LeaveThread();
+}
+
+TEST(ScanBudgetTest, CpuTimeOfSeveralThreads)
+{
+    ScanBudget budget {0, 0, "low", 0};
+
+    budget.Start();
+
+    const auto worker {[&budget]()
+                       {
+                           budget.EnterThread();
+                           BusyWait(std::chrono::milliseconds {40});
+                           budget.LeaveThread();
+                       }};
+
+    std::thread first {worker};
+    std::thread second {worker};
+    first.join();
+    second.join();
+
+    const auto metrics {budget.Finish()};
+    EXPECT_GT(metrics.cpuTime.count(), 0);
+    EXPECT_LE(metrics.cpuTime.count(), 2 * metrics.duration.count());
+}
@@ -9,6 +9,7 @@
 #include <boost/asio/steady_timer.hpp>
 
 #include <list>
+#include <mutex>
 #include <string>
 
 namespace logcollector
@@ -17,6 +18,15 @@ namespace logcollector
     /// @brief Interface for log readers
     class IReader;
 
+    /// @brief Persistent store of file reading positions
+    class FileCheckpointStore;
+
+    /// @brief Include/exclude rules of a log source
+    class LineFilter;
+
+    /// @brief Command that returns the line filter counters, as GetFilterStats does
+    const std::string FILTER_STATS_COMMAND = "filter-stats";
+
     /// @brief Logcollector module class
     ///
     /// This module is responsible for collecting logs from various sources and processing them.
@@ -78,6 +88,12 @@ namespace logcollector
             return s_instance;
         }
 
+        /// @brief Gets the line filter counters of every log source with include/exclude rules
+        /// @details The counters are returned by the FILTER_STATS_COMMAND command, and logged when the readers are
+        /// cleaned up
+        /// @return JSON object mapping each source to its matched and dropped line counts
+        nlohmann::json GetFilterStats() const;
+
         /// @brief Add platform specific implementation of IReader to logcollector.
         /// @param ConfigurationParser where to get parameters.
         void AddPlatformSpecificReader(std::shared_ptr<const configuration::ConfigurationParser> configurationParser);
@@ -96,6 +112,12 @@ namespace logcollector
         /// @brief Clean all readers
         void CleanAllReaders();
 
+        /// @brief Creates the line filter of a log source from its "include" and "exclude" settings
+        /// @param source Name of the log source
+        /// @param config Configuration node of the log source
+        /// @return Line filter, or nullptr if the source has no rules
+        std::shared_ptr<LineFilter> CreateLineFilter(const std::string& source, const YAML::Node& config);
+
     private:
         /// @brief Module name
         const std::string m_moduleName = "logcollector";
@@ -120,6 +142,15 @@ namespace logcollector
 
         /// @brief List of steady timers
         std::list<boost::asio::steady_timer*> m_timers;
+
+        /// @brief File checkpoint store, or nullptr if checkpoints are not available
+        std::shared_ptr<FileCheckpointStore> m_checkpoints;
+
+        /// @brief Mutex to access the line filters list, read by the commands
+        mutable std::mutex m_lineFiltersMutex;
+
+        /// @brief Line filters of the configured log sources
+        std::list<std::shared_ptr<LineFilter>> m_lineFilters;
     };
 
 } // namespace logcollector
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <persistence.hpp>
+#include <reader.hpp>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+
+namespace logcollector
+{
+
+    /// @brief Reading position of a local file
+    ///
+    /// Besides the offset, the checkpoint keeps the identity of the file (device
+    /// and inode) and a fingerprint of its first bytes, so that a reader can tell
+    /// whether the file has been rotated or truncated since the checkpoint was taken.
+    struct FileCheckpoint
+    {
+        /// @brief Device where the file resides
+        std::uint64_t device = 0;
+
+        /// @brief Inode of the file
+        std::uint64_t inode = 0;
+
+        /// @brief Offset of the first byte not read yet
+        std::int64_t offset = 0;
+
+        /// @brief Hash of the first bytes of the file
+        std::uint64_t fingerprint = 0;
+
+        /// @brief Number of bytes covered by the fingerprint
+        std::int64_t fingerprintSize = 0;
+    };
+
+    /// @brief File checkpoint store class
+    ///
+    /// Keeps the reading position of every local file in memory and persists it
+    /// into a database under the agent data folder. Updates are cheap, as they only
+    /// touch memory; the database is written only when Flush is called.
+    class FileCheckpointStore
+    {
+    public:
+        /// @brief Constructor
+        /// @param dbFolderPath Path to the database folder
+        /// @param persistence Optional pointer to an existing persistence object
+        /// @throw std::runtime_error if the database cannot be opened
+        explicit FileCheckpointStore(const std::string& dbFolderPath, std::unique_ptr<Persistence> persistence = nullptr);
+
+        /// @brief Gets the checkpoint of a file
+        /// @param path File path
+        /// @return Checkpoint, or std::nullopt if the file has never been checkpointed
+        std::optional<FileCheckpoint> Get(const std::string& path) const;
+
+        /// @brief Sets the checkpoint of a file
+        /// @param path File path
+        /// @param checkpoint Checkpoint
+        void Set(const std::string& path, const FileCheckpoint& checkpoint);
+
+        /// @brief Writes the checkpoints modified since the last flush into the database
+        void Flush();
+
+    private:
+        /// @brief Creates the checkpoint table if it does not exist
+        void CreateTable();
+
+        /// @brief Loads the checkpoints from the database
+        ///
+        /// Checkpoints of files that no longer exist are discarded.
+        void Load();
+
+        /// @brief Database
+        std::unique_ptr<Persistence> m_db;
+
+        /// @brief Checkpoints indexed by file path
+        std::map<std::string, FileCheckpoint> m_checkpoints;
+
+        /// @brief Paths modified since the last flush
+        std::set<std::string> m_dirty;
+
+        /// @brief Mutex to access the checkpoint map
+        mutable std::mutex m_mutex;
+
+        /// @brief Mutex to serialize database writes
+        std::mutex m_flushMutex;
+    };
+
+    /// @brief Checkpoint writer class
+    ///
+    /// Reader-like task that periodically flushes the checkpoint store, so that
+    /// file readers never block on database writes.
+    class CheckpointWriter : public IReader
+    {
+    public:
+        /// @brief Constructor
+        /// @param logcollector Logcollector instance
+        /// @param store Checkpoint store
+        /// @param interval Flush interval in milliseconds
+        CheckpointWriter(Logcollector& logcollector, std::shared_ptr<FileCheckpointStore> store, std::time_t interval);
+
+        /// @brief Runs the checkpoint writer
+        /// @return Awaitable result
+        Awaitable Run() override;
+
+        /// @brief Stops the checkpoint writer
+        void Stop() override;
+
+    private:
+        /// @brief Checkpoint store
+        std::shared_ptr<FileCheckpointStore> m_store;
+
+        /// @brief Flush interval in milliseconds
+        std::time_t m_interval;
+    };
+
+} // namespace logcollector
@@ -1,10 +1,18 @@
 #pragma once
 
+#include <cstdint>
 #include <ctime>
 #include <exception>
+#include <filesystem>
 #include <fstream>
 #include <list>
+#include <map>
+#include <optional>
+#include <unordered_map>
+#include <utility>
 
+#include <file_checkpoint_store.hpp>
+#include <line_filter.hpp>
 #include <logcollector.hpp>
 #include <reader.hpp>
 
@@ -35,6 +43,20 @@ namespace logcollector
         /// @brief Seeks to the end of the file
         void SeekEnd();
 
+        /// @brief Resumes reading from a checkpoint
+        ///
+        /// If the file is the same one that was checkpointed, it seeks to the
+        /// checkpoint offset. Otherwise, the file has been rotated or truncated
+        /// after the checkpoint was taken, and it seeks to the beginning.
+        ///
+        /// @param checkpoint Checkpoint
+        /// @return True if the reading resumes at the checkpoint offset, false otherwise
+        bool Resume(const FileCheckpoint& checkpoint);
+
+        /// @brief Gets the current checkpoint of the file
+        /// @return Checkpoint pointing to the first byte not read yet
+        FileCheckpoint Checkpoint();
+
         /// @brief Checks if the file has been rotated
         ///
         /// This method checks if the file has been rotated by comparing the current
@@ -47,6 +69,34 @@ namespace logcollector
         /// @brief Reopens the file
         void Reopen();
 
+        /// @brief Closes the file, keeping the reading position
+        void Close();
+
+        /// @brief Opens a closed file again, at the position where it was closed
+        ///
+        /// If the file has been replaced or truncated while it was closed, it
+        /// seeks to the beginning. The file is considered the same if its
+        /// identity is unchanged, it is not shorter than the reading position
+        /// and its head still matches the cached fingerprint, if any.
+        ///
+        /// @return True if the reading resumes at the previous position, false otherwise
+        bool Restore();
+
+        /// @brief Checks whether the file size differs from the size seen when its end was last reached
+        ///
+        /// This is meant for closed files, to decide whether it is worth opening
+        /// them again. A trailing partial line does not count as new data.
+        ///
+        /// @return True if the file may have new data, false otherwise
+        bool HasNewData() const;
+
+        /// @brief Checks if the file is open
+        /// @return True if the file is open, false otherwise
+        inline bool IsOpen() const
+        {
+            return m_stream != nullptr;
+        }
+
         /// @brief Gets the file name
         /// @return File name
         inline const std::string& Filename() const
@@ -54,7 +104,29 @@ namespace logcollector
             return m_filename;
         }
 
+        /// @brief Gets the identity of the file being read
+        /// @return Pair of device and inode, or zeros if unknown
+        inline std::pair<std::uint64_t, std::uint64_t> Identity() const
+        {
+            return {m_device, m_inode};
+        }
+
+        /// @brief Gets the identity of a file without opening it for reading
+        /// @param filename File name
+        /// @return Pair of device and inode, or zeros if the file cannot be queried
+        static std::pair<std::uint64_t, std::uint64_t> Identity(const std::string& filename);
+
     private:
+        /// @brief Reads the identity (device and inode) of the file
+        ///
+        /// If the file cannot be queried, the identity is set to zeros.
+        void ReadIdentity();
+
+        /// @brief Computes the fingerprint of the first bytes of the file
+        /// @param size Maximum number of bytes to hash
+        /// @return Pair of hash and number of bytes hashed
+        std::pair<std::uint64_t, std::int64_t> Fingerprint(std::int64_t size) const;
+
         /// @brief File name
         std::string m_filename;
 
@@ -63,6 +135,111 @@ namespace logcollector
 
         /// @brief Current position in the file
         std::streampos m_pos;
+
+        /// @brief File size when its end was last reached, or -1 if unknown
+        std::streamoff m_readSize = -1;
+
+        /// @brief Device of the file being read
+        std::uint64_t m_device = 0;
+
+        /// @brief Inode of the file being read
+        std::uint64_t m_inode = 0;
+
+        /// @brief Cached fingerprint of the file head
+        std::uint64_t m_fingerprint = 0;
+
+        /// @brief Number of bytes covered by the cached fingerprint
+        std::int64_t m_fingerprintSize = 0;
+    };
+
+    /// @brief Local file registry class
+    ///
+    /// Indexes the local files of a file reader by path and by identity (device
+    /// and inode), and limits the number of files kept open at the same time.
+    /// When the limit is reached, the least recently read file is closed; it
+    /// keeps its position and is opened again once it has new data.
+    class LocalfileRegistry
+    {
+    public:
+        /// @brief Constructor
+        /// @param maxOpenFiles Maximum number of open files, 0 means no limit
+        explicit LocalfileRegistry(std::size_t maxOpenFiles = 0);
+
+        /// @brief Checks if a path is registered
+        /// @param path File path
+        /// @return True if the path is registered, false otherwise
+        bool Contains(const std::string& path) const;
+
+        /// @brief Opens and registers a local file
+        ///
+        /// If the file is already registered under another path (same device and
+        /// inode, e.g. it has been renamed), it is neither opened nor registered
+        /// again.
+        ///
+        /// @param path File path
+        /// @return Pointer to the local file, or nullptr if it is a duplicate
+        /// @throw OpenError if the file cannot be opened
+        Localfile* Add(const std::string& path);
+
+        /// @brief Unregisters a local file
+        /// @param path File path
+        /// @post The file is destroyed and may not be used anymore
+        void Remove(const std::string& path);
+
+        /// @brief Opens a closed local file again
+        /// @param lf Localfile
+        /// @return True if the reading resumes at the previous position, false otherwise
+        /// @throw OpenError if the file cannot be opened
+        bool Restore(Localfile& lf);
+
+        /// @brief Reopens a rotated local file
+        /// @param lf Localfile
+        /// @throw OpenError if the file cannot be opened
+        void Reopen(Localfile& lf);
+
+        /// @brief Marks a local file as the most recently read
+        /// @param lf Localfile
+        void Touch(Localfile& lf);
+
+        /// @brief Gets the number of registered files
+        /// @return Number of files
+        std::size_t Size() const;
+
+        /// @brief Gets the number of open files
+        /// @return Number of open files
+        std::size_t OpenCount() const;
+
+    private:
+        /// @brief Registry entry
+        struct Entry
+        {
+            /// @brief Local file
+            Localfile file;
+
+            /// @brief Position in the LRU list, valid while the file is open
+            std::list<Localfile*>::iterator lru;
+        };
+
+        /// @brief Inserts an open file into the LRU list, closing the oldest files if needed
+        /// @param entry Registry entry
+        void Open(Entry& entry);
+
+        /// @brief Updates the identity index of a file
+        /// @param lf Localfile
+        /// @param previous Identity under which the file was indexed
+        void Reindex(const Localfile& lf, const std::pair<std::uint64_t, std::uint64_t>& previous);
+
+        /// @brief Maximum number of open files
+        std::size_t m_maxOpenFiles;
+
+        /// @brief Files indexed by path
+        std::unordered_map<std::string, Entry> m_byPath;
+
+        /// @brief File paths indexed by identity
+        std::map<std::pair<std::uint64_t, std::uint64_t>, std::string> m_byIdentity;
+
+        /// @brief Open files, most recently read first
+        std::list<Localfile*> m_lru;
     };
 
     /// @brief File reader class
@@ -79,7 +256,16 @@ namespace logcollector
         /// @param pattern File pattern
         /// @param fileWait File wait time in milliseconds
         /// @param reloadInterval Reload interval in milliseconds
-        FileReader(Logcollector& logcollector, std::string pattern, std::time_t fileWait, std::time_t reloadInterval);
+        /// @param maxOpenFiles Maximum number of files kept open, 0 means no limit
+        /// @param checkpoints Optional checkpoint store to resume reading after a restart
+        /// @param lineFilter Optional include/exclude rules applied to every line
+        FileReader(Logcollector& logcollector,
+                   std::string pattern,
+                   std::time_t fileWait,
+                   std::time_t reloadInterval,
+                   std::size_t maxOpenFiles = 0,
+                   std::shared_ptr<FileCheckpointStore> checkpoints = nullptr,
+                   std::shared_ptr<LineFilter> lineFilter = nullptr);
 
         /// @brief Runs the file reader
         /// @return Awaitable result
@@ -111,6 +297,26 @@ namespace logcollector
         /// @param callback Callback function
         void AddLocalfiles(const std::list<std::string>& paths, const std::function<void(Localfile&)>& callback);
 
+        /// @brief Checks whether the pattern directory may contain new files
+        ///
+        /// If the directory part of the pattern has no wildcards, its modification
+        /// time is compared with the one seen in the last reload. Otherwise, the
+        /// directory is always considered changed.
+        ///
+        /// @return True if the pattern has to be expanded again, false otherwise
+        bool PatternDirectoryChanged();
+
+        /// @brief Positions a new local file
+        ///
+        /// Resumes from its checkpoint if there is one. Otherwise, seeks to the end.
+        ///
+        /// @param lf Localfile
+        void Position(Localfile& lf);
+
+        /// @brief Saves the checkpoint of a local file
+        /// @param lf Localfile
+        void SaveCheckpoint(Localfile& lf);
+
         /// @brief Removes a local file from the list
         /// @param filename File name
         /// @post The file is destroyed and may not be used anymore
@@ -119,8 +325,11 @@ namespace logcollector
         /// @brief File pattern
         std::string m_filePattern;
 
-        /// @brief List of local files
-        std::list<Localfile> m_localfiles;
+        /// @brief Registry of local files
+        LocalfileRegistry m_localfiles;
+
+        /// @brief Modification time of the pattern directory in the last reload
+        std::optional<std::filesystem::file_time_type> m_directoryTime;
 
         /// @brief File reading interval in milliseconds
         std::time_t m_fileWait;
@@ -128,6 +337,12 @@ namespace logcollector
         /// @brief Reload (wildcard expand) interval in milliseconds
         std::time_t m_reloadInterval;
 
+        /// @brief Checkpoint store
+        std::shared_ptr<FileCheckpointStore> m_checkpoints;
+
+        /// @brief Include/exclude rules
+        std::shared_ptr<LineFilter> m_lineFilter;
+
         /// @brief File pattern
         const std::string m_collectorType = FILE_READER_TYPE;
     };
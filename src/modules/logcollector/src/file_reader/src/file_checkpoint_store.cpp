@@ -0,0 +1,234 @@
+#include "file_checkpoint_store.hpp"
+
+#include <column.hpp>
+#include <logger.hpp>
+#include <persistence_factory.hpp>
+
+#include <filesystem>
+#include <stdexcept>
+#include <vector>
+
+using namespace logcollector;
+using namespace column;
+
+namespace
+{
+    // database
+    const std::string CHECKPOINT_DB_NAME = "logcollector.db";
+
+    // file_checkpoint table
+    const std::string CHECKPOINT_TABLE_NAME = "file_checkpoint";
+    const std::string CHECKPOINT_PATH_COLUMN_NAME = "path";
+    const std::string CHECKPOINT_DEVICE_COLUMN_NAME = "device";
+    const std::string CHECKPOINT_INODE_COLUMN_NAME = "inode";
+    const std::string CHECKPOINT_OFFSET_COLUMN_NAME = "offset";
+    const std::string CHECKPOINT_FINGERPRINT_COLUMN_NAME = "fingerprint";
+    const std::string CHECKPOINT_FINGERPRINT_SIZE_COLUMN_NAME = "fingerprint_size";
+
+    // 64-bit unsigned values (device, inode and hash) are stored as text, as they may not fit into a SQLite INTEGER
+    const Names CHECKPOINT_COLUMNS = {ColumnName(CHECKPOINT_PATH_COLUMN_NAME, ColumnType::TEXT),
+                                      ColumnName(CHECKPOINT_DEVICE_COLUMN_NAME, ColumnType::TEXT),
+                                      ColumnName(CHECKPOINT_INODE_COLUMN_NAME, ColumnType::TEXT),
+                                      ColumnName(CHECKPOINT_OFFSET_COLUMN_NAME, ColumnType::INTEGER),
+                                      ColumnName(CHECKPOINT_FINGERPRINT_COLUMN_NAME, ColumnType::TEXT),
+                                      ColumnName(CHECKPOINT_FINGERPRINT_SIZE_COLUMN_NAME, ColumnType::INTEGER)};
+} // namespace
+
+FileCheckpointStore::FileCheckpointStore(const std::string& dbFolderPath, std::unique_ptr<Persistence> persistence)
+{
+    const auto dbFilePath = dbFolderPath + "/" + CHECKPOINT_DB_NAME;
+
+    try
+    {
+        if (persistence)
+        {
+            m_db = std::move(persistence);
+        }
+        else
+        {
+            m_db = PersistenceFactory::CreatePersistence(PersistenceFactory::PersistenceType::SQLITE3, dbFilePath);
+        }
+
+        if (!m_db->TableExists(CHECKPOINT_TABLE_NAME))
+        {
+            CreateTable();
+        }
+
+        Load();
+    }
+    catch (const std::exception&)
+    {
+        throw std::runtime_error(std::string("Cannot open database: " + dbFilePath));
+    }
+}
+
+void FileCheckpointStore::CreateTable()
+{
+    try
+    {
+        const Keys columns = {
+            ColumnKey(CHECKPOINT_PATH_COLUMN_NAME, ColumnType::TEXT, NOT_NULL | PRIMARY_KEY),
+            ColumnKey(CHECKPOINT_DEVICE_COLUMN_NAME, ColumnType::TEXT, NOT_NULL),
+            ColumnKey(CHECKPOINT_INODE_COLUMN_NAME, ColumnType::TEXT, NOT_NULL),
+            ColumnKey(CHECKPOINT_OFFSET_COLUMN_NAME, ColumnType::INTEGER, NOT_NULL),
+            ColumnKey(CHECKPOINT_FINGERPRINT_COLUMN_NAME, ColumnType::TEXT, NOT_NULL),
+            ColumnKey(CHECKPOINT_FINGERPRINT_SIZE_COLUMN_NAME, ColumnType::INTEGER, NOT_NULL)};
+
+        m_db->CreateTable(CHECKPOINT_TABLE_NAME, columns);
+    }
+    catch (const std::exception& e)
+    {
+        LogError("Error creating table: {}.", e.what());
+        throw;
+    }
+}
+
+void FileCheckpointStore::Load()
+{
+    const auto rows = m_db->Select(CHECKPOINT_TABLE_NAME, CHECKPOINT_COLUMNS);
+    std::vector<std::string> stale;
+
+    for (const auto& row : rows)
+    {
+        if (row.size() != CHECKPOINT_COLUMNS.size())
+        {
+            continue;
+        }
+
+        const auto& path = row[0].Value;
+        std::error_code ec;
+
+        if (!std::filesystem::exists(path, ec))
+        {
+            stale.push_back(path);
+            continue;
+        }
+
+        try
+        {
+            FileCheckpoint checkpoint;
+            checkpoint.device = std::stoull(row[1].Value);
+            checkpoint.inode = std::stoull(row[2].Value);
+            checkpoint.offset = std::stoll(row[3].Value);
+            checkpoint.fingerprint = std::stoull(row[4].Value);
+            checkpoint.fingerprintSize = std::stoll(row[5].Value);
+            m_checkpoints[path] = checkpoint;
+        }
+        catch (const std::exception&)
+        {
+            LogWarn("Discarding invalid checkpoint for file: {}", path);
+            stale.push_back(path);
+        }
+    }
+
+    for (const auto& path : stale)
+    {
+        m_db->Remove(CHECKPOINT_TABLE_NAME, {ColumnValue(CHECKPOINT_PATH_COLUMN_NAME, ColumnType::TEXT, path)});
+    }
+
+    LogDebug("Loaded {} file checkpoints, {} discarded.", m_checkpoints.size(), stale.size());
+}
+
+std::optional<FileCheckpoint> FileCheckpointStore::Get(const std::string& path) const
+{
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    const auto it = m_checkpoints.find(path);
+
+    if (it == m_checkpoints.end())
+    {
+        return std::nullopt;
+    }
+
+    return it->second;
+}
+
+void FileCheckpointStore::Set(const std::string& path, const FileCheckpoint& checkpoint)
+{
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    m_checkpoints[path] = checkpoint;
+    m_dirty.insert(path);
+}
+
+void FileCheckpointStore::Flush()
+{
+    const std::lock_guard<std::mutex> flushLock(m_flushMutex);
+    std::map<std::string, FileCheckpoint> pending;
+
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+
+        for (const auto& path : m_dirty)
+        {
+            pending.emplace(path, m_checkpoints.at(path));
+        }
+
+        m_dirty.clear();
+    }
+
+    if (pending.empty())
+    {
+        return;
+    }
+
+    const auto transaction = m_db->BeginTransaction();
+
+    try
+    {
+        for (const auto& [path, checkpoint] : pending)
+        {
+            const Criteria filter = {ColumnValue(CHECKPOINT_PATH_COLUMN_NAME, ColumnType::TEXT, path)};
+            const Row row = {
+                ColumnValue(CHECKPOINT_PATH_COLUMN_NAME, ColumnType::TEXT, path),
+                ColumnValue(CHECKPOINT_DEVICE_COLUMN_NAME, ColumnType::TEXT, std::to_string(checkpoint.device)),
+                ColumnValue(CHECKPOINT_INODE_COLUMN_NAME, ColumnType::TEXT, std::to_string(checkpoint.inode)),
+                ColumnValue(CHECKPOINT_OFFSET_COLUMN_NAME, ColumnType::INTEGER, std::to_string(checkpoint.offset)),
+                ColumnValue(
+                    CHECKPOINT_FINGERPRINT_COLUMN_NAME, ColumnType::TEXT, std::to_string(checkpoint.fingerprint)),
+                ColumnValue(CHECKPOINT_FINGERPRINT_SIZE_COLUMN_NAME,
+                            ColumnType::INTEGER,
+                            std::to_string(checkpoint.fingerprintSize))};
+
+            m_db->Remove(CHECKPOINT_TABLE_NAME, filter);
+            m_db->Insert(CHECKPOINT_TABLE_NAME, row);
+        }
+
+        m_db->CommitTransaction(transaction);
+        LogTrace("Flushed {} file checkpoints.", pending.size());
+    }
+    catch (const std::exception& e)
+    {
+        LogError("Error writing file checkpoints: {}.", e.what());
+        m_db->RollbackTransaction(transaction);
+
+        // Keep the checkpoints pending so that the next flush retries them
+        const std::lock_guard<std::mutex> lock(m_mutex);
+
+        for (const auto& [path, checkpoint] : pending)
+        {
+            m_dirty.insert(path);
+        }
+    }
+}
+
+CheckpointWriter::CheckpointWriter(Logcollector& logcollector,
+                                   std::shared_ptr<FileCheckpointStore> store,
+                                   std::time_t interval)
+    : IReader(logcollector)
+    , m_store(std::move(store))
+    , m_interval(interval)
+{
+}
+
+Awaitable CheckpointWriter::Run()
+{
+    while (m_keepRunning.load())
+    {
+        co_await m_logcollector.Wait(std::chrono::milliseconds(m_interval));
+        m_store->Flush();
+    }
+}
+
+void CheckpointWriter::Stop()
+{
+    m_keepRunning.store(false);
+}
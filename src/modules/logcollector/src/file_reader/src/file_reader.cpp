@@ -5,19 +5,41 @@
 #include <logger.hpp>
 
 #include <algorithm>
+#include <filesystem>
 #include <string>
+#include <tuple>
+#include <vector>
 
 using namespace logcollector;
 
+namespace
+{
+    /// @brief Maximum number of bytes of the file head covered by the fingerprint
+    constexpr std::int64_t FINGERPRINT_SIZE = 1024;
+
+    // FNV-1a parameters, so that fingerprints are stable across builds and platforms
+    constexpr std::uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+    constexpr std::uint64_t FNV_PRIME = 1099511628211ULL;
+
+    /// @brief Directories modified more recently than this are always expanded again, as some filesystems have a
+    /// coarse timestamp resolution
+    constexpr auto DIRECTORY_TIME_GRANULARITY = std::chrono::seconds(2);
+} // namespace
+
 FileReader::FileReader(Logcollector& logcollector,
                        std::string pattern,
                        std::time_t fileWait,
-                       std::time_t reloadInterval)
+                       std::time_t reloadInterval,
+                       std::size_t maxOpenFiles,
+                       std::shared_ptr<FileCheckpointStore> checkpoints,
+                       std::shared_ptr<LineFilter> lineFilter)
     : IReader(logcollector)
     , m_filePattern(std::move(pattern))
-    , m_localfiles()
+    , m_localfiles(maxOpenFiles)
     , m_fileWait(fileWait)
     , m_reloadInterval(reloadInterval)
+    , m_checkpoints(std::move(checkpoints))
+    , m_lineFilter(std::move(lineFilter))
 {
 }
 
@@ -28,7 +50,7 @@ Awaitable FileReader::Run()
         Reload(
             [&](Localfile& lf)
             {
-                lf.SeekEnd();
+                Position(lf);
                 m_logcollector.EnqueueTask(ReadLocalfile(&lf));
             });
 
@@ -45,25 +67,59 @@ Awaitable FileReader::ReadLocalfile(Localfile* lf)
 {
     while (m_keepRunning.load())
     {
+        if (!lf->IsOpen() && !lf->HasNewData())
+        {
+            co_await m_logcollector.Wait(std::chrono::milliseconds(m_fileWait));
+            continue;
+        }
+
+        try
+        {
+            if (!lf->IsOpen() && !m_localfiles.Restore(*lf))
+            {
+                LogInfo("File '{}' replaced while closed, reading from the beginning", lf->Filename());
+            }
+        }
+        catch (OpenError&)
+        {
+            LogInfo("File inaccesible: {}", lf->Filename());
+            RemoveLocalfile(lf->Filename());
+            co_return;
+        }
+
+        m_localfiles.Touch(*lf);
+
         auto log = lf->NextLog();
+        const bool hasLogs = !log.empty();
 
         while (!log.empty())
         {
-            m_logcollector.SendMessage(lf->Filename(), log, m_collectorType);
+            if (!m_lineFilter || m_lineFilter->Accept(log))
+            {
+                m_logcollector.SendMessage(lf->Filename(), log, m_collectorType);
+            }
+
             log = lf->NextLog();
         }
 
+        if (hasLogs)
+        {
+            SaveCheckpoint(*lf);
+        }
+
         try
         {
             if (lf->Rotated())
             {
                 LogInfo("File '{}' rotated, reloading", lf->Filename());
-                lf->Reopen();
+                m_localfiles.Reopen(*lf);
+                SaveCheckpoint(*lf);
             }
         }
         catch (OpenError&)
         {
             LogInfo("File inaccesible: {}", lf->Filename());
+            RemoveLocalfile(lf->Filename());
             co_return;
         }
 
@@ -75,20 +131,225 @@ Awaitable FileReader::ReadLocalfile(Localfile* lf)
 
 void FileReader::AddLocalfiles(const std::list<std::string>& paths, const std::function<void(Localfile&)>& callback)
 {
-    for (auto& path : paths)
+    for (const auto& path : paths)
     {
-        if (none_of(m_localfiles.begin(), m_localfiles.end(), [&path](Localfile& lf) { return lf.Filename() == path; }))
+        if (m_localfiles.Contains(path))
         {
-            m_localfiles.emplace_back(path);
-            LogInfo("Reading log file: {}", m_localfiles.back().Filename());
-            callback(m_localfiles.back());
+            continue;
         }
+
+        try
+        {
+            auto* lf = m_localfiles.Add(path);
+
+            if (!lf)
+            {
+                LogDebug("File '{}' is already being read under another path", path);
+                continue;
+            }
+
+            LogInfo("Reading log file: {}", lf->Filename());
+            callback(*lf);
+        }
+        catch (OpenError& e)
+        {
+            LogWarn("{}", e.what());
+        }
+    }
+}
+
+bool FileReader::PatternDirectoryChanged()
+{
+    const auto separator = m_filePattern.find_last_of("\\/");
+
+    if (separator == std::string::npos)
+    {
+        return true;
+    }
+
+    const auto directory = m_filePattern.substr(0, std::max<size_t>(separator, 1));
+
+    if (directory.find_first_of("*?[") != std::string::npos)
+    {
+        return true;
+    }
+
+    std::error_code ec;
+    const auto writeTime = std::filesystem::last_write_time(directory, ec);
+
+    if (ec)
+    {
+        m_directoryTime.reset();
+        return true;
+    }
+
+    const auto now = std::filesystem::file_time_type::clock::now();
+    const bool changed =
+        !m_directoryTime || *m_directoryTime != writeTime || now - writeTime < DIRECTORY_TIME_GRANULARITY;
+
+    m_directoryTime = writeTime;
+    return changed;
+}
+
+void FileReader::Position(Localfile& lf)
+{
+    const auto checkpoint = m_checkpoints ? m_checkpoints->Get(lf.Filename()) : std::nullopt;
+
+    if (!checkpoint)
+    {
+        lf.SeekEnd();
+    }
+    else if (lf.Resume(*checkpoint))
+    {
+        LogDebug("Resuming file '{}' at offset {}", lf.Filename(), checkpoint->offset);
+    }
+    else
+    {
+        LogInfo("File '{}' changed since its last checkpoint, reading from the beginning", lf.Filename());
+    }
+
+    SaveCheckpoint(lf);
+}
+
+void FileReader::SaveCheckpoint(Localfile& lf)
+{
+    if (m_checkpoints)
+    {
+        m_checkpoints->Set(lf.Filename(), lf.Checkpoint());
     }
 }
 
 void FileReader::RemoveLocalfile(const std::string& filename)
 {
-    m_localfiles.remove_if([&filename](Localfile& lf) { return lf.Filename() == filename; });
+    m_localfiles.Remove(filename);
+}
+
+LocalfileRegistry::LocalfileRegistry(std::size_t maxOpenFiles)
+    : m_maxOpenFiles(maxOpenFiles)
+{
+}
+
+bool LocalfileRegistry::Contains(const std::string& path) const
+{
+    return m_byPath.contains(path);
+}
+
+Localfile* LocalfileRegistry::Add(const std::string& path)
+{
+    // Duplicates are listed again on every reload, so they are found by their identity before being opened
+    if (m_byIdentity.contains(Localfile::Identity(path)))
+    {
+        return nullptr;
+    }
+
+    auto [it, inserted] = m_byPath.try_emplace(path, Entry {Localfile(path), {}});
+    const auto identity = it->second.file.Identity();
+
+    if (identity != std::pair<std::uint64_t, std::uint64_t> {0, 0})
+    {
+        m_byIdentity[identity] = path;
+    }
+
+    Open(it->second);
+    return &it->second.file;
+}
+
+void LocalfileRegistry::Remove(const std::string& path)
+{
+    const auto it = m_byPath.find(path);
+
+    if (it == m_byPath.end())
+    {
+        return;
+    }
+
+    auto& entry = it->second;
+
+    if (entry.file.IsOpen())
+    {
+        m_lru.erase(entry.lru);
+    }
+
+    const auto identity = m_byIdentity.find(entry.file.Identity());
+
+    if (identity != m_byIdentity.end() && identity->second == entry.file.Filename())
+    {
+        m_byIdentity.erase(identity);
+    }
+
+    m_byPath.erase(it);
+}
+
+bool LocalfileRegistry::Restore(Localfile& lf)
+{
+    auto& entry = m_byPath.at(lf.Filename());
+    const auto previous = lf.Identity();
+    const bool samePosition = lf.Restore();
+
+    Reindex(lf, previous);
+    Open(entry);
+    return samePosition;
+}
+
+void LocalfileRegistry::Reopen(Localfile& lf)
+{
+    const auto previous = lf.Identity();
+    lf.Reopen();
+    Reindex(lf, previous);
+}
+
+void LocalfileRegistry::Touch(Localfile& lf)
+{
+    const auto it = m_byPath.find(lf.Filename());
+
+    if (it != m_byPath.end() && lf.IsOpen())
+    {
+        m_lru.splice(m_lru.begin(), m_lru, it->second.lru);
+    }
+}
+
+std::size_t LocalfileRegistry::Size() const
+{
+    return m_byPath.size();
+}
+
+std::size_t LocalfileRegistry::OpenCount() const
+{
+    return m_lru.size();
+}
+
+void LocalfileRegistry::Open(Entry& entry)
+{
+    m_lru.push_front(&entry.file);
+    entry.lru = m_lru.begin();
+
+    while (m_maxOpenFiles > 0 && m_lru.size() > m_maxOpenFiles)
+    {
+        m_lru.back()->Close();
+        m_lru.pop_back();
+    }
+}
+
+void LocalfileRegistry::Reindex(const Localfile& lf, const std::pair<std::uint64_t, std::uint64_t>& previous)
+{
+    const auto current = lf.Identity();
+
+    if (current == previous)
+    {
+        return;
+    }
+
+    const auto it = m_byIdentity.find(previous);
+
+    if (it != m_byIdentity.end() && it->second == lf.Filename())
+    {
+        m_byIdentity.erase(it);
+    }
+
+    if (current != std::pair<std::uint64_t, std::uint64_t> {0, 0})
+    {
+        m_byIdentity[current] = lf.Filename();
+    }
 }
 
 Localfile::Localfile(std::string filename)
@@ -100,6 +361,8 @@ Localfile::Localfile(std::string filename)
     {
         throw OpenError(m_filename);
     }
+
+    ReadIdentity();
 }
 
 Localfile::Localfile(std::shared_ptr<std::istream> stream)
@@ -119,6 +382,11 @@ std::string Localfile::NextLog()
     }
     else
     {
+        if (m_stream->eof())
+        {
+            m_readSize = static_cast<std::streamoff>(m_pos) + m_stream->gcount();
+        }
+
         m_stream->seekg(m_pos);
         m_stream->clear();
         return {};
@@ -128,6 +396,63 @@ std::string Localfile::NextLog()
 void Localfile::SeekEnd()
 {
     m_stream->seekg(0, std::ios::end);
+    m_pos = m_stream->tellg();
+    m_readSize = static_cast<std::streamoff>(m_pos);
+}
+
+bool Localfile::Resume(const FileCheckpoint& checkpoint)
+{
+    std::error_code ec;
+    const auto fileSize = std::filesystem::file_size(m_filename, ec);
+    const auto [fingerprint, fingerprintSize] = Fingerprint(checkpoint.fingerprintSize);
+
+    const bool sameFile = !ec && m_device == checkpoint.device && m_inode == checkpoint.inode &&
+                          fingerprint == checkpoint.fingerprint && fingerprintSize == checkpoint.fingerprintSize &&
+                          static_cast<std::int64_t>(fileSize) >= checkpoint.offset;
+
+    m_stream->clear();
+    m_stream->seekg(sameFile ? checkpoint.offset : 0);
+    m_pos = m_stream->tellg();
+    m_readSize = -1;
+
+    return sameFile;
+}
+
+FileCheckpoint Localfile::Checkpoint()
+{
+    const auto offset = static_cast<std::int64_t>(m_pos);
+
+    // The fingerprint only needs to grow until it covers FINGERPRINT_SIZE bytes
+    if (m_fingerprintSize == 0 || (m_fingerprintSize < FINGERPRINT_SIZE && offset > m_fingerprintSize))
+    {
+        std::tie(m_fingerprint, m_fingerprintSize) = Fingerprint(FINGERPRINT_SIZE);
+    }
+
+    return {m_device, m_inode, offset, m_fingerprint, m_fingerprintSize};
+}
+
+std::pair<std::uint64_t, std::int64_t> Localfile::Fingerprint(std::int64_t size) const
+{
+    std::ifstream file(m_filename, std::ios::binary);
+
+    if (size <= 0 || !file)
+    {
+        return {0, 0};
+    }
+
+    auto buffer = std::vector<char>(static_cast<size_t>(size));
+    file.read(buffer.data(), size);
+
+    const auto count = static_cast<std::int64_t>(file.gcount());
+    auto hash = FNV_OFFSET_BASIS;
+
+    for (std::int64_t i = 0; i < count; ++i)
+    {
+        hash ^= static_cast<unsigned char>(buffer[static_cast<size_t>(i)]);
+        hash *= FNV_PRIME;
+    }
+
+    return {hash, count};
 }
 
 bool Localfile::Rotated()
@@ -152,6 +477,66 @@ void Localfile::Reopen()
     {
         throw OpenError(m_filename);
     }
+
+    m_pos = 0;
+    m_readSize = -1;
+    m_fingerprint = 0;
+    m_fingerprintSize = 0;
+    ReadIdentity();
+}
+
+void Localfile::Close()
+{
+    m_stream.reset();
+}
+
+bool Localfile::Restore()
+{
+    const auto previous = Identity();
+    m_stream = std::make_shared<std::ifstream>(m_filename);
+
+    if (m_stream->fail())
+    {
+        m_stream.reset();
+        throw OpenError(m_filename);
+    }
+
+    ReadIdentity();
+
+    std::error_code ec;
+    const auto fileSize = std::filesystem::file_size(m_filename, ec);
+    bool sameFile =
+        !ec && Identity() == previous && static_cast<std::streamoff>(fileSize) >= static_cast<std::streamoff>(m_pos);
+
+    // A copytruncate keeps the identity, and the file may have grown back past the position while it was closed
+    if (sameFile && m_fingerprintSize > 0)
+    {
+        sameFile = Fingerprint(m_fingerprintSize) == std::make_pair(m_fingerprint, m_fingerprintSize);
+    }
+
+    if (!sameFile)
+    {
+        m_pos = 0;
+        m_readSize = -1;
+        m_fingerprint = 0;
+        m_fingerprintSize = 0;
+    }
+
+    m_stream->seekg(m_pos);
+    return sameFile;
+}
+
+void Localfile::ReadIdentity()
+{
+    std::tie(m_device, m_inode) = Identity(m_filename);
+}
+
+bool Localfile::HasNewData() const
+{
+    std::error_code ec;
+    const auto fileSize = std::filesystem::file_size(m_filename, ec);
+
+    return ec || static_cast<std::streamoff>(fileSize) != m_readSize;
 }
 
 OpenError::OpenError(const std::string& filename)
@@ -3,6 +3,7 @@
 #include <glob.h>
 #include <logcollector.hpp>
 #include <logger.hpp>
+#include <sys/stat.h>
 
 #include <span>
 
@@ -10,6 +11,12 @@ using namespace logcollector;
 
 void FileReader::Reload(const std::function<void(Localfile&)>& callback)
 {
+    if (!PatternDirectoryChanged())
+    {
+        LogTrace("Directory unchanged, skipping pattern: {}", m_filePattern);
+        return;
+    }
+
     glob_t globResult;
 
     const int ret = glob(m_filePattern.c_str(), 0, nullptr, &globResult);
@@ -40,3 +47,15 @@ void FileReader::Reload(const std::function<void(Localfile&)>& callback)
     AddLocalfiles(localfiles, callback);
     globfree(&globResult);
 }
+
+std::pair<std::uint64_t, std::uint64_t> Localfile::Identity(const std::string& filename)
+{
+    struct stat fileStat {};
+
+    if (filename.empty() || stat(filename.c_str(), &fileStat) != 0)
+    {
+        return {0, 0};
+    }
+
+    return {static_cast<std::uint64_t>(fileStat.st_dev), static_cast<std::uint64_t>(fileStat.st_ino)};
+}
@@ -11,6 +11,12 @@ using namespace logcollector;
 
 void FileReader::Reload(const std::function<void(Localfile&)>& callback)
 {
+    if (!PatternDirectoryChanged())
+    {
+        LogTrace("Directory unchanged, skipping pattern: {}", m_filePattern);
+        return;
+    }
+
     WIN32_FIND_DATA findFileData;
     HANDLE hFind = FindFirstFile(m_filePattern.c_str(), &findFileData);
     std::list<std::string> files;
@@ -39,3 +45,36 @@ void FileReader::Reload(const std::function<void(Localfile&)>& callback)
     AddLocalfiles(files, callback);
     FindClose(hFind);
 }
+
+std::pair<std::uint64_t, std::uint64_t> Localfile::Identity(const std::string& filename)
+{
+    if (filename.empty())
+    {
+        return {0, 0};
+    }
+
+    HANDLE hFile = CreateFile(filename.c_str(),
+                              0,
+                              FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                              nullptr,
+                              OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL,
+                              nullptr);
+
+    if (hFile == INVALID_HANDLE_VALUE)
+    {
+        return {0, 0};
+    }
+
+    BY_HANDLE_FILE_INFORMATION fileInfo;
+    std::pair<std::uint64_t, std::uint64_t> identity {0, 0};
+
+    if (GetFileInformationByHandle(hFile, &fileInfo))
+    {
+        identity = {fileInfo.dwVolumeSerialNumber,
+                    (static_cast<std::uint64_t>(fileInfo.nFileIndexHigh) << 32) | fileInfo.nFileIndexLow};
+    }
+
+    CloseHandle(hFile);
+    return identity;
+}
@@ -58,6 +58,130 @@ using FilterGroup = std::vector<JournalFilter>;
 /// @brief Set of filter groups combined with OR logic
 using FilterSet = std::vector<FilterGroup>;
 
+/// @brief Snapshot of the fields of a journal entry
+///
+/// Small flat map holding only the fields of interest, filled from a single
+/// pass over the entry data. Values are kept between entries, so that their
+/// buffers are reused and filling the snapshot does not allocate once warm.
+class EntryFields
+{
+public:
+    /// @brief Constructor
+    /// @param names Names of the fields to keep, each one becomes a slot
+    explicit EntryFields(std::vector<std::string> names)
+        : m_names(std::move(names))
+        , m_values(m_names.size())
+        , m_present(m_names.size(), false)
+    {
+    }
+
+    /// @brief Marks all fields as missing
+    void Clear()
+    {
+        std::fill(m_present.begin(), m_present.end(), false);
+    }
+
+    /// @brief Stores a "FIELD=value" journal data item if the field is of interest
+    ///
+    /// If a field appears more than once, the first value is kept.
+    ///
+    /// @param data Journal data item
+    void Set(std::string_view data)
+    {
+        const auto separator = data.find('=');
+        if (separator == std::string_view::npos)
+        {
+            return;
+        }
+
+        const auto name = data.substr(0, separator);
+        for (size_t slot = 0; slot < m_names.size(); ++slot)
+        {
+            if (!m_present[slot] && m_names[slot] == name)
+            {
+                m_values[slot].assign(data.substr(separator + 1));
+                m_present[slot] = true;
+                return;
+            }
+        }
+    }
+
+    /// @brief Gets the value of a field
+    /// @param slot Field slot
+    /// @return Field value, or std::nullopt if the field is missing in the entry
+    std::optional<std::string_view> Get(size_t slot) const
+    {
+        if (!m_present[slot])
+        {
+            return std::nullopt;
+        }
+        return m_values[slot];
+    }
+
+    /// @brief Gets the name of a field
+    /// @param slot Field slot
+    /// @return Field name
+    const std::string& Name(size_t slot) const
+    {
+        return m_names[slot];
+    }
+
+private:
+    std::vector<std::string> m_names;  ///< Field names, by slot
+    std::vector<std::string> m_values; ///< Field values, by slot
+    std::vector<bool> m_present;       ///< Whether each field is present in the entry
+};
+
+/// @brief Filter set compiled for matching journal entries
+///
+/// Field names are resolved into snapshot slots and filter values are split
+/// once, so that matching an entry neither allocates nor throws.
+class CompiledFilterSet
+{
+public:
+    /// @brief Slot of the MESSAGE field
+    static constexpr size_t MESSAGE_SLOT = 0;
+
+    /// @brief Slot of the _SYSTEMD_UNIT field
+    static constexpr size_t UNIT_SLOT = 1;
+
+    /// @brief Compiles a filter set
+    /// @param filters Set of filter groups
+    explicit CompiledFilterSet(const FilterSet& filters);
+
+    /// @brief Creates an empty snapshot holding the fields required by the filters
+    /// @return Entry snapshot
+    EntryFields CreateEntryFields() const
+    {
+        return EntryFields(m_fields);
+    }
+
+    /// @brief Checks if an entry matches any filter group
+    /// @param entry Entry snapshot
+    /// @param ignoreIfMissing Whether to ignore missing fields
+    /// @return true if any group matches, false otherwise
+    bool Matches(const EntryFields& entry, bool ignoreIfMissing) const;
+
+    /// @brief Checks if the set has no groups
+    /// @return true if empty, false otherwise
+    bool Empty() const
+    {
+        return m_groups.empty();
+    }
+
+private:
+    /// @brief Compiled filter
+    struct Filter
+    {
+        size_t slot;                     ///< Slot of the field in the entry snapshot
+        std::vector<std::string> values; ///< Values to match, any of them
+        bool exactMatch;                 ///< Whether to perform exact matching or substring matching
+    };
+
+    std::vector<std::string> m_fields;         ///< Field names, by slot
+    std::vector<std::vector<Filter>> m_groups; ///< Filter groups
+};
+
 /// @brief Exception class for journal-related errors
 class JournalLogException : public std::runtime_error
 {
@@ -112,6 +236,17 @@ public:
     /// @throw JournalLogException if field not found
     virtual std::string GetData(const std::string& field) const;
 
+    /// @brief Retrieves field data from current journal entry, if present
+    /// @param field Field name to retrieve
+    /// @return Field value, or std::nullopt if the field is not present
+    /// @throw JournalLogException on journal errors
+    virtual std::optional<std::string> FindData(const std::string& field) const;
+
+    /// @brief Fills a snapshot with the fields of current journal entry in a single pass
+    /// @param entry Snapshot to fill
+    /// @return true if the entry data could be read, false otherwise
+    virtual bool ReadEntryFields(EntryFields& entry) const;
+
     /// @brief Gets timestamp of current journal entry
     /// @return Timestamp in microseconds since epoch
     virtual uint64_t GetTimestamp() const;
@@ -127,6 +262,13 @@ public:
     /// @return Optional containing filtered message if found
     virtual std::optional<FilteredMessage> GetNextFilteredMessage(const FilterSet& filters, bool ignoreIfMissing);
 
+    /// @brief Gets next message that matches precompiled filters
+    /// @param filters Compiled filter set to apply
+    /// @param ignoreIfMissing Whether to ignore missing fields
+    /// @return Optional containing filtered message if found
+    virtual std::optional<FilteredMessage> GetNextFilteredMessage(const CompiledFilterSet& filters,
+                                                                  bool ignoreIfMissing);
+
     /// @brief Clears all active filters
     void FlushFilters();
 
@@ -138,6 +280,21 @@ public:
         return !filter.field.empty() && !filter.value.empty();
     }
 
+    /// @brief Gets a file descriptor that becomes readable when the journal changes
+    /// @return File descriptor, or -1 if the journal cannot be waited on
+    virtual int GetFd();
+
+    /// @brief Processes the journal changes after a wakeup
+    ///
+    /// Must be called after the file descriptor becomes readable or the timeout expires.
+    ///
+    /// @return true if entries were appended or journal files were added or removed, false otherwise
+    virtual bool Process();
+
+    /// @brief Gets the maximum time to wait for the file descriptor before calling Process
+    /// @return Time to wait, or std::nullopt if it can wait indefinitely
+    virtual std::optional<std::chrono::milliseconds> GetTimeout() const;
+
     virtual std::string GetCursor() const;
     virtual bool SeekCursor(const std::string& cursor);
 
@@ -162,22 +319,10 @@ private:
     /// @param operation Operation description for error message
     void ThrowIfError(int result, const std::string& operation) const;
 
-    /// @brief Applies filter set with OR logic between groups
-    /// @param filters Set of filter groups to apply
-    /// @param ignoreIfMissing Whether to ignore missing fields
-    /// @return true if any group matches, false otherwise
-    bool ApplyFilterSet(const FilterSet& filters, bool ignoreIfMissing);
-
-    /// @brief Applies filter group with AND logic between filters
-    /// @param group Group of filters to add
-    /// @param ignoreIfMissing Whether to ignore missing fields
-    /// @return true if all filters match, false otherwise
-    bool ApplyFilterGroup(const FilterGroup& group, bool ignoreIfMissing) const;
-
     /// @brief Processes current journal entry
-    /// @param filters Set of filter groups to apply
+    /// @param entry Snapshot of the entry fields
     /// @param ignoreIfMissing Whether to ignore missing fields
     /// @param message Filtered message structure to fill
-    /// @return true if entry matches any filter, false otherwise
-    bool ProcessJournalEntry(const FilterSet& filters, bool ignoreIfMissing, FilteredMessage& message) const;
+    /// @return true if the entry has a message, false otherwise
+    static bool ProcessJournalEntry(const EntryFields& entry, bool ignoreIfMissing, FilteredMessage& message);
 };
@@ -1,9 +1,12 @@
 #pragma once
 
 #include <journal_log.hpp>
+#include <line_filter.hpp>
 #include <logcollector.hpp>
 #include <reader.hpp>
 
+#include <boost/asio/posix/stream_descriptor.hpp>
+
 #include <memory>
 #include <regex>
 
@@ -22,7 +25,12 @@ namespace logcollector
         /// @param filters Group of filters to apply (AND logic between them)
         /// @param ignoreIfMissing Whether to ignore missing fields
         /// @param fileWait Time to wait between reads in milliseconds
-        JournaldReader(Logcollector& logcollector, FilterGroup filters, bool ignoreIfMissing, std::time_t fileWait);
+        /// @param lineFilter Optional include/exclude rules applied to every message
+        JournaldReader(Logcollector& logcollector,
+                       FilterGroup filters,
+                       bool ignoreIfMissing,
+                       std::time_t fileWait,
+                       std::shared_ptr<LineFilter> lineFilter = nullptr);
 
         /// @brief Runs the journal reader
         /// @return Awaitable for asynchronous operation
@@ -36,11 +44,19 @@ namespace logcollector
         std::string GetFilterDescription() const;
 
     private:
+        /// @brief Waits until the journal changes, the journal timeout expires or the reader is stopped
+        /// @param descriptor Descriptor of the journal change notifications
+        /// @return Awaitable for asynchronous operation
+        Awaitable WaitForChanges(boost::asio::posix::stream_descriptor& descriptor);
+
         FilterGroup m_filters;                           ///< Active filters
+        CompiledFilterSet m_compiledFilters;             ///< Active filters, compiled for matching
         bool m_ignoreIfMissing;                          ///< Whether to ignore missing fields
         std::unique_ptr<JournalLog> m_journal;           ///< Journal interface
         std::chrono::milliseconds m_waitTime;            ///< Wait time between reads
+        std::shared_ptr<LineFilter> m_lineFilter;        ///< Include/exclude rules
         static constexpr size_t MAX_LINE_LENGTH = 16384; ///< Maximum message length
+        static constexpr auto MAX_IDLE_WAIT = std::chrono::seconds(5); ///< Maximum wait without journal changes
     };
 
 } // namespace logcollector
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <limits>
 #include <logger.hpp>
 #include <ranges>
 #include <systemd/sd-journal.h>
@@ -71,13 +72,23 @@ bool JournalLog::SeekTimestamp(uint64_t timestamp)
 }
 
 std::string JournalLog::GetData(const std::string& field) const
+{
+    auto value = FindData(field);
+    if (!value)
+    {
+        throw JournalLogException("Field not present in current journal entry");
+    }
+    return std::move(*value);
+}
+
+std::optional<std::string> JournalLog::FindData(const std::string& field) const
 {
     const void* data = nullptr;
     size_t length = 0;
     const int ret = sd_journal_get_data(m_journal, field.c_str(), &data, &length);
     if (ret == -ENOENT)
     {
-        throw JournalLogException("Field not present in current journal entry");
+        return std::nullopt;
     }
     ThrowIfError(ret, "get data");
 
@@ -88,6 +99,28 @@ std::string JournalLog::GetData(const std::string& field) const
     return std::string(full_str.substr(prefix_len));
 }
 
+bool JournalLog::ReadEntryFields(EntryFields& entry) const
+{
+    entry.Clear();
+    sd_journal_restart_data(m_journal);
+
+    const void* data = nullptr;
+    size_t length = 0;
+    int ret = 0;
+
+    while ((ret = sd_journal_enumerate_data(m_journal, &data, &length)) > 0)
+    {
+        entry.Set(std::string_view(static_cast<const char*>(data), length));
+    }
+
+    if (ret < 0)
+    {
+        LogTrace("Failed to read journal entry data: {}", strerror(-ret));
+        return false;
+    }
+    return true;
+}
+
 uint64_t JournalLog::GetTimestamp() const
 {
     uint64_t timestamp = 0;
@@ -193,6 +226,45 @@ uint64_t JournalLog::GetEpochTime()
             .count());
 }
 
+int JournalLog::GetFd()
+{
+    const int fd = sd_journal_get_fd(m_journal);
+    if (fd < 0)
+    {
+        LogWarn("Cannot wait for journal changes: {}", strerror(-fd));
+        return -1;
+    }
+    return fd;
+}
+
+bool JournalLog::Process()
+{
+    const int ret = sd_journal_process(m_journal);
+    ThrowIfError(ret, "process journal changes");
+    return ret != SD_JOURNAL_NOP;
+}
+
+std::optional<std::chrono::milliseconds> JournalLog::GetTimeout() const
+{
+    uint64_t timeout = 0;
+    const int ret = sd_journal_get_timeout(m_journal, &timeout);
+    ThrowIfError(ret, "get timeout");
+
+    if (timeout == std::numeric_limits<uint64_t>::max())
+    {
+        return std::nullopt;
+    }
+
+    // The timeout is an absolute CLOCK_MONOTONIC time, which std::chrono::steady_clock is based on
+    const auto now = std::chrono::duration_cast<std::chrono::microseconds>(
+                         std::chrono::steady_clock::now().time_since_epoch())
+                         .count();
+    const auto remaining = static_cast<int64_t>(timeout) - static_cast<int64_t>(now);
+
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::microseconds(std::max<int64_t>(remaining, 0)));
+}
+
 std::string JournalLog::GetCursor() const
 {
     char* rawCursor = nullptr;
@@ -279,63 +351,89 @@ void JournalLog::FlushFilters()
     }
 }
 
-bool JournalLog::ApplyFilterGroup(const FilterGroup& group, bool ignoreIfMissing) const
+CompiledFilterSet::CompiledFilterSet(const FilterSet& filters)
+    : m_fields {"MESSAGE", "_SYSTEMD_UNIT"}
 {
-    return std::all_of(group.begin(),
-                       group.end(),
-                       [this, ignoreIfMissing](const auto& filter)
-                       {
-                           try
-                           {
-                               const std::string fieldValue = GetData(filter.field);
-                               return filter.Matches(fieldValue);
-                           }
-                           catch (const JournalLogException&)
-                           {
-                               if (!ignoreIfMissing)
-                               {
-                                   LogTrace("Field {} not present in entry, skipping...", filter.field);
-                               }
-                               return false;
-                           }
-                       });
+    m_groups.reserve(filters.size());
+
+    for (const auto& group : filters)
+    {
+        auto& compiled = m_groups.emplace_back();
+        compiled.reserve(group.size());
+
+        for (const auto& filter : group)
+        {
+            const auto field = std::find(m_fields.begin(), m_fields.end(), filter.field);
+            const auto slot = static_cast<size_t>(std::distance(m_fields.begin(), field));
+
+            if (field == m_fields.end())
+            {
+                m_fields.push_back(filter.field);
+            }
+
+            const auto views = filter.GetValueViews();
+            compiled.push_back({slot, std::vector<std::string>(views.begin(), views.end()), filter.exact_match});
+        }
+    }
 }
 
-bool JournalLog::ApplyFilterSet(const FilterSet& filters, bool ignoreIfMissing)
+bool CompiledFilterSet::Matches(const EntryFields& entry, bool ignoreIfMissing) const
 {
-    return std::any_of(filters.begin(),
-                       filters.end(),
-                       [this, ignoreIfMissing](const auto& group) { return ApplyFilterGroup(group, ignoreIfMissing); });
+    return std::ranges::any_of(
+        m_groups,
+        [&entry, ignoreIfMissing](const auto& group)
+        {
+            return std::ranges::all_of(
+                group,
+                [&entry, ignoreIfMissing](const Filter& filter)
+                {
+                    const auto fieldValue = entry.Get(filter.slot);
+                    if (!fieldValue)
+                    {
+                        if (!ignoreIfMissing)
+                        {
+                            LogTrace("Field {} not present in entry, skipping...", entry.Name(filter.slot));
+                        }
+                        return false;
+                    }
+
+                    return std::ranges::any_of(filter.values,
+                                               [&fieldValue, &filter](const std::string& value)
+                                               {
+                                                   return filter.exactMatch
+                                                              ? *fieldValue == value
+                                                              : fieldValue->find(value) != std::string_view::npos;
+                                               });
+                });
+        });
 }
 
-bool JournalLog::ProcessJournalEntry(const FilterSet&, bool ignoreIfMissing, FilteredMessage& message) const
+bool JournalLog::ProcessJournalEntry(const EntryFields& entry, bool ignoreIfMissing, FilteredMessage& message)
 {
-    try
-    {
-        message.message = GetData("MESSAGE");
-        try
-        {
-            message.fieldValue = GetData("_SYSTEMD_UNIT");
-        }
-        catch (const JournalLogException&)
-        {
-            message.fieldValue = "unknown";
-        }
-        return true;
-    }
-    catch (const JournalLogException& e)
+    const auto text = entry.Get(CompiledFilterSet::MESSAGE_SLOT);
+    if (!text)
     {
         if (!ignoreIfMissing)
         {
-            LogError("Failed to process journal entry: {}", e.what());
+            LogError("Failed to process journal entry: {} field not present", entry.Name(CompiledFilterSet::MESSAGE_SLOT));
         }
         return false;
     }
+
+    message.message = *text;
+    message.fieldValue = entry.Get(CompiledFilterSet::UNIT_SLOT).value_or("unknown");
+    return true;
 }
 
 std::optional<JournalLog::FilteredMessage> JournalLog::GetNextFilteredMessage(const FilterSet& filters,
                                                                               bool ignoreIfMissing)
 {
+    return GetNextFilteredMessage(CompiledFilterSet(filters), ignoreIfMissing);
+}
+
+std::optional<JournalLog::FilteredMessage> JournalLog::GetNextFilteredMessage(const CompiledFilterSet& filters,
+                                                                              bool ignoreIfMissing)
+{
 
     if (!m_hasActiveFilters)
     {
@@ -343,10 +441,13 @@ std::optional<JournalLog::FilteredMessage> JournalLog::GetNextFilteredMessage(co
         return std::nullopt;
     }
 
+    auto entry = filters.CreateEntryFields();
+
     while (Next())
     {
         FilteredMessage message;
-        if (ApplyFilterSet(filters, ignoreIfMissing) && ProcessJournalEntry(filters, ignoreIfMissing, message))
+        if (ReadEntryFields(entry) && filters.Matches(entry, ignoreIfMissing) &&
+            ProcessJournalEntry(entry, ignoreIfMissing, message))
         {
             return message;
         }
@@ -1,7 +1,14 @@
 #include "journald_reader.hpp"
 
+#include <boost/asio/experimental/awaitable_operators.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
 #include <logger.hpp>
+
+#include <optional>
 #include <sstream>
+#include <unistd.h>
 
 namespace
 {
@@ -13,12 +20,15 @@ namespace logcollector
     JournaldReader::JournaldReader(Logcollector& logcollector,
                                    FilterGroup filters,
                                    bool ignoreIfMissing,
-                                   std::time_t fileWait)
+                                   std::time_t fileWait,
+                                   std::shared_ptr<LineFilter> lineFilter)
         : IReader(logcollector)
         , m_filters(std::move(filters))
+        , m_compiledFilters(FilterSet {m_filters})
         , m_ignoreIfMissing(ignoreIfMissing)
         , m_journal(std::make_unique<JournalLog>())
         , m_waitTime(std::chrono::milliseconds(fileWait))
+        , m_lineFilter(std::move(lineFilter))
     {
 
         LogInfo("Creating JournaldReader with {} filters", m_filters.size());
@@ -53,6 +63,20 @@ namespace logcollector
                 co_return;
             }
 
+            // The descriptor owns a duplicate, so that closing it does not affect the journal
+            std::optional<boost::asio::posix::stream_descriptor> descriptor;
+            const int fd = m_journal->GetFd();
+            const int descriptorFd = fd >= 0 ? ::dup(fd) : -1;
+
+            if (descriptorFd >= 0)
+            {
+                descriptor.emplace(co_await boost::asio::this_coro::executor, descriptorFd);
+            }
+            else
+            {
+                LogWarn("Journal change notifications not available, polling every {} ms", m_waitTime.count());
+            }
+
             LogInfo("Journald reader started successfully");
 
             while (m_keepRunning.load())
@@ -61,13 +85,18 @@ namespace logcollector
                 try
                 {
                     LogTrace("Checking for new journal entries...");
-                    FilterSet filterSet {m_filters};
-                    while (auto filteredMessage = m_journal->GetNextFilteredMessage(filterSet, m_ignoreIfMissing))
+                    while (auto filteredMessage =
+                               m_journal->GetNextFilteredMessage(m_compiledFilters, m_ignoreIfMissing))
                     {
                         shouldWait = false;
                         auto& message = filteredMessage->message;
                         LogDebug("Found matching message for {}", GetFilterDescription());
 
+                        if (m_lineFilter && !m_lineFilter->Accept(message))
+                        {
+                            continue;
+                        }
+
                         if (message.length() > MAX_LINE_LENGTH)
                         {
                             LogDebug("Truncating message of length {}", message.length());
@@ -83,7 +112,14 @@ namespace logcollector
 
                 if (shouldWait)
                 {
-                    co_await m_logcollector.Wait(m_waitTime);
+                    if (descriptor)
+                    {
+                        co_await WaitForChanges(*descriptor);
+                    }
+                    else
+                    {
+                        co_await m_logcollector.Wait(m_waitTime);
+                    }
                 }
             }
         }
@@ -93,6 +129,37 @@ namespace logcollector
         }
     }
 
+    Awaitable JournaldReader::WaitForChanges(boost::asio::posix::stream_descriptor& descriptor)
+    {
+        using namespace boost::asio::experimental::awaitable_operators;
+
+        auto timeout = std::chrono::duration_cast<std::chrono::milliseconds>(MAX_IDLE_WAIT);
+
+        try
+        {
+            timeout = std::min(timeout, m_journal->GetTimeout().value_or(timeout));
+        }
+        catch (const JournalLogException& e)
+        {
+            LogWarn("Failed to get journal timeout: {}", e.what());
+        }
+
+        // The logcollector timer is canceled on stop, which also cancels the descriptor wait
+        boost::system::error_code ec;
+        co_await (descriptor.async_wait(boost::asio::posix::descriptor_base::wait_read,
+                                        boost::asio::redirect_error(boost::asio::use_awaitable, ec)) ||
+                  m_logcollector.Wait(timeout));
+
+        try
+        {
+            m_journal->Process();
+        }
+        catch (const JournalLogException& e)
+        {
+            LogError("Failed to process journal changes: {}", e.what());
+        }
+    }
+
     void JournaldReader::Stop()
     {
         m_journal->FlushFilters();
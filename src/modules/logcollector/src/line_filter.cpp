@@ -0,0 +1,166 @@
+#include "line_filter.hpp"
+
+#include <logger.hpp>
+
+#include <cctype>
+
+using namespace logcollector;
+
+namespace
+{
+    /// @brief Characters with a special meaning in ECMAScript regular expressions
+    constexpr std::string_view REGEX_SPECIAL_CHARS = "\\^$.|?*+()[]{}";
+
+    /// @brief Extracts the longest literal that any string matching the pattern must contain
+    ///
+    /// The analysis is conservative: patterns with alternations or groups yield
+    /// no literal, so the regular expression is always evaluated. Bracket expressions
+    /// (with their leading ']', escapes and [:class:] forms) are not parsed, the
+    /// analysis stops at the first one.
+    ///
+    /// @param pattern Regular expression
+    /// @return Mandatory literal, or an empty string if none could be determined
+    std::string MandatoryLiteral(const std::string& pattern)
+    {
+        if (pattern.find_first_of("|()") != std::string::npos)
+        {
+            return {};
+        }
+
+        std::string best;
+        std::string current;
+
+        const auto flush = [&best, &current]()
+        {
+            if (current.size() > best.size())
+            {
+                best = current;
+            }
+            current.clear();
+        };
+
+        for (size_t i = 0; i < pattern.size(); ++i)
+        {
+            const char c = pattern[i];
+
+            if (c == '\\' && i + 1 < pattern.size())
+            {
+                const char escaped = pattern[++i];
+
+                if (std::isalnum(static_cast<unsigned char>(escaped)))
+                {
+                    // Character classes (\d, \w...), anchors (\b) and back-references
+                    flush();
+                }
+                else
+                {
+                    current += escaped;
+                }
+            }
+            else if (c == '?' || c == '*' || c == '{')
+            {
+                // The preceding character is optional
+                if (!current.empty())
+                {
+                    current.pop_back();
+                }
+                flush();
+
+                if (c == '{')
+                {
+                    i = std::min(pattern.find('}', i), pattern.size());
+                }
+            }
+            else if (c == '[')
+            {
+                // The literal before the bracket expression is still mandatory
+                break;
+            }
+            else if (REGEX_SPECIAL_CHARS.find(c) != std::string_view::npos)
+            {
+                flush();
+            }
+            else
+            {
+                current += c;
+            }
+        }
+
+        flush();
+        return best;
+    }
+} // namespace
+
+LineFilter::LineFilter(std::string source,
+                       const std::vector<std::string>& include,
+                       const std::vector<std::string>& exclude)
+    : m_source(std::move(source))
+{
+    m_include = Compile(include);
+    m_exclude = Compile(exclude);
+}
+
+bool LineFilter::Accept(std::string_view line)
+{
+    const bool accepted = (m_include.empty() || MatchesAny(m_include, line)) && !MatchesAny(m_exclude, line);
+
+    if (accepted)
+    {
+        m_matched.fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+    {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return accepted;
+}
+
+std::vector<LineFilter::Rule> LineFilter::Compile(const std::vector<std::string>& patterns) const
+{
+    std::vector<Rule> rules;
+    rules.reserve(patterns.size());
+
+    for (const auto& pattern : patterns)
+    {
+        if (pattern.empty())
+        {
+            continue;
+        }
+
+        if (pattern.find_first_of(REGEX_SPECIAL_CHARS) == std::string::npos)
+        {
+            rules.push_back({pattern, std::nullopt});
+            continue;
+        }
+
+        try
+        {
+            rules.push_back({MandatoryLiteral(pattern), std::regex(pattern, std::regex::optimize)});
+        }
+        catch (const std::regex_error& e)
+        {
+            LogError("Invalid filter '{}' for {} ignored: {}", pattern, m_source, e.what());
+        }
+    }
+
+    return rules;
+}
+
+bool LineFilter::MatchesAny(const std::vector<Rule>& rules, std::string_view line)
+{
+    for (const auto& rule : rules)
+    {
+        if (!rule.literal.empty() && line.find(rule.literal) == std::string_view::npos)
+        {
+            continue;
+        }
+
+        if (!rule.regex || std::regex_search(line.begin(), line.end(), *rule.regex))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
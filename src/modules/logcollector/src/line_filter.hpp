@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace logcollector
+{
+
+    /// @brief Line filter class
+    ///
+    /// Holds the include and exclude rules of a log source, compiled once when
+    /// the source is set up. A line is accepted if it matches any include rule
+    /// (or there are none) and no exclude rule.
+    ///
+    /// Rules are regular expressions. Rules without special characters are
+    /// matched as plain substrings, and the rest are only evaluated on lines that
+    /// contain their longest mandatory literal.
+    class LineFilter
+    {
+    public:
+        /// @brief Constructor
+        /// @param source Name of the log source, for reporting
+        /// @param include Include rules
+        /// @param exclude Exclude rules
+        LineFilter(std::string source, const std::vector<std::string>& include, const std::vector<std::string>& exclude);
+
+        /// @brief Checks whether a line has to be collected, and updates the counters
+        /// @param line Line to check
+        /// @return True if the line is accepted, false if it must be dropped
+        bool Accept(std::string_view line);
+
+        /// @brief Gets the name of the log source
+        /// @return Source name
+        inline const std::string& Source() const
+        {
+            return m_source;
+        }
+
+        /// @brief Gets the number of accepted lines
+        /// @return Number of lines
+        inline std::uint64_t Matched() const
+        {
+            return m_matched.load(std::memory_order_relaxed);
+        }
+
+        /// @brief Gets the number of dropped lines
+        /// @return Number of lines
+        inline std::uint64_t Dropped() const
+        {
+            return m_dropped.load(std::memory_order_relaxed);
+        }
+
+        /// @brief Checks if the filter has no rules
+        /// @return True if there are no rules, false otherwise
+        inline bool Empty() const
+        {
+            return m_include.empty() && m_exclude.empty();
+        }
+
+    private:
+        /// @brief Compiled rule
+        struct Rule
+        {
+            /// @brief Substring that any matching line must contain
+            std::string literal;
+
+            /// @brief Regular expression, unset if the rule is a plain substring
+            std::optional<std::regex> regex;
+        };
+
+        /// @brief Compiles a list of rules, skipping invalid ones
+        /// @param patterns Rule patterns
+        /// @return Compiled rules
+        std::vector<Rule> Compile(const std::vector<std::string>& patterns) const;
+
+        /// @brief Checks if a line matches any rule
+        /// @param rules Compiled rules
+        /// @param line Line to check
+        /// @return True if any rule matches, false otherwise
+        static bool MatchesAny(const std::vector<Rule>& rules, std::string_view line);
+
+        /// @brief Name of the log source
+        std::string m_source;
+
+        /// @brief Include rules
+        std::vector<Rule> m_include;
+
+        /// @brief Exclude rules
+        std::vector<Rule> m_exclude;
+
+        /// @brief Number of accepted lines
+        std::atomic<std::uint64_t> m_matched = 0;
+
+        /// @brief Number of dropped lines
+        std::atomic<std::uint64_t> m_dropped = 0;
+    };
+
+} // namespace logcollector
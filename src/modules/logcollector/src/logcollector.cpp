@@ -12,7 +12,9 @@
 #include <map>
 #include <sstream>
 
+#include "file_checkpoint_store.hpp"
 #include "file_reader.hpp"
+#include "line_filter.hpp"
 
 using namespace logcollector;
 
@@ -21,6 +23,25 @@ namespace logcollector
     constexpr int ACTIVE_READERS_WAIT_MS = 10;
 }
 
+namespace
+{
+    /// @brief Reads a list of rules that may be given as a single string or as a sequence
+    std::vector<std::string> ReadRules(const YAML::Node& node)
+    {
+        if (!node)
+        {
+            return {};
+        }
+
+        if (node.IsScalar())
+        {
+            return {node.as<std::string>()};
+        }
+
+        return node.as<std::vector<std::string>>();
+    }
+} // namespace
+
 void Logcollector::Start()
 {
     if (!m_enabled)
@@ -72,6 +93,18 @@ void Logcollector::Setup(std::shared_ptr<const configuration::ConfigurationParse
         m_ioContext.restart();
     }
 
+    const auto dbFolderPath = configurationParser->GetConfigOrDefault(config::DEFAULT_DATA_PATH, "agent", "path.data");
+
+    try
+    {
+        m_checkpoints = std::make_shared<FileCheckpointStore>(dbFolderPath);
+    }
+    catch (const std::exception& e)
+    {
+        LogWarn("File checkpoints not available, files will be read from the end: {}", e.what());
+        m_checkpoints.reset();
+    }
+
     SetupFileReader(configurationParser);
     AddPlatformSpecificReader(configurationParser);
 }
@@ -84,19 +117,78 @@ void Logcollector::SetupFileReader(const std::shared_ptr<const configuration::Co
     const auto reloadInterval = configurationParser->GetTimeConfigOrDefault(
         config::logcollector::DEFAULT_RELOAD_INTERVAL, "logcollector", "reload_interval");
 
-    const auto localFilesDefault = std::vector<std::string> {config::logcollector::DEFAULT_LOCALFILES};
+    const auto maxOpenFiles = configurationParser->GetConfigOrDefault(
+        config::logcollector::DEFAULT_MAX_OPEN_FILES, "logcollector", "max_open_files");
+
+    const auto localFilesDefault = YAML::Node(std::vector<std::string> {config::logcollector::DEFAULT_LOCALFILES});
 
     const auto localfiles = configurationParser->GetConfigOrDefault(localFilesDefault, "logcollector", "localfiles");
 
     for (const auto& lf : localfiles)
     {
-        AddReader(std::make_shared<FileReader>(*this, lf, fileWait, reloadInterval));
+        // Each entry is either a plain pattern or a map with "location" and optional "include"/"exclude" rules
+        const auto location = lf.IsMap() ? lf["location"].as<std::string>("") : lf.as<std::string>("");
+
+        if (location.empty())
+        {
+            LogWarn("Ignoring localfile entry without location.");
+            continue;
+        }
+
+        AddReader(std::make_shared<FileReader>(*this,
+                                               location,
+                                               fileWait,
+                                               reloadInterval,
+                                               maxOpenFiles,
+                                               m_checkpoints,
+                                               lf.IsMap() ? CreateLineFilter(location, lf) : nullptr));
+    }
+
+    if (m_checkpoints)
+    {
+        const auto checkpointInterval = configurationParser->GetTimeConfigOrDefault(
+            config::logcollector::DEFAULT_CHECKPOINT_INTERVAL, "logcollector", "checkpoint_interval");
+
+        AddReader(std::make_shared<CheckpointWriter>(*this, m_checkpoints, checkpointInterval));
+    }
+}
+
+std::shared_ptr<LineFilter> Logcollector::CreateLineFilter(const std::string& source, const YAML::Node& config)
+{
+    auto lineFilter = std::make_shared<LineFilter>(source, ReadRules(config["include"]), ReadRules(config["exclude"]));
+
+    if (lineFilter->Empty())
+    {
+        return nullptr;
     }
+
+    const std::lock_guard<std::mutex> lock(m_lineFiltersMutex);
+    m_lineFilters.push_back(lineFilter);
+    return lineFilter;
+}
+
+nlohmann::json Logcollector::GetFilterStats() const
+{
+    auto stats = nlohmann::json::object();
+    const std::lock_guard<std::mutex> lock(m_lineFiltersMutex);
+
+    for (const auto& lineFilter : m_lineFilters)
+    {
+        stats[lineFilter->Source()] = {{"matched", lineFilter->Matched()}, {"dropped", lineFilter->Dropped()}};
+    }
+
+    return stats;
 }
 
 void Logcollector::Stop()
 {
     CleanAllReaders();
+
+    if (m_checkpoints)
+    {
+        m_checkpoints->Flush();
+    }
+
     m_ioContext.stop();
     LogInfo("Logcollector module stopped.");
 }
@@ -115,6 +207,10 @@ Co_CommandExecutionResult Logcollector::ExecuteCommand(const std::string command
         LogInfo("Logcollector module is stopped.");
         co_return module_command::CommandExecutionResult {module_command::Status::FAILURE, "Module is stopped"};
     }
+    else if (command == FILTER_STATS_COMMAND)
+    {
+        co_return module_command::CommandExecutionResult {module_command::Status::SUCCESS, GetFilterStats().dump()};
+    }
     LogInfo("Logcollector command: ", command);
     co_return module_command::CommandExecutionResult {module_command::Status::SUCCESS, "Command not implemented yet"};
 }
@@ -181,7 +277,16 @@ void Logcollector::CleanAllReaders()
     {
         std::this_thread::sleep_for(std::chrono::milliseconds(ACTIVE_READERS_WAIT_MS));
     }
+
+    if (const auto stats = GetFilterStats(); !stats.empty())
+    {
+        LogDebug("Filter stats: {}", stats.dump());
+    }
+
     m_readers.clear();
+
+    const std::lock_guard<std::mutex> lock(m_lineFiltersMutex);
+    m_lineFilters.clear();
 }
 
 Awaitable Logcollector::Wait(std::chrono::milliseconds ms)
@@ -4,6 +4,22 @@
 
 #include <memory>
 
+namespace
+{
+    /// @brief Builds the name of a journald source from its conditions, for filter reporting
+    std::string JournaldSource(const FilterGroup& filters)
+    {
+        std::string source = "journald";
+
+        for (const auto& filter : filters)
+        {
+            source += ":" + filter.field + "=" + filter.value;
+        }
+
+        return source;
+    }
+} // namespace
+
 namespace logcollector
 {
 
@@ -37,8 +53,11 @@ namespace logcollector
                 if (!filters.empty())
                 {
                     // Create a reader with all conditions
-                    AddReader(std::make_shared<JournaldReader>(
-                        *this, filters, config["ignore_if_missing"].as<bool>(false), fileWait));
+                    AddReader(std::make_shared<JournaldReader>(*this,
+                                                               filters,
+                                                               config["ignore_if_missing"].as<bool>(false),
+                                                               fileWait,
+                                                               CreateLineFilter(JournaldSource(filters), config)));
                 }
             }
             else
@@ -48,8 +67,11 @@ namespace logcollector
                                             config["value"].as<std::string>(),
                                             config["exact_match"].as<bool>(true)}};
 
-                AddReader(std::make_shared<JournaldReader>(
-                    *this, filters, config["ignore_if_missing"].as<bool>(false), fileWait));
+                AddReader(std::make_shared<JournaldReader>(*this,
+                                                           filters,
+                                                           config["ignore_if_missing"].as<bool>(false),
+                                                           fileWait,
+                                                           CreateLineFilter(JournaldSource(filters), config)));
             }
         }
     }
@@ -3,6 +3,7 @@
 #include <spdlog/spdlog.h>
 #include <sstream>
 
+#include <file_checkpoint_store.hpp>
 #include <file_reader.hpp>
 #include <logcollector.hpp>
 #include <logcollector_mock.hpp>
@@ -83,6 +84,163 @@ TEST(Localfile, Deleted)
     }
 }
 
+TEST(Localfile, ResumeSameFile)
+{
+    auto fileA = TempFile("/tmp/A.log", "Hello World\nGoodbye World\n");
+    auto lf = Localfile("/tmp/A.log");
+
+    ASSERT_EQ(lf.NextLog(), "Hello World");
+    const auto checkpoint = lf.Checkpoint();
+
+    auto resumed = Localfile("/tmp/A.log");
+    ASSERT_TRUE(resumed.Resume(checkpoint));
+    ASSERT_EQ(resumed.NextLog(), "Goodbye World");
+}
+
+TEST(Localfile, ResumeRotatedFile)
+{
+    auto fileA = std::make_unique<TempFile>("/tmp/A.log", "Hello World\nGoodbye World\n");
+    auto lf = Localfile("/tmp/A.log");
+
+    ASSERT_EQ(lf.NextLog(), "Hello World");
+    const auto checkpoint = lf.Checkpoint();
+
+    fileA.reset();
+    fileA = std::make_unique<TempFile>("/tmp/A.log", "Rotated World\n");
+    auto resumed = Localfile("/tmp/A.log");
+    ASSERT_FALSE(resumed.Resume(checkpoint));
+    ASSERT_EQ(resumed.NextLog(), "Rotated World");
+}
+
+TEST(Localfile, ResumeCopyTruncatedFile)
+{
+    auto fileA = TempFile("/tmp/A.log", "Hello World\nGoodbye World\n");
+    auto lf = Localfile("/tmp/A.log");
+
+    ASSERT_EQ(lf.NextLog(), "Hello World");
+    ASSERT_EQ(lf.NextLog(), "Goodbye World");
+    const auto checkpoint = lf.Checkpoint();
+
+    fileA.Truncate();
+    fileA.Write("Truncated World\n");
+    auto resumed = Localfile("/tmp/A.log");
+    ASSERT_FALSE(resumed.Resume(checkpoint));
+    ASSERT_EQ(resumed.NextLog(), "Truncated World");
+}
+
+TEST(Localfile, RestoreCopyTruncatedFile)
+{
+    auto fileA = TempFile("/tmp/A.log", "Hello World\nGoodbye World\n");
+    auto lf = Localfile("/tmp/A.log");
+
+    ASSERT_EQ(lf.NextLog(), "Hello World");
+    lf.Checkpoint();
+    lf.Close();
+
+    fileA.Truncate();
+    fileA.Write("Truncated World\nAnd grown back\n");
+    ASSERT_FALSE(lf.Restore());
+    ASSERT_EQ(lf.NextLog(), "Truncated World");
+}
+
+TEST(Localfile, PartialLineIsNotNewData)
+{
+    auto fileA = TempFile("/tmp/A.log", "Hello");
+    auto lf = Localfile("/tmp/A.log");
+
+    ASSERT_EQ(lf.NextLog(), "");
+    lf.Close();
+    ASSERT_FALSE(lf.HasNewData());
+
+    fileA.Write(" World\n");
+    ASSERT_TRUE(lf.HasNewData());
+    ASSERT_TRUE(lf.Restore());
+    ASSERT_EQ(lf.NextLog(), "Hello World");
+}
+
+TEST(FileCheckpointStore, FlushAndLoad)
+{
+    const auto dbFolder = std::filesystem::temp_directory_path() / "logcollector_checkpoint_test";
+    std::filesystem::create_directories(dbFolder);
+
+    auto fileA = TempFile("/tmp/A.log", "Hello World\n");
+    const auto checkpoint = FileCheckpoint {1, 2, 12, 3, 12}; // NOLINT
+
+    {
+        auto store = FileCheckpointStore(dbFolder.string());
+        ASSERT_FALSE(store.Get("/tmp/A.log").has_value());
+
+        store.Set("/tmp/A.log", checkpoint);
+        store.Set("/tmp/unexisting.log", checkpoint);
+        store.Flush();
+    }
+
+    {
+        auto store = FileCheckpointStore(dbFolder.string());
+        const auto loaded = store.Get("/tmp/A.log");
+
+        ASSERT_TRUE(loaded.has_value());
+        ASSERT_EQ(loaded->device, checkpoint.device);
+        ASSERT_EQ(loaded->inode, checkpoint.inode);
+        ASSERT_EQ(loaded->offset, checkpoint.offset);
+        ASSERT_EQ(loaded->fingerprint, checkpoint.fingerprint);
+        ASSERT_EQ(loaded->fingerprintSize, checkpoint.fingerprintSize);
+        ASSERT_FALSE(store.Get("/tmp/unexisting.log").has_value());
+    }
+
+    std::filesystem::remove_all(dbFolder);
+}
+
+TEST(LocalfileRegistry, AddAndRemove)
+{
+    auto fileA = TempFile("/tmp/A.log", "Hello World\n");
+    auto registry = LocalfileRegistry();
+
+    ASSERT_NE(registry.Add("/tmp/A.log"), nullptr);
+    ASSERT_TRUE(registry.Contains("/tmp/A.log"));
+    ASSERT_EQ(registry.Size(), 1);
+
+    registry.Remove("/tmp/A.log");
+    ASSERT_FALSE(registry.Contains("/tmp/A.log"));
+    ASSERT_EQ(registry.Size(), 0);
+}
+
+TEST(LocalfileRegistry, DuplicateIdentity)
+{
+    auto fileA = TempFile("/tmp/A.log", "Hello World\n");
+    std::filesystem::create_hard_link("/tmp/A.log", "/tmp/B.log");
+    auto registry = LocalfileRegistry();
+
+    ASSERT_NE(registry.Add("/tmp/A.log"), nullptr);
+    ASSERT_EQ(registry.Add("/tmp/B.log"), nullptr);
+    ASSERT_EQ(registry.Size(), 1);
+
+    std::filesystem::remove("/tmp/B.log");
+}
+
+TEST(LocalfileRegistry, MaxOpenFiles)
+{
+    auto fileA = TempFile("/tmp/A.log");
+    auto fileB = TempFile("/tmp/B.log");
+    auto registry = LocalfileRegistry(1);
+
+    auto* lfA = registry.Add("/tmp/A.log");
+    lfA->SeekEnd();
+    auto* lfB = registry.Add("/tmp/B.log");
+
+    ASSERT_FALSE(lfA->IsOpen());
+    ASSERT_TRUE(lfB->IsOpen());
+    ASSERT_EQ(registry.OpenCount(), 1);
+    ASSERT_FALSE(lfA->HasNewData());
+
+    fileA.Write("Hello World\n");
+    ASSERT_TRUE(lfA->HasNewData());
+    ASSERT_TRUE(registry.Restore(*lfA));
+    ASSERT_TRUE(lfA->IsOpen());
+    ASSERT_FALSE(lfB->IsOpen());
+    ASSERT_EQ(lfA->NextLog(), "Hello World");
+}
+
 TEST(FileReader, Reload)
 {
     spdlog::default_logger()->sinks().clear();
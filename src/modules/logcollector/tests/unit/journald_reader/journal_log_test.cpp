@@ -118,3 +118,52 @@ TEST_F(JournalLogTests, ErrorHandling)
     const FilterGroup invalidGroup {{"", "value", true}};
     EXPECT_THROW(journal->AddFilterGroup(invalidGroup, false), JournalLogException);
 }
+
+TEST_F(JournalLogTests, ChangeNotification)
+{
+    const int fd = journal->GetFd();
+
+    // Change notifications might not be available in test environment
+    if (fd >= 0)
+    {
+        EXPECT_NO_THROW(journal->Process());
+
+        const auto timeout = journal->GetTimeout();
+        if (timeout)
+        {
+            EXPECT_GE(timeout->count(), 0);
+        }
+    }
+}
+
+TEST(CompiledFilterSetTests, MatchesEntryFields)
+{
+    const CompiledFilterSet filters {{{{"_SYSTEMD_UNIT", "ssh|cron", false}, {"PRIORITY", "3|4", true}}}};
+    auto entry = filters.CreateEntryFields();
+
+    entry.Set("MESSAGE=Accepted publickey");
+    entry.Set("_SYSTEMD_UNIT=ssh.service");
+    entry.Set("PRIORITY=4");
+    entry.Set("PRIORITY=6");
+    EXPECT_TRUE(filters.Matches(entry, true));
+    EXPECT_EQ(entry.Get(CompiledFilterSet::MESSAGE_SLOT), "Accepted publickey");
+    EXPECT_EQ(entry.Get(CompiledFilterSet::UNIT_SLOT), "ssh.service");
+
+    entry.Clear();
+    entry.Set("_SYSTEMD_UNIT=ssh.service");
+    entry.Set("PRIORITY=6");
+    EXPECT_FALSE(filters.Matches(entry, true));
+
+    entry.Clear();
+    entry.Set("_SYSTEMD_UNIT=cron.service");
+    EXPECT_FALSE(filters.Matches(entry, true));
+    EXPECT_FALSE(entry.Get(CompiledFilterSet::MESSAGE_SLOT));
+}
+
+TEST_F(JournalLogTests, FindMissingData)
+{
+    if (journal->SeekHead() && journal->Next())
+    {
+        EXPECT_FALSE(journal->FindData("NONEXISTENT_FIELD"));
+    }
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <line_filter.hpp>
+
+#include <regex>
+
+using namespace logcollector;
+
+TEST(LineFilter, NoRules)
+{
+    auto filter = LineFilter("source", {}, {});
+
+    ASSERT_TRUE(filter.Empty());
+    ASSERT_TRUE(filter.Accept("Hello World"));
+    ASSERT_EQ(filter.Matched(), 1);
+    ASSERT_EQ(filter.Dropped(), 0);
+}
+
+TEST(LineFilter, IncludeLiteral)
+{
+    auto filter = LineFilter("source", {"sshd", "sudo"}, {});
+
+    ASSERT_TRUE(filter.Accept("box sshd[123]: Accepted publickey"));
+    ASSERT_TRUE(filter.Accept("box sudo: pam_unix(sudo:session)"));
+    ASSERT_FALSE(filter.Accept("box CRON[23505]: session closed"));
+    ASSERT_EQ(filter.Matched(), 2);
+    ASSERT_EQ(filter.Dropped(), 1);
+}
+
+TEST(LineFilter, ExcludeRegex)
+{
+    auto filter = LineFilter("source", {}, {R"(CRON\[\d+\]: pam_unix)"});
+
+    ASSERT_FALSE(filter.Accept("box CRON[23505]: pam_unix(cron:session): session closed"));
+    ASSERT_TRUE(filter.Accept("box CRON[23505]: (root) CMD (run-parts)"));
+    ASSERT_TRUE(filter.Accept("box sshd[123]: pam_unix(sshd:session)"));
+}
+
+TEST(LineFilter, IncludeAndExclude)
+{
+    auto filter = LineFilter("source", {"^.*(error|fail)"}, {"debug"});
+
+    ASSERT_TRUE(filter.Accept("disk error on sda"));
+    ASSERT_TRUE(filter.Accept("login fail for root"));
+    ASSERT_FALSE(filter.Accept("debug: disk error on sda"));
+    ASSERT_FALSE(filter.Accept("all good"));
+}
+
+TEST(LineFilter, OptionalCharacters)
+{
+    auto filter = LineFilter("source", {"colou?r", "ab*c"}, {});
+
+    ASSERT_TRUE(filter.Accept("color"));
+    ASSERT_TRUE(filter.Accept("colour"));
+    ASSERT_TRUE(filter.Accept("ac"));
+    ASSERT_FALSE(filter.Accept("colr"));
+}
+
+TEST(LineFilter, InvalidRuleIgnored)
+{
+    auto filter = LineFilter("source", {"("}, {});
+
+    ASSERT_TRUE(filter.Empty());
+    ASSERT_TRUE(filter.Accept("anything"));
+}
+
+TEST(LineFilter, BracketExpressions)
+{
+    // The rules are only a faster std::regex_search, so any line they accept or drop must agree with it
+    const std::vector<std::string> patterns = {
+        R"([\]xyz]+q)", R"([[:alpha:]xyz]+q)", "[]abc]", "[^]]abc", "err[0-9]+ code", R"(id=[a-f\]]{2}ok)"};
+    const std::vector<std::string> lines = {
+        "]q", "aq", "xyzq", "abc", "]abc", "xabc", "err42 code", "err code", "id=a]ok", "id=aaok", "id=ok"};
+
+    for (const auto& pattern : patterns)
+    {
+        auto filter = LineFilter("source", {pattern}, {});
+        const auto regex = std::regex(pattern);
+
+        for (const auto& line : lines)
+        {
+            EXPECT_EQ(filter.Accept(line), std::regex_search(line, regex)) << pattern << " on " << line;
+        }
+    }
+}
@@ -3,6 +3,11 @@
 #include <configuration_parser.hpp>
 #include <file_reader.hpp>
 #include <gtest/gtest.h>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+
 #include <regex>
 
 using namespace configuration;
@@ -53,6 +58,44 @@ TEST(Logcollector, SetupFileReader)
     ASSERT_NE(capturedReader2, nullptr);
 }
 
+TEST(Logcollector, SetupFileReaderWithFilters)
+{
+    auto constexpr CONFIG_RAW = R"(
+    logcollector:
+      localfiles:
+        - /var/log/auth.log
+        - location: /var/log/syslog
+          include: sshd
+          exclude:
+            - debug
+            - CRON\[\d+\]
+    )";
+
+    auto logcollector = LogcollectorMock();
+    auto config = std::make_shared<configuration::ConfigurationParser>(std::string(CONFIG_RAW));
+
+    EXPECT_CALL(logcollector, AddReader(::testing::_)).Times(2);
+
+    logcollector.SetupFileReader(config);
+
+    const auto stats = logcollector.GetFilterStats();
+    ASSERT_EQ(stats.size(), 1);
+    ASSERT_EQ(stats["/var/log/syslog"]["matched"], 0);
+    ASSERT_EQ(stats["/var/log/syslog"]["dropped"], 0);
+
+    boost::asio::io_context ioContext;
+    boost::asio::co_spawn(
+        ioContext,
+        [&logcollector, &stats]() -> boost::asio::awaitable<void>
+        {
+            const auto result = co_await logcollector.ExecuteCommand(FILTER_STATS_COMMAND, {});
+            EXPECT_EQ(result.ErrorCode, module_command::Status::SUCCESS);
+            EXPECT_EQ(nlohmann::json::parse(result.Message), stats);
+        },
+        boost::asio::detached);
+    ioContext.run();
+}
+
 TEST(Logcollector, SendMessageFile)
 {
     PushMessageMock mock;